@@ -13,8 +13,38 @@
 #include <math.h>
 #include <time.h>
 #include <stdbool.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 #include "dsl_lists.h"
 #include "dsl_listsort.h"
+#include "dsl_threadpool.h"
+#include "dsl_unrolled.h"
+#include "dsl_typed_lists.h"
+#include "dsl_sortgen.h"
+#include "dsl_skiplist.h"
+#include "dsl_cache.h"
+#include "dsl_heap.h"
+#include "dsl_simdsort.h"
+#include "dsl_extsort.h"
+#include "dsl_serialize.h"
+#include "dsl_cursor.h"
+#include "dsl_compactlist.h"
+#include "dsl_deque.h"
+#include "dsl_blockingqueue.h"
+#include "dsl_parallel.h"
+
+//  Singly linked list of `int` stored inline, for the inline value storage benchmarks
+DSL_DEFINE_TYPED_SLL(int_sll, int, DSL_COMPARE_SCALAR(a, b))
+
+//  Sorts of lists of `int*` with an inlined comparison, for the type-specialized sorting benchmarks
+DSL_DEFINE_SORT(int_sort, int, a < b)
+
+//  The same sorts calling the comparison through a pointer, as the sorts of `dsl_listsort.h` do: the pointer is volatile so that the call is never inlined.
+//  The merge and quick sorts of `dsl_listsort.h` build new lists, so the benchmarks compare the generated ones against these, which only differ by the call.
+static int (*volatile benchmark_sort_compare)(void*, void*) = compare_int;
+DSL_DEFINE_SORT(callback_int_sort, int, benchmark_sort_compare(&a, &b) < 0)
 
 /*
     General use functions and routines
@@ -142,19 +172,46 @@ double standard_deviation(double values[], int size) {
 
 
 
+/*
+    benchmark_wall_time
+    Returns the current value of a monotonic wall clock, in seconds.
+    @returns double
+*/
+double benchmark_wall_time(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+};
+
+
+/*
+    Values of the random lists, filled as they are drawn: the nodes point into this table rather than to copies of the integers in their block,
+    so the lists can be concatenated, sorted by exchanging data and freed in parts like lists of allocated elements
+*/
+static int benchmark_int_values[1000];
+
+/*
+    benchmark_random_int
+    Generator of the random lists: a random integer between 0 and 999, as a pointer into `benchmark_int_values`
+*/
+static void* benchmark_random_int(size_t index, void* slot, void* context){
+    (void)index;
+    (void)slot;
+    (void)context;
+
+    int value = rand() % 1000;
+    benchmark_int_values[value] = value;
+
+    return &benchmark_int_values[value];
+};
+
 /*
     sll_get_random_sll
     Function to generate a list of random integers.
     @returns SinglyLinkedList* list
 */
 SinglyLinkedList* sll_get_random_sll(int size){
-    SinglyLinkedList* list = sll_create();
-    for(int i = 0; i < size; i++){
-        int* data = (int*)malloc(sizeof(int));
-        *data = rand() % 1000;
-        sll_insert(list, data);
-    }
-    return list;
+    return sll_from_generator(size, 0, benchmark_random_int, NULL);
 };
 
 /*
@@ -163,11 +220,20 @@ SinglyLinkedList* sll_get_random_sll(int size){
     @returns DoublyLinkedList* list
 */
 DoublyLinkedList* dll_get_random_dll(int size){
-    DoublyLinkedList* list = dll_create();
+    return dll_from_generator(size, 0, benchmark_random_int, NULL);
+};
+
+/*
+    ull_get_random_ull
+    Function to generate an unrolled list of random integers.
+    @returns UnrolledList* list
+*/
+UnrolledList* ull_get_random_ull(int size){
+    UnrolledList* list = ull_create();
     for(int i = 0; i < size; i++){
         int* data = (int*)malloc(sizeof(int));
         *data = rand() % 1000;
-        dll_insert(list, data);
+        ull_insert(list, data);
     }
     return list;
 };
@@ -740,4 +806,3015 @@ char* RUN_BENCHMARK(char* function, char* list_type, int ntests, int list_size){
     free(results);
 
     return buffer;
-};
\ No newline at end of file
+};
+
+
+
+/*
+    Work-stealing thread pool benchmarks
+*/
+
+/*
+    UnbalancedTask
+    Node of the unbalanced task tree: a task of size `n` forks tasks of size `n - 1` and `n - 2`.
+*/
+typedef struct UnbalancedTask {
+    ThreadPool* pool;
+    int n;
+    long result;
+} UnbalancedTask;
+
+/*
+    unbalanced_leaf
+    Sequential work done at the leaves of the unbalanced task tree.
+    @param int n
+    @returns long
+*/
+static long unbalanced_leaf(int n){
+    return n < 2 ? n : unbalanced_leaf(n - 1) + unbalanced_leaf(n - 2);
+};
+
+/*
+    unbalanced_task
+    Task of the unbalanced workload. The two subtrees have different sizes, so a static split would leave workers idle.
+    @param void* arg
+    @returns void
+*/
+static void unbalanced_task(void* arg){
+    UnbalancedTask* task = (UnbalancedTask*) arg;
+
+    if(task->n < 16){
+        task->result = unbalanced_leaf(task->n);
+        return;
+    }
+
+    UnbalancedTask left = {task->pool, task->n - 1, 0};
+    UnbalancedTask right = {task->pool, task->n - 2, 0};
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    if(!threadpool_submit(task->pool, &group, unbalanced_task, &left)){
+        unbalanced_task(&left);
+    }
+    unbalanced_task(&right);
+    threadpool_wait(task->pool, &group);
+
+    task->result = left.result + right.result;
+};
+
+/*
+    benchmark_threadpool_unbalanced_on
+    Runs the unbalanced workload on an existing pool.
+    @param ThreadPool* pool
+    @param int depth
+    @returns BenchmarkResult*
+*/
+static BenchmarkResult* benchmark_threadpool_unbalanced_on(ThreadPool* pool, int depth){
+    //  Set time variables
+    double start, end;
+
+    UnbalancedTask root = {pool, depth, 0};
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    //  Start the clock
+    start = benchmark_wall_time();
+
+    //  Submit the root task from outside the pool and wait for the whole tree
+    threadpool_submit(pool, &group, unbalanced_task, &root);
+    threadpool_wait(pool, &group);
+
+    //  Stop the clock
+    end = benchmark_wall_time();
+
+    //  Return the benchmark result
+    return create_benchmark_result("Thread Pool Unbalanced Recursion", "Work-Stealing Deque", "Fork-Join", depth, (end - start) * 1000.0);
+};
+
+/*
+    benchmark_threadpool_unbalanced
+    Benchmarks a work-stealing thread pool on an unbalanced recursive workload.
+    @param int nthreads
+    @param int depth
+    @returns BenchmarkResult*
+*/
+BenchmarkResult* benchmark_threadpool_unbalanced(int nthreads, int depth){
+    ThreadPool* pool = threadpool_create(nthreads);
+    BenchmarkResult* result = benchmark_threadpool_unbalanced_on(pool, depth);
+    threadpool_destroy(pool);
+    return result;
+};
+
+/*
+    benchmark_sll_parallel_mergesort
+    Benchmarks `sll_parallel_mergesort` on a random singly linked list.
+    @param int nthreads
+    @param int list_size
+    @returns BenchmarkResult*
+*/
+BenchmarkResult* benchmark_sll_parallel_mergesort(int nthreads, int list_size){
+    //  Set time variables
+    double start, end;
+
+    ThreadPool* pool = threadpool_create(nthreads);
+    SinglyLinkedList* sll = sll_get_random_sll(list_size);
+
+    //  Start the clock
+    start = benchmark_wall_time();
+
+    //  Run the parallel merge sort on a `SinglyLinkedList` structure
+    sll_parallel_mergesort(sll, compare_int, pool);
+
+    //  Stop the clock
+    end = benchmark_wall_time();
+
+    threadpool_destroy(pool);
+
+    int size = sll_len(sll);
+    sll_destroy(sll);
+
+    //  Return the benchmark result
+    return create_benchmark_result("Singly Linked List Parallel Merge Sort", "Singly Linked List", "Parallel Merge Sort", size, (end - start) * 1000.0);
+};
+
+/*
+    run_benchmark_threadpool
+    Runs the thread pool benchmarks for 1, 2, 4, ... worker threads, up to the number of online processors.
+    @param int depth
+    @param int list_size
+    @returns char*
+*/
+char* run_benchmark_threadpool(int depth, int list_size){
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = online > 0 ? (int) online : 1;
+
+    size_t capacity = 4096;
+    size_t length = 0;
+    char* buffer = (char*) malloc(capacity * sizeof(char));
+
+    length += snprintf(buffer + length, capacity - length, "Benchmark Test: Work-Stealing Thread Pool\nTask Tree Depth: %d\nList Size: %d\n", depth, list_size);
+
+    double baseline_tree = 0.0;
+    double baseline_sort = 0.0;
+
+    for(int nthreads = 1; ; nthreads *= 2){
+        if(nthreads > max_threads){
+            nthreads = max_threads;
+        }
+
+        ThreadPool* pool = threadpool_create(nthreads);
+        BenchmarkResult* tree = benchmark_threadpool_unbalanced_on(pool, depth);
+
+        //  Load balance: tasks executed by the least and most loaded workers
+        size_t min_executed = (size_t) -1, max_executed = 0, stolen = 0;
+        for(int i = 0; i < nthreads; i++){
+            size_t executed = threadpool_executed(pool, i);
+            min_executed = executed < min_executed ? executed : min_executed;
+            max_executed = executed > max_executed ? executed : max_executed;
+            stolen += threadpool_stolen(pool, i);
+        }
+        threadpool_destroy(pool);
+
+        BenchmarkResult* sort = benchmark_sll_parallel_mergesort(nthreads, list_size);
+
+        if(nthreads == 1){
+            baseline_tree = tree->time;
+            baseline_sort = sort->time;
+        }
+
+        if(capacity - length < 512){
+            capacity *= 2;
+            buffer = (char*) realloc(buffer, capacity * sizeof(char));
+        }
+
+        length += snprintf(buffer + length, capacity - length, "Threads: %d\n  Unbalanced tree: %f ms (speedup %.2fx), tasks per worker min %zu / max %zu, steals %zu\n  Parallel merge sort: %f ms (speedup %.2fx)\n", nthreads, tree->time, baseline_tree / tree->time, min_executed, max_executed, stolen, sort->time, baseline_sort / sort->time);
+
+        free_benchmark_result(tree);
+        free_benchmark_result(sort);
+
+        if(nthreads == max_threads){
+            break;
+        }
+    }
+
+    return buffer;
+};
+
+
+
+/*
+    Unrolled linked list benchmarks
+*/
+
+/*
+    benchmark_sll_traversal
+    Benchmarks a full traversal of a random singly linked list.
+    @param int list_size
+    @param int repeats
+    @returns BenchmarkResult*
+*/
+BenchmarkResult* benchmark_sll_traversal(int list_size, int repeats){
+    //  Set time variables
+    double start, end;
+
+    SinglyLinkedList* sll = sll_get_random_sll(list_size);
+    int missing = 0;
+
+    //  Start the clock
+    start = benchmark_wall_time();
+
+    //  Search for an element that is not in the list: every node is visited
+    for(int i = 0; i < repeats; i++){
+        if(sll_search(sll, &missing) != NULL){
+            break;
+        }
+    }
+
+    //  Stop the clock
+    end = benchmark_wall_time();
+
+    sll_destroy(sll);
+
+    //  Return the benchmark result
+    return create_benchmark_result("Singly Linked List Traversal", "Singly Linked List", "Search", list_size, (end - start) * 1000.0);
+};
+
+/*
+    benchmark_ull_traversal
+    Benchmarks a full traversal of a random unrolled linked list.
+    @param int list_size
+    @param int repeats
+    @returns BenchmarkResult*
+*/
+BenchmarkResult* benchmark_ull_traversal(int list_size, int repeats){
+    //  Set time variables
+    double start, end;
+
+    UnrolledList* ull = ull_get_random_ull(list_size);
+    int missing = 0;
+
+    //  Start the clock
+    start = benchmark_wall_time();
+
+    //  Search for an element that is not in the list: every node is visited
+    for(int i = 0; i < repeats; i++){
+        if(ull_search(ull, &missing, NULL) != NULL){
+            break;
+        }
+    }
+
+    //  Stop the clock
+    end = benchmark_wall_time();
+
+    ull_destroy_with(ull, free);
+
+    //  Return the benchmark result
+    return create_benchmark_result("Unrolled Linked List Traversal", "Unrolled Linked List", "Search", list_size, (end - start) * 1000.0);
+};
+
+/*
+    run_benchmark_unrolled_traversal
+    Compares the traversal of a `SinglyLinkedList` and of an `UnrolledList`.
+    @param int list_size
+    @param int repeats
+    @returns char*
+*/
+char* run_benchmark_unrolled_traversal(int list_size, int repeats){
+    BenchmarkResult* sll = benchmark_sll_traversal(list_size, repeats);
+    BenchmarkResult* ull = benchmark_ull_traversal(list_size, repeats);
+
+    //  Built by `ull_insert`, every node but the first is full
+    double ull_nodes = (double) ((list_size + ULL_NODE_CAPACITY - 1) / ULL_NODE_CAPACITY);
+    double visited = (double) list_size * repeats;
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    sprintf(buffer, "Benchmark Test: Unrolled List Traversal\nList Size: %d\nTraversals: %d\n"
+                    "Singly Linked List: %f ms (%.3f ns/element), nodes visited per element: 1.000, node bytes per element: %zu\n"
+                    "Unrolled Linked List: %f ms (%.3f ns/element), nodes visited per element: %.3f, node bytes per element: %.3f\n"
+                    "Speedup: %.2fx",
+            list_size, repeats,
+            sll->time, sll->time * 1e6 / visited, sizeof(SLLNode),
+            ull->time, ull->time * 1e6 / visited, ull_nodes / list_size, ull_nodes * sizeof(ULLNode) / list_size,
+            sll->time / ull->time);
+
+    free_benchmark_result(sll);
+    free_benchmark_result(ull);
+
+    return buffer;
+};
+
+
+
+/*
+    Inline value storage benchmarks
+*/
+
+/*
+    run_benchmark_typed_sll
+    Compares a generic `SinglyLinkedList` of `int*` with an `int_sll_list` storing the values inline.
+    @param int list_size
+    @param int repeats
+    @returns char*
+*/
+char* run_benchmark_typed_sll(int list_size, int repeats){
+    //  Set time variables
+    double start, end;
+    double generic_build, generic_search, typed_build, typed_search;
+    int missing = -1;
+
+    //  Generic list: one node and one `int` allocated per element
+    start = benchmark_wall_time();
+    SinglyLinkedList* sll = sll_get_random_sll(list_size);
+    end = benchmark_wall_time();
+    generic_build = (end - start) * 1000.0;
+
+    //  Search by value: `sll_search` compares pointers, so the scan calls `compare_int` like the sorts do
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        for(SLLNode* current = sll->head; current != NULL; current = current->next){
+            if(compare_int(current->data, &missing) == 0){
+                break;
+            }
+        }
+    }
+    end = benchmark_wall_time();
+    generic_search = (end - start) * 1000.0;
+
+    //  Typed list: one node per element, with the value inside
+    start = benchmark_wall_time();
+    int_sll_list* typed = int_sll_create();
+    for(int i = 0; i < list_size; i++){
+        int_sll_insert(typed, rand() % 1000);
+    }
+    end = benchmark_wall_time();
+    typed_build = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        if(int_sll_search(typed, missing) != NULL){
+            break;
+        }
+    }
+    end = benchmark_wall_time();
+    typed_search = (end - start) * 1000.0;
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    sprintf(buffer, "Benchmark Test: Inline Value Storage\nList Size: %d\nSearches: %d\n"
+                    "Generic SinglyLinkedList: build %f ms, search %f ms, allocations per element: 2, bytes per element: %zu\n"
+                    "Typed int_sll_list: build %f ms, search %f ms, allocations per element: 1, bytes per element: %zu\n"
+                    "Speedup: build %.2fx, search %.2fx",
+            list_size, repeats,
+            generic_build, generic_search, sizeof(SLLNode) + sizeof(int),
+            typed_build, typed_search, sizeof(int_sll_node),
+            generic_build / typed_build, generic_search / typed_search);
+
+    sll_destroy(sll);
+    int_sll_destroy(typed);
+
+    return buffer;
+};
+
+
+
+/*
+    Type-specialized sorting benchmarks
+*/
+
+/*
+    benchmark_sll_sort_pair
+    Sorts two singly linked lists holding the same random `int`s: one with a callback sort of `dsl_listsort.h`, one with its `DSL_DEFINE_SORT` counterpart.
+    The times (in ms) are added to `callback_time` and `inlined_time`.
+    @param SinglyLinkedList* (*callback_sort)(SinglyLinkedList*, int (*)(void*, void*))
+    @param SinglyLinkedList* (*inlined_sort)(SinglyLinkedList*)
+    @param int list_size
+    @param double* callback_time
+    @param double* inlined_time
+    @returns void
+*/
+static void benchmark_sll_sort_pair(SinglyLinkedList* (*callback_sort)(SinglyLinkedList*, int (*)(void*, void*)), SinglyLinkedList* (*inlined_sort)(SinglyLinkedList*), int list_size, double* callback_time, double* inlined_time){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(list_size * sizeof(int));
+    SinglyLinkedList* callback_list = sll_create();
+    SinglyLinkedList* inlined_list = sll_create();
+
+    for(int i = 0; i < list_size; i++){
+        values[i] = rand() % 1000;
+        sll_insert(callback_list, &values[i]);
+        sll_insert(inlined_list, &values[i]);
+    }
+
+    start = benchmark_wall_time();
+    SinglyLinkedList* sorted = callback_sort(callback_list, compare_int);
+    end = benchmark_wall_time();
+    *callback_time += (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    inlined_sort(inlined_list);
+    end = benchmark_wall_time();
+    *inlined_time += (end - start) * 1000.0;
+
+    if(sorted != callback_list){
+        sll_destroy(sorted);
+    }
+    sll_destroy(callback_list);
+    sll_destroy(inlined_list);
+    free(values);
+};
+
+/*
+    benchmark_callback_mergesort, benchmark_callback_quicksort
+    In-place merge and quick sorts relinking the nodes like the generated ones, calling `compare` through a pointer.
+*/
+static SinglyLinkedList* benchmark_callback_mergesort(SinglyLinkedList* list, int (*compare)(void*, void*)){
+    benchmark_sort_compare = compare;
+    return callback_int_sort_sll_mergesort(list);
+};
+
+static SinglyLinkedList* benchmark_callback_quicksort(SinglyLinkedList* list, int (*compare)(void*, void*)){
+    benchmark_sort_compare = compare;
+    return callback_int_sort_sll_quicksort(list);
+};
+
+/*
+    run_benchmark_sortgen
+    Compares the callback sorts with the sorts generated by `DSL_DEFINE_SORT`: the bubble, selection and insertion sorts of `dsl_listsort.h`, which swap the data in place,
+    and in-place merge and quick sorts that only differ from the generated ones by the comparison call.
+    @param int ntests
+    @param int list_size
+    @returns char*
+*/
+char* run_benchmark_sortgen(int ntests, int list_size){
+    const char* names[] = {"Bubble Sort", "Selection Sort", "Insertion Sort", "Merge Sort", "Quick Sort"};
+    SinglyLinkedList* (*callback_sorts[])(SinglyLinkedList*, int (*)(void*, void*)) = {sll_bubblesort, sll_selectionsort, sll_insertionsort, benchmark_callback_mergesort, benchmark_callback_quicksort};
+    SinglyLinkedList* (*inlined_sorts[])(SinglyLinkedList*) = {int_sort_sll_bubblesort, int_sort_sll_selectionsort, int_sort_sll_insertionsort, int_sort_sll_mergesort, int_sort_sll_quicksort};
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Type-Specialized Sorting\nNumber of Tests: %d\nList Size: %d\n", ntests, list_size);
+
+    for(int algorithm = 0; algorithm < 5; algorithm++){
+        double callback_time = 0.0;
+        double inlined_time = 0.0;
+
+        for(int i = 0; i < ntests; i++){
+            benchmark_sll_sort_pair(callback_sorts[algorithm], inlined_sorts[algorithm], list_size, &callback_time, &inlined_time);
+        }
+
+        length += sprintf(buffer + length, "%s: callback %f ms, inlined %f ms, speedup %.2fx\n", names[algorithm], callback_time / ntests, inlined_time / ntests, callback_time / inlined_time);
+    }
+
+    return buffer;
+};
+
+
+/*
+    Skip list benchmarks
+*/
+
+/*
+    run_benchmark_skiplist
+    Compares `sll_search` on a sorted singly linked list with `skiplist_search` on a skip list holding the same elements, for list sizes 10^min_exponent to 10^max_exponent.
+    @param int min_exponent
+    @param int max_exponent
+    @param int lookups
+    @returns char*
+*/
+char* run_benchmark_skiplist(int min_exponent, int max_exponent, int lookups){
+    //  Set time variables
+    double start, end;
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Skip List Search\nLookups: %d (fewer for the linear search on large lists)\n", lookups);
+
+    int list_size = 1;
+    for(int i = 0; i < min_exponent; i++){
+        list_size *= 10;
+    }
+
+    for(int exponent = min_exponent; exponent <= max_exponent; exponent++, list_size *= 10){
+        int* values = (int*) malloc(list_size * sizeof(int));
+        SinglyLinkedList* sll = sll_create();
+        SkipList* skl = skiplist_create(compare_int);
+
+        for(int i = 0; i < list_size; i++){
+            values[i] = i;
+        }
+
+        //  Both structures hold the sorted values
+        for(int i = list_size - 1; i >= 0; i--){
+            sll_insert(sll, &values[i]);
+        }
+
+        start = benchmark_wall_time();
+        for(int i = 0; i < list_size; i++){
+            skiplist_insert(skl, &values[i]);
+        }
+        end = benchmark_wall_time();
+        double build_time = (end - start) * 1000.0;
+
+        //  Keep the linear scans to about 10^8 visited nodes
+        int sll_lookups = lookups;
+        if((long) sll_lookups * list_size > 100000000L){
+            sll_lookups = (int) (100000000L / list_size);
+        }
+        if(sll_lookups < 1){
+            sll_lookups = 1;
+        }
+
+        size_t found = 0;
+        start = benchmark_wall_time();
+        for(int i = 0; i < sll_lookups; i++){
+            found += sll_search(sll, &values[rand() % list_size]) != NULL;
+        }
+        end = benchmark_wall_time();
+        double sll_time = (end - start) * 1e9 / sll_lookups;
+
+        start = benchmark_wall_time();
+        for(int i = 0; i < lookups; i++){
+            int key = rand() % list_size;
+            found += skiplist_search(skl, &key) != NULL;
+        }
+        end = benchmark_wall_time();
+        double skl_time = (end - start) * 1e9 / lookups;
+
+        length += sprintf(buffer + length, "List Size: %d, sll_search: %.1f ns/lookup, skiplist_search: %.1f ns/lookup (build %f ms), speedup %.1fx, found %zu\n",
+                list_size, sll_time, skl_time, build_time, sll_time / skl_time, found);
+
+        sll_destroy(sll);
+        skiplist_destroy(skl);
+        free(values);
+    }
+
+    return buffer;
+};
+
+
+
+/*
+    Hash index benchmarks
+*/
+
+/*
+    run_benchmark_hashindex
+    Compares `dll_remove` on a `DoublyLinkedList` with and without an attached hash index.
+    @param int list_size
+    @param int removals
+    @returns char*
+*/
+char* run_benchmark_hashindex(int list_size, int removals){
+    //  Set time variables
+    double start, end;
+
+    if(removals > list_size){
+        removals = list_size;
+    }
+
+    int* values = (int*) malloc(list_size * sizeof(int));
+    int* order = (int*) malloc(list_size * sizeof(int));
+    DoublyLinkedList* plain = dll_create();
+    DoublyLinkedList* indexed = dll_create();
+
+    for(int i = 0; i < list_size; i++){
+        values[i] = i;
+        order[i] = i;
+        dll_append(plain, &values[i]);
+        dll_append(indexed, &values[i]);
+    }
+
+    //  Remove distinct elements, in random order
+    for(int i = list_size - 1; i > 0; i--){
+        int j = rand() % (i + 1);
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < removals; i++){
+        dll_remove(plain, &values[order[i]]);
+    }
+    end = benchmark_wall_time();
+    double plain_time = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    dll_index_attach(indexed, NULL, NULL);
+    end = benchmark_wall_time();
+    double attach_time = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < removals; i++){
+        dll_remove(indexed, &values[order[i]]);
+    }
+    end = benchmark_wall_time();
+    double indexed_time = (end - start) * 1000.0;
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    sprintf(buffer, "Benchmark Test: Hash Index Removal\nList Size: %d\nRemovals: %d\n"
+                    "Linear scan: %f ms (%.1f ns/removal)\n"
+                    "Hash index: %f ms (%.1f ns/removal), index attached in %f ms\n"
+                    "Speedup: %.1fx",
+            list_size, removals,
+            plain_time, plain_time * 1e6 / removals,
+            indexed_time, indexed_time * 1e6 / removals, attach_time,
+            plain_time / indexed_time);
+
+    dll_destroy(plain);
+    dll_destroy(indexed);
+    free(order);
+    free(values);
+
+    return buffer;
+};
+
+
+
+/*
+    Cache benchmarks
+*/
+
+/*
+    zipf_trace
+    Generates a trace of keys in [0, nkeys) drawn from a Zipf distribution: key k has a probability proportional to 1 / (k + 1)^exponent.
+    @param int nkeys
+    @param double exponent
+    @param int length
+    @returns int*
+*/
+static int* zipf_trace(int nkeys, double exponent, int length){
+    double* cdf = (double*) malloc(nkeys * sizeof(double));
+    int* trace = (int*) malloc(length * sizeof(int));
+    double total = 0.0;
+
+    for(int k = 0; k < nkeys; k++){
+        total += 1.0 / pow(k + 1, exponent);
+        cdf[k] = total;
+    }
+
+    for(int i = 0; i < length; i++){
+        double u = (double) rand() / ((double) RAND_MAX + 1.0) * total;
+        int low = 0;
+        int high = nkeys - 1;
+
+        //  First key whose cumulative weight exceeds `u`
+        while(low < high){
+            int middle = low + (high - low) / 2;
+            if(cdf[middle] > u){
+                high = middle;
+            }   else{
+                    low = middle + 1;
+            }
+        }
+
+        trace[i] = low;
+    }
+
+    free(cdf);
+
+    return trace;
+};
+
+/*
+    Slice of a trace replayed by a thread of the sharded cache benchmark
+*/
+typedef struct CacheReplay {
+    ShardedCache* cache;
+    int* trace;
+    int length;
+} CacheReplay;
+
+/*
+    cache_replay
+    Replays a slice of a trace on a sharded cache: every key is read, and put on a miss.
+    @param void* arg
+    @returns void*
+*/
+static void* cache_replay(void* arg){
+    CacheReplay* replay = (CacheReplay*) arg;
+
+    for(int i = 0; i < replay->length; i++){
+        void* key = (void*) (size_t) (replay->trace[i] + 1);
+        if(!sharded_cache_get(replay->cache, key, NULL)){
+            sharded_cache_put(replay->cache, key, key, 1);
+        }
+    }
+
+    return NULL;
+};
+
+/*
+    benchmark_sharded_cache
+    Replays a trace on a sharded cache, split between `nthreads` threads, and returns the throughput in millions of operations per second.
+    @param size_t nshards
+    @param int nthreads
+    @param int capacity
+    @param int* trace
+    @param int length
+    @returns double
+*/
+static double benchmark_sharded_cache(size_t nshards, int nthreads, int capacity, int* trace, int length){
+    //  Set time variables
+    double start, end;
+
+    ShardedCache* cache = sharded_cache_create(nshards, CACHE_LRU, capacity, 0, NULL, NULL);
+    pthread_t* threads = (pthread_t*) malloc(nthreads * sizeof(pthread_t));
+    CacheReplay* replays = (CacheReplay*) malloc(nthreads * sizeof(CacheReplay));
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < nthreads; i++){
+        replays[i].cache = cache;
+        replays[i].trace = trace + (long) length * i / nthreads;
+        replays[i].length = (int) ((long) length * (i + 1) / nthreads - (long) length * i / nthreads);
+        pthread_create(&threads[i], NULL, cache_replay, &replays[i]);
+    }
+    for(int i = 0; i < nthreads; i++){
+        pthread_join(threads[i], NULL);
+    }
+    end = benchmark_wall_time();
+
+    sharded_cache_destroy(cache);
+    free(replays);
+    free(threads);
+
+    return length / (end - start) / 1e6;
+};
+
+/*
+    run_benchmark_cache
+    Measures the hit rate and throughput of the LRU and CLOCK caches on Zipf traces, and the throughput of a sharded cache accessed by several threads.
+    @param int nkeys
+    @param int capacity
+    @param int operations
+    @returns char*
+*/
+char* run_benchmark_cache(int nkeys, int capacity, int operations){
+    //  Set time variables
+    double start, end;
+
+    const double exponents[] = {0.8, 0.99, 1.2};
+    const char* names[] = {"LRU", "CLOCK"};
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int nthreads = online > 4 ? (int) online : 4;
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: LRU and CLOCK Caches\nKeys: %d\nCapacity: %d\nOperations: %d\n", nkeys, capacity, operations);
+
+    for(int e = 0; e < 3; e++){
+        int* trace = zipf_trace(nkeys, exponents[e], operations);
+
+        for(int policy = CACHE_LRU; policy <= CACHE_CLOCK; policy++){
+            Cache* cache = cache_create((CachePolicy) policy, capacity, 0, NULL, NULL);
+
+            start = benchmark_wall_time();
+            for(int i = 0; i < operations; i++){
+                void* key = (void*) (size_t) (trace[i] + 1);
+                if(!cache_get(cache, key, NULL)){
+                    cache_put(cache, key, key, 1);
+                }
+            }
+            end = benchmark_wall_time();
+
+            length += sprintf(buffer + length, "Zipf %.2f, %s: hit rate %.3f, %.2f Mops/s\n", exponents[e], names[policy], cache_hit_rate(cache), operations / (end - start) / 1e6);
+
+            cache_destroy(cache);
+        }
+
+        //  Lock contention: one shard against one shard per 64 keys of capacity, at most 64
+        size_t shards = capacity / 64 > 64 ? 64 : (capacity / 64 > 1 ? capacity / 64 : 2);
+        length += sprintf(buffer + length, "Zipf %.2f, LRU, %d threads: 1 shard %.2f Mops/s, %zu shards %.2f Mops/s\n", exponents[e], nthreads,
+                benchmark_sharded_cache(1, nthreads, capacity, trace, operations),
+                shards, benchmark_sharded_cache(shards, nthreads, capacity, trace, operations));
+
+        free(trace);
+    }
+
+    return buffer;
+};
+
+
+
+/*
+    Priority queue benchmarks
+*/
+
+/*
+    run_benchmark_heap
+    Compares a `Heap` with a `Queue` re-sorted by `queue_mergesort` whenever a priority changes.
+    @param int size
+    @param int updates
+    @returns char*
+*/
+char* run_benchmark_heap(int size, int updates){
+    //  Set time variables
+    double start, end;
+
+    int* heap_priorities = (int*) malloc(size * sizeof(int));
+    int* queue_priorities = (int*) malloc(size * sizeof(int));
+    int* targets = (int*) malloc(updates * sizeof(int));
+    int* deltas = (int*) malloc(updates * sizeof(int));
+    Queue* heap_source = queue_create();
+    Queue* queue = queue_create();
+    long checksum = 0;
+
+    for(int i = 0; i < size; i++){
+        heap_priorities[i] = rand() % 1000000;
+        queue_priorities[i] = heap_priorities[i];
+        queue_enqueue(heap_source, &heap_priorities[i]);
+        queue_enqueue(queue, &queue_priorities[i]);
+    }
+    for(int i = 0; i < updates; i++){
+        targets[i] = rand() % size;
+        deltas[i] = rand() % 1000;
+    }
+
+    //  Heap: built once, then one decrease-key per update
+    start = benchmark_wall_time();
+    Heap* heap = heap_from_queue(heap_source, HEAP_DEFAULT_ARITY, compare_int);
+    end = benchmark_wall_time();
+    double heap_build = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < updates; i++){
+        heap_priorities[targets[i]] -= deltas[i];
+        heap_decrease_key(heap, (HeapHandle) targets[i]);
+        checksum += *(int*) heap_peek(heap);
+    }
+    end = benchmark_wall_time();
+    double heap_update = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    while(heap_size(heap) > 0){
+        heap_pop_min(heap);
+    }
+    end = benchmark_wall_time();
+    double heap_drain = (end - start) * 1000.0;
+
+    //  Sort on demand: the queue is sorted again after every update
+    start = benchmark_wall_time();
+    for(int i = 0; i < updates; i++){
+        queue_priorities[targets[i]] -= deltas[i];
+        queue_mergesort(queue, compare_int);
+        checksum -= *(int*) queue_front(queue);
+    }
+    end = benchmark_wall_time();
+    double queue_update = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    queue_mergesort(queue, compare_int);
+    while(queue_size(queue) > 0){
+        queue_dequeue(queue);
+    }
+    end = benchmark_wall_time();
+    double queue_drain = (end - start) * 1000.0;
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    sprintf(buffer, "Benchmark Test: Priority Queue Updates\nSize: %d\nUpdates: %d\n"
+                    "Heap (%d-ary): build %f ms, updates %f ms (%.1f ns/update), drain %f ms\n"
+                    "Sorted Queue: updates %f ms (%.1f ns/update), drain %f ms\n"
+                    "Update speedup: %.1fx%s",
+            size, updates,
+            HEAP_DEFAULT_ARITY, heap_build, heap_update, heap_update * 1e6 / updates, heap_drain,
+            queue_update, queue_update * 1e6 / updates, queue_drain,
+            queue_update / heap_update, checksum == 0 ? "" : " (MISMATCH)");
+
+    heap_destroy(heap);
+    queue_destroy(heap_source);
+    queue_destroy(queue);
+    free(heap_priorities);
+    free(queue_priorities);
+    free(targets);
+    free(deltas);
+
+    return buffer;
+};
+
+
+
+/*
+    Selection benchmarks
+*/
+
+/*
+    benchmark_topk_list
+    Build a singly linked list over an array of values, in order.
+    @param int* values
+    @param int size
+    @returns SinglyLinkedList*
+*/
+static SinglyLinkedList* benchmark_topk_list(int* values, int size){
+    SinglyLinkedList* sll = sll_create();
+
+    for(int i = size - 1; i >= 0; i--){
+        sll_insert(sll, &values[i]);
+    }
+
+    return sll;
+};
+
+/*
+    benchmark_topk_at
+    Get the value at a position of a singly linked list of `int*`.
+    @param SinglyLinkedList* sll
+    @param int position
+    @returns int
+*/
+static int benchmark_topk_at(SinglyLinkedList* sll, int position){
+    SLLNode* current = sll->head;
+
+    for(int i = 0; i < position; i++){
+        current = current->next;
+    }
+
+    return *(int*) current->data;
+};
+
+/*
+    run_benchmark_topk
+    Compares a full heap sort with `sll_topk`, `sll_partial_sort` and `sll_nth_element` for a range of K/N ratios.
+    @param int list_size
+    @returns char*
+*/
+char* run_benchmark_topk(int list_size){
+    //  Set time variables
+    double start, end;
+
+    const double ratios[] = {0.0001, 0.001, 0.01, 0.1, 0.5, 1.0};
+    const int nratios = sizeof(ratios) / sizeof(ratios[0]);
+
+    int* values = (int*) malloc(list_size * sizeof(int));
+    for(int i = 0; i < list_size; i++){
+        values[i] = rand();
+    }
+
+    //  The full sort does not depend on K
+    SinglyLinkedList* sll = benchmark_topk_list(values, list_size);
+    start = benchmark_wall_time();
+    sll_heapsort(sll, compare_int);
+    end = benchmark_wall_time();
+    double full = (end - start) * 1000.0;
+    sll_destroy(sll);
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Top-K Selection\nList Size: %d\nFull sort (sll_heapsort): %f ms\n", list_size, full);
+
+    for(int r = 0; r < nratios; r++){
+        int k = (int) (ratios[r] * list_size);
+        if(k < 1){
+            k = 1;
+        }
+
+        sll = benchmark_topk_list(values, list_size);
+        start = benchmark_wall_time();
+        SinglyLinkedList* top = sll_topk(sll, k, compare_int);
+        end = benchmark_wall_time();
+        double topk = (end - start) * 1000.0;
+        int kth = benchmark_topk_at(top, k - 1);
+        sll_destroy(top);
+        sll_destroy(sll);
+
+        sll = benchmark_topk_list(values, list_size);
+        start = benchmark_wall_time();
+        sll_partial_sort(sll, k, compare_int);
+        end = benchmark_wall_time();
+        double partial = (end - start) * 1000.0;
+        bool match = benchmark_topk_at(sll, k - 1) == kth;
+        sll_destroy(sll);
+
+        sll = benchmark_topk_list(values, list_size);
+        start = benchmark_wall_time();
+        SLLNode* nth = sll_nth_element(sll, k - 1, compare_int);
+        end = benchmark_wall_time();
+        double select = (end - start) * 1000.0;
+        match = match && *(int*) nth->data == kth;
+        sll_destroy(sll);
+
+        length += sprintf(buffer + length, "K/N %g (K = %d): topk %f ms, partial sort %f ms, nth_element %f ms%s\n",
+                ratios[r], k, topk, partial, select, match ? "" : " (MISMATCH)");
+    }
+
+    free(values);
+
+    return buffer;
+};
+
+
+
+/*
+    Adaptive sorting benchmarks
+*/
+
+/*
+    run_benchmark_natural_mergesort
+    Compares `sll_natural_mergesort` with the top-down merge sort of `queue_mergesort` on lists made of sorted batches.
+    @param int list_size
+    @returns char*
+*/
+char* run_benchmark_natural_mergesort(int list_size){
+    //  Set time variables
+    double start, end;
+
+    //  0 batches stands for random input
+    const int batches[] = {1, 16, 1024, 0};
+    const int nbatches = sizeof(batches) / sizeof(batches[0]);
+
+    int* values = (int*) malloc(list_size * sizeof(int));
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Natural Merge Sort\nList Size: %d\n", list_size);
+
+    for(int b = 0; b < nbatches; b++){
+        //  Each batch is ascending on its own, over the same range of values as the others
+        int batch_size = batches[b] > 0 ? (list_size + batches[b] - 1) / batches[b] : 1;
+        int step = RAND_MAX / batch_size + 1;
+        for(int i = 0; i < list_size; i++){
+            if(i % batch_size == 0){
+                values[i] = batch_size > 1 ? rand() % step : rand();
+            }else{
+                values[i] = values[i - 1] + rand() % step;
+            }
+        }
+
+        SinglyLinkedList* sll = sll_create();
+        Queue* queue = queue_create();
+        for(int i = list_size - 1; i >= 0; i--){
+            sll_insert(sll, &values[i]);
+        }
+        for(int i = 0; i < list_size; i++){
+            queue_enqueue(queue, &values[i]);
+        }
+
+        start = benchmark_wall_time();
+        sll_natural_mergesort(sll, compare_int);
+        end = benchmark_wall_time();
+        double natural = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        queue_mergesort(queue, compare_int);
+        end = benchmark_wall_time();
+        double topdown = (end - start) * 1000.0;
+
+        if(batches[b] > 0){
+            length += sprintf(buffer + length, "%d sorted batches: ", batches[b]);
+        }else{
+            length += sprintf(buffer + length, "Random: ");
+        }
+        length += sprintf(buffer + length, "natural %f ms, top-down %f ms, speedup %.2fx\n", natural, topdown, topdown / natural);
+
+        sll_destroy(sll);
+        queue_destroy(queue);
+    }
+
+    free(values);
+
+    return buffer;
+};
+
+
+
+/*
+    k-way merge benchmarks
+*/
+
+/*
+    run_benchmark_merge_k
+    Compares `sll_merge_k` and `sll_parallel_merge_k` with sorting the concatenation of the lists.
+    @param int list_size, total number of elements
+    @returns char*
+*/
+char* run_benchmark_merge_k(int list_size){
+    //  Set time variables
+    double start, end;
+
+    const int ks[] = {4, 64, 1024};
+    const int nks = sizeof(ks) / sizeof(ks[0]);
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int nthreads = online > 0 ? (int) online : 1;
+
+    int* values = (int*) malloc(list_size * sizeof(int));
+    ThreadPool* pool = threadpool_create(nthreads);
+
+    char* buffer = (char*) malloc(1024 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: k-way Merge\nTotal Size: %d\nThreads: %d\n", list_size, nthreads);
+
+    for(int t = 0; t < nks; t++){
+        int k = ks[t];
+        int shard_size = (list_size + k - 1) / k;
+        int step = RAND_MAX / shard_size + 1;
+
+        //  Shard `j` holds the ascending values from `j * shard_size`
+        for(int i = 0; i < list_size; i++){
+            values[i] = (i % shard_size == 0) ? rand() % step : values[i - 1] + rand() % step;
+        }
+
+        SinglyLinkedList** shards = (SinglyLinkedList**) malloc(k * sizeof(SinglyLinkedList*));
+        SinglyLinkedList** parallel_shards = (SinglyLinkedList**) malloc(k * sizeof(SinglyLinkedList*));
+        SinglyLinkedList* concatenated = sll_create();
+        SinglyLinkedList* concatenated_heap = sll_create();
+
+        for(int j = 0; j < k; j++){
+            shards[j] = sll_create();
+            parallel_shards[j] = sll_create();
+        }
+        for(int i = list_size - 1; i >= 0; i--){
+            sll_insert(shards[i / shard_size], &values[i]);
+            sll_insert(parallel_shards[i / shard_size], &values[i]);
+            sll_insert(concatenated, &values[i]);
+            sll_insert(concatenated_heap, &values[i]);
+        }
+
+        start = benchmark_wall_time();
+        SinglyLinkedList* merged = sll_merge_k(shards, k, compare_int);
+        end = benchmark_wall_time();
+        double merge = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        SinglyLinkedList* parallel_merged = sll_parallel_merge_k(parallel_shards, k, compare_int, pool);
+        end = benchmark_wall_time();
+        double parallel = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        sll_natural_mergesort(concatenated, compare_int);
+        end = benchmark_wall_time();
+        double natural = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        sll_heapsort(concatenated_heap, compare_int);
+        end = benchmark_wall_time();
+        double heap = (end - start) * 1000.0;
+
+        //  The four lists hold the same values in the same order
+        bool match = true;
+        SLLNode* a = merged->head;
+        SLLNode* b = parallel_merged->head;
+        SLLNode* c = concatenated->head;
+        SLLNode* d = concatenated_heap->head;
+        while(match && a != NULL){
+            match = *(int*) a->data == *(int*) b->data && *(int*) a->data == *(int*) c->data && *(int*) a->data == *(int*) d->data;
+            a = a->next;
+            b = b->next;
+            c = c->next;
+            d = d->next;
+        }
+
+        length += sprintf(buffer + length, "k = %d: merge_k %f ms, parallel merge_k %f ms, concatenate + natural merge sort %f ms, concatenate + heap sort %f ms%s\n",
+                k, merge, parallel, natural, heap, match ? "" : " (MISMATCH)");
+
+        for(int j = 0; j < k; j++){
+            sll_destroy(shards[j]);
+            sll_destroy(parallel_shards[j]);
+        }
+        free(shards);
+        free(parallel_shards);
+        sll_destroy(merged);
+        sll_destroy(parallel_merged);
+        sll_destroy(concatenated);
+        sll_destroy(concatenated_heap);
+    }
+
+    threadpool_destroy(pool);
+    free(values);
+
+    return buffer;
+};
+
+
+
+/*
+    Array sort benchmarks
+*/
+
+/*
+    benchmark_scattered_list
+    Build a singly linked list over an array of values, whose nodes are linked in a random order of their addresses,
+    as in a list that has been sorted or edited for a while.
+    @param int* values
+    @param int size
+    @returns SinglyLinkedList*
+*/
+static SinglyLinkedList* benchmark_scattered_list(int* values, int size){
+    SinglyLinkedList* sll = sll_create();
+    SLLNode** nodes = (SLLNode**) malloc(size * sizeof(SLLNode*));
+
+    for(int i = 0; i < size; i++){
+        sll_insert(sll, NULL);
+    }
+
+    int n = 0;
+    for(SLLNode* current = sll->head; current != NULL; current = current->next){
+        nodes[n++] = current;
+    }
+
+    //  Fisher-Yates shuffle of the nodes, then relink them in that order
+    for(int i = size - 1; i > 0; i--){
+        int j = rand() % (i + 1);
+        SLLNode* node = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = node;
+    }
+    for(int i = 0; i < size; i++){
+        nodes[i]->data = &values[i];
+        nodes[i]->next = (i + 1 < size) ? nodes[i + 1] : NULL;
+    }
+    sll->head = size > 0 ? nodes[0] : NULL;
+
+    free(nodes);
+
+    return sll;
+};
+
+/*
+    run_benchmark_arraysort
+    Compares `sll_arraysort` (gather, introsort, relink) with the in-list sorts `sll_natural_mergesort` and `sll_heapsort`, on scattered lists of increasing size.
+    @param int min_size
+    @param int max_size
+    @returns char*
+*/
+char* run_benchmark_arraysort(int min_size, int max_size){
+    //  Set time variables
+    double start, end;
+
+    ListSortScratch* scratch = listsort_scratch_create();
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Array Sort\n");
+
+    for(int size = min_size; size <= max_size; size *= 10){
+        //  Small lists are sorted several times, to sort about `max_size` elements per algorithm
+        int repeats = max_size / size;
+        double array = 0.0, natural = 0.0, heap = 0.0;
+        bool match = true;
+
+        int* values = (int*) malloc(size * sizeof(int));
+
+        for(int r = 0; r < repeats; r++){
+            for(int i = 0; i < size; i++){
+                values[i] = rand();
+            }
+
+            SinglyLinkedList* array_list = benchmark_scattered_list(values, size);
+            SinglyLinkedList* natural_list = benchmark_scattered_list(values, size);
+            SinglyLinkedList* heap_list = benchmark_scattered_list(values, size);
+
+            start = benchmark_wall_time();
+            sll_arraysort(array_list, compare_int, scratch);
+            end = benchmark_wall_time();
+            array += end - start;
+
+            start = benchmark_wall_time();
+            sll_natural_mergesort(natural_list, compare_int);
+            end = benchmark_wall_time();
+            natural += end - start;
+
+            start = benchmark_wall_time();
+            sll_heapsort(heap_list, compare_int);
+            end = benchmark_wall_time();
+            heap += end - start;
+
+            SLLNode* a = array_list->head;
+            SLLNode* b = natural_list->head;
+            SLLNode* c = heap_list->head;
+            while(match && a != NULL){
+                match = *(int*) a->data == *(int*) b->data && *(int*) a->data == *(int*) c->data;
+                a = a->next;
+                b = b->next;
+                c = c->next;
+            }
+
+            sll_destroy(array_list);
+            sll_destroy(natural_list);
+            sll_destroy(heap_list);
+        }
+
+        free(values);
+
+        //  Time per element sorted
+        double elements = (double) size * repeats;
+        length += sprintf(buffer + length, "Size %d: array sort %.1f ns, natural merge sort %.1f ns, heap sort %.1f ns per element, array sort speedup %.2fx%s\n",
+                size, array * 1e9 / elements, natural * 1e9 / elements, heap * 1e9 / elements, natural / array, match ? "" : " (MISMATCH)");
+    }
+
+    listsort_scratch_destroy(scratch);
+
+    return buffer;
+};
+
+
+
+/*
+    Integer sort benchmarks
+*/
+
+/*
+    run_benchmark_simdsort
+    Compares `sll_sort_int` with each kernel of `dsl_simdsort.h` (radix, SSE4.2, AVX2) and the in-list `sll_natural_mergesort`, on scattered lists of increasing size.
+    @param int min_size
+    @param int max_size
+    @returns char*
+*/
+char* run_benchmark_simdsort(int min_size, int max_size){
+    //  Set time variables
+    double start, end;
+
+    SimdSortIsa best = simdsort_detect();
+    ListSortScratch* scratch = listsort_scratch_create();
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Integer Sort Kernels\nBest kernel: %s\n", simdsort_isa_name(best));
+
+    for(int size = min_size; size <= max_size; size *= 10){
+        int* values = (int*) malloc(size * sizeof(int));
+        for(int i = 0; i < size; i++){
+            values[i] = rand();
+        }
+
+        SinglyLinkedList* merge_list = benchmark_scattered_list(values, size);
+        start = benchmark_wall_time();
+        sll_natural_mergesort(merge_list, compare_int);
+        end = benchmark_wall_time();
+        double merge = (end - start) * 1000.0;
+
+        length += sprintf(buffer + length, "Size %d: merge sort %f ms", size, merge);
+
+        for(int isa = SIMDSORT_SCALAR; isa <= (int) best; isa++){
+            simdsort_set_isa((SimdSortIsa) isa);
+
+            SinglyLinkedList* sll = benchmark_scattered_list(values, size);
+            start = benchmark_wall_time();
+            sll_sort_int(sll, scratch);
+            end = benchmark_wall_time();
+            double kernel = (end - start) * 1000.0;
+
+            //  Both sorts are stable: the lists hold the same nodes' data in the same order
+            bool match = true;
+            for(SLLNode *a = sll->head, *b = merge_list->head; match && a != NULL; a = a->next, b = b->next){
+                match = a->data == b->data;
+            }
+
+            length += sprintf(buffer + length, ", %s %f ms (%.1fx)%s", simdsort_isa_name((SimdSortIsa) isa), kernel, merge / kernel, match ? "" : " (MISMATCH)");
+
+            sll_destroy(sll);
+        }
+
+        length += sprintf(buffer + length, "\n");
+
+        sll_destroy(merge_list);
+        free(values);
+    }
+
+    simdsort_set_isa(best);
+    listsort_scratch_destroy(scratch);
+
+    return buffer;
+};
+
+
+/*
+    benchmark_int_serialize
+    Serialization callback of the external sort benchmark: the record of an `int` is its bytes
+*/
+static size_t benchmark_int_serialize(void* data, void* buffer, size_t capacity, void* context){
+    (void)context;
+
+    if(capacity >= sizeof(int)){
+        memcpy(buffer, data, sizeof(int));
+    }
+
+    return sizeof(int);
+};
+
+/*
+    benchmark_int_deserialize
+    Deserialization callback of the external sort benchmark
+*/
+static void* benchmark_int_deserialize(const void* record, size_t size, void* context){
+    (void)size;
+    (void)context;
+
+    int* value = (int*) malloc(sizeof(int));
+    if(value){
+        memcpy(value, record, sizeof(int));
+    }
+
+    return value;
+};
+
+/*
+    benchmark_int_free
+    Free callback of the external sort benchmark
+*/
+static void benchmark_int_free(void* data, void* context){
+    (void)context;
+    free(data);
+};
+
+/*
+    benchmark_int_list
+    Build a singly linked list of `size` allocated copies of `values`, in order
+*/
+static SinglyLinkedList* benchmark_int_list(int* values, int size){
+    SinglyLinkedList* sll = sll_create();
+
+    for(int i = size - 1; i >= 0; i--){
+        int* value = (int*) malloc(sizeof(int));
+        *value = values[i];
+        sll_insert(sll, value);
+    }
+
+    return sll;
+};
+
+/*
+    run_benchmark_extsort
+    Sorts a list of `int` with the external sort of `dsl_extsort.h` under memory budgets from the whole list down to 1/64 of it,
+    and compares it with the in-memory `sll_natural_mergesort`.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_extsort(int size){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+
+    //  Cost of an element against the budget: its record, its length and its node
+    size_t footprint = (size_t) size * (sizeof(int) + sizeof(uint32_t) + sizeof(SLLNode));
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: External Sort\nList size: %d (%zu KiB held in memory)\n", size, footprint / 1024);
+
+    SinglyLinkedList* sll = benchmark_int_list(values, size);
+    start = benchmark_wall_time();
+    sll_natural_mergesort(sll, compare_int);
+    end = benchmark_wall_time();
+    double in_memory = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "In-memory natural merge sort: %f ms\n", in_memory);
+
+    for(int fraction = 1; fraction <= 64; fraction *= 4){
+        ExtSortConfig config = {
+            .compare = compare_int,
+            .serialize = benchmark_int_serialize,
+            .deserialize = benchmark_int_deserialize,
+            .free_data = benchmark_int_free,
+            .context = NULL,
+            .memory_budget = footprint / fraction + 1,
+            .block_size = 0,
+            .directory = NULL
+        };
+
+        SinglyLinkedList* input = benchmark_int_list(values, size);
+        ExtSort* sort = extsort_create(&config);
+
+        start = benchmark_wall_time();
+        extsort_push_sll(sort, input);
+        //  The elements still held in memory are written to a last run by `extsort_finish`
+        size_t runs = extsort_runs(sort) + (sort->nruns > 0 && sort->npending > 0 ? 1 : 0);
+        SinglyLinkedList* sorted = extsort_finish(sort);
+        end = benchmark_wall_time();
+        double external = (end - start) * 1000.0;
+
+        //  Both sorts are stable on equal keys, so the values must match one by one
+        bool match = sorted != NULL && sorted->size == sll->size;
+        for(SLLNode *a = match ? sorted->head : NULL, *b = sll->head; match && a != NULL; a = a->next, b = b->next){
+            match = *(int*) a->data == *(int*) b->data;
+        }
+
+        length += sprintf(buffer + length, "Budget 1/%d: %zu runs, %f ms (%.1fx the in-memory sort)%s\n", fraction, runs, external, external / in_memory, match ? "" : " (MISMATCH)");
+
+        if(sorted){
+            sll_destroy_with(sorted, free);
+        }
+
+        sll_destroy(input);
+        extsort_destroy(sort);
+    }
+
+    sll_destroy_with(sll, free);
+    free(values);
+
+    return buffer;
+};
+
+/*
+    run_benchmark_serialize
+    Compares the startup cost of a list of `int`: rebuilt with one allocation per element, or loaded from a list file of `dsl_serialize.h`
+    by mapping it, with and without the checksum, as a view and as a plain traversal of the mapping.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_serialize(int size){
+    //  Set time variables
+    double start, end;
+
+    const char* path = "dsl_benchmark_list.bin";
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: List Files\nList size: %d\n", size);
+
+    //  Rebuild: one allocation per element and per node
+    start = benchmark_wall_time();
+    SinglyLinkedList* sll = benchmark_int_list(values, size);
+    end = benchmark_wall_time();
+    double rebuild = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    bool saved = sll_save(sll, path, sizeof(int), NULL);
+    end = benchmark_wall_time();
+
+    length += sprintf(buffer + length, "Rebuild with malloc: %f ms\nSave: %f ms%s\n", rebuild, (end - start) * 1000.0, saved ? "" : " (FAILED)");
+
+    for(int verify = 1; verify >= 0; verify--){
+        start = benchmark_wall_time();
+        ListFile* file = listfile_map(path, verify);
+        SinglyLinkedList* view = listfile_sll(file);
+        end = benchmark_wall_time();
+        double load = (end - start) * 1000.0;
+
+        bool match = view != NULL && view->size == sll->size;
+        for(SLLNode *a = match ? view->head : NULL, *b = sll->head; match && a != NULL; a = a->next, b = b->next){
+            match = *(int*) a->data == *(int*) b->data;
+        }
+
+        length += sprintf(buffer + length, "Map and view%s: %f ms (%.1fx faster)%s\n", verify ? " with checksum" : "", load, rebuild / load, match ? "" : " (MISMATCH)");
+
+        listfile_unmap(file);
+    }
+
+    //  No allocation at all: the elements are read in place
+    start = benchmark_wall_time();
+    ListFile* file = listfile_map(path, false);
+    long long sum = 0;
+    size_t cursor = 0;
+    const void* data;
+    while((data = listfile_next(file, &cursor, NULL)) != NULL){
+        sum += *(const int*) data;
+    }
+    end = benchmark_wall_time();
+    double traversal = (end - start) * 1000.0;
+
+    long long expected = 0;
+    for(int i = 0; i < size; i++){
+        expected += values[i];
+    }
+
+    length += sprintf(buffer + length, "Map and traverse in place: %f ms (%.1fx faster)%s\n", traversal, rebuild / traversal, sum == expected ? "" : " (MISMATCH)");
+
+    listfile_unmap(file);
+    remove(path);
+
+    sll_destroy_with(sll, free);
+    free(values);
+
+    return buffer;
+};
+
+/*
+    benchmark_int_sum
+    Traverse a list of `int` and sum its elements
+*/
+static long long benchmark_int_sum(SinglyLinkedList* sll){
+    long long sum = 0;
+
+    for(SLLNode* current = sll->head; current != NULL; current = current->next){
+        sum += *(int*) current->data;
+    }
+
+    return sum;
+};
+
+/*
+    benchmark_copy_int
+    Generator of the bulk construction benchmark: copy the element of the array given as context into the slot of the node
+*/
+static void* benchmark_copy_int(size_t index, void* slot, void* context){
+    *(int*)slot = ((int*) context)[index];
+
+    return slot;
+};
+
+/*
+    run_benchmark_bulk_construction
+    Compares building a list of `int` with one `sll_insert` and one allocation of the element per value
+    with the bulk constructors of `dsl_lists.h`: build, traversal and destruction times.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_bulk_construction(int size){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Bulk Construction\nList size: %d\n", size);
+
+    //  Loop: one node and one element allocated per value, inserted from the last value
+    start = benchmark_wall_time();
+    SinglyLinkedList* loop = sll_create();
+    for(int i = size - 1; i >= 0; i--){
+        int* data = (int*) malloc(sizeof(int));
+        *data = values[i];
+        sll_insert(loop, data);
+    }
+    end = benchmark_wall_time();
+    double build = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    long long expected = benchmark_int_sum(loop);
+    end = benchmark_wall_time();
+    double traversal = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    sll_destroy_with(loop, free);
+    end = benchmark_wall_time();
+
+    length += sprintf(buffer + length, "sll_insert loop: build %f ms, traverse %f ms, destroy %f ms\n", build, traversal, (end - start) * 1000.0);
+
+    //  The first large allocation after freeing the loop's small blocks pays for their consolidation by the allocator: keep it out of the timings
+    sll_destroy(sll_from_array(values, size, sizeof(int), true));
+
+    const char* names[] = {"sll_from_array (pointing into the array)", "sll_from_array (copying the elements)", "sll_from_generator (copying the elements)"};
+
+    for(int method = 0; method < 3; method++){
+        SinglyLinkedList* sll;
+
+        start = benchmark_wall_time();
+        if(method == 2){
+            sll = sll_from_generator(size, sizeof(int), benchmark_copy_int, values);
+        }   else{
+                sll = sll_from_array(values, size, sizeof(int), method == 1);
+        }
+        end = benchmark_wall_time();
+        double bulk = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        long long sum = benchmark_int_sum(sll);
+        end = benchmark_wall_time();
+        double bulk_traversal = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        sll_destroy(sll);
+        end = benchmark_wall_time();
+
+        length += sprintf(buffer + length, "%s: build %f ms (%.1fx faster), traverse %f ms, destroy %f ms%s\n", names[method], bulk, build / bulk, bulk_traversal, (end - start) * 1000.0, sum == expected ? "" : " (MISMATCH)");
+    }
+
+    free(values);
+
+    return buffer;
+};
+
+/*
+    run_benchmark_splice
+    Compares merging `nlists` lists of `size / nlists` elements into one, and splitting a list in half,
+    with the append loops that copy the elements into new nodes, and the splicing functions of `dsl_lists.h` that move the nodes.
+    @param int size
+    @param int nlists
+    @returns char*
+*/
+char* run_benchmark_splice(int size, int nlists){
+    //  Set time variables
+    double start, end;
+
+    int part = size / nlists;
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = i;
+    }
+
+    DoublyLinkedList** dlls = (DoublyLinkedList**) malloc(nlists * sizeof(DoublyLinkedList*));
+    Queue** queues = (Queue**) malloc(nlists * sizeof(Queue*));
+    SinglyLinkedList** slls = (SinglyLinkedList**) malloc(nlists * sizeof(SinglyLinkedList*));
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Splicing\nMerging %d lists of %d elements, splitting a list of %d elements\n", nlists, part, size);
+
+    //  DoublyLinkedList: dll_append loop, then dll_concat
+    for(int i = 0; i < nlists; i++){
+        dlls[i] = dll_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    DoublyLinkedList* dll = dll_create();
+    for(int i = 0; i < nlists; i++){
+        for(DLLNode* current = dlls[i]->head; current != NULL; current = current->next){
+            dll_append(dll, current->data);
+        }
+        dll_destroy(dlls[i]);
+    }
+    end = benchmark_wall_time();
+    double loop = (end - start) * 1000.0;
+    dll_destroy(dll);
+
+    for(int i = 0; i < nlists; i++){
+        dlls[i] = dll_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    dll = dll_create();
+    for(int i = 0; i < nlists; i++){
+        dll_concat(dll, dlls[i]);
+        dll_destroy(dlls[i]);
+    }
+    end = benchmark_wall_time();
+    double splice = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "DoublyLinkedList merge: dll_append loop %f ms, dll_concat %f ms (%.0fx faster)%s\n", loop, splice, loop / splice, dll->size == (size_t) part * nlists ? "" : " (MISMATCH)");
+
+    //  DoublyLinkedList: split in half, by copying the second half, then with dll_split_at
+    DLLNode* middle = dll->head;
+    for(size_t i = 0; i < dll->size / 2; i++){
+        middle = middle->next;
+    }
+
+    start = benchmark_wall_time();
+    DoublyLinkedList* copy = dll_create();
+    for(DLLNode* current = middle; current != NULL; current = current->next){
+        dll_append(copy, current->data);
+    }
+    DLLNode* kept = middle->prev;
+    DLLNode* last = dll->tail;
+    while(last != kept){
+        DLLNode* previous = last->prev;
+        dllnode_free(last);
+        last = previous;
+    }
+    dll->tail = last;
+    last->next = NULL;
+    dll->size -= copy->size;
+    end = benchmark_wall_time();
+    loop = (end - start) * 1000.0;
+
+    //  Put the copied half back, so the list is whole again before the split
+    dll_concat(dll, copy);
+    middle = dll->head;
+    for(size_t i = 0; i < dll->size / 2; i++){
+        middle = middle->next;
+    }
+
+    start = benchmark_wall_time();
+    DoublyLinkedList* rest = dll_create();
+    dll_split_at(dll, middle, rest);
+    end = benchmark_wall_time();
+    splice = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "DoublyLinkedList split: copy loop %f ms, dll_split_at %f ms (%.0fx faster)%s\n", loop, splice, loop / splice, dll->size + rest->size == (size_t) part * nlists ? "" : " (MISMATCH)");
+
+    dll_destroy(copy);
+    dll_destroy(rest);
+    dll_destroy(dll);
+
+    //  Queue: queue_enqueue loop, then queue_concat
+    for(int i = 0; i < nlists; i++){
+        queues[i] = queue_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    Queue* queue = queue_create();
+    for(int i = 0; i < nlists; i++){
+        for(DLLNode* current = queues[i]->front; current != NULL; current = current->next){
+            queue_enqueue(queue, current->data);
+        }
+        queue_destroy(queues[i]);
+    }
+    end = benchmark_wall_time();
+    loop = (end - start) * 1000.0;
+    queue_destroy(queue);
+
+    for(int i = 0; i < nlists; i++){
+        queues[i] = queue_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    queue = queue_create();
+    for(int i = 0; i < nlists; i++){
+        queue_concat(queue, queues[i]);
+        queue_destroy(queues[i]);
+    }
+    end = benchmark_wall_time();
+    splice = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "Queue merge: queue_enqueue loop %f ms, queue_concat %f ms (%.0fx faster)%s\n", loop, splice, loop / splice, queue->size == (size_t) part * nlists ? "" : " (MISMATCH)");
+    queue_destroy(queue);
+
+    //  SinglyLinkedList: copy loop keeping the last node (sll_append walks the whole list), then sll_concat given the last node
+    for(int i = 0; i < nlists; i++){
+        slls[i] = sll_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    SinglyLinkedList* sll = sll_create();
+    SLLNode* tail = NULL;
+    for(int i = 0; i < nlists; i++){
+        for(SLLNode* current = slls[i]->head; current != NULL; current = current->next){
+            SLLNode* node = sllnode_create(current->data);
+            if(tail){
+                tail->next = node;
+            }   else{
+                    sll->head = node;
+            }
+            tail = node;
+            sll->size++;
+        }
+        sll_destroy(slls[i]);
+    }
+    end = benchmark_wall_time();
+    loop = (end - start) * 1000.0;
+    sll_destroy(sll);
+
+    for(int i = 0; i < nlists; i++){
+        slls[i] = sll_from_array(values + i * part, part, sizeof(int), false);
+    }
+    start = benchmark_wall_time();
+    sll = sll_create();
+    tail = NULL;
+    for(int i = 0; i < nlists; i++){
+        //  The producer of each list knows its last node: here it is the last node of its block
+        SLLNode* source_tail = slls[i]->head + (part - 1);
+        sll_concat(sll, slls[i], tail);
+        tail = part > 0 ? source_tail : tail;
+        sll_destroy(slls[i]);
+    }
+    end = benchmark_wall_time();
+    splice = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "SinglyLinkedList merge: copy loop %f ms, sll_concat %f ms (%.0fx faster)%s\n", loop, splice, loop / splice, sll->size == (size_t) part * nlists ? "" : " (MISMATCH)");
+    sll_destroy(sll);
+
+    free(slls);
+    free(queues);
+    free(dlls);
+    free(values);
+
+    return buffer;
+};
+
+/*
+    run_benchmark_teardown
+    Compares tearing down a list of `int` with a loop freeing the elements followed by `sll_destroy` and with `sll_destroy_with`;
+    and releasing the nodes of lists built in bulk one by one (`sllnode_free`, `dllnode_free`) and with `sll_destroy` and `dll_destroy`.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_teardown(int size){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Teardown\nList size: %d\n", size);
+
+    //  A list built in a fresh heap is cheaper to free than one built over freed blocks: both timed lists are built over the blocks of a first one
+    sll_destroy_with(benchmark_int_list(values, size), free);
+
+    //  Elements allocated one by one: two passes, then one
+    SinglyLinkedList* sll = benchmark_int_list(values, size);
+    start = benchmark_wall_time();
+    for(SLLNode* current = sll->head; current != NULL; current = current->next){
+        free(current->data);
+    }
+    sll_destroy(sll);
+    end = benchmark_wall_time();
+    double two_passes = (end - start) * 1000.0;
+
+    sll = benchmark_int_list(values, size);
+    start = benchmark_wall_time();
+    sll_destroy_with(sll, free);
+    end = benchmark_wall_time();
+    double one_pass = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "Allocated elements: free loop + sll_destroy %f ms, sll_destroy_with %f ms (%.0f%% of the two passes)\n", two_passes, one_pass, 100.0 * one_pass / two_passes);
+
+    //  The first large allocation after freeing the small blocks pays for their consolidation by the allocator: keep it out of the timings
+    sll_destroy(sll_from_array(values, size, sizeof(int), true));
+
+    //  Lists built in bulk: every node released from its block, then the whole block at once
+    sll = sll_from_array(values, size, sizeof(int), true);
+    start = benchmark_wall_time();
+    SLLNode* node = sll->head;
+    while(node){
+        SLLNode* next = node->next;
+        sllnode_free(node);
+        node = next;
+    }
+    free(sll);
+    end = benchmark_wall_time();
+    double by_node = (end - start) * 1000.0;
+
+    sll = sll_from_array(values, size, sizeof(int), true);
+    start = benchmark_wall_time();
+    sll_destroy(sll);
+    end = benchmark_wall_time();
+    double by_block = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "SinglyLinkedList built in bulk: sllnode_free loop %f ms, sll_destroy %f ms (%.1fx faster)\n", by_node, by_block, by_node / by_block);
+
+    DoublyLinkedList* dll = dll_from_array(values, size, sizeof(int), true);
+    start = benchmark_wall_time();
+    DLLNode* dnode = dll->head;
+    while(dnode){
+        DLLNode* next = dnode->next;
+        dllnode_free(dnode);
+        dnode = next;
+    }
+    free(dll);
+    end = benchmark_wall_time();
+    by_node = (end - start) * 1000.0;
+
+    dll = dll_from_array(values, size, sizeof(int), true);
+    start = benchmark_wall_time();
+    dll_destroy(dll);
+    end = benchmark_wall_time();
+    by_block = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "DoublyLinkedList built in bulk: dllnode_free loop %f ms, dll_destroy %f ms (%.1fx faster)\n", by_node, by_block, by_node / by_block);
+
+    free(values);
+
+    return buffer;
+};
+
+/*
+    run_benchmark_prefetch
+    Measures the search throughput on a heap-scattered singly linked list of `int`, with prefetch distances from 0 (no prefetch) to 32:
+    a search by pointer, which only reads the nodes, and a search by value, which also reads the elements. Every search misses, so it visits every node.
+    @param int size
+    @param int repeats
+    @returns char*
+*/
+char* run_benchmark_prefetch(int size, int repeats){
+    //  Set time variables
+    double start, end;
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Prefetching Traversal\nList size: %d, %d searches (default distance: %d)\n", size, repeats, DSL_PREFETCH_DISTANCE);
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = i;
+    }
+
+    SinglyLinkedList* sll = benchmark_scattered_list(values, size);
+    int missing = -1;
+    double nodes = (double) size * repeats;
+    double baseline_pointer = 0, baseline_value = 0;
+
+    for(size_t distance = 0; distance <= 32; distance = distance ? 2 * distance : 2){
+        size_t found = 0;
+
+        //  Search by pointer, as `sll_search` does
+        start = benchmark_wall_time();
+        for(int i = 0; i < repeats; i++){
+            SLLCursor cursor = sll_cursor_at(sll->head, distance, false);
+            SLLNode* node = NULL;
+            while((node = sll_cursor_next(&cursor))){
+                if(node->data == &missing){
+                    found++;
+                    break;
+                }
+            }
+        }
+        end = benchmark_wall_time();
+        double pointer = (end - start) * 1000.0;
+
+        //  Search by value
+        start = benchmark_wall_time();
+        for(int i = 0; i < repeats; i++){
+            SLLNode* node = NULL;
+            SLL_FOREACH_AT(node, sll->head, distance){
+                if(*(int*) node->data == missing){
+                    found++;
+                    break;
+                }
+            }
+        }
+        end = benchmark_wall_time();
+        double value = (end - start) * 1000.0;
+
+        if(distance == 0){
+            baseline_pointer = pointer;
+            baseline_value = value;
+        }
+
+        length += sprintf(buffer + length, "Distance %2zu: by pointer %.1f Mnodes/s (%.2fx), by value %.1f Mnodes/s (%.2fx)%s\n",
+                          distance, nodes / pointer / 1000.0, baseline_pointer / pointer, nodes / value / 1000.0, baseline_value / value, found ? " (MISMATCH)" : "");
+    }
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        if(sll_search(sll, &missing) != NULL){
+            break;
+        }
+    }
+    end = benchmark_wall_time();
+    length += sprintf(buffer + length, "sll_search: %.1f Mnodes/s\n", nodes / ((end - start) * 1000.0) / 1000.0);
+
+    sll_destroy(sll);
+    free(values);
+
+    return buffer;
+};
+
+/*
+    benchmark_heap_bytes
+    Bytes allocated on the heap, to measure the memory of the lists whose nodes are allocated one by one. 0 where the allocator cannot tell.
+*/
+static size_t benchmark_heap_bytes(void){
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+};
+
+/*
+    run_benchmark_compactlist
+    Compares the singly and doubly linked lists of `dsl_lists.h` with the compact lists of `dsl_compactlist.h` holding the same `int`:
+    bytes per element, and the times to append every element, search for a missing element, sort (relinking the nodes), and remove 20 elements.
+    The compact lists store data pointers, or copies of the `int` themselves.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_compactlist(int size){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+    int missing = -1;
+    int removals = size < 20 ? size : 20;
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Compact Lists\nList size: %d, %d removals (bytes of the list and its nodes or pool, elements excluded unless copied)\n", size, removals);
+
+    //  SinglyLinkedList: appended through a tail pointer, as sll_append walks the list
+    size_t heap = benchmark_heap_bytes();
+    start = benchmark_wall_time();
+    SinglyLinkedList* sll = sll_create();
+    SLLNode* tail = NULL;
+    for(int i = 0; i < size; i++){
+        SLLNode* node = sllnode_create(&values[i]);
+        if(tail){
+            tail->next = node;
+        }   else{
+                sll->head = node;
+        }
+        tail = node;
+        sll->size++;
+    }
+    end = benchmark_wall_time();
+    double build = (end - start) * 1000.0;
+    size_t bytes = heap ? benchmark_heap_bytes() - heap : sizeof(SinglyLinkedList) + (size_t) size * (sizeof(SLLNode) + sizeof(size_t));
+
+    start = benchmark_wall_time();
+    SLLNode* found = sll_search(sll, &missing);
+    end = benchmark_wall_time();
+    double search = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    sll_natural_mergesort(sll, compare_int);
+    end = benchmark_wall_time();
+    double sort = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < removals; i++){
+        sll_remove(sll, &values[(size_t) i * size / removals]);
+    }
+    end = benchmark_wall_time();
+    double removal = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "SinglyLinkedList: %.1f bytes/element, append %f ms, search %f ms, sort %f ms, remove %f ms%s\n",
+                      (double) bytes / size, build, search, sort, removal, found || sll->size != (size_t)(size - removals) ? " (MISMATCH)" : "");
+    sll_destroy(sll);
+
+    //  DoublyLinkedList
+    heap = benchmark_heap_bytes();
+    start = benchmark_wall_time();
+    DoublyLinkedList* dll = dll_create();
+    for(int i = 0; i < size; i++){
+        dll_append(dll, &values[i]);
+    }
+    end = benchmark_wall_time();
+    build = (end - start) * 1000.0;
+    bytes = heap ? benchmark_heap_bytes() - heap : sizeof(DoublyLinkedList) + (size_t) size * (sizeof(DLLNode) + sizeof(size_t));
+
+    start = benchmark_wall_time();
+    DLLNode* dfound = dll_search(dll, &missing);
+    end = benchmark_wall_time();
+    search = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    dll_natural_mergesort(dll, compare_int);
+    end = benchmark_wall_time();
+    sort = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < removals; i++){
+        dll_remove(dll, &values[(size_t) i * size / removals]);
+    }
+    end = benchmark_wall_time();
+    removal = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "DoublyLinkedList: %.1f bytes/element, append %f ms, search %f ms, sort %f ms, remove %f ms%s\n",
+                      (double) bytes / size, build, search, sort, removal, dfound || dll->size != (size_t)(size - removals) ? " (MISMATCH)" : "");
+    dll_destroy(dll);
+
+    //  Compact lists, with the pool reserved up front so that the bytes count no spare slot
+    const char* names[] = {"singly", "doubly", "XOR"};
+    for(int copy = 0; copy <= 1; copy++){
+        for(int mode = COMPACT_SINGLY; mode <= COMPACT_XOR; mode++){
+            start = benchmark_wall_time();
+            CompactList* list = compactlist_create((CompactListMode) mode, copy ? sizeof(int) : 0);
+            compactlist_reserve(list, size);
+            for(int i = 0; i < size; i++){
+                compactlist_append(list, &values[i]);
+            }
+            end = benchmark_wall_time();
+            build = (end - start) * 1000.0;
+
+            start = benchmark_wall_time();
+            CompactIndex cfound = compactlist_search(list, &missing);
+            end = benchmark_wall_time();
+            search = (end - start) * 1000.0;
+
+            start = benchmark_wall_time();
+            compactlist_sort(list, compare_int);
+            end = benchmark_wall_time();
+            sort = (end - start) * 1000.0;
+
+            start = benchmark_wall_time();
+            for(int i = 0; i < removals; i++){
+                compactlist_remove(list, &values[(size_t) i * size / removals]);
+            }
+            end = benchmark_wall_time();
+            removal = (end - start) * 1000.0;
+
+            length += sprintf(buffer + length, "CompactList %s, %s: %.1f bytes/element, append %f ms, search %f ms, sort %f ms, remove %f ms%s\n",
+                              names[mode], copy ? "int copied" : "pointers", (double) compactlist_bytes(list) / size, build, search, sort, removal,
+                              cfound != COMPACT_NIL || compactlist_len(list) != (size_t)(size - removals) ? " (MISMATCH)" : "");
+            compactlist_destroy(list);
+        }
+    }
+
+    free(values);
+
+    return buffer;
+};
+
+/*
+    benchmark_dll_sum
+    Sum of the `int` of a doubly linked list, read by a traversal
+*/
+static long long benchmark_dll_sum(DoublyLinkedList* dll){
+    long long sum = 0;
+
+    for(DLLNode* current = dll->head; current != NULL; current = current->next){
+        sum += *(int*) current->data;
+    }
+
+    return sum;
+};
+
+/*
+    benchmark_compactlist_sum
+    Sum of the `int` copied into a compact list, read by a traversal
+*/
+static long long benchmark_compactlist_sum(CompactList* list){
+    long long sum = 0;
+    CompactCursor cursor = compactlist_begin(list);
+    CompactIndex index;
+
+    while((index = compactlist_next(list, &cursor)) != COMPACT_NIL){
+        sum += *(int*) compactlist_data(list, index);
+    }
+
+    return sum;
+};
+
+/*
+    run_benchmark_compaction
+    Sorts lists of random `int` with relinking sorts, which scatter the traversal order over memory, then compacts them:
+    locality (average distance between consecutive nodes) and traversal time before and after, and the time of the compaction.
+    Lists: a doubly linked list built by `dll_append` with allocated elements, a singly linked list built in bulk, two doubly linked lists built in bulk and concatenated,
+    split and freed in parts after the compaction, and a XOR-linked compact list.
+    @param int size
+    @param int repeats
+    @returns char*
+*/
+char* run_benchmark_compaction(int size, int repeats){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Compaction\nList size: %d, %d traversals\n", size, repeats);
+
+    //  DoublyLinkedList with allocated elements
+    DoublyLinkedList* dll = dll_create();
+    for(int i = 0; i < size; i++){
+        int* data = (int*) malloc(sizeof(int));
+        *data = values[i];
+        dll_append(dll, data);
+    }
+    dll_natural_mergesort(dll, compare_int);
+    double before = dll_locality(dll);
+
+    long long expected = 0, sum = 0;
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        expected += benchmark_dll_sum(dll);
+    }
+    end = benchmark_wall_time();
+    double scattered = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    dll_compact(dll);
+    end = benchmark_wall_time();
+    double compaction = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        sum += benchmark_dll_sum(dll);
+    }
+    end = benchmark_wall_time();
+    double compacted = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "DoublyLinkedList, sorted: stride %.0f -> %.0f bytes, traversal %f -> %f ms (%.1fx faster), dll_compact %f ms%s\n",
+                      before, dll_locality(dll), scattered, compacted, scattered / compacted, compaction, sum == expected ? "" : " (MISMATCH)");
+    dll_destroy_with(dll, free);
+
+    //  SinglyLinkedList built in bulk
+    SinglyLinkedList* sll = sll_from_array(values, size, sizeof(int), true);
+    sll_natural_mergesort(sll, compare_int);
+    before = sll_locality(sll);
+
+    expected = 0;
+    sum = 0;
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        expected += benchmark_int_sum(sll);
+    }
+    end = benchmark_wall_time();
+    scattered = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    sll_compact(sll);
+    end = benchmark_wall_time();
+    compaction = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        sum += benchmark_int_sum(sll);
+    }
+    end = benchmark_wall_time();
+    compacted = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "SinglyLinkedList built in bulk, sorted: stride %.0f -> %.0f bytes, traversal %f -> %f ms (%.1fx faster), sll_compact %f ms%s\n",
+                      before, sll_locality(sll), scattered, compacted, scattered / compacted, compaction, sum == expected ? "" : " (MISMATCH)");
+    sll_destroy(sll);
+
+    //  Two DoublyLinkedList built in bulk, concatenated and sorted: the sort interleaves the nodes of both blocks, and the compaction must leave every copied int
+    //  in a node of its own block, so that the list can still be split and freed in parts
+    DoublyLinkedList* first = dll_from_array(values, size / 2, sizeof(int), true);
+    DoublyLinkedList* second = dll_from_array(values + size / 2, size - size / 2, sizeof(int), true);
+    dll_concat(second, first);
+    dll_destroy(first);
+    dll_natural_mergesort(second, compare_int);
+    before = dll_locality(second);
+
+    start = benchmark_wall_time();
+    dll_compact(second);
+    end = benchmark_wall_time();
+    compaction = (end - start) * 1000.0;
+
+    DLLNode* split = second->head;
+    for(int i = 0; i < size / 2; i++){
+        split = split->next;
+    }
+
+    expected = 0;
+    for(DLLNode* current = split; current != NULL; current = current->next){
+        expected += *(int*) current->data;
+    }
+
+    DoublyLinkedList* rest = dll_create();
+    dll_split_at(second, split, rest);
+    dll_destroy_with(second, free);
+    sum = benchmark_dll_sum(rest);
+
+    length += sprintf(buffer + length, "DoublyLinkedList of two blocks, sorted: stride %.0f -> %.0f bytes, dll_compact %f ms, split and freed in parts%s\n",
+                      before, dll_locality(rest), compaction, sum == expected ? "" : " (MISMATCH)");
+    dll_destroy(rest);
+
+    //  XOR-linked compact list of copied int
+    CompactList* list = compactlist_create(COMPACT_XOR, sizeof(int));
+    for(int i = 0; i < size; i++){
+        compactlist_append(list, &values[i]);
+    }
+    compactlist_sort(list, compare_int);
+    before = compactlist_locality(list);
+
+    expected = 0;
+    sum = 0;
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        expected += benchmark_compactlist_sum(list);
+    }
+    end = benchmark_wall_time();
+    scattered = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    compactlist_compact(list);
+    end = benchmark_wall_time();
+    compaction = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < repeats; i++){
+        sum += benchmark_compactlist_sum(list);
+    }
+    end = benchmark_wall_time();
+    compacted = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "CompactList XOR, sorted: stride %.0f -> %.0f bytes, traversal %f -> %f ms (%.1fx faster), compactlist_compact %f ms%s\n",
+                      before, compactlist_locality(list), scattered, compacted, scattered / compacted, compaction, sum == expected ? "" : " (MISMATCH)");
+    compactlist_destroy(list);
+
+    free(values);
+
+    return buffer;
+};
+
+/*
+    run_benchmark_deque
+    Compares the node-based `Stack` and `Queue` of `dsl_lists.h` with a `Deque` used through the same `stack_*` and `queue_*` calls:
+    pushing then popping every element, enqueuing then dequeuing every element, a worklist keeping 1024 elements in flight, and the heap bytes per element.
+    The indexed access of the deque, which the node-based lists lack, is timed over sequential and random positions.
+    @param int size
+    @returns char*
+*/
+char* run_benchmark_deque(int size){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++){
+        values[i] = rand() % 1000;
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Deque\nElements: %d, %d slots per block\n", size, DEQUE_BLOCK_SIZE);
+
+    //  Stack: push every element, then pop them all
+    long long expected = 0, sum = 0;
+    size_t heap = benchmark_heap_bytes();
+    start = benchmark_wall_time();
+    Stack* stack = stack_create();
+    for(int i = 0; i < size; i++){
+        stack_push(stack, &values[i]);
+    }
+    size_t node_bytes = heap ? benchmark_heap_bytes() - heap : 0;
+    while(stack_size(stack) > 0){
+        expected += *(int*) stack_pop(stack);
+    }
+    stack_destroy(stack);
+    end = benchmark_wall_time();
+    double node_time = (end - start) * 1000.0;
+
+    heap = benchmark_heap_bytes();
+    start = benchmark_wall_time();
+    Deque* deque = deque_create();
+    for(int i = 0; i < size; i++){
+        stack_push(deque, &values[i]);
+    }
+    size_t deque_bytes = heap ? benchmark_heap_bytes() - heap : 0;
+    while(stack_size(deque) > 0){
+        sum += *(int*) stack_pop(deque);
+    }
+    stack_destroy(deque);
+    end = benchmark_wall_time();
+    double deque_time = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "Stack push/pop: Stack %f ms, Deque %f ms (%.1fx faster)%s\n",
+                      node_time, deque_time, node_time / deque_time, sum == expected ? "" : " (MISMATCH)");
+    if(heap){
+        length += sprintf(buffer + length, "Heap bytes per element: Stack %.1f, Deque %.1f\n",
+                          (double) node_bytes / size, (double) deque_bytes / size);
+    }
+
+    //  Queue: enqueue every element, then dequeue them all
+    expected = 0;
+    sum = 0;
+    start = benchmark_wall_time();
+    Queue* queue = queue_create();
+    for(int i = 0; i < size; i++){
+        queue_enqueue(queue, &values[i]);
+    }
+    while(queue_size(queue) > 0){
+        expected += *(int*) queue_dequeue(queue);
+    }
+    queue_destroy(queue);
+    end = benchmark_wall_time();
+    node_time = (end - start) * 1000.0;
+
+    start = benchmark_wall_time();
+    deque = deque_create();
+    for(int i = 0; i < size; i++){
+        queue_enqueue(deque, &values[i]);
+    }
+    while(queue_size(deque) > 0){
+        sum += *(int*) queue_dequeue(deque);
+    }
+    queue_destroy(deque);
+    end = benchmark_wall_time();
+    deque_time = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "Queue enqueue/dequeue: Queue %f ms, Deque %f ms (%.1fx faster)%s\n",
+                      node_time, deque_time, node_time / deque_time, sum == expected ? "" : " (MISMATCH)");
+
+    //  Worklist: 1024 elements in flight, each dequeued element is enqueued again
+    int in_flight = size < 1024 ? size : 1024;
+    expected = 0;
+    sum = 0;
+    queue = queue_create();
+    for(int i = 0; i < in_flight; i++){
+        queue_enqueue(queue, &values[i]);
+    }
+    start = benchmark_wall_time();
+    for(int i = 0; i < size; i++){
+        int* data = (int*) queue_dequeue(queue);
+        expected += *data;
+        queue_enqueue(queue, &values[(i + in_flight) % size]);
+    }
+    end = benchmark_wall_time();
+    node_time = (end - start) * 1000.0;
+    queue_destroy(queue);
+
+    deque = deque_create();
+    for(int i = 0; i < in_flight; i++){
+        queue_enqueue(deque, &values[i]);
+    }
+    start = benchmark_wall_time();
+    for(int i = 0; i < size; i++){
+        int* data = (int*) queue_dequeue(deque);
+        sum += *data;
+        queue_enqueue(deque, &values[(i + in_flight) % size]);
+    }
+    end = benchmark_wall_time();
+    deque_time = (end - start) * 1000.0;
+
+    length += sprintf(buffer + length, "Worklist of %d elements: Queue %f ms, Deque %f ms (%.1fx faster)%s\n",
+                      in_flight, node_time, deque_time, node_time / deque_time, sum == expected ? "" : " (MISMATCH)");
+    deque_destroy(deque);
+
+    //  Indexed access of the deque, checked against the array
+    deque = deque_create();
+    for(int i = 0; i < size; i++){
+        deque_push_back(deque, &values[i]);
+    }
+
+    expected = 0;
+    sum = 0;
+    for(int i = 0; i < size; i++){
+        expected += values[i];
+    }
+    start = benchmark_wall_time();
+    for(int i = 0; i < size; i++){
+        sum += *(int*) deque_get(deque, i);
+    }
+    end = benchmark_wall_time();
+    double sequential = (end - start) * 1e9 / size;
+    bool match = sum == expected;
+
+    expected = 0;
+    sum = 0;
+    unsigned int seed = 12345;
+    for(int i = 0; i < size; i++){
+        seed = seed * 1103515245u + 12345u;
+        expected += values[seed % size];
+    }
+    seed = 12345;
+    start = benchmark_wall_time();
+    for(int i = 0; i < size; i++){
+        seed = seed * 1103515245u + 12345u;
+        sum += *(int*) deque_get(deque, seed % size);
+    }
+    end = benchmark_wall_time();
+    double random = (end - start) * 1e9 / size;
+
+    length += sprintf(buffer + length, "deque_get: %f ns sequential, %f ns random%s\n",
+                      sequential, random, match && sum == expected ? "" : " (MISMATCH)");
+    deque_destroy(deque);
+
+    free(values);
+
+    return buffer;
+};
+
+//  Sleep of a polling consumer that found its queue empty, in microseconds
+#define BENCHMARK_POLL_SLEEP_US 50
+
+/*
+    Channel between the producer and the consumer of the blocking queue benchmarks
+    - `polled` is the queue of the polling consumer, guarded by `polled_lock`, NULL to use `blocking`
+    - `blocking` is the blocking queue, NULL to use `polled`
+    - `items` are the elements sent, `count` their number
+    - `times` receives the send time of each element for the latency runs, NULL for the throughput runs
+    - `pace_us` is the pause of the producer before each element, in microseconds
+*/
+typedef struct BenchmarkChannel {
+    Queue* polled;
+    pthread_mutex_t* polled_lock;
+    BlockingQueue* blocking;
+    void** items;
+    int count;
+    double* times;
+    int pace_us;
+} BenchmarkChannel;
+
+/*
+    Result of the consumer of a channel
+    - `sum` is the sum of the `int` received, for the throughput runs
+    - `latency_total` and `latency_max` are the total and largest delays between sending and receiving an element, in seconds
+    - `cpu_ms` is the CPU time of the consumer thread
+*/
+typedef struct BenchmarkConsumed {
+    long long sum;
+    double latency_total;
+    double latency_max;
+    double cpu_ms;
+} BenchmarkConsumed;
+
+/*
+    benchmark_thread_cpu_time
+    Returns the CPU time used by the calling thread, in seconds.
+    @returns double
+*/
+static double benchmark_thread_cpu_time(void){
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+};
+
+/*
+    benchmark_producer
+    Sends the elements of a channel, either enqueued under the lock of the polled queue or enqueued in the blocking queue.
+    @param void* arg: the BenchmarkChannel
+    @returns void*
+*/
+static void* benchmark_producer(void* arg){
+    BenchmarkChannel* channel = (BenchmarkChannel*) arg;
+
+    for(int i = 0; i < channel->count; i++){
+        if(channel->pace_us){
+            usleep(channel->pace_us);
+        }
+        if(channel->times){
+            channel->times[i] = benchmark_wall_time();
+        }
+
+        if(channel->polled){
+            pthread_mutex_lock(channel->polled_lock);
+            queue_enqueue(channel->polled, channel->items[i]);
+            pthread_mutex_unlock(channel->polled_lock);
+        }   else{
+                blockingqueue_enqueue(channel->blocking, channel->items[i]);
+        }
+    }
+
+    return NULL;
+};
+
+/*
+    benchmark_channel_run
+    Runs the producer of a channel in a new thread and consumes every element in the calling thread: by polling the queue under its lock
+    and sleeping while it is empty, or by waiting on the blocking queue for up to `batch` elements at a time.
+    @param BenchmarkChannel* channel
+    @param size_t batch
+    @param double* elapsed_ms: set to the wall time of the run
+    @returns BenchmarkConsumed
+*/
+static BenchmarkConsumed benchmark_channel_run(BenchmarkChannel* channel, size_t batch, double* elapsed_ms){
+    BenchmarkConsumed consumed = {0, 0.0, 0.0, 0.0};
+    void* received[64];
+    pthread_t producer;
+
+    double start = benchmark_wall_time();
+    double cpu = benchmark_thread_cpu_time();
+    pthread_create(&producer, NULL, benchmark_producer, channel);
+
+    for(int done = 0; done < channel->count; ){
+        size_t n = 0;
+
+        if(channel->polled){
+            pthread_mutex_lock(channel->polled_lock);
+            if(queue_size(channel->polled) > 0){
+                received[n++] = queue_dequeue(channel->polled);
+            }
+            pthread_mutex_unlock(channel->polled_lock);
+
+            if(n == 0){
+                usleep(BENCHMARK_POLL_SLEEP_US);
+                continue;
+            }
+        }   else{
+                n = blockingqueue_dequeue_batch(channel->blocking, received, batch, -1);
+        }
+
+        for(size_t i = 0; i < n; i++){
+            if(channel->times){
+                double latency = benchmark_wall_time() - *(double*) received[i];
+                consumed.latency_total += latency;
+                if(latency > consumed.latency_max){
+                    consumed.latency_max = latency;
+                }
+            }   else{
+                    consumed.sum += *(int*) received[i];
+            }
+        }
+        done += (int) n;
+    }
+
+    consumed.cpu_ms = (benchmark_thread_cpu_time() - cpu) * 1000.0;
+    *elapsed_ms = (benchmark_wall_time() - start) * 1000.0;
+    pthread_join(producer, NULL);
+
+    return consumed;
+};
+
+/*
+    run_benchmark_blockingqueue
+    Compares a consumer polling a `Queue` under a mutex, sleeping `BENCHMARK_POLL_SLEEP_US` while it is empty, with a consumer blocking on a `BlockingQueue` of 1024 elements:
+    - throughput: a producer sends `size` elements as fast as it can; wall time and consumer CPU time, with single and batched dequeues (64 elements per wakeup);
+    - latency: a producer sends `messages` elements 200 microseconds apart; average and largest delay between sending and receiving an element.
+    @param int size
+    @param int messages
+    @returns char*
+*/
+char* run_benchmark_blockingqueue(int size, int messages){
+    double elapsed;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    void** items = (void**) malloc(size * sizeof(void*));
+    long long expected = 0;
+    for(int i = 0; i < size; i++){
+        values[i] = rand() % 1000;
+        items[i] = &values[i];
+        expected += values[i];
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Blocking queue\nElements: %d, latency messages: %d, poll sleep: %d us\n", size, messages, BENCHMARK_POLL_SLEEP_US);
+
+    pthread_mutex_t lock;
+    pthread_mutex_init(&lock, NULL);
+    Queue* polled = queue_create();
+    BlockingQueue* blocking = blockingqueue_create(1024);
+
+    //  Throughput
+    BenchmarkChannel channel = {polled, &lock, NULL, items, size, NULL, 0};
+    BenchmarkConsumed consumed = benchmark_channel_run(&channel, 1, &elapsed);
+    length += sprintf(buffer + length, "Throughput, polling Queue: %f ms (%.2f M elements/s), consumer CPU %f ms%s\n",
+                      elapsed, size / elapsed / 1000.0, consumed.cpu_ms, consumed.sum == expected ? "" : " (MISMATCH)");
+
+    channel.polled = NULL;
+    channel.blocking = blocking;
+    consumed = benchmark_channel_run(&channel, 1, &elapsed);
+    length += sprintf(buffer + length, "Throughput, BlockingQueue: %f ms (%.2f M elements/s), consumer CPU %f ms%s\n",
+                      elapsed, size / elapsed / 1000.0, consumed.cpu_ms, consumed.sum == expected ? "" : " (MISMATCH)");
+
+    consumed = benchmark_channel_run(&channel, 64, &elapsed);
+    length += sprintf(buffer + length, "Throughput, BlockingQueue batch of 64: %f ms (%.2f M elements/s), consumer CPU %f ms%s\n",
+                      elapsed, size / elapsed / 1000.0, consumed.cpu_ms, consumed.sum == expected ? "" : " (MISMATCH)");
+
+    //  Latency
+    double* times = (double*) malloc(messages * sizeof(double));
+    void** stamps = (void**) malloc(messages * sizeof(void*));
+    for(int i = 0; i < messages; i++){
+        stamps[i] = &times[i];
+    }
+
+    BenchmarkChannel paced = {polled, &lock, NULL, stamps, messages, times, 200};
+    consumed = benchmark_channel_run(&paced, 1, &elapsed);
+    length += sprintf(buffer + length, "Latency, polling Queue: average %f us, max %f us, consumer CPU %f ms\n",
+                      consumed.latency_total / messages * 1e6, consumed.latency_max * 1e6, consumed.cpu_ms);
+
+    paced.polled = NULL;
+    paced.blocking = blocking;
+    consumed = benchmark_channel_run(&paced, 1, &elapsed);
+    length += sprintf(buffer + length, "Latency, BlockingQueue: average %f us, max %f us, consumer CPU %f ms\n",
+                      consumed.latency_total / messages * 1e6, consumed.latency_max * 1e6, consumed.cpu_ms);
+
+    blockingqueue_destroy(blocking);
+    queue_destroy(polled);
+    pthread_mutex_destroy(&lock);
+    free(times);
+    free(stamps);
+    free(items);
+    free(values);
+
+    return buffer;
+};
+
+/*
+    Work of a thread of the node allocation benchmark
+    - `rounds` is the number of chains built and freed, `length` the number of nodes of a chain
+    - `cached` selects `dllnode_create` and `dllnode_free` instead of `malloc` and `free`
+    - `exchange` is the queue through which the threads swap their chains before freeing them, NULL to free their own chains
+*/
+typedef struct NodeChurn {
+    int rounds;
+    int length;
+    bool cached;
+    BlockingQueue* exchange;
+} NodeChurn;
+
+/*
+    benchmark_node_churn
+    Builds chains of doubly linked list nodes and frees them, either its own chains or chains received from the other threads.
+    @param void* arg: the NodeChurn
+    @returns void*
+*/
+static void* benchmark_node_churn(void* arg){
+    NodeChurn* churn = (NodeChurn*) arg;
+
+    for(int round = 0; round < churn->rounds; round++){
+        DLLNode* head = NULL;
+
+        for(int i = 0; i < churn->length; i++){
+            DLLNode* node = churn->cached ? dllnode_create(NULL) : (DLLNode*) malloc(sizeof(DLLNode));
+            node->next = head;
+            head = node;
+        }
+
+        if(churn->exchange){
+            blockingqueue_enqueue(churn->exchange, head);
+            head = (DLLNode*) blockingqueue_dequeue(churn->exchange);
+        }
+
+        while(head){
+            DLLNode* next = head->next;
+            if(churn->cached){
+                dllnode_free(head);
+            }   else{
+                    free(head);
+            }
+            head = next;
+        }
+    }
+
+    return NULL;
+};
+
+/*
+    benchmark_node_churn_run
+    Runs the node allocation churn on `nthreads` threads, sharing `nodes` node allocations between them, and returns the throughput in millions of nodes per second.
+    @param int nthreads
+    @param int nodes
+    @param int length
+    @param bool cached
+    @param bool exchange
+    @returns double
+*/
+static double benchmark_node_churn_run(int nthreads, int nodes, int length, bool cached, bool exchange){
+    //  Set time variables
+    double start, end;
+
+    pthread_t* threads = (pthread_t*) malloc(nthreads * sizeof(pthread_t));
+    BlockingQueue* queue = exchange ? blockingqueue_create(nthreads) : NULL;
+    NodeChurn churn = {nodes / length / nthreads, length, cached, queue};
+
+    start = benchmark_wall_time();
+    for(int i = 0; i < nthreads; i++){
+        pthread_create(&threads[i], NULL, benchmark_node_churn, &churn);
+    }
+    for(int i = 0; i < nthreads; i++){
+        pthread_join(threads[i], NULL);
+    }
+    end = benchmark_wall_time();
+
+    blockingqueue_destroy(queue);
+    free(threads);
+
+    return (double) churn.rounds * length * nthreads / (end - start) / 1e6;
+};
+
+/*
+    run_benchmark_nodecache
+    Compares the thread-local node caches behind `dllnode_create` and `dllnode_free` with `malloc` and `free` on a churn of `nodes` node allocations
+    shared by 1 to `max_threads` threads, each building and freeing chains of 1000 nodes: freeing its own chains, or swapping them with the other threads first.
+    The own chains are measured again while a list built in bulk, whose nodes are in a node block, is alive.
+    @param int nodes
+    @param int max_threads
+    @returns char*
+*/
+char* run_benchmark_nodecache(int nodes, int max_threads){
+    int chain = 1000;
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Node caches\nNode allocations: %d, chains of %d nodes, %ld online processors\n", nodes, chain, sysconf(_SC_NPROCESSORS_ONLN));
+
+    //  Warm-up, so the first measure does not pay for growing the heap
+    benchmark_node_churn_run(1, nodes, chain, false, false);
+    benchmark_node_churn_run(1, nodes, chain, true, false);
+
+    for(int nthreads = 1; nthreads <= max_threads; nthreads *= 2){
+        double plain = benchmark_node_churn_run(nthreads, nodes, chain, false, false);
+        double cached = benchmark_node_churn_run(nthreads, nodes, chain, true, false);
+        length += sprintf(buffer + length, "%d threads, own chains: malloc %.1f M nodes/s, node cache %.1f M nodes/s (%.1fx)\n",
+                      nthreads, plain, cached, cached / plain);
+
+        plain = benchmark_node_churn_run(nthreads, nodes, chain, false, true);
+        cached = benchmark_node_churn_run(nthreads, nodes, chain, true, true);
+        length += sprintf(buffer + length, "%d threads, swapped chains: malloc %.1f M nodes/s, node cache %.1f M nodes/s (%.1fx)\n",
+                      nthreads, plain, cached, cached / plain);
+    }
+
+    //  Same churn while a list built in bulk is alive, as in any program holding one: the nodes of the churn must still be freed without a lock
+    SinglyLinkedList* bulk = sll_get_random_sll(100000);
+
+    for(int nthreads = 1; nthreads <= max_threads; nthreads *= 2){
+        double plain = benchmark_node_churn_run(nthreads, nodes, chain, false, false);
+        double cached = benchmark_node_churn_run(nthreads, nodes, chain, true, false);
+        length += sprintf(buffer + length, "%d threads, own chains, live bulk list: malloc %.1f M nodes/s, node cache %.1f M nodes/s (%.1fx)\n",
+                      nthreads, plain, cached, cached / plain);
+    }
+
+    sll_destroy(bulk);
+    list_nodes_trim();
+
+    return buffer;
+};
+
+/*
+    benchmark_parallel_accumulate, benchmark_parallel_combine
+    Sum of the `int` of a list, as a parallel reduction.
+*/
+static void benchmark_parallel_accumulate(void* accumulator, void* data, void* context){
+    (void) context;
+    *(long long*) accumulator += *(int*) data;
+};
+
+static void benchmark_parallel_combine(void* accumulator, const void* other, void* context){
+    (void) context;
+    *(long long*) accumulator += *(const long long*) other;
+};
+
+/*
+    benchmark_parallel_work
+    Replaces an `int` by a hash of it computed in 32 rounds, as a compute-bound parallel visit.
+*/
+static void benchmark_parallel_work(void* data, void* context){
+    (void) context;
+    unsigned int value = (unsigned int) *(int*) data;
+    for(int i = 0; i < 32; i++){
+        value = value * 2654435761u + 0x9e3779b9u;
+        value ^= value >> 15;
+    }
+    *(int*) data = (int) (value & 0x7fffffff);
+};
+
+/*
+    benchmark_parallel_keep
+    Keeps the even `int`, as the predicate of a parallel filter.
+*/
+static bool benchmark_parallel_keep(void* data, void* context){
+    (void) context;
+    return *(int*) data % 2 == 0;
+};
+
+/*
+    benchmark_parallel_list
+    Builds a singly linked list of the `int` of an array, one node at a time, in the order of the array. The nodes recycled by the node caches come
+    in no particular order, so the list is compacted: every list of the benchmark is traversed in address order.
+*/
+static SinglyLinkedList* benchmark_parallel_list(int* values, int size){
+    SinglyLinkedList* sll = sll_create();
+    for(int i = size - 1; i >= 0; i--){
+        sll_insert(sll, &values[i]);
+    }
+    sll_compact(sll);
+    return sll;
+};
+
+/*
+    run_benchmark_parallel
+    Times `sll_parallel_reduce` (a sum), `sll_parallel_foreach` (a compute-bound visit) and `sll_parallel_filter` (removing half of the nodes) on a list of `size` `int`,
+    sequentially and on thread pools of 1 to `max_threads` threads, and reports the speedup over the sequential pass. The splitter pass is timed on its own as a plain traversal.
+    The filter runs on a list of cached nodes and on a list built in bulk by `sll_from_array`, whose removed nodes are released from their node block.
+    @param int size
+    @param int max_threads
+    @returns char*
+*/
+char* run_benchmark_parallel(int size, int max_threads){
+    //  Set time variables
+    double start, end;
+
+    int* values = (int*) malloc(size * sizeof(int));
+    long long expected = 0;
+    for(int i = 0; i < size; i++){
+        values[i] = rand();
+        expected += values[i];
+    }
+
+    char* buffer = (char*) malloc(2048 * sizeof(char));
+    int length = sprintf(buffer, "Benchmark Test: Parallel list operations\nList size: %d, %ld online processors\n", size, sysconf(_SC_NPROCESSORS_ONLN));
+
+    SinglyLinkedList* sll = benchmark_parallel_list(values, size);
+
+    //  The splitter pass follows the `next` pointers without reading the elements
+    start = benchmark_wall_time();
+    size_t walked = 0;
+    for(SLLNode* node = sll->head; node; node = node->next){
+        walked++;
+    }
+    end = benchmark_wall_time();
+    length += sprintf(buffer + length, "Splitter pass: %f ms for %zu nodes\n", (end - start) * 1000.0, walked);
+
+    double sequential_reduce = 0, sequential_foreach = 0, sequential_filter = 0, sequential_bulk_filter = 0;
+
+    for(int nthreads = 0; nthreads <= max_threads; nthreads = nthreads ? 2 * nthreads : 1){
+        ThreadPool* pool = nthreads ? threadpool_create(nthreads) : NULL;
+
+        long long sum = 0, identity = 0;
+        start = benchmark_wall_time();
+        sll_parallel_reduce(sll, &sum, &identity, sizeof(long long), benchmark_parallel_accumulate, benchmark_parallel_combine, NULL, pool);
+        end = benchmark_wall_time();
+        double reduce = (end - start) * 1000.0;
+
+        start = benchmark_wall_time();
+        sll_parallel_foreach(sll, benchmark_parallel_work, NULL, pool);
+        end = benchmark_wall_time();
+        double foreach = (end - start) * 1000.0;
+
+        //  The visit rewrote the elements: restore them before the filter, on a new list
+        for(int i = 0; i < size; i++){
+            values[i] = (int) (i * 2654435761u & 0x7fffffff);
+        }
+        sll_destroy(sll);
+        sll = benchmark_parallel_list(values, size);
+
+        start = benchmark_wall_time();
+        size_t removed = sll_parallel_filter(sll, benchmark_parallel_keep, NULL, NULL, pool);
+        end = benchmark_wall_time();
+        double filter = (end - start) * 1000.0;
+
+        //  Same filter on a list built in bulk, whose nodes and copied elements are in one node block: the copies are not passed to `free`
+        SinglyLinkedList* bulk = sll_from_array(values, size, sizeof(int), true);
+        start = benchmark_wall_time();
+        size_t bulk_removed = sll_parallel_filter(bulk, benchmark_parallel_keep, free, NULL, pool);
+        end = benchmark_wall_time();
+        double bulk_filter = (end - start) * 1000.0;
+        sll_destroy(bulk);
+
+        if(nthreads == 0){
+            sequential_reduce = reduce;
+            sequential_foreach = foreach;
+            sequential_filter = filter;
+            sequential_bulk_filter = bulk_filter;
+            length += sprintf(buffer + length, "Sequential: reduce %f ms, foreach %f ms, filter %f ms (%zu removed), filter of a bulk list %f ms%s\n",
+                              reduce, foreach, filter, removed, bulk_filter, sum == expected && bulk_removed == removed ? "" : " (MISMATCH)");
+        }   else{
+                length += sprintf(buffer + length, "%d threads: reduce %f ms (%.2fx), foreach %f ms (%.2fx), filter %f ms (%.2fx), filter of a bulk list %f ms (%.2fx)%s\n",
+                                  nthreads, reduce, sequential_reduce / reduce, foreach, sequential_foreach / foreach, filter, sequential_filter / filter,
+                                  bulk_filter, sequential_bulk_filter / bulk_filter, sum == expected && bulk_removed == removed ? "" : " (MISMATCH)");
+        }
+
+        //  Rebuild the list of the reduction for the next pool
+        expected = 0;
+        for(int i = 0; i < size; i++){
+            values[i] = rand();
+            expected += values[i];
+        }
+        sll_destroy(sll);
+        sll = benchmark_parallel_list(values, size);
+
+        if(pool){
+            threadpool_destroy(pool);
+        }
+    }
+
+    sll_destroy(sll);
+    list_nodes_trim();
+    free(values);
+
+    return buffer;
+};
@@ -87,6 +87,490 @@ char* get_benchmark_result(BenchmarkResult* result);
     Benchmarking tests
 */
 BenchmarkResult* benchmark_sll_bubblesort(int (*compare)(void*, void*));
+
+/*
+    benchmark_wall_time
+    Returns the current value of a monotonic wall clock, in seconds.
+    Unlike `clock()`, it does not add up the CPU time of every thread, so it is used by the multi-threaded benchmarks.
+*/
+double benchmark_wall_time(void);
+
+/*
+    Work-stealing thread pool benchmarks
+*/
+
+/*
+    benchmark_threadpool_unbalanced
+    Benchmarks a work-stealing thread pool on an unbalanced recursive workload (a Fibonacci-shaped task tree).
+
+    Parameters:
+    - nthreads: the number of worker threads
+    - depth: the depth of the task tree
+
+    Returns:
+    - a pointer to the benchmark result (time in ms)
+*/
+BenchmarkResult* benchmark_threadpool_unbalanced(int nthreads, int depth);
+
+/*
+    benchmark_sll_parallel_mergesort
+    Benchmarks `sll_parallel_mergesort` on a random singly linked list.
+
+    Parameters:
+    - nthreads: the number of worker threads
+    - list_size: the size of the list to sort
+
+    Returns:
+    - a pointer to the benchmark result (time in ms)
+*/
+BenchmarkResult* benchmark_sll_parallel_mergesort(int nthreads, int list_size);
+
+/*
+    run_benchmark_threadpool
+    Runs the thread pool benchmarks for 1, 2, 4, ... worker threads, up to the number of online processors.
+    For the unbalanced workload, the report shows how the tasks were spread over the workers.
+
+    Parameters:
+    - depth: the depth of the unbalanced task tree
+    - list_size: the size of the list sorted by `sll_parallel_mergesort`
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_threadpool(int depth, int list_size);
+
+/*
+    Unrolled linked list benchmarks
+*/
+
+/*
+    benchmark_sll_traversal
+    Benchmarks a full traversal of a random singly linked list (a `sll_search` for a missing element).
+
+    Parameters:
+    - list_size: the size of the list
+    - repeats: the number of traversals
+
+    Returns:
+    - a pointer to the benchmark result (time in ms, for all the traversals)
+*/
+BenchmarkResult* benchmark_sll_traversal(int list_size, int repeats);
+
+/*
+    benchmark_ull_traversal
+    Benchmarks a full traversal of a random unrolled linked list (a `ull_search` for a missing element).
+
+    Parameters:
+    - list_size: the size of the list
+    - repeats: the number of traversals
+
+    Returns:
+    - a pointer to the benchmark result (time in ms, for all the traversals)
+*/
+BenchmarkResult* benchmark_ull_traversal(int list_size, int repeats);
+
+/*
+    run_benchmark_unrolled_traversal
+    Compares the traversal of a `SinglyLinkedList` and of an `UnrolledList` holding the same elements.
+    The report includes the number of nodes (i.e. potential cache misses) visited per element.
+
+    Parameters:
+    - list_size: the size of the lists
+    - repeats: the number of traversals
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_unrolled_traversal(int list_size, int repeats);
+
+/*
+    Inline value storage benchmarks
+*/
+
+/*
+    run_benchmark_typed_sll
+    Compares a generic `SinglyLinkedList` of `int*` with a list generated by `DSL_DEFINE_TYPED_SLL` for `int`:
+    the construction of a random list (two allocations per element against one) and a search by value for a missing element
+    (a call to `compare_int` per element against an inlined comparison).
+
+    Parameters:
+    - list_size: the size of the lists
+    - repeats: the number of searches
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_typed_sll(int list_size, int repeats);
+
+/*
+    Type-specialized sorting benchmarks
+*/
+
+/*
+    run_benchmark_sortgen
+    Compares sorts calling `compare_int` through a function pointer with the sorts generated by `DSL_DEFINE_SORT` for `int`, on the same random singly linked lists.
+    Bubble, selection and insertion sorts are those of `dsl_listsort.h`. Since `sll_mergesort` and `sll_quicksort` build new lists, the merge and quick sorts are compared
+    with in-place versions generated around an indirect call, so that both versions only differ by the comparison.
+
+    Parameters:
+    - ntests: the number of lists sorted by each algorithm
+    - list_size: the size of the lists
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_sortgen(int ntests, int list_size);
+/*
+    Skip list benchmarks
+*/
+
+/*
+    run_benchmark_skiplist
+    Compares the lookup of random elements with `sll_search`, on a sorted `SinglyLinkedList`, and with `skiplist_search`, on a `SkipList` holding the same elements.
+    The lists hold 10^min_exponent to 10^max_exponent elements; the number of linear searches is reduced on the large lists to bound the run time.
+
+    Parameters:
+    - min_exponent: the exponent of the smallest list size
+    - max_exponent: the exponent of the largest list size
+    - lookups: the number of lookups per list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_skiplist(int min_exponent, int max_exponent, int lookups);
+/*
+    Hash index benchmarks
+*/
+
+/*
+    run_benchmark_hashindex
+    Compares the removal of random elements from a `DoublyLinkedList` by `dll_remove`, with a linear scan and with an attached hash index (`dll_index_attach`).
+    The time to attach the index to the full list is reported separately.
+
+    Parameters:
+    - list_size: the size of the lists
+    - removals: the number of elements removed
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_hashindex(int list_size, int removals);
+/*
+    Cache benchmarks
+*/
+
+/*
+    run_benchmark_cache
+    Replays Zipf traces (exponents 0.8, 0.99 and 1.2) on the LRU and CLOCK caches of `dsl_cache.h`: every key is read, and put on a miss.
+    Reports the hit rate and the throughput of each policy, then the throughput of a `ShardedCache` replayed by several threads, with one shard and with several shards.
+
+    Parameters:
+    - nkeys: the number of distinct keys of the traces
+    - capacity: the number of items of the caches
+    - operations: the length of the traces
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_cache(int nkeys, int capacity, int operations);
+/*
+    Priority queue benchmarks
+*/
+
+/*
+    run_benchmark_heap
+    Compares two schedulers that lower the priority of random elements and read the minimum after every change:
+    a `Heap` from `dsl_heap.h` (built once with `heap_from_queue`, then `heap_decrease_key`), and a `Queue` sorted again with `queue_mergesort` after every change.
+    Also reports the time to remove every element in priority order.
+
+    Parameters:
+    - size: the number of elements
+    - updates: the number of priority changes
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_heap(int size, int updates);
+/*
+    Selection benchmarks
+*/
+
+/*
+    run_benchmark_topk
+    Compares the selection of the K smallest elements of a `SinglyLinkedList` for K/N ratios from 0.0001 to 1:
+    a full sort (`sll_heapsort`), `sll_topk` (bounded heap, O(N log K)), `sll_partial_sort` (O(N + K log K)) and `sll_nth_element` (O(N)).
+    Every function runs on a fresh copy of the same random list.
+
+    Parameters:
+    - list_size: the number of elements of the list
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_topk(int list_size);
+/*
+    Adaptive sorting benchmarks
+*/
+
+/*
+    run_benchmark_natural_mergesort
+    Compares `sll_natural_mergesort` with the top-down merge sort of `queue_mergesort` on lists made of 1, 16 and 1024 ascending batches, and on random lists.
+
+    Parameters:
+    - list_size: the number of elements of the lists
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_natural_mergesort(int list_size);
+/*
+    k-way merge benchmarks
+*/
+
+/*
+    run_benchmark_merge_k
+    Merges k = 4, 64 and 1024 sorted `SinglyLinkedList` shards with `sll_merge_k` and `sll_parallel_merge_k` (one thread per processor),
+    and compares them with sorting the concatenation of the shards with `sll_natural_mergesort` and `sll_heapsort`.
+
+    Parameters:
+    - list_size: the total number of elements of the shards
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_merge_k(int list_size);
+/*
+    Array sort benchmarks
+*/
+
+/*
+    run_benchmark_arraysort
+    Compares `sll_arraysort`, which sorts (data, node) pairs in a reused scratch buffer before relinking the nodes,
+    with the in-list sorts `sll_natural_mergesort` and `sll_heapsort`, on lists whose nodes are scattered in memory.
+    The sizes go from `min_size` to `max_size` by factors of 10; smaller lists are sorted repeatedly, and times are reported per element.
+
+    Parameters:
+    - min_size: the smallest list size
+    - max_size: the largest list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_arraysort(int min_size, int max_size);
+/*
+    Integer sort benchmarks
+*/
+
+/*
+    run_benchmark_simdsort
+    Sorts scattered lists of `int` with `sll_sort_int` for every kernel of `dsl_simdsort.h` supported by the processor (radix, SSE4.2, AVX2),
+    and compares them with the in-list `sll_natural_mergesort`. The sizes go from `min_size` to `max_size` by factors of 10.
+
+    Parameters:
+    - min_size: the smallest list size
+    - max_size: the largest list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_simdsort(int min_size, int max_size);
+/*
+    External sort benchmarks
+*/
+
+/*
+    run_benchmark_extsort
+    Sorts a list of `int` with the external sort of `dsl_extsort.h`, with memory budgets of 1, 1/4, 1/16 and 1/64 of the list,
+    and compares it with the in-memory `sll_natural_mergesort`.
+
+    Parameters:
+    - size: the list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_extsort(int size);
+/*
+    List file benchmarks
+*/
+
+/*
+    run_benchmark_serialize
+    Compares the startup cost of a list of `int` rebuilt with one allocation per element with loading it from a list file of `dsl_serialize.h`:
+    mapped and viewed as a list, with and without the checksum, and mapped and traversed in place.
+
+    Parameters:
+    - size: the list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_serialize(int size);
+/*
+    Bulk construction benchmarks
+*/
+
+/*
+    run_benchmark_bulk_construction
+    Compares building a list of `int` with one `sll_insert` and one allocation of the element per value with the bulk constructors
+    `sll_from_array` and `sll_from_generator`, whose nodes and elements share one block; the traversal and destruction of the lists are timed too.
+
+    Parameters:
+    - size: the list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_bulk_construction(int size);
+/*
+    Splicing benchmarks
+*/
+
+/*
+    run_benchmark_splice
+    Compares merging `nlists` lists of `size / nlists` elements into one with the append loops (`dll_append`, `queue_enqueue`, a copy loop for singly linked lists)
+    and with `dll_concat`, `queue_concat` and `sll_concat`; and splitting a doubly linked list in half by copying its second half and with `dll_split_at`.
+
+    Parameters:
+    - size: the total number of elements
+    - nlists: the number of lists merged
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_splice(int size, int nlists);
+/*
+    Teardown benchmarks
+*/
+
+/*
+    run_benchmark_teardown
+    Compares freeing the elements of a list in a loop before `sll_destroy` with `sll_destroy_with`,
+    and freeing the nodes of lists built in bulk one by one with `sll_destroy` and `dll_destroy`, which release them from their block in batches.
+
+    Parameters:
+    - size: the list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_teardown(int size);
+/*
+    Prefetching benchmarks
+*/
+
+/*
+    run_benchmark_prefetch
+    Measures the throughput of `repeats` searches by pointer and by value on a singly linked list whose nodes are scattered in the heap,
+    with the cursors of `dsl_cursor.h` at prefetch distances from 0 (no prefetch) to 32, and of `sll_search`.
+
+    Parameters:
+    - size: the list size
+    - repeats: the number of searches
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_prefetch(int size, int repeats);
+/*
+    Compact list benchmarks
+*/
+
+/*
+    run_benchmark_compactlist
+    Compares the singly and doubly linked lists with the compact lists of `dsl_compactlist.h` (singly, doubly and XOR-linked; data pointers or copied `int`):
+    bytes per element, and the times to append, search, sort and remove.
+
+    Parameters:
+    - size: the list size
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_compactlist(int size);
+/*
+    Compaction benchmarks
+*/
+
+/*
+    run_benchmark_compaction
+    Measures the locality and the traversal time of lists scattered by a relinking sort before and after their compaction
+    (`dll_compact`, `sll_compact`, `compactlist_compact`), and the time of the compaction.
+
+    Parameters:
+    - size: the list size
+    - repeats: the number of traversals timed
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_compaction(int size, int repeats);
+/*
+    Deque benchmarks
+*/
+
+/*
+    run_benchmark_deque
+    Compares the node-based `Stack` and `Queue` with a `Deque` used through the same `stack_*` and `queue_*` calls
+    (push/pop, enqueue/dequeue, a worklist, heap bytes per element), and times the indexed access of the deque.
+
+    Parameters:
+    - size: the number of elements
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_deque(int size);
+/*
+    Blocking queue benchmarks
+*/
+
+/*
+    run_benchmark_blockingqueue
+    Compares a consumer polling a `Queue` under a mutex with a consumer blocking on a `BlockingQueue`: throughput and consumer CPU time
+    with single and batched dequeues, and the latency between sending and receiving paced messages.
+
+    Parameters:
+    - size: the number of elements of the throughput runs
+    - messages: the number of messages of the latency runs
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_blockingqueue(int size, int messages);
+/*
+    Node cache benchmarks
+*/
+
+/*
+    run_benchmark_nodecache
+    Compares the node caches behind `dllnode_create` and `dllnode_free` with `malloc` and `free` on a multi-threaded churn of node allocations,
+    with threads freeing their own nodes or the nodes of other threads.
+
+    Parameters:
+    - nodes: the number of node allocations, shared between the threads
+    - max_threads: the largest number of threads, doubled from 1
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_nodecache(int nodes, int max_threads);
+/*
+    Parallel list operation benchmarks
+*/
+
+/*
+    run_benchmark_parallel
+    Measures the speedup of `sll_parallel_reduce`, `sll_parallel_foreach` and `sll_parallel_filter` over a sequential pass on thread pools of 1 to `max_threads` threads.
+
+    Parameters:
+    - size: the list size
+    - max_threads: the largest number of threads, doubled from 1
+
+    Returns:
+    - a string representation of the benchmark results
+*/
+char* run_benchmark_parallel(int size, int max_threads);
 #endif // DSL_BENCHMARKING_SUIT_H
 
 char* run_benchmark_sll_bubblesort(int ntests, int list_size);
@@ -0,0 +1,296 @@
+/*
+    Implementation of the blocking bounded queue.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "dsl_blockingqueue.h"
+
+/*
+    blockingqueue_deadline
+    Get the time on the monotonic clock, which the condition variables of the queue use, at which a timeout expires
+    @param  long            Timeout in milliseconds
+    @return struct timespec The deadline
+*/
+static struct timespec blockingqueue_deadline(long timeout_ms){
+    struct timespec deadline = {0, 0};
+
+    if(timeout_ms <= 0){
+        return deadline;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+
+    if(deadline.tv_nsec >= 1000000000L){
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    return deadline;
+}
+
+/*
+    blockingqueue_wait
+    Wait on a condition variable of a queue, with its lock held, counting the thread among the waiting ones
+    @param  BlockingQueue*      Pointer to the queue
+    @param  pthread_cond_t*     Condition variable
+    @param  size_t*             Number of threads waiting on the condition variable
+    @param  long                Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @param  struct timespec*    Deadline of the timeout, from `blockingqueue_deadline`
+    @return bool                false if the timeout expired, true otherwise; the caller checks the condition again either way
+*/
+static bool blockingqueue_wait(BlockingQueue* queue, pthread_cond_t* condition, size_t* waiting, long timeout_ms, struct timespec* deadline){
+    int result;
+
+    if(timeout_ms == 0){
+        return false;
+    }
+
+    (*waiting)++;
+
+    if(timeout_ms < 0){
+        result = pthread_cond_wait(condition, &queue->lock);
+    }   else{
+            result = pthread_cond_timedwait(condition, &queue->lock, deadline);
+    }
+
+    (*waiting)--;
+
+    return result != ETIMEDOUT;
+}
+
+/*
+    blockingqueue_create
+    Create a new, empty, blocking queue
+    @param  size_t          Maximum number of elements, greater than 0
+    @return BlockingQueue*  Pointer to the new queue, NULL if the capacity is 0 or the creation failed
+*/
+BlockingQueue* blockingqueue_create(size_t capacity){
+    if(capacity == 0){
+        return NULL;
+    }
+
+    BlockingQueue* queue = (BlockingQueue*) malloc(sizeof(BlockingQueue));
+
+    if(!queue){
+        return NULL;
+    }
+
+    queue->items = (void**) malloc(capacity * sizeof(void*));
+
+    if(!queue->items){
+        free(queue);
+        return NULL;
+    }
+
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->size = 0;
+    queue->closed = false;
+    queue->waiting_consumers = 0;
+    queue->waiting_producers = 0;
+
+    //  The timed waits measure their deadline on the monotonic clock, which does not jump with the system time
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, &attributes);
+    pthread_cond_init(&queue->not_full, &attributes);
+
+    pthread_condattr_destroy(&attributes);
+
+    return queue;
+}
+
+/*
+    blockingqueue_destroy
+    Destroy a blocking queue. No thread may be using it any more; the data of the remaining elements is not freed.
+    @param  BlockingQueue*  Pointer to the queue
+    @return void
+*/
+void blockingqueue_destroy(BlockingQueue* queue){
+    if(!queue){
+        return;
+    }
+
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+    free(queue->items);
+    free(queue);
+}
+
+/*
+    blockingqueue_close
+    Close a blocking queue and wake every waiting thread: enqueuing fails from now on, and dequeuing returns the remaining elements, then NULL without waiting
+    @param  BlockingQueue*  Pointer to the queue
+    @return void
+*/
+void blockingqueue_close(BlockingQueue* queue){
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = true;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+/*
+    blockingqueue_enqueue
+    Insert a new element at the back of a blocking queue, waiting as long as the queue is full
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void*           Pointer to the data, not NULL
+    @return bool            true if the operation was successful, false if the queue is closed or the data is NULL
+*/
+bool blockingqueue_enqueue(BlockingQueue* queue, void* data){
+    return blockingqueue_enqueue_wait(queue, data, -1);
+}
+
+/*
+    blockingqueue_enqueue_wait
+    Insert a new element at the back of a blocking queue, waiting at most a given time while the queue is full
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void*           Pointer to the data, not NULL
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return bool            true if the operation was successful, false if the queue stayed full, is closed, or the data is NULL
+*/
+bool blockingqueue_enqueue_wait(BlockingQueue* queue, void* data, long timeout_ms){
+    if(!data){
+        return false;
+    }
+
+    struct timespec deadline = blockingqueue_deadline(timeout_ms);
+
+    pthread_mutex_lock(&queue->lock);
+
+    while(queue->size == queue->capacity && !queue->closed &&
+          blockingqueue_wait(queue, &queue->not_full, &queue->waiting_producers, timeout_ms, &deadline));
+
+    if(queue->size == queue->capacity || queue->closed){
+        pthread_mutex_unlock(&queue->lock);
+        return false;
+    }
+
+    size_t tail = queue->head + queue->size;
+
+    if(tail >= queue->capacity){
+        tail -= queue->capacity;
+    }
+
+    queue->items[tail] = data;
+    queue->size++;
+
+    if(queue->waiting_consumers > 0){
+        pthread_cond_signal(&queue->not_empty);
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+
+    return true;
+}
+
+/*
+    blockingqueue_dequeue
+    Remove the element at the front of a blocking queue, waiting as long as the queue is empty and open
+    @param  BlockingQueue*  Pointer to the queue
+    @return void*           Pointer to the data of the element, NULL if the queue is closed and empty
+*/
+void* blockingqueue_dequeue(BlockingQueue* queue){
+    return blockingqueue_dequeue_wait(queue, -1);
+}
+
+/*
+    blockingqueue_dequeue_wait
+    Remove the element at the front of a blocking queue, waiting at most a given time while the queue is empty
+    @param  BlockingQueue*  Pointer to the queue
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return void*           Pointer to the data of the element, NULL if the queue stayed empty or is closed and empty
+*/
+void* blockingqueue_dequeue_wait(BlockingQueue* queue, long timeout_ms){
+    void* data = NULL;
+
+    blockingqueue_dequeue_batch(queue, &data, 1, timeout_ms);
+
+    return data;
+}
+
+/*
+    blockingqueue_dequeue_batch
+    Remove up to `max_n` elements at the front of a blocking queue in one locked section, waiting at most a given time for the first one
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void**          Array receiving the data of the elements, in queue order
+    @param  size_t          Maximum number of elements, the length of the array
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return size_t          Number of elements removed, 0 if the queue stayed empty or is closed and empty
+*/
+size_t blockingqueue_dequeue_batch(BlockingQueue* queue, void** items, size_t max_n, long timeout_ms){
+    if(max_n == 0){
+        return 0;
+    }
+
+    struct timespec deadline = blockingqueue_deadline(timeout_ms);
+
+    pthread_mutex_lock(&queue->lock);
+
+    while(queue->size == 0 && !queue->closed &&
+          blockingqueue_wait(queue, &queue->not_empty, &queue->waiting_consumers, timeout_ms, &deadline));
+
+    size_t n = queue->size < max_n ? queue->size : max_n;
+
+    //  Copy the elements in at most two runs: up to the end of the ring, then from its start
+    size_t first_run = queue->capacity - queue->head;
+
+    if(first_run > n){
+        first_run = n;
+    }
+
+    memcpy(items, queue->items + queue->head, first_run * sizeof(void*));
+    memcpy(items + first_run, queue->items, (n - first_run) * sizeof(void*));
+
+    queue->head += n;
+
+    if(queue->head >= queue->capacity){
+        queue->head -= queue->capacity;
+    }
+
+    queue->size -= n;
+
+    //  Every freed slot can take an element of a waiting producer
+    if(n > 0 && queue->waiting_producers > 0){
+        if(n == 1){
+            pthread_cond_signal(&queue->not_full);
+        }   else{
+                pthread_cond_broadcast(&queue->not_full);
+        }
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+
+    return n;
+}
+
+/*
+    blockingqueue_size
+    Get the number of elements in a blocking queue, which may change as soon as it is returned
+    @param  BlockingQueue*  Pointer to the queue
+    @return size_t          Number of elements
+*/
+size_t blockingqueue_size(BlockingQueue* queue){
+    pthread_mutex_lock(&queue->lock);
+    size_t size = queue->size;
+    pthread_mutex_unlock(&queue->lock);
+
+    return size;
+}
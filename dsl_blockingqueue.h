@@ -0,0 +1,134 @@
+#ifndef DSL_BLOCKINGQUEUE_H
+#define DSL_BLOCKINGQUEUE_H
+/*
+    Interface for the implementation of the blocking bounded queue.
+
+    A `BlockingQueue` is a FIFO queue of data pointers shared between producer and consumer threads, stored in a ring of `capacity` slots allocated once.
+    Instead of polling `queue_size` and `queue_dequeue` of `dsl_lists.h` under a mutex, and spinning or sleeping while the queue is empty, a consumer blocks on a condition variable
+    and is woken as soon as an element is enqueued; a producer blocks while the queue is full, which holds back a producer faster than its consumers.
+    Threads are only signaled when another thread is waiting, and `blockingqueue_dequeue_batch` drains up to `max_n` elements per wakeup.
+
+    The waits take a timeout in milliseconds: negative to wait as long as needed, 0 not to wait at all. Closing a queue wakes every waiting thread:
+    enqueuing then fails, and dequeuing returns the remaining elements, then nothing. NULL is not a valid element, since it is returned when nothing was dequeued.
+
+    The current `BlockingQueue` methods are:
+    - `blockingqueue_create`: Create a new blocking queue
+    - `blockingqueue_destroy`: Destroy a blocking queue
+    - `blockingqueue_close`: Close a blocking queue
+    - `blockingqueue_enqueue`, `blockingqueue_enqueue_wait`: Insert a new element at the back of a blocking queue
+    - `blockingqueue_dequeue`, `blockingqueue_dequeue_wait`: Remove the element at the front of a blocking queue
+    - `blockingqueue_dequeue_batch`: Remove several elements at the front of a blocking queue
+    - `blockingqueue_size`: Get the number of elements in a blocking queue
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/*
+    Blocking bounded queue
+    - `items` is the ring of slots, `capacity` the number of slots
+    - `head` is the slot of the front element, `size` the number of elements
+    - `closed` is set once the queue is closed
+    - `waiting_consumers` and `waiting_producers` are the numbers of threads waiting on `not_empty` and `not_full`
+    - `lock` protects the other fields
+*/
+typedef struct BlockingQueue {
+    void **items;
+    size_t capacity;
+    size_t head;
+    size_t size;
+    bool closed;
+    size_t waiting_consumers;
+    size_t waiting_producers;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} BlockingQueue;
+
+//  BlockingQueue methods
+
+/*
+    blockingqueue_create
+    Create a new, empty, blocking queue
+    @param  size_t          Maximum number of elements, greater than 0
+    @return BlockingQueue*  Pointer to the new queue, NULL if the capacity is 0 or the creation failed
+*/
+BlockingQueue* blockingqueue_create(size_t capacity);
+
+/*
+    blockingqueue_destroy
+    Destroy a blocking queue. No thread may be using it any more; the data of the remaining elements is not freed.
+    @param  BlockingQueue*  Pointer to the queue
+    @return void
+*/
+void blockingqueue_destroy(BlockingQueue* queue);
+
+/*
+    blockingqueue_close
+    Close a blocking queue and wake every waiting thread: enqueuing fails from now on, and dequeuing returns the remaining elements, then NULL without waiting
+    @param  BlockingQueue*  Pointer to the queue
+    @return void
+*/
+void blockingqueue_close(BlockingQueue* queue);
+
+/*
+    blockingqueue_enqueue
+    Insert a new element at the back of a blocking queue, waiting as long as the queue is full
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void*           Pointer to the data, not NULL
+    @return bool            true if the operation was successful, false if the queue is closed or the data is NULL
+*/
+bool blockingqueue_enqueue(BlockingQueue* queue, void* data);
+
+/*
+    blockingqueue_enqueue_wait
+    Insert a new element at the back of a blocking queue, waiting at most a given time while the queue is full
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void*           Pointer to the data, not NULL
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return bool            true if the operation was successful, false if the queue stayed full, is closed, or the data is NULL
+*/
+bool blockingqueue_enqueue_wait(BlockingQueue* queue, void* data, long timeout_ms);
+
+/*
+    blockingqueue_dequeue
+    Remove the element at the front of a blocking queue, waiting as long as the queue is empty and open
+    @param  BlockingQueue*  Pointer to the queue
+    @return void*           Pointer to the data of the element, NULL if the queue is closed and empty
+*/
+void* blockingqueue_dequeue(BlockingQueue* queue);
+
+/*
+    blockingqueue_dequeue_wait
+    Remove the element at the front of a blocking queue, waiting at most a given time while the queue is empty
+    @param  BlockingQueue*  Pointer to the queue
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return void*           Pointer to the data of the element, NULL if the queue stayed empty or is closed and empty
+*/
+void* blockingqueue_dequeue_wait(BlockingQueue* queue, long timeout_ms);
+
+/*
+    blockingqueue_dequeue_batch
+    Remove up to `max_n` elements at the front of a blocking queue in one locked section, waiting at most a given time for the first one
+    @param  BlockingQueue*  Pointer to the queue
+    @param  void**          Array receiving the data of the elements, in queue order
+    @param  size_t          Maximum number of elements, the length of the array
+    @param  long            Timeout in milliseconds, negative to wait as long as needed, 0 not to wait
+    @return size_t          Number of elements removed, 0 if the queue stayed empty or is closed and empty
+*/
+size_t blockingqueue_dequeue_batch(BlockingQueue* queue, void** items, size_t max_n, long timeout_ms);
+
+/*
+    blockingqueue_size
+    Get the number of elements in a blocking queue, which may change as soon as it is returned
+    @param  BlockingQueue*  Pointer to the queue
+    @return size_t          Number of elements
+*/
+size_t blockingqueue_size(BlockingQueue* queue);
+
+#endif // DSL_BLOCKINGQUEUE_H
@@ -0,0 +1,645 @@
+/*
+    Implementation of the LRU and CLOCK caches.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "dsl_cache.h"
+
+/*
+    cache_unlink
+    Unlink a node from the list of a cache, moving the CLOCK hand past it
+    @param  Cache*      Pointer to the cache
+    @param  DLLNode*    Pointer to the node
+    @return void
+*/
+static void cache_unlink(Cache* cache, DLLNode* node){
+    if(cache->hand == node){
+        cache->hand = node->next ? node->next : cache->list.head;
+        if(cache->hand == node){
+            cache->hand = NULL;
+        }
+    }
+
+    if(node->prev){
+        node->prev->next = node->next;
+    }   else{
+            cache->list.head = node->next;
+    }
+
+    if(node->next){
+        node->next->prev = node->prev;
+    }   else{
+            cache->list.tail = node->prev;
+    }
+
+    node->prev = NULL;
+    node->next = NULL;
+    cache->list.size--;
+}
+
+/*
+    cache_link_front
+    Link a node at the front of the list of a cache
+    @param  Cache*      Pointer to the cache
+    @param  DLLNode*    Pointer to the node
+    @return void
+*/
+static void cache_link_front(Cache* cache, DLLNode* node){
+    node->prev = NULL;
+    node->next = cache->list.head;
+
+    if(cache->list.head){
+        cache->list.head->prev = node;
+    }   else{
+            cache->list.tail = node;
+    }
+
+    cache->list.head = node;
+    cache->list.size++;
+}
+
+/*
+    cache_link_behind_hand
+    Link a node just before the CLOCK hand, so that it is the last node the hand reaches
+    @param  Cache*      Pointer to the cache
+    @param  DLLNode*    Pointer to the node
+    @return void
+*/
+static void cache_link_behind_hand(Cache* cache, DLLNode* node){
+    DLLNode* hand = cache->hand;
+
+    if(!hand){
+        cache_link_front(cache, node);
+        cache->hand = node;
+        return;
+    }
+
+    node->next = hand;
+    node->prev = hand->prev;
+
+    if(hand->prev){
+        hand->prev->next = node;
+    }   else{
+            cache->list.head = node;
+    }
+
+    hand->prev = node;
+    cache->list.size++;
+}
+
+/*
+    cache_use
+    Record a use of an item, as its replacement policy requires
+    @param  Cache*          Pointer to the cache
+    @param  CacheEntry*     Pointer to the item
+    @return void
+*/
+static void cache_use(Cache* cache, CacheEntry* entry){
+    if(cache->policy == CACHE_CLOCK){
+        entry->referenced = true;
+    }   else if(cache->list.head != &entry->node){
+            cache_unlink(cache, &entry->node);
+            cache_link_front(cache, &entry->node);
+    }
+}
+
+/*
+    cache_drop
+    Unlink an item, remove it from the index and free it
+    @param  Cache*              Pointer to the cache
+    @param  HashIndexEntry*     Pointer to the index entry of the item
+    @return CacheEntry          Copy of the dropped item
+*/
+static CacheEntry cache_drop(Cache* cache, HashIndexEntry* slot){
+    CacheEntry* entry = (CacheEntry*)slot->node;
+    CacheEntry dropped = *entry;
+
+    cache_unlink(cache, &entry->node);
+    hashindex_remove(cache->index, slot);
+    cache->cost -= entry->cost;
+    free(entry);
+
+    return dropped;
+}
+
+/*
+    cache_over_limit
+    Check whether a cache exceeds one of its limits
+    @param  Cache*  Pointer to the cache
+    @return bool    true if the cache must evict, false otherwise
+*/
+static bool cache_over_limit(Cache* cache){
+    return (cache->capacity && cache->list.size > cache->capacity) || (cache->max_cost && cache->cost > cache->max_cost);
+}
+
+/*
+    cache_create
+    Create a new, empty, cache
+    @param  CachePolicy                     Replacement policy
+    @param  size_t                          Maximum number of items, 0 for no limit
+    @param  size_t                          Maximum total cost of the items, 0 for no limit
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return Cache*                          Pointer to the new cache, NULL if the allocation failed
+*/
+Cache* cache_create(CachePolicy policy, size_t capacity, size_t max_cost, size_t (*hash)(void*), bool (*equal)(void*, void*)){
+    Cache* cache = (Cache*)malloc(sizeof(Cache));
+
+    if(!cache){
+        return NULL;
+    }
+
+    cache->index = hashindex_create(hash, equal);
+
+    if(!cache->index){
+        free(cache);
+        return NULL;
+    }
+
+    cache->policy = policy;
+    cache->list.head = NULL;
+    cache->list.tail = NULL;
+    cache->list.size = 0;
+    cache->list.index = NULL;
+    cache->hand = NULL;
+    cache->capacity = capacity;
+    cache->max_cost = max_cost;
+    cache->cost = 0;
+    cache->evict = NULL;
+    cache->evict_context = NULL;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+
+    return cache;
+}
+
+/*
+    cache_destroy
+    Destroy a cache. The eviction callback is called for every item left.
+    @param  Cache*  Pointer to the cache
+    @return void
+*/
+void cache_destroy(Cache* cache){
+    DLLNode* current = cache->list.head;
+    DLLNode* next = NULL;
+
+    while(current){
+        CacheEntry* entry = (CacheEntry*)current->data;
+        next = current->next;
+
+        if(cache->evict){
+            cache->evict(entry->key, entry->value, cache->evict_context);
+        }
+
+        free(entry);
+        current = next;
+    }
+
+    hashindex_destroy(cache->index);
+    free(cache);
+}
+
+/*
+    cache_set_evict_callback
+    Set the function called with the key and value of every item dropped by the cache
+    @param  Cache*                  Pointer to the cache
+    @param  CacheEvictFunction      Eviction callback, NULL for none
+    @param  void*                   Context given to the callback
+    @return void
+*/
+void cache_set_evict_callback(Cache* cache, CacheEvictFunction evict, void* context){
+    cache->evict = evict;
+    cache->evict_context = context;
+}
+
+/*
+    cache_get
+    Get the value of a key, and mark the key as used
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key to be searched
+    @param  void**  If not NULL, receives the value of the key
+    @return bool    true on a hit, false on a miss
+*/
+bool cache_get(Cache* cache, void* key, void** value){
+    HashIndexEntry* slot = hashindex_find(cache->index, key);
+
+    if(!slot){
+        cache->misses++;
+        return false;
+    }
+
+    CacheEntry* entry = (CacheEntry*)slot->node;
+    cache_use(cache, entry);
+    cache->hits++;
+
+    if(value){
+        *value = entry->value;
+    }
+
+    return true;
+}
+
+/*
+    cache_put
+    Insert a key, or replace its item, then evict items until the cache is within its limits. A replaced item keeps the new key pointer and value; the old key pointer
+    and the old value, when they differ from the new ones, are given to the eviction callback, NULL for the one that does not differ.
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @param  void*   Value of the item
+    @param  size_t  Cost of the item
+    @return bool    true if the operation was successful, false if the allocation failed or `cost` exceeds `max_cost`
+*/
+bool cache_put(Cache* cache, void* key, void* value, size_t cost){
+    if(cache->max_cost && cost > cache->max_cost){
+        return false;
+    }
+
+    HashIndexEntry* slot = hashindex_find(cache->index, key);
+    CacheEntry* entry = NULL;
+
+    if(slot){
+        entry = (CacheEntry*)slot->node;
+
+        //  The item keeps the new key and value: the callback receives whichever of the old ones the cache no longer holds
+        void* old_key = entry->key != key ? entry->key : NULL;
+        void* old_value = entry->value != value ? entry->value : NULL;
+
+        if(cache->evict && (old_key || old_value)){
+            cache->evict(old_key, old_value, cache->evict_context);
+        }
+
+        slot->data = key;
+        entry->key = key;
+        entry->value = value;
+        cache->cost += cost - entry->cost;
+        entry->cost = cost;
+        cache_use(cache, entry);
+    }   else{
+            entry = (CacheEntry*)malloc(sizeof(CacheEntry));
+
+            if(!entry){
+                return false;
+            }
+
+            //  Make room first, so that the new item cannot be its own victim
+            while(((cache->capacity && cache->list.size + 1 > cache->capacity) || (cache->max_cost && cache->cost + cost > cache->max_cost)) && cache_evict(cache));
+
+            if(!hashindex_insert(cache->index, key, entry, NULL)){
+                free(entry);
+                return false;
+            }
+
+            entry->node.data = entry;
+            entry->key = key;
+            entry->value = value;
+            entry->cost = cost;
+            entry->referenced = false;
+            cache->cost += cost;
+
+            if(cache->policy == CACHE_CLOCK){
+                cache_link_behind_hand(cache, &entry->node);
+            }   else{
+                    cache_link_front(cache, &entry->node);
+            }
+    }
+
+    //  A replaced value may have raised the total cost
+    while(cache_over_limit(cache) && cache_evict(cache));
+
+    return true;
+}
+
+/*
+    cache_touch
+    Mark a key as used, without reading its value or counting a hit
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @return bool    true if the key is in the cache, false otherwise
+*/
+bool cache_touch(Cache* cache, void* key){
+    HashIndexEntry* slot = hashindex_find(cache->index, key);
+
+    if(!slot){
+        return false;
+    }
+
+    cache_use(cache, (CacheEntry*)slot->node);
+
+    return true;
+}
+
+/*
+    cache_remove
+    Remove a key from the cache. The eviction callback is not called: the value is returned instead.
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @param  void**  If not NULL, receives the value of the key
+    @return bool    true if the key was in the cache, false otherwise
+*/
+bool cache_remove(Cache* cache, void* key, void** value){
+    HashIndexEntry* slot = hashindex_find(cache->index, key);
+
+    if(!slot){
+        return false;
+    }
+
+    CacheEntry dropped = cache_drop(cache, slot);
+
+    if(value){
+        *value = dropped.value;
+    }
+
+    return true;
+}
+
+/*
+    cache_evict
+    Evict one item, chosen by the replacement policy
+    @param  Cache*  Pointer to the cache
+    @return bool    true if an item was evicted, false if the cache is empty
+*/
+bool cache_evict(Cache* cache){
+    DLLNode* victim = NULL;
+
+    if(!cache->list.head){
+        return false;
+    }
+
+    if(cache->policy == CACHE_CLOCK){
+        //  Give a second chance to the referenced items; after a full turn every bit is clear
+        while(((CacheEntry*)cache->hand->data)->referenced){
+            ((CacheEntry*)cache->hand->data)->referenced = false;
+            cache->hand = cache->hand->next ? cache->hand->next : cache->list.head;
+        }
+        victim = cache->hand;
+    }   else{
+            victim = cache->list.tail;
+    }
+
+    CacheEntry* entry = (CacheEntry*)victim->data;
+    CacheEntry dropped = cache_drop(cache, hashindex_find_node(cache->index, entry->key, entry));
+    cache->evictions++;
+
+    if(cache->evict){
+        cache->evict(dropped.key, dropped.value, cache->evict_context);
+    }
+
+    return true;
+}
+
+/*
+    cache_size
+    Get the number of items of a cache
+    @param  Cache*  Pointer to the cache
+    @return size_t  Number of items
+*/
+size_t cache_size(Cache* cache){
+    return cache->list.size;
+}
+
+/*
+    cache_cost
+    Get the total cost of the items of a cache
+    @param  Cache*  Pointer to the cache
+    @return size_t  Total cost of the items
+*/
+size_t cache_cost(Cache* cache){
+    return cache->cost;
+}
+
+/*
+    cache_hit_rate
+    Get the fraction of the calls to `cache_get` that were hits
+    @param  Cache*  Pointer to the cache
+    @return double  Hit rate, between 0 and 1
+*/
+double cache_hit_rate(Cache* cache){
+    size_t lookups = cache->hits + cache->misses;
+    return lookups ? (double)cache->hits / lookups : 0.0;
+}
+
+/*
+    sharded_cache_shard
+    Get the shard of a key. The hash is mixed again, since the low bits already select the bucket inside the shard.
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key
+    @return CacheShard*     Pointer to the shard of the key
+*/
+static CacheShard* sharded_cache_shard(ShardedCache* cache, void* key){
+    size_t hash = cache->hash ? cache->hash(key) : hashindex_pointer_hash(key);
+    hash = (hash ^ (hash >> 31)) * 0x9E3779B97F4A7C15ULL;
+
+    return &cache->shards[(hash >> 32) % cache->nshards];
+}
+
+/*
+    sharded_cache_create
+    Create a new, empty, sharded cache. The limits are divided between the shards and add up to the limits of the cache, so there are at most as many shards as the limits.
+    @param  size_t                          Number of shards
+    @param  CachePolicy                     Replacement policy
+    @param  size_t                          Maximum number of items, 0 for no limit
+    @param  size_t                          Maximum total cost of the items, 0 for no limit
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return ShardedCache*                   Pointer to the new sharded cache, NULL if the allocation failed
+*/
+ShardedCache* sharded_cache_create(size_t nshards, CachePolicy policy, size_t capacity, size_t max_cost, size_t (*hash)(void*), bool (*equal)(void*, void*)){
+    //  Every shard gets a limit of at least 1, since a limit of 0 would mean no limit
+    if(capacity && nshards > capacity){
+        nshards = capacity;
+    }
+
+    if(max_cost && nshards > max_cost){
+        nshards = max_cost;
+    }
+
+    if(nshards == 0){
+        nshards = 1;
+    }
+
+    ShardedCache* cache = (ShardedCache*)malloc(sizeof(ShardedCache));
+
+    if(!cache){
+        return NULL;
+    }
+
+    cache->shards = (CacheShard*)malloc(nshards * sizeof(CacheShard));
+
+    if(!cache->shards){
+        free(cache);
+        return NULL;
+    }
+
+    cache->nshards = nshards;
+    cache->hash = hash;
+
+    //  The first shards take the remainders of the limits, so the limits of the shards add up to the limits of the cache
+    for(size_t i = 0; i < nshards; i++){
+        size_t shard_capacity = capacity / nshards + (i < capacity % nshards ? 1 : 0);
+        size_t shard_max_cost = max_cost / nshards + (i < max_cost % nshards ? 1 : 0);
+
+        cache->shards[i].cache = cache_create(policy, shard_capacity, shard_max_cost, hash, equal);
+
+        if(!cache->shards[i].cache){
+            cache->nshards = i;
+            sharded_cache_destroy(cache);
+            return NULL;
+        }
+
+        pthread_mutex_init(&cache->shards[i].lock, NULL);
+    }
+
+    return cache;
+}
+
+/*
+    sharded_cache_destroy
+    Destroy a sharded cache. The eviction callback is called for every item left.
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return void
+*/
+void sharded_cache_destroy(ShardedCache* cache){
+    for(size_t i = 0; i < cache->nshards; i++){
+        cache_destroy(cache->shards[i].cache);
+        pthread_mutex_destroy(&cache->shards[i].lock);
+    }
+
+    free(cache->shards);
+    free(cache);
+}
+
+/*
+    sharded_cache_set_evict_callback
+    Set the eviction callback of every shard
+    @param  ShardedCache*           Pointer to the sharded cache
+    @param  CacheEvictFunction      Eviction callback, NULL for none
+    @param  void*                   Context given to the callback
+    @return void
+*/
+void sharded_cache_set_evict_callback(ShardedCache* cache, CacheEvictFunction evict, void* context){
+    for(size_t i = 0; i < cache->nshards; i++){
+        pthread_mutex_lock(&cache->shards[i].lock);
+        cache_set_evict_callback(cache->shards[i].cache, evict, context);
+        pthread_mutex_unlock(&cache->shards[i].lock);
+    }
+}
+
+/*
+    sharded_cache_get
+    Get the value of a key, see `cache_get`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key to be searched
+    @param  void**          If not NULL, receives the value of the key
+    @return bool            true on a hit, false on a miss
+*/
+bool sharded_cache_get(ShardedCache* cache, void* key, void** value){
+    CacheShard* shard = sharded_cache_shard(cache, key);
+
+    pthread_mutex_lock(&shard->lock);
+    bool hit = cache_get(shard->cache, key, value);
+    pthread_mutex_unlock(&shard->lock);
+
+    return hit;
+}
+
+/*
+    sharded_cache_put
+    Insert a key, or replace its value, see `cache_put`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @param  void*           Value of the item
+    @param  size_t          Cost of the item
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool sharded_cache_put(ShardedCache* cache, void* key, void* value, size_t cost){
+    CacheShard* shard = sharded_cache_shard(cache, key);
+
+    pthread_mutex_lock(&shard->lock);
+    bool done = cache_put(shard->cache, key, value, cost);
+    pthread_mutex_unlock(&shard->lock);
+
+    return done;
+}
+
+/*
+    sharded_cache_touch
+    Mark a key as used, see `cache_touch`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @return bool            true if the key is in the cache, false otherwise
+*/
+bool sharded_cache_touch(ShardedCache* cache, void* key){
+    CacheShard* shard = sharded_cache_shard(cache, key);
+
+    pthread_mutex_lock(&shard->lock);
+    bool found = cache_touch(shard->cache, key);
+    pthread_mutex_unlock(&shard->lock);
+
+    return found;
+}
+
+/*
+    sharded_cache_remove
+    Remove a key, see `cache_remove`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @param  void**          If not NULL, receives the value of the key
+    @return bool            true if the key was in the cache, false otherwise
+*/
+bool sharded_cache_remove(ShardedCache* cache, void* key, void** value){
+    CacheShard* shard = sharded_cache_shard(cache, key);
+
+    pthread_mutex_lock(&shard->lock);
+    bool found = cache_remove(shard->cache, key, value);
+    pthread_mutex_unlock(&shard->lock);
+
+    return found;
+}
+
+/*
+    sharded_cache_size
+    Get the number of items of a sharded cache
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return size_t          Number of items
+*/
+size_t sharded_cache_size(ShardedCache* cache){
+    size_t size = 0;
+
+    for(size_t i = 0; i < cache->nshards; i++){
+        pthread_mutex_lock(&cache->shards[i].lock);
+        size += cache_size(cache->shards[i].cache);
+        pthread_mutex_unlock(&cache->shards[i].lock);
+    }
+
+    return size;
+}
+
+/*
+    sharded_cache_hit_rate
+    Get the fraction of the calls to `sharded_cache_get` that were hits
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return double          Hit rate, between 0 and 1
+*/
+double sharded_cache_hit_rate(ShardedCache* cache){
+    size_t hits = 0;
+    size_t lookups = 0;
+
+    for(size_t i = 0; i < cache->nshards; i++){
+        pthread_mutex_lock(&cache->shards[i].lock);
+        hits += cache->shards[i].cache->hits;
+        lookups += cache->shards[i].cache->hits + cache->shards[i].cache->misses;
+        pthread_mutex_unlock(&cache->shards[i].lock);
+    }
+
+    return lookups ? (double)hits / lookups : 0.0;
+}
@@ -0,0 +1,330 @@
+#ifndef DSL_CACHE_H
+#define DSL_CACHE_H
+/*
+    Interface for the implementation of the LRU and CLOCK caches.
+
+    A `Cache` maps keys to values and keeps a bounded number of items, evicting the ones that are least likely to be used again.
+    Its items are the nodes of a `DoublyLinkedList` (see `dsl_lists.h`), and a `HashIndex` (see `dsl_hashindex.h`) maps each key to its node, so get, put, touch and evict take O(1) expected time.
+
+    Two replacement policies are available:
+    - `CACHE_LRU`: the list is kept in order of use, the most recently used item first; a hit moves its node to the front, and the last node is evicted;
+    - `CACHE_CLOCK`: a hit only sets the `referenced` bit of the item; to evict, a hand sweeps the list circularly, clearing the bits it finds set, and evicts the first item whose bit is clear.
+      CLOCK approximates LRU without relinking on hits.
+
+    The size of a cache can be limited by the number of items (`capacity`), by the sum of the costs given to `cache_put` (`max_cost`, e.g. a size in bytes), or both; a limit of 0 means no limit.
+    The eviction callback is called with the key and value of every item the cache drops on its own: evicted items, and the items left when the cache is destroyed.
+    When `cache_put` replaces an item, the item keeps the new key and value, and the callback receives the old key and the old value that the cache no longer holds, NULL for one still held.
+
+    Keys are compared by pointer by default. A `hash` and `equal` pair can be given instead to compare the pointed keys.
+
+    A `Cache` is not thread safe. A `ShardedCache` splits the keys over several caches, each protected by its own mutex, so that threads accessing different shards do not contend on a single lock.
+
+    The current `Cache` methods are:
+    - `cache_create`: Create a new cache
+    - `cache_destroy`: Destroy a cache
+    - `cache_set_evict_callback`: Set the eviction callback of a cache
+    - `cache_get`: Get the value of a key
+    - `cache_put`: Insert or replace the value of a key
+    - `cache_touch`: Mark a key as used
+    - `cache_remove`: Remove a key
+    - `cache_evict`: Evict one item
+    - `cache_size`: Get the number of items of a cache
+    - `cache_cost`: Get the total cost of the items of a cache
+    - `cache_hit_rate`: Get the fraction of hits of `cache_get`
+
+    The current `ShardedCache` methods are:
+    - `sharded_cache_create`: Create a new sharded cache
+    - `sharded_cache_destroy`: Destroy a sharded cache
+    - `sharded_cache_set_evict_callback`: Set the eviction callback of every shard
+    - `sharded_cache_get`, `sharded_cache_put`, `sharded_cache_touch`, `sharded_cache_remove`: Same as the `Cache` methods, on the shard of the key
+    - `sharded_cache_size`: Get the number of items of a sharded cache
+    - `sharded_cache_hit_rate`: Get the fraction of hits of `sharded_cache_get`
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "dsl_lists.h"
+#include "dsl_hashindex.h"
+
+/*
+    Replacement policy of a cache
+*/
+typedef enum CachePolicy {
+    CACHE_LRU,
+    CACHE_CLOCK
+} CachePolicy;
+
+/*
+    Eviction callback of a cache
+    - `key` and `value` are the key and value of the dropped item; either may be NULL when `cache_put` replaces an item
+    - `context` is the pointer given to `cache_set_evict_callback`
+*/
+typedef void (*CacheEvictFunction)(void* key, void* value, void* context);
+
+/*
+    Item of a cache
+    - `node` is the node of the item in the list of the cache; its `data` points to the item
+    - `key` is the key of the item
+    - `value` is the value of the item
+    - `cost` is the cost of the item, counted against `max_cost`
+    - `referenced` is the reference bit of the CLOCK policy
+*/
+typedef struct CacheEntry {
+    DLLNode node;
+    void *key;
+    void *value;
+    size_t cost;
+    bool referenced;
+} CacheEntry;
+
+/*
+    Cache
+    - `policy` is the replacement policy
+    - `list` is the list of the items: in order of use for `CACHE_LRU`, in order of the sweep for `CACHE_CLOCK`
+    - `hand` is the next node examined by the CLOCK hand
+    - `index` maps the keys to the items
+    - `capacity` is the maximum number of items, 0 for no limit
+    - `max_cost` is the maximum total cost of the items, 0 for no limit
+    - `cost` is the total cost of the items
+    - `evict` and `evict_context` are the eviction callback and its context
+    - `hits`, `misses` and `evictions` count the outcomes of `cache_get` and the evicted items
+*/
+typedef struct Cache {
+    CachePolicy policy;
+    DoublyLinkedList list;
+    DLLNode *hand;
+    HashIndex *index;
+    size_t capacity;
+    size_t max_cost;
+    size_t cost;
+    CacheEvictFunction evict;
+    void *evict_context;
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+} Cache;
+
+/*
+    Shard of a sharded cache
+    - `lock` protects `cache`
+    - `cache` is the cache of the shard
+*/
+typedef struct CacheShard {
+    pthread_mutex_t lock;
+    Cache *cache;
+} CacheShard;
+
+/*
+    Sharded cache
+    - `nshards` is the number of shards
+    - `shards` is the array of shards
+    - `hash` is the hash function of the keys, NULL to hash the pointers
+*/
+typedef struct ShardedCache {
+    size_t nshards;
+    CacheShard *shards;
+    size_t (*hash)(void*);
+} ShardedCache;
+
+//  Cache methods
+
+/*
+    cache_create
+    Create a new, empty, cache
+    @param  CachePolicy                     Replacement policy
+    @param  size_t                          Maximum number of items, 0 for no limit
+    @param  size_t                          Maximum total cost of the items, 0 for no limit
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return Cache*                          Pointer to the new cache, NULL if the allocation failed
+*/
+Cache* cache_create(CachePolicy policy, size_t capacity, size_t max_cost, size_t (*hash)(void*), bool (*equal)(void*, void*));
+
+/*
+    cache_destroy
+    Destroy a cache. The eviction callback is called for every item left.
+    @param  Cache*  Pointer to the cache
+    @return void
+*/
+void cache_destroy(Cache* cache);
+
+/*
+    cache_set_evict_callback
+    Set the function called with the key and value of every item dropped by the cache
+    @param  Cache*                  Pointer to the cache
+    @param  CacheEvictFunction      Eviction callback, NULL for none
+    @param  void*                   Context given to the callback
+    @return void
+*/
+void cache_set_evict_callback(Cache* cache, CacheEvictFunction evict, void* context);
+
+/*
+    cache_get
+    Get the value of a key, and mark the key as used
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key to be searched
+    @param  void**  If not NULL, receives the value of the key
+    @return bool    true on a hit, false on a miss
+*/
+bool cache_get(Cache* cache, void* key, void** value);
+
+/*
+    cache_put
+    Insert a key, or replace its item, then evict items until the cache is within its limits. A replaced item keeps the new key pointer and value; the old key pointer
+    and the old value, when they differ from the new ones, are given to the eviction callback, NULL for the one that does not differ.
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @param  void*   Value of the item
+    @param  size_t  Cost of the item
+    @return bool    true if the operation was successful, false if the allocation failed or `cost` exceeds `max_cost`
+*/
+bool cache_put(Cache* cache, void* key, void* value, size_t cost);
+
+/*
+    cache_touch
+    Mark a key as used, without reading its value or counting a hit
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @return bool    true if the key is in the cache, false otherwise
+*/
+bool cache_touch(Cache* cache, void* key);
+
+/*
+    cache_remove
+    Remove a key from the cache. The eviction callback is not called: the value is returned instead.
+    @param  Cache*  Pointer to the cache
+    @param  void*   Key of the item
+    @param  void**  If not NULL, receives the value of the key
+    @return bool    true if the key was in the cache, false otherwise
+*/
+bool cache_remove(Cache* cache, void* key, void** value);
+
+/*
+    cache_evict
+    Evict one item, chosen by the replacement policy
+    @param  Cache*  Pointer to the cache
+    @return bool    true if an item was evicted, false if the cache is empty
+*/
+bool cache_evict(Cache* cache);
+
+/*
+    cache_size
+    Get the number of items of a cache
+    @param  Cache*  Pointer to the cache
+    @return size_t  Number of items
+*/
+size_t cache_size(Cache* cache);
+
+/*
+    cache_cost
+    Get the total cost of the items of a cache
+    @param  Cache*  Pointer to the cache
+    @return size_t  Total cost of the items
+*/
+size_t cache_cost(Cache* cache);
+
+/*
+    cache_hit_rate
+    Get the fraction of the calls to `cache_get` that were hits
+    @param  Cache*  Pointer to the cache
+    @return double  Hit rate, between 0 and 1
+*/
+double cache_hit_rate(Cache* cache);
+
+//  Sharded Cache methods
+
+/*
+    sharded_cache_create
+    Create a new, empty, sharded cache. The limits are divided between the shards and add up to the limits of the cache, so there are at most as many shards as the limits.
+    @param  size_t                          Number of shards
+    @param  CachePolicy                     Replacement policy
+    @param  size_t                          Maximum number of items, 0 for no limit
+    @param  size_t                          Maximum total cost of the items, 0 for no limit
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return ShardedCache*                   Pointer to the new sharded cache, NULL if the allocation failed
+*/
+ShardedCache* sharded_cache_create(size_t nshards, CachePolicy policy, size_t capacity, size_t max_cost, size_t (*hash)(void*), bool (*equal)(void*, void*));
+
+/*
+    sharded_cache_destroy
+    Destroy a sharded cache. The eviction callback is called for every item left.
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return void
+*/
+void sharded_cache_destroy(ShardedCache* cache);
+
+/*
+    sharded_cache_set_evict_callback
+    Set the eviction callback of every shard. The callback runs with the lock of the shard held.
+    @param  ShardedCache*           Pointer to the sharded cache
+    @param  CacheEvictFunction      Eviction callback, NULL for none
+    @param  void*                   Context given to the callback
+    @return void
+*/
+void sharded_cache_set_evict_callback(ShardedCache* cache, CacheEvictFunction evict, void* context);
+
+/*
+    sharded_cache_get
+    Get the value of a key, see `cache_get`.
+    Another thread may evict the item as soon as the call returns: values that are freed by the eviction callback need their own reference counting.
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key to be searched
+    @param  void**          If not NULL, receives the value of the key
+    @return bool            true on a hit, false on a miss
+*/
+bool sharded_cache_get(ShardedCache* cache, void* key, void** value);
+
+/*
+    sharded_cache_put
+    Insert a key, or replace its value, see `cache_put`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @param  void*           Value of the item
+    @param  size_t          Cost of the item
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool sharded_cache_put(ShardedCache* cache, void* key, void* value, size_t cost);
+
+/*
+    sharded_cache_touch
+    Mark a key as used, see `cache_touch`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @return bool            true if the key is in the cache, false otherwise
+*/
+bool sharded_cache_touch(ShardedCache* cache, void* key);
+
+/*
+    sharded_cache_remove
+    Remove a key, see `cache_remove`
+    @param  ShardedCache*   Pointer to the sharded cache
+    @param  void*           Key of the item
+    @param  void**          If not NULL, receives the value of the key
+    @return bool            true if the key was in the cache, false otherwise
+*/
+bool sharded_cache_remove(ShardedCache* cache, void* key, void** value);
+
+/*
+    sharded_cache_size
+    Get the number of items of a sharded cache
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return size_t          Number of items
+*/
+size_t sharded_cache_size(ShardedCache* cache);
+
+/*
+    sharded_cache_hit_rate
+    Get the fraction of the calls to `sharded_cache_get` that were hits
+    @param  ShardedCache*   Pointer to the sharded cache
+    @return double          Hit rate, between 0 and 1
+*/
+double sharded_cache_hit_rate(ShardedCache* cache);
+
+#endif // DSL_CACHE_H
@@ -0,0 +1,638 @@
+/*
+    Implementation of the compact lists.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "dsl_compactlist.h"
+
+/*
+    compactlist_slot_size
+    Get the size of a slot: an element, or a data pointer
+    @param  CompactList*    Pointer to the list
+    @return size_t          Size of a slot
+*/
+static size_t compactlist_slot_size(CompactList* list){
+    return list->element_size ? list->element_size : sizeof(void*);
+}
+
+/*
+    compactlist_allocate
+    Take a free slot, reusing the slot of a removed element first, and store an element in it
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element to copy
+    @return CompactIndex    Index of the slot, `COMPACT_NIL` if the pool could not grow
+*/
+static CompactIndex compactlist_allocate(CompactList* list, void* data){
+    CompactIndex index = list->free_slots;
+
+    if(index != COMPACT_NIL){
+        list->free_slots = list->links[index];
+    }   else{
+            if(list->used == list->capacity){
+                size_t capacity = list->capacity ? 2 * (size_t)list->capacity : 16;
+
+                if(capacity > COMPACT_MAX_CAPACITY){
+                    capacity = COMPACT_MAX_CAPACITY;
+                }
+
+                if(capacity == list->capacity || !compactlist_reserve(list, capacity)){
+                    return COMPACT_NIL;
+                }
+            }
+
+            index = list->used++;
+    }
+
+    if(list->element_size){
+        memcpy(list->slots + (size_t)index * list->element_size, data, list->element_size);
+    }   else{
+            ((void**)list->slots)[index] = data;
+    }
+
+    return index;
+}
+
+/*
+    compactlist_follow
+    Get the element after `current` in a traversal coming from `previous`
+    @param  CompactList*    Pointer to the list
+    @param  CompactIndex    Index of the previous element, `COMPACT_NIL` at the head
+    @param  CompactIndex    Index of the current element
+    @return CompactIndex    Index of the next element, `COMPACT_NIL` at the tail
+*/
+static inline CompactIndex compactlist_follow(CompactList* list, CompactIndex previous, CompactIndex current){
+    if(list->mode == COMPACT_XOR){
+        return list->links[current] ^ previous;
+    }
+
+    return list->links[current];
+}
+
+/*
+    compactlist_equal
+    Check whether an element equals the given data: the same pointer, or the same bytes if the list copies its elements
+    @param  CompactList*    Pointer to the list
+    @param  CompactIndex    Index of the element
+    @param  void*           Pointer to the data, or to the element
+    @return bool            true if they are equal
+*/
+static bool compactlist_equal(CompactList* list, CompactIndex index, void* data){
+    if(list->element_size){
+        return memcmp(list->slots + (size_t)index * list->element_size, data, list->element_size) == 0;
+    }
+
+    return ((void**)list->slots)[index] == data;
+}
+
+/*
+    compactlist_link
+    Link the elements of an array of indices, in order, as the whole list
+    @param  CompactList*    Pointer to the list
+    @param  CompactIndex*   Indices of the elements, `list->size` of them
+    @return void
+*/
+static void compactlist_link(CompactList* list, CompactIndex* order){
+    size_t n = list->size;
+
+    for(size_t i = 0; i < n; i++){
+        CompactIndex previous = i > 0 ? order[i - 1] : COMPACT_NIL;
+        CompactIndex next = i + 1 < n ? order[i + 1] : COMPACT_NIL;
+
+        if(list->mode == COMPACT_XOR){
+            list->links[order[i]] = previous ^ next;
+        }   else{
+                list->links[order[i]] = next;
+
+                if(list->previous){
+                    list->previous[order[i]] = previous;
+                }
+        }
+    }
+
+    list->head = n > 0 ? order[0] : COMPACT_NIL;
+    list->tail = n > 0 ? order[n - 1] : COMPACT_NIL;
+}
+
+/*
+    compactlist_merge_sort
+    Sort an array of indices by the data of their elements, with a stable top-down merge sort
+    @param  CompactList*            Pointer to the list
+    @param  CompactIndex*           Array of indices to sort
+    @param  CompactIndex*           Scratch array of the same size
+    @param  size_t                  Number of indices
+    @param  int (*)(void*, void*)   Comparison function
+    @return void
+*/
+static void compactlist_merge_sort(CompactList* list, CompactIndex* order, CompactIndex* scratch, size_t n, int (*compare)(void*, void*)){
+    //  Short ranges are sorted by insertion
+    if(n <= 16){
+        for(size_t i = 1; i < n; i++){
+            CompactIndex index = order[i];
+            void* data = compactlist_data(list, index);
+            size_t j = i;
+
+            while(j > 0 && compare(compactlist_data(list, order[j - 1]), data) > 0){
+                order[j] = order[j - 1];
+                j--;
+            }
+
+            order[j] = index;
+        }
+
+        return;
+    }
+
+    size_t half = n / 2;
+
+    compactlist_merge_sort(list, order, scratch, half, compare);
+    compactlist_merge_sort(list, order + half, scratch, n - half, compare);
+
+    //  Already in order: nothing to merge
+    if(compare(compactlist_data(list, order[half - 1]), compactlist_data(list, order[half])) <= 0){
+        return;
+    }
+
+    memcpy(scratch, order, half * sizeof(CompactIndex));
+
+    size_t left = 0;
+    size_t right = half;
+    size_t out = 0;
+
+    while(left < half && right < n){
+        //  Ties are taken from the left half, which keeps the sort stable
+        if(compare(compactlist_data(list, order[right]), compactlist_data(list, scratch[left])) < 0){
+            order[out++] = order[right++];
+        }   else{
+                order[out++] = scratch[left++];
+        }
+    }
+
+    while(left < half){
+        order[out++] = scratch[left++];
+    }
+}
+
+/*
+    compactlist_create
+    Create a new, empty, compact list
+    @param  CompactListMode     Linking of the list
+    @param  size_t              Size of the elements copied into the slots, 0 to store data pointers
+    @return CompactList*        Pointer to the new list, NULL if the allocation failed
+*/
+CompactList* compactlist_create(CompactListMode mode, size_t element_size){
+    CompactList* list = (CompactList*)malloc(sizeof(CompactList));
+
+    if(!list){
+        return NULL;
+    }
+
+    list->mode = mode;
+    list->element_size = element_size;
+    list->slots = NULL;
+    list->links = NULL;
+    list->previous = NULL;
+    list->capacity = 0;
+    list->used = 0;
+    list->free_slots = COMPACT_NIL;
+    list->head = COMPACT_NIL;
+    list->tail = COMPACT_NIL;
+    list->size = 0;
+
+    return list;
+}
+
+/*
+    compactlist_destroy
+    Destroy a compact list and its pool
+    @param  CompactList*    Pointer to the list
+    @return void
+*/
+void compactlist_destroy(CompactList* list){
+    free(list->slots);
+    free(list->links);
+    free(list->previous);
+    free(list);
+}
+
+/*
+    compactlist_reserve
+    Grow the pool of a compact list to hold at least a number of elements
+    @param  CompactList*    Pointer to the list
+    @param  size_t          Number of elements
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool compactlist_reserve(CompactList* list, size_t capacity){
+    if(capacity <= list->capacity){
+        return true;
+    }
+
+    if(capacity > COMPACT_MAX_CAPACITY || capacity > SIZE_MAX / compactlist_slot_size(list)){
+        return false;
+    }
+
+    //  Each array keeps its old contents if a later one cannot grow, so a failure leaves the list as it was
+    unsigned char* slots = (unsigned char*)realloc(list->slots, capacity * compactlist_slot_size(list));
+
+    if(!slots){
+        return false;
+    }
+
+    list->slots = slots;
+
+    CompactIndex* links = (CompactIndex*)realloc(list->links, capacity * sizeof(CompactIndex));
+
+    if(!links){
+        return false;
+    }
+
+    list->links = links;
+
+    if(list->mode == COMPACT_DOUBLY){
+        CompactIndex* previous = (CompactIndex*)realloc(list->previous, capacity * sizeof(CompactIndex));
+
+        if(!previous){
+            return false;
+        }
+
+        list->previous = previous;
+    }
+
+    list->capacity = (CompactIndex)capacity;
+
+    return true;
+}
+
+/*
+    compactlist_insert
+    Insert a new element at the beginning of a compact list
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element to copy
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool compactlist_insert(CompactList* list, void* data){
+    CompactIndex index = compactlist_allocate(list, data);
+
+    if(index == COMPACT_NIL){
+        return false;
+    }
+
+    CompactIndex head = list->head;
+
+    switch(list->mode){
+        case COMPACT_SINGLY:
+            list->links[index] = head;
+            break;
+        case COMPACT_DOUBLY:
+            list->links[index] = head;
+            list->previous[index] = COMPACT_NIL;
+
+            if(head != COMPACT_NIL){
+                list->previous[head] = index;
+            }
+            break;
+        case COMPACT_XOR:
+            list->links[index] = COMPACT_NIL ^ head;
+
+            //  The previous element of the old head was none, it is now the new element
+            if(head != COMPACT_NIL){
+                list->links[head] ^= COMPACT_NIL ^ index;
+            }
+            break;
+    }
+
+    list->head = index;
+
+    if(list->tail == COMPACT_NIL){
+        list->tail = index;
+    }
+
+    list->size++;
+
+    return true;
+}
+
+/*
+    compactlist_append
+    Append a new element at the end of a compact list
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element to copy
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool compactlist_append(CompactList* list, void* data){
+    CompactIndex index = compactlist_allocate(list, data);
+
+    if(index == COMPACT_NIL){
+        return false;
+    }
+
+    CompactIndex tail = list->tail;
+
+    switch(list->mode){
+        case COMPACT_SINGLY:
+            list->links[index] = COMPACT_NIL;
+
+            if(tail != COMPACT_NIL){
+                list->links[tail] = index;
+            }
+            break;
+        case COMPACT_DOUBLY:
+            list->links[index] = COMPACT_NIL;
+            list->previous[index] = tail;
+
+            if(tail != COMPACT_NIL){
+                list->links[tail] = index;
+            }
+            break;
+        case COMPACT_XOR:
+            list->links[index] = tail ^ COMPACT_NIL;
+
+            //  The next element of the old tail was none, it is now the new element
+            if(tail != COMPACT_NIL){
+                list->links[tail] ^= COMPACT_NIL ^ index;
+            }
+            break;
+    }
+
+    list->tail = index;
+
+    if(list->head == COMPACT_NIL){
+        list->head = index;
+    }
+
+    list->size++;
+
+    return true;
+}
+
+/*
+    compactlist_remove
+    Remove the first element of a compact list equal to the given one, and free its slot
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element
+    @return bool            true if an element was removed, false otherwise
+*/
+bool compactlist_remove(CompactList* list, void* data){
+    CompactIndex previous = COMPACT_NIL;
+    CompactIndex current = list->head;
+
+    while(current != COMPACT_NIL && !compactlist_equal(list, current, data)){
+        CompactIndex next = compactlist_follow(list, previous, current);
+        previous = current;
+        current = next;
+    }
+
+    if(current == COMPACT_NIL){
+        return false;
+    }
+
+    CompactIndex next = compactlist_follow(list, previous, current);
+
+    if(list->mode == COMPACT_XOR){
+        //  The neighbours now link to each other instead of the element
+        if(previous != COMPACT_NIL){
+            list->links[previous] ^= current ^ next;
+        }
+
+        if(next != COMPACT_NIL){
+            list->links[next] ^= current ^ previous;
+        }
+    }   else{
+            if(previous != COMPACT_NIL){
+                list->links[previous] = next;
+            }
+
+            if(list->previous && next != COMPACT_NIL){
+                list->previous[next] = previous;
+            }
+    }
+
+    if(list->head == current){
+        list->head = next;
+    }
+
+    if(list->tail == current){
+        list->tail = previous;
+    }
+
+    list->links[current] = list->free_slots;
+    list->free_slots = current;
+    list->size--;
+
+    return true;
+}
+
+/*
+    compactlist_search
+    Search for the first element of a compact list equal to the given one
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element
+    @return CompactIndex    Index of the element, `COMPACT_NIL` if it was not found
+*/
+CompactIndex compactlist_search(CompactList* list, void* data){
+    CompactCursor cursor = compactlist_begin(list);
+    CompactIndex index;
+
+    while((index = compactlist_next(list, &cursor)) != COMPACT_NIL){
+        if(compactlist_equal(list, index, data)){
+            return index;
+        }
+    }
+
+    return COMPACT_NIL;
+}
+
+/*
+    compactlist_sort
+    Sort a compact list with a stable merge sort over the indices of its elements, then relink them in one pass
+    @param  CompactList*            Pointer to the list
+    @param  int (*)(void*, void*)   Comparison function
+    @return bool                    true if the operation was successful, false if the allocation failed
+*/
+bool compactlist_sort(CompactList* list, int (*compare)(void*, void*)){
+    if(list->size < 2){
+        return true;
+    }
+
+    CompactIndex* order = (CompactIndex*)malloc(list->size * sizeof(CompactIndex));
+    CompactIndex* scratch = (CompactIndex*)malloc((list->size / 2 + 1) * sizeof(CompactIndex));
+
+    if(!order || !scratch){
+        free(order);
+        free(scratch);
+        return false;
+    }
+
+    CompactCursor cursor = compactlist_begin(list);
+    size_t n = 0;
+    CompactIndex index;
+
+    while((index = compactlist_next(list, &cursor)) != COMPACT_NIL){
+        order[n++] = index;
+    }
+
+    compactlist_merge_sort(list, order, scratch, n, compare);
+    compactlist_link(list, order);
+
+    free(order);
+    free(scratch);
+
+    return true;
+}
+
+/*
+    compactlist_compact
+    Move the elements of a compact list into a new pool, in traversal order
+    @param  CompactList*    Pointer to the list
+    @return bool            true if the operation was successful, false if the allocation failed
+*/
+bool compactlist_compact(CompactList* list){
+    size_t count = list->size;
+    size_t capacity = count ? count : 1;
+    size_t slot_size = compactlist_slot_size(list);
+
+    unsigned char* slots = (unsigned char*)malloc(capacity * slot_size);
+    CompactIndex* links = (CompactIndex*)malloc(capacity * sizeof(CompactIndex));
+    CompactIndex* previous = list->mode == COMPACT_DOUBLY ? (CompactIndex*)malloc(capacity * sizeof(CompactIndex)) : NULL;
+
+    if(!slots || !links || (list->mode == COMPACT_DOUBLY && !previous)){
+        free(slots);
+        free(links);
+        free(previous);
+        return false;
+    }
+
+    CompactCursor cursor = compactlist_begin(list);
+    CompactIndex index;
+    size_t i = 0;
+
+    while((index = compactlist_next(list, &cursor)) != COMPACT_NIL){
+        memcpy(slots + i * slot_size, list->slots + (size_t)index * slot_size, slot_size);
+        i++;
+    }
+
+    //  Element i follows element i - 1
+    for(i = 0; i < count; i++){
+        CompactIndex before = i > 0 ? (CompactIndex)(i - 1) : COMPACT_NIL;
+        CompactIndex after = i + 1 < count ? (CompactIndex)(i + 1) : COMPACT_NIL;
+
+        links[i] = list->mode == COMPACT_XOR ? before ^ after : after;
+
+        if(previous){
+            previous[i] = before;
+        }
+    }
+
+    free(list->slots);
+    free(list->links);
+    free(list->previous);
+
+    list->slots = slots;
+    list->links = links;
+    list->previous = previous;
+    list->capacity = (CompactIndex)capacity;
+    list->used = (CompactIndex)count;
+    list->free_slots = COMPACT_NIL;
+    list->head = count ? 0 : COMPACT_NIL;
+    list->tail = count ? (CompactIndex)(count - 1) : COMPACT_NIL;
+
+    return true;
+}
+
+/*
+    compactlist_locality
+    Get the average distance in bytes between the slots of consecutive elements of a compact list
+    @param  CompactList*    Pointer to the list
+    @return double          Average distance, 0 for fewer than two elements
+*/
+double compactlist_locality(CompactList* list){
+    if(list->size < 2){
+        return 0.0;
+    }
+
+    CompactCursor cursor = compactlist_begin(list);
+    CompactIndex last = compactlist_next(list, &cursor);
+    CompactIndex index;
+    double total = 0.0;
+
+    while((index = compactlist_next(list, &cursor)) != COMPACT_NIL){
+        total += index > last ? (double)(index - last) : (double)(last - index);
+        last = index;
+    }
+
+    return total * (double)compactlist_slot_size(list) / (double)(list->size - 1);
+}
+
+/*
+    compactlist_data
+    Get the data of an element
+    @param  CompactList*    Pointer to the list
+    @param  CompactIndex    Index of the element
+    @return void*           Pointer to the data
+*/
+void* compactlist_data(CompactList* list, CompactIndex index){
+    if(list->element_size){
+        return list->slots + (size_t)index * list->element_size;
+    }
+
+    return ((void**)list->slots)[index];
+}
+
+/*
+    compactlist_begin
+    Start a traversal of a compact list from its first element
+    @param  CompactList*    Pointer to the list
+    @return CompactCursor   The cursor
+*/
+CompactCursor compactlist_begin(CompactList* list){
+    CompactCursor cursor = {COMPACT_NIL, list->head};
+
+    return cursor;
+}
+
+/*
+    compactlist_next
+    Get the current element of a traversal and advance the cursor
+    @param  CompactList*    Pointer to the list
+    @param  CompactCursor*  Pointer to the cursor
+    @return CompactIndex    Index of the element, `COMPACT_NIL` at the end of the list
+*/
+CompactIndex compactlist_next(CompactList* list, CompactCursor* cursor){
+    CompactIndex current = cursor->current;
+
+    if(current != COMPACT_NIL){
+        cursor->current = compactlist_follow(list, cursor->previous, current);
+        cursor->previous = current;
+    }
+
+    return current;
+}
+
+/*
+    compactlist_len
+    Get the number of elements in a compact list
+    @param  CompactList*    Pointer to the list
+    @return size_t          Number of elements
+*/
+size_t compactlist_len(CompactList* list){
+    return list->size;
+}
+
+/*
+    compactlist_bytes
+    Get the memory used by a compact list and its pool
+    @param  CompactList*    Pointer to the list
+    @return size_t          Number of bytes
+*/
+size_t compactlist_bytes(CompactList* list){
+    size_t links = list->mode == COMPACT_DOUBLY ? 2 * sizeof(CompactIndex) : sizeof(CompactIndex);
+
+    return sizeof(CompactList) + (size_t)list->capacity * (compactlist_slot_size(list) + links);
+}
@@ -0,0 +1,229 @@
+#ifndef DSL_COMPACTLIST_H
+#define DSL_COMPACTLIST_H
+/*
+    Interface for the implementation of the compact lists.
+
+    A node of `dsl_lists.h` is allocated on its own and links with 64-bit pointers: a `DLLNode` takes 24 bytes, 32 with the allocator's header, to hold an 8-byte data pointer.
+    A `CompactList` keeps its elements in a pool of slots owned by the list, in parallel arrays, and links them with 32-bit slot indices:
+    - `COMPACT_SINGLY`: one `next` index per element, a singly linked list;
+    - `COMPACT_DOUBLY`: a `next` and a `previous` index per element, a doubly linked list;
+    - `COMPACT_XOR`: one index per element, the XOR of the `previous` and `next` indices: a doubly linked list, traversed from either end, with a single link.
+    An element costs its data pointer and 4 or 8 bytes of links (12 or 16 bytes instead of 32). With `element_size` > 0, the elements themselves are copied into the slots
+    instead of their pointers, e.g. 8 bytes per `int` in a singly linked or XOR-linked list.
+
+    Elements are identified by the index of their slot (`CompactIndex`), which stays the same while the element is in the list, including across sorts, until the list is compacted (`compactlist_compact`); the slots of removed elements are reused.
+    In XOR mode, the neighbours of an element can only be found from a neighbour, so the list is traversed with a `CompactCursor` that remembers the previous index.
+    A pointer to a copied element (`compactlist_data` with `element_size` > 0) is valid until the next insertion, which may move the pool.
+
+    The current `CompactList` methods are:
+    - `compactlist_create`: Create a new compact list
+    - `compactlist_destroy`: Destroy a compact list
+    - `compactlist_reserve`: Make room for a number of elements
+    - `compactlist_insert`: Insert a new element at the beginning of a compact list
+    - `compactlist_append`: Append a new element at the end of a compact list
+    - `compactlist_remove`: Remove an element from a compact list
+    - `compactlist_search`: Search for an element in a compact list
+    - `compactlist_sort`: Sort a compact list
+    - `compactlist_compact`: Renumber the elements of a compact list in traversal order
+    - `compactlist_locality`: Get the average distance between consecutive elements of a compact list
+    - `compactlist_data`: Get the data of an element
+    - `compactlist_begin`, `compactlist_next`: Traverse a compact list
+    - `compactlist_len`: Get the number of elements in a compact list
+    - `compactlist_bytes`: Get the memory used by a compact list
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//  Index of a slot of a compact list
+typedef uint32_t CompactIndex;
+
+//  Index of no slot: the link of the last element, and the result of a failed search
+#define COMPACT_NIL UINT32_MAX
+
+//  Largest number of slots of a compact list
+#define COMPACT_MAX_CAPACITY (UINT32_MAX - 1)
+
+/*
+    Linking of a compact list
+*/
+typedef enum CompactListMode {
+    COMPACT_SINGLY,
+    COMPACT_DOUBLY,
+    COMPACT_XOR
+} CompactListMode;
+
+/*
+    Compact list
+    - `mode` is the linking of the list
+    - `element_size` is the size of the elements copied into the slots, 0 if the slots hold data pointers
+    - `slots` is the array of the data pointers or elements
+    - `links` is the array of the `next` indices, or of the XOR of the `previous` and `next` indices; the free slots are chained through it
+    - `previous` is the array of the `previous` indices, NULL unless the list is `COMPACT_DOUBLY`
+    - `capacity` is the number of slots of the arrays, `used` the number of slots ever given to an element
+    - `free_slots` is the first free slot below `used`, `COMPACT_NIL` if there is none
+    - `head` and `tail` are the first and last elements, `COMPACT_NIL` if the list is empty
+    - `size` is the number of elements
+*/
+typedef struct CompactList {
+    CompactListMode mode;
+    size_t element_size;
+    unsigned char *slots;
+    CompactIndex *links;
+    CompactIndex *previous;
+    CompactIndex capacity;
+    CompactIndex used;
+    CompactIndex free_slots;
+    CompactIndex head;
+    CompactIndex tail;
+    size_t size;
+} CompactList;
+
+/*
+    Cursor of a traversal
+    - `previous` is the element before `current`, needed to follow the XOR links
+    - `current` is the next element returned, `COMPACT_NIL` at the end of the list
+*/
+typedef struct CompactCursor {
+    CompactIndex previous;
+    CompactIndex current;
+} CompactCursor;
+
+//  CompactList methods
+
+/*
+    compactlist_create
+    Create a new, empty, compact list
+    @param  CompactListMode     Linking of the list
+    @param  size_t              Size of the elements copied into the slots, 0 to store data pointers like the lists of `dsl_lists.h`
+    @return CompactList*        Pointer to the new list, NULL if the allocation failed
+*/
+CompactList* compactlist_create(CompactListMode mode, size_t element_size);
+
+/*
+    compactlist_destroy
+    Destroy a compact list and its pool. The data pointed to by the slots is not freed.
+    @param  CompactList*    Pointer to the list
+    @return void
+*/
+void compactlist_destroy(CompactList* list);
+
+/*
+    compactlist_reserve
+    Grow the pool of a compact list to hold at least a number of elements without another allocation
+    @param  CompactList*    Pointer to the list
+    @param  size_t          Number of elements
+    @return bool            true if the operation was successful, false if the allocation failed or the number exceeds `COMPACT_MAX_CAPACITY`
+*/
+bool compactlist_reserve(CompactList* list, size_t capacity);
+
+/*
+    compactlist_insert
+    Insert a new element at the beginning of a compact list
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element to copy if the list copies its elements
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool compactlist_insert(CompactList* list, void* data);
+
+/*
+    compactlist_append
+    Append a new element at the end of a compact list
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element to copy if the list copies its elements
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool compactlist_append(CompactList* list, void* data);
+
+/*
+    compactlist_remove
+    Remove the first element of a compact list equal to the given one: the same pointer, or the same bytes if the list copies its elements
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element
+    @return bool            true if an element was removed, false otherwise
+*/
+bool compactlist_remove(CompactList* list, void* data);
+
+/*
+    compactlist_search
+    Search for the first element of a compact list equal to the given one. See `compactlist_remove`.
+    @param  CompactList*    Pointer to the list
+    @param  void*           Pointer to the data, or to the element
+    @return CompactIndex    Index of the element, `COMPACT_NIL` if it was not found
+*/
+CompactIndex compactlist_search(CompactList* list, void* data);
+
+/*
+    compactlist_sort
+    Sort a compact list with a stable merge sort. Only the links change: every element keeps its index.
+    @param  CompactList*            Pointer to the list
+    @param  int (*)(void*, void*)   Comparison function, called with the results of `compactlist_data`, with the convention of `dsl_listsort.h`
+    @return bool                    true if the operation was successful, false if the allocation failed (the list is unchanged)
+*/
+bool compactlist_sort(CompactList* list, int (*compare)(void*, void*));
+
+/*
+    compactlist_compact
+    Move the elements of a compact list into a new pool, in traversal order, without free slots: after inserts, removals and sorts,
+    a traversal reads the arrays forward again. The element at position i of the list gets index i, so the indices held by the caller are no longer valid.
+    @param  CompactList*    Pointer to the list
+    @return bool            true if the operation was successful, false if the allocation failed (the list is unchanged)
+*/
+bool compactlist_compact(CompactList* list);
+
+/*
+    compactlist_locality
+    Get the average distance in bytes between the slots of consecutive elements of a compact list; the size of a slot is the best case
+    @param  CompactList*    Pointer to the list
+    @return double          Average distance, 0 for fewer than two elements
+*/
+double compactlist_locality(CompactList* list);
+
+/*
+    compactlist_data
+    Get the data of an element: the data pointer, or a pointer to the element if the list copies its elements
+    @param  CompactList*    Pointer to the list
+    @param  CompactIndex    Index of the element
+    @return void*           Pointer to the data
+*/
+void* compactlist_data(CompactList* list, CompactIndex index);
+
+/*
+    compactlist_begin
+    Start a traversal of a compact list from its first element
+    @param  CompactList*    Pointer to the list
+    @return CompactCursor   The cursor
+*/
+CompactCursor compactlist_begin(CompactList* list);
+
+/*
+    compactlist_next
+    Get the current element of a traversal and advance the cursor
+    @param  CompactList*    Pointer to the list
+    @param  CompactCursor*  Pointer to the cursor
+    @return CompactIndex    Index of the element, `COMPACT_NIL` at the end of the list
+*/
+CompactIndex compactlist_next(CompactList* list, CompactCursor* cursor);
+
+/*
+    compactlist_len
+    Get the number of elements in a compact list
+    @param  CompactList*    Pointer to the list
+    @return size_t          Number of elements
+*/
+size_t compactlist_len(CompactList* list);
+
+/*
+    compactlist_bytes
+    Get the memory used by a compact list: the list and the whole pool, free slots included
+    @param  CompactList*    Pointer to the list
+    @return size_t          Number of bytes
+*/
+size_t compactlist_bytes(CompactList* list);
+
+#endif // DSL_COMPACTLIST_H
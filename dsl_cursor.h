@@ -0,0 +1,207 @@
+#ifndef DSL_CURSOR_H
+#define DSL_CURSOR_H
+/*
+    Interface for the prefetching traversal of the lists in `dsl_lists.h`.
+
+    Following a list stalls on every `next` pointer: the address of a node is only known once the previous node has been loaded.
+    A cursor walks the list with a second pointer kept `distance` nodes ahead of the current node, and issues a software prefetch
+    for every node (and, optionally, every element) it reaches, so they are already in the cache when the cursor gets to them.
+    The chain of `next` pointers itself is still loaded one node after the other; what the prefetches hide is the load of the
+    current node, its data and whatever the loop body does with them, which is where heap-scattered lists spend their time.
+
+    Cursors are used by the searches of `dsl_lists.c`, the bubble and selection sorts of `dsl_listsort.c`, and the foreach macros below:
+        SLLNode* node;
+        SLL_FOREACH(node, list){
+            ...
+        }
+    The cursor has already moved past `node` when the body runs, so the body may remove and free `node`, but no other node.
+
+    The current methods are:
+    - `sll_cursor_at`, `dll_cursor_at`: Start a cursor at a node
+    - `sll_cursor_next`, `dll_cursor_next`: Get the current node of a cursor and advance it
+    - `SLL_FOREACH`, `DLL_FOREACH`, `STACK_FOREACH`, `QUEUE_FOREACH`: Visit every node of a list
+    - `SLL_FOREACH_AT`, `DLL_FOREACH_AT`: Visit the nodes from a given node, with a given prefetch distance
+
+    The default distance, `DSL_PREFETCH_DISTANCE`, can be set at compile time (e.g. `-DDSL_PREFETCH_DISTANCE=16`); 0 disables the prefetches.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dsl_lists.h"
+
+//  Number of nodes the cursors prefetch ahead of the current node by default
+#ifndef DSL_PREFETCH_DISTANCE
+#define DSL_PREFETCH_DISTANCE 8
+#endif
+
+//  Prefetch an address for reading, into all the cache levels
+#if defined(__GNUC__) || defined(__clang__)
+#define DSL_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+#define DSL_PREFETCH(address) ((void)(address))
+#endif
+
+/*
+    Cursor over singly linked list nodes
+    - `current` is the next node returned, NULL at the end of the list
+    - `ahead` is the node `distance` nodes after `current`, NULL once past the end of the list or if the cursor does not prefetch
+    - `prefetch_data` is set if the elements are prefetched with their nodes
+*/
+typedef struct SLLCursor {
+    SLLNode *current;
+    SLLNode *ahead;
+    bool prefetch_data;
+} SLLCursor;
+
+/*
+    Cursor over doubly linked list nodes, also used for stacks and queues. See `SLLCursor`.
+*/
+typedef struct DLLCursor {
+    DLLNode *current;
+    DLLNode *ahead;
+    bool prefetch_data;
+} DLLCursor;
+
+/*
+    sll_cursor_at
+    Start a cursor at a node of a singly linked list, prefetching the first `distance` nodes
+    @param  SLLNode*    Pointer to the first node visited, NULL for none
+    @param  size_t      Prefetch distance, in nodes; 0 for a plain traversal
+    @param  bool        Whether to prefetch the data of the nodes too, for loops that read the elements
+    @return SLLCursor   The cursor
+*/
+static inline SLLCursor sll_cursor_at(SLLNode* node, size_t distance, bool prefetch_data){
+    SLLCursor cursor = {node, NULL, prefetch_data};
+
+    if(distance == 0){
+        return cursor;
+    }
+
+    cursor.ahead = node;
+
+    for(size_t i = 0; i < distance && cursor.ahead; i++){
+        if(prefetch_data){
+            DSL_PREFETCH(cursor.ahead->data);
+        }
+
+        cursor.ahead = cursor.ahead->next;
+        DSL_PREFETCH(cursor.ahead);
+    }
+
+    return cursor;
+}
+
+/*
+    sll_cursor_next
+    Get the current node of a cursor and advance the cursor, prefetching one more node
+    @param  SLLCursor*  Pointer to the cursor
+    @return SLLNode*    Pointer to the node, NULL at the end of the list
+*/
+static inline SLLNode* sll_cursor_next(SLLCursor* cursor){
+    SLLNode* node = cursor->current;
+
+    if(!node){
+        return NULL;
+    }
+
+    if(cursor->ahead){
+        if(cursor->prefetch_data){
+            DSL_PREFETCH(cursor->ahead->data);
+        }
+
+        cursor->ahead = cursor->ahead->next;
+        DSL_PREFETCH(cursor->ahead);
+    }
+
+    cursor->current = node->next;
+
+    return node;
+}
+
+/*
+    dll_cursor_at
+    Start a cursor at a node of a doubly linked list, a stack or a queue. See `sll_cursor_at`.
+*/
+static inline DLLCursor dll_cursor_at(DLLNode* node, size_t distance, bool prefetch_data){
+    DLLCursor cursor = {node, NULL, prefetch_data};
+
+    if(distance == 0){
+        return cursor;
+    }
+
+    cursor.ahead = node;
+
+    for(size_t i = 0; i < distance && cursor.ahead; i++){
+        if(prefetch_data){
+            DSL_PREFETCH(cursor.ahead->data);
+        }
+
+        cursor.ahead = cursor.ahead->next;
+        DSL_PREFETCH(cursor.ahead);
+    }
+
+    return cursor;
+}
+
+/*
+    dll_cursor_next
+    Get the current node of a cursor and advance the cursor, prefetching one more node. See `sll_cursor_next`.
+*/
+static inline DLLNode* dll_cursor_next(DLLCursor* cursor){
+    DLLNode* node = cursor->current;
+
+    if(!node){
+        return NULL;
+    }
+
+    if(cursor->ahead){
+        if(cursor->prefetch_data){
+            DSL_PREFETCH(cursor->ahead->data);
+        }
+
+        cursor->ahead = cursor->ahead->next;
+        DSL_PREFETCH(cursor->ahead);
+    }
+
+    cursor->current = node->next;
+
+    return node;
+}
+
+/*
+    SLL_FOREACH_AT
+    Visit the nodes of a singly linked list from `start`, prefetching `distance` nodes and their data ahead
+    - `node` is a declared `SLLNode*` variable, set to each node in turn
+    - `start` is the first node visited
+    - `distance` is the prefetch distance
+*/
+#define SLL_FOREACH_AT(node, start, distance)                                                           \
+    for(SLLCursor node##_cursor = sll_cursor_at((start), (distance), true); ((node) = sll_cursor_next(&node##_cursor)) != NULL; )
+
+/*
+    SLL_FOREACH
+    Visit every node of a singly linked list, with the default prefetch distance
+*/
+#define SLL_FOREACH(node, sll) SLL_FOREACH_AT(node, (sll)->head, DSL_PREFETCH_DISTANCE)
+
+/*
+    DLL_FOREACH_AT
+    Visit the nodes of a doubly linked list, a stack or a queue from `start`. See `SLL_FOREACH_AT`.
+*/
+#define DLL_FOREACH_AT(node, start, distance)                                                           \
+    for(DLLCursor node##_cursor = dll_cursor_at((start), (distance), true); ((node) = dll_cursor_next(&node##_cursor)) != NULL; )
+
+/*
+    DLL_FOREACH, STACK_FOREACH, QUEUE_FOREACH
+    Visit every node of a doubly linked list from its head, of a stack from its top, of a queue from its front
+*/
+#define DLL_FOREACH(node, dll) DLL_FOREACH_AT(node, (dll)->head, DSL_PREFETCH_DISTANCE)
+#define STACK_FOREACH(node, stack) DLL_FOREACH_AT(node, (stack)->top, DSL_PREFETCH_DISTANCE)
+#define QUEUE_FOREACH(node, queue) DLL_FOREACH_AT(node, (queue)->front, DSL_PREFETCH_DISTANCE)
+
+#endif // DSL_CURSOR_H
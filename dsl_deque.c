@@ -0,0 +1,358 @@
+/*
+    Implementation of the block deque.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "dsl_deque.h"
+
+/*
+    deque_block_take
+    Get an empty block: the spare block if there is one, a new block otherwise
+    @param  Deque*  Pointer to the deque
+    @return void**  Pointer to the block, NULL if the allocation failed
+*/
+static void** deque_block_take(Deque* deque){
+    void** block = deque->spare;
+
+    if(block){
+        deque->spare = NULL;
+        return block;
+    }
+
+    return (void**) malloc(DEQUE_BLOCK_SIZE * sizeof(void*));
+}
+
+/*
+    deque_block_give
+    Release a block that is no longer used: it becomes the spare block, or is freed if there is one already
+    @param  Deque*  Pointer to the deque
+    @param  void**  Pointer to the block
+    @return void
+*/
+static void deque_block_give(Deque* deque, void** block){
+    if(!deque->spare){
+        deque->spare = block;
+    }   else{
+            free(block);
+    }
+}
+
+/*
+    deque_map_room
+    Make sure the map has a free entry before the first block, or after the last block. The blocks are centered in the map,
+    which is doubled first if it is more than half full, so recentering happens at most once every `map_capacity / 4` new blocks.
+    @param  Deque*  Pointer to the deque
+    @param  bool    true for an entry before the first block, false for an entry after the last block
+    @return bool    true if the operation was successful, false if the allocation failed
+*/
+static bool deque_map_room(Deque* deque, bool at_front){
+    if(at_front ? deque->first > 0 : deque->first + deque->nblocks < deque->map_capacity){
+        return true;
+    }
+
+    size_t capacity = deque->map_capacity;
+
+    if(2 * (deque->nblocks + 1) > capacity){
+        capacity = capacity ? 2 * capacity : 8;
+    }
+
+    size_t first = (capacity - deque->nblocks) / 2;
+
+    if(capacity == deque->map_capacity){
+        memmove(deque->map + first, deque->map + deque->first, deque->nblocks * sizeof(void**));
+    }   else{
+            void*** map = (void***) malloc(capacity * sizeof(void**));
+
+            if(!map){
+                return false;
+            }
+
+            if(deque->nblocks){
+                memcpy(map + first, deque->map + deque->first, deque->nblocks * sizeof(void**));
+            }
+
+            free(deque->map);
+            deque->map = map;
+            deque->map_capacity = capacity;
+    }
+
+    deque->first = first;
+
+    return true;
+}
+
+/*
+    deque_empty
+    Release the blocks of a deque once its last element has been removed, so both ends start from the middle of the map again
+    @param  Deque*  Pointer to the deque
+    @return void
+*/
+static void deque_empty(Deque* deque){
+    for(size_t i = 0; i < deque->nblocks; i++){
+        deque_block_give(deque, deque->map[deque->first + i]);
+    }
+
+    deque->nblocks = 0;
+    deque->front = 0;
+    deque->first = deque->map_capacity / 2;
+}
+
+/*
+    deque_create
+    Create a new, empty, deque. No block is allocated before the first element.
+    @param  void
+    @return Deque*  Pointer to the new deque, NULL if the allocation failed
+*/
+Deque* deque_create(void){
+    Deque* deque = (Deque*) malloc(sizeof(Deque));
+
+    if(!deque){
+        return NULL;
+    }
+
+    deque->map = NULL;
+    deque->map_capacity = 0;
+    deque->first = 0;
+    deque->nblocks = 0;
+    deque->front = 0;
+    deque->size = 0;
+    deque->spare = NULL;
+
+    return deque;
+}
+
+/*
+    deque_destroy
+    Destroy a deque. The data of the elements is not freed.
+    @param  Deque*  Pointer to the deque
+    @return void
+*/
+void deque_destroy(Deque* deque){
+    deque_destroy_with(deque, NULL);
+}
+
+/*
+    deque_destroy_with
+    Destroy a deque and free the data of its elements in the same pass
+    @param  Deque*              Pointer to the deque
+    @param  ListFreeFunction    Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void deque_destroy_with(Deque* deque, ListFreeFunction free_data){
+    if(!deque){
+        return;
+    }
+
+    if(free_data){
+        for(size_t i = 0; i < deque->size; i++){
+            size_t position = deque->front + i;
+            free_data(deque->map[deque->first + position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE]);
+        }
+    }
+
+    for(size_t i = 0; i < deque->nblocks; i++){
+        free(deque->map[deque->first + i]);
+    }
+
+    free(deque->spare);
+    free(deque->map);
+    free(deque);
+}
+
+/*
+    deque_push_front
+    Insert a new element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @param  void*   Pointer to the data
+    @return bool    true if the operation was successful, false if the allocation failed
+*/
+bool deque_push_front(Deque* deque, void* data){
+    if(deque->front == 0){
+        //  The first block is full, or there is no block
+        if(!deque_map_room(deque, true)){
+            return false;
+        }
+
+        void** block = deque_block_take(deque);
+
+        if(!block){
+            return false;
+        }
+
+        deque->map[--deque->first] = block;
+        deque->nblocks++;
+        deque->front = DEQUE_BLOCK_SIZE;
+    }
+
+    deque->front--;
+    deque->map[deque->first][deque->front] = data;
+    deque->size++;
+
+    return true;
+}
+
+/*
+    deque_push_back
+    Insert a new element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @param  void*   Pointer to the data
+    @return bool    true if the operation was successful, false if the allocation failed
+*/
+bool deque_push_back(Deque* deque, void* data){
+    size_t position = deque->front + deque->size;
+
+    if(position == deque->nblocks * DEQUE_BLOCK_SIZE){
+        //  The last block is full, or there is no block
+        if(!deque_map_room(deque, false)){
+            return false;
+        }
+
+        void** block = deque_block_take(deque);
+
+        if(!block){
+            return false;
+        }
+
+        deque->map[deque->first + deque->nblocks] = block;
+        deque->nblocks++;
+    }
+
+    deque->map[deque->first + position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE] = data;
+    deque->size++;
+
+    return true;
+}
+
+/*
+    deque_pop_front
+    Remove the element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_pop_front(Deque* deque){
+    if(deque->size == 0){
+        return NULL;
+    }
+
+    void* data = deque->map[deque->first][deque->front];
+
+    deque->front++;
+    deque->size--;
+
+    if(deque->size == 0){
+        deque_empty(deque);
+    }   else if(deque->front == DEQUE_BLOCK_SIZE){
+            //  The first block is now empty
+            deque_block_give(deque, deque->map[deque->first]);
+            deque->first++;
+            deque->nblocks--;
+            deque->front = 0;
+    }
+
+    return data;
+}
+
+/*
+    deque_pop_back
+    Remove the element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_pop_back(Deque* deque){
+    if(deque->size == 0){
+        return NULL;
+    }
+
+    deque->size--;
+
+    size_t position = deque->front + deque->size;
+    void* data = deque->map[deque->first + position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+
+    if(deque->size == 0){
+        deque_empty(deque);
+    }   else if(position % DEQUE_BLOCK_SIZE == 0){
+            //  The element was the first of the last block, which is now empty
+            deque->nblocks--;
+            deque_block_give(deque, deque->map[deque->first + deque->nblocks]);
+    }
+
+    return data;
+}
+
+/*
+    deque_front
+    Get the element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_front(Deque* deque){
+    if(deque->size == 0){
+        return NULL;
+    }
+
+    return deque->map[deque->first][deque->front];
+}
+
+/*
+    deque_back
+    Get the element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_back(Deque* deque){
+    if(deque->size == 0){
+        return NULL;
+    }
+
+    size_t position = deque->front + deque->size - 1;
+
+    return deque->map[deque->first + position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+}
+
+/*
+    deque_get
+    Get the element at a position of a deque, 0 being the front, in O(1)
+    @param  Deque*  Pointer to the deque
+    @param  size_t  Position of the element
+    @return void*   Pointer to the data of the element, NULL if the position is out of range
+*/
+void* deque_get(Deque* deque, size_t position){
+    void** slot = deque_at(deque, position);
+
+    return slot ? *slot : NULL;
+}
+
+/*
+    deque_at
+    Get the slot of the element at a position of a deque, which keeps its address while the element is in the deque
+    @param  Deque*  Pointer to the deque
+    @param  size_t  Position of the element
+    @return void**  Pointer to the slot, NULL if the position is out of range
+*/
+void** deque_at(Deque* deque, size_t position){
+    if(position >= deque->size){
+        return NULL;
+    }
+
+    position += deque->front;
+
+    return &deque->map[deque->first + position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+}
+
+/*
+    deque_size
+    Get the number of elements in a deque
+    @param  Deque*  Pointer to the deque
+    @return size_t  Number of elements
+*/
+size_t deque_size(Deque* deque){
+    return deque->size;
+}
@@ -0,0 +1,181 @@
+#ifndef DSL_DEQUE_H
+#define DSL_DEQUE_H
+/*
+    Interface for the implementation of the block deque.
+
+    A `Deque` is a double-ended queue of data pointers stored in fixed-size blocks of `DEQUE_BLOCK_SIZE` slots, reached through a block map, as in the usual STL deques:
+    - pushing and popping at either end take O(1), and allocate or free a block only once every `DEQUE_BLOCK_SIZE` elements; the last freed block is kept for the next one;
+    - the element at any position is reached in O(1), through its block in the map;
+    - the slot of an element stays at the same address while the element is in the deque: only the block map is reallocated as the deque grows.
+
+    A `Deque` serves both as a stack and as a queue. The `stack_*` and `queue_*` functions of `dsl_lists.h` that take a stack or a queue also accept a `Deque*` once this header is included:
+    the stack pushes and pops at the back, the queue enqueues at the back and dequeues from the front. A worklist written for a `Stack*` or a `Queue*` switches to a deque by changing
+    the type of its variable and its creation function, e.g. `Deque* stack = deque_create(); stack_push(stack, data);`.
+
+    The current `Deque` methods are:
+    - `deque_create`: Create a new deque
+    - `deque_destroy`: Destroy a deque
+    - `deque_destroy_with`: Destroy a deque and the data of its elements
+    - `deque_push_front`, `deque_push_back`: Insert a new element at one end of a deque
+    - `deque_pop_front`, `deque_pop_back`: Remove the element at one end of a deque
+    - `deque_front`, `deque_back`: Get the element at one end of a deque
+    - `deque_get`: Get the element at a position of a deque
+    - `deque_at`: Get the slot of the element at a position of a deque
+    - `deque_size`: Get the number of elements in a deque
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dsl_lists.h"
+
+//  Number of slots of a block: 1 KiB of data pointers
+#define DEQUE_BLOCK_SIZE 128
+
+/*
+    Block deque
+    - `map` is the array of the blocks; the blocks in use are `map[first]` to `map[first + nblocks - 1]`
+    - `map_capacity` is the number of entries of `map`
+    - `first` is the position in `map` of the first block in use, `nblocks` the number of blocks in use
+    - `front` is the position of the first element in the first block
+    - `size` is the number of elements
+    - `spare` is an empty block kept for the next block needed, NULL if there is none
+*/
+typedef struct Deque {
+    void ***map;
+    size_t map_capacity;
+    size_t first;
+    size_t nblocks;
+    size_t front;
+    size_t size;
+    void **spare;
+} Deque;
+
+//  Deque methods
+
+/*
+    deque_create
+    Create a new, empty, deque. No block is allocated before the first element.
+    @param  void
+    @return Deque*  Pointer to the new deque, NULL if the allocation failed
+*/
+Deque* deque_create(void);
+
+/*
+    deque_destroy
+    Destroy a deque. The data of the elements is not freed.
+    @param  Deque*  Pointer to the deque
+    @return void
+*/
+void deque_destroy(Deque* deque);
+
+/*
+    deque_destroy_with
+    Destroy a deque and free the data of its elements in the same pass
+    @param  Deque*              Pointer to the deque
+    @param  ListFreeFunction    Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void deque_destroy_with(Deque* deque, ListFreeFunction free_data);
+
+/*
+    deque_push_front
+    Insert a new element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @param  void*   Pointer to the data
+    @return bool    true if the operation was successful, false if the allocation failed
+*/
+bool deque_push_front(Deque* deque, void* data);
+
+/*
+    deque_push_back
+    Insert a new element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @param  void*   Pointer to the data
+    @return bool    true if the operation was successful, false if the allocation failed
+*/
+bool deque_push_back(Deque* deque, void* data);
+
+/*
+    deque_pop_front
+    Remove the element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_pop_front(Deque* deque);
+
+/*
+    deque_pop_back
+    Remove the element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_pop_back(Deque* deque);
+
+/*
+    deque_front
+    Get the element at the front of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_front(Deque* deque);
+
+/*
+    deque_back
+    Get the element at the back of a deque
+    @param  Deque*  Pointer to the deque
+    @return void*   Pointer to the data of the element, NULL if the deque is empty
+*/
+void* deque_back(Deque* deque);
+
+/*
+    deque_get
+    Get the element at a position of a deque, 0 being the front, in O(1)
+    @param  Deque*  Pointer to the deque
+    @param  size_t  Position of the element
+    @return void*   Pointer to the data of the element, NULL if the position is out of range
+*/
+void* deque_get(Deque* deque, size_t position);
+
+/*
+    deque_at
+    Get the slot of the element at a position of a deque, which keeps its address while the element is in the deque
+    @param  Deque*  Pointer to the deque
+    @param  size_t  Position of the element
+    @return void**  Pointer to the slot, NULL if the position is out of range
+*/
+void** deque_at(Deque* deque, size_t position);
+
+/*
+    deque_size
+    Get the number of elements in a deque
+    @param  Deque*  Pointer to the deque
+    @return size_t  Number of elements
+*/
+size_t deque_size(Deque* deque);
+
+/*
+    Stack and Queue adapters
+    Each function of `dsl_lists.h` taking a `Stack*` or a `Queue*` is wrapped by a macro of the same name, which calls the deque function for a `Deque*`
+    and the original function for anything else. The choice is made at compile time.
+*/
+#define stack_destroy(stack) _Generic((stack), Deque*: deque_destroy, default: stack_destroy)(stack)
+#define stack_destroy_with(stack, free_data) _Generic((stack), Deque*: deque_destroy_with, default: stack_destroy_with)(stack, free_data)
+#define stack_push(stack, data) _Generic((stack), Deque*: deque_push_back, default: stack_push)(stack, data)
+#define stack_pop(stack) _Generic((stack), Deque*: deque_pop_back, default: stack_pop)(stack)
+#define stack_top(stack) _Generic((stack), Deque*: deque_back, default: stack_top)(stack)
+#define stack_size(stack) _Generic((stack), Deque*: deque_size, default: stack_size)(stack)
+
+#define queue_destroy(queue) _Generic((queue), Deque*: deque_destroy, default: queue_destroy)(queue)
+#define queue_destroy_with(queue, free_data) _Generic((queue), Deque*: deque_destroy_with, default: queue_destroy_with)(queue, free_data)
+#define queue_enqueue(queue, data) _Generic((queue), Deque*: deque_push_back, default: queue_enqueue)(queue, data)
+#define queue_dequeue(queue) _Generic((queue), Deque*: deque_pop_front, default: queue_dequeue)(queue)
+#define queue_front(queue) _Generic((queue), Deque*: deque_front, default: queue_front)(queue)
+#define queue_back(queue) _Generic((queue), Deque*: deque_back, default: queue_back)(queue)
+#define queue_size(queue) _Generic((queue), Deque*: deque_size, default: queue_size)(queue)
+
+#endif // DSL_DEQUE_H
@@ -0,0 +1,1151 @@
+/*
+    Implementation of the external-memory sort.
+
+    A run file is a sequence of records, each one a 32-bit length followed by the bytes written by `serialize`.
+    The runs are written through the buffered `FILE` of the run and read back with `pread` by the I/O thread of the merge,
+    which serves the refill requests of the readers in the order they were made.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "dsl_extsort.h"
+#include "dsl_listsort.h"
+#include "dsl_heap.h"
+
+//  Bytes held for each pushed element on top of its record: its node and the length of the record
+#define EXTSORT_ELEMENT_OVERHEAD (sizeof(SLLNode) + sizeof(uint32_t))
+
+//  Initial size of the record buffer
+#define EXTSORT_RECORD_CAPACITY 256
+
+/*
+    Reader of a run during a merge
+    - `sort` is the sort the run belongs to
+    - `run` is the run read
+    - `order` is the position of the run among the runs merged, which breaks the ties between equal elements
+    - `offset` is the offset of the next block in the run file, used by the I/O thread only
+    - `blocks` are the two read-ahead blocks, `lengths` the number of bytes read in each and `ready` whether each was read
+    - `current` is the block being consumed and `position` the next byte in it
+    - `remaining` is the number of records not yet read
+    - `record` is the current record, `record_size` its size and `record_capacity` the size of the buffer
+    - `data` is the element built from the current record
+    - `handle` is the handle of the reader in the heap of the merge
+    - `io_error` is set by the I/O thread after a read error
+    - `failed` is set by the merge after an error on the run
+*/
+typedef struct ExtSortReader {
+    ExtSort *sort;
+    ExtSortRun *run;
+    size_t order;
+    size_t offset;
+    unsigned char *blocks[2];
+    size_t lengths[2];
+    bool ready[2];
+    int current;
+    size_t position;
+    size_t remaining;
+    unsigned char *record;
+    size_t record_size;
+    size_t record_capacity;
+    void *data;
+    HeapHandle handle;
+    bool io_error;
+    bool failed;
+} ExtSortReader;
+
+/*
+    Refill request of a read-ahead block
+*/
+typedef struct ExtSortRequest {
+    ExtSortReader *reader;
+    int block;
+} ExtSortRequest;
+
+/*
+    I/O thread of a merge
+    - `lock` protects the queue of requests and the `lengths`, `ready` and `io_error` fields of the readers
+    - `requested` is signaled when a request is queued, `completed` when a block is read
+    - `requests` is the ring of the pending requests, `capacity` its size, `first` its first request and `count` the number of requests
+    - `block_size` is the size of the read-ahead blocks
+    - `stop` asks the thread to exit once the queue is empty
+*/
+typedef struct ExtSortIO {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t requested;
+    pthread_cond_t completed;
+    ExtSortRequest *requests;
+    size_t capacity;
+    size_t first;
+    size_t count;
+    size_t block_size;
+    bool stop;
+} ExtSortIO;
+
+/*
+    Receiver of the elements of a merge. It takes the ownership of `reader->data` even when it fails.
+*/
+typedef bool (*ExtSortSink)(ExtSortReader* reader, void* context);
+
+/*
+    List built by `extsort_finish`
+*/
+typedef struct ExtSortChain {
+    SLLNode *head;
+    SLLNode *tail;
+    size_t size;
+} ExtSortChain;
+
+/*
+    Output callback of `extsort_finish_stream`
+*/
+typedef struct ExtSortStream {
+    ExtSortEmitFunction emit;
+    void *context;
+} ExtSortStream;
+
+
+/*
+    Serialization
+*/
+
+/*
+    extsort_free_data
+    Free an element with the `free_data` callback, if set
+    @param  ExtSort*    Pointer to the sort
+    @param  void*       Pointer to the element
+    @return void
+*/
+static void extsort_free_data(ExtSort* sort, void* data){
+    if(sort->config.free_data && data){
+        sort->config.free_data(data, sort->config.context);
+    }
+}
+
+/*
+    extsort_serialize
+    Serialize an element into the record buffer of the sort, growing it as needed
+    @param  ExtSort*    Pointer to the sort
+    @param  void*       Pointer to the element
+    @param  size_t*     Receives the size of the record
+    @return bool        true if the operation was successful, false if the allocation failed or the record exceeds 4 GiB
+*/
+static bool extsort_serialize(ExtSort* sort, void* data, size_t* size){
+    size_t needed = sort->config.serialize(data, sort->record, sort->record_capacity, sort->config.context);
+
+    if(needed > UINT32_MAX){
+        return false;
+    }
+
+    if(needed > sort->record_capacity){
+        size_t capacity = sort->record_capacity;
+
+        while(capacity < needed){
+            capacity *= 2;
+        }
+
+        unsigned char* record = (unsigned char*)realloc(sort->record, capacity);
+
+        if(!record){
+            return false;
+        }
+
+        sort->record = record;
+        sort->record_capacity = capacity;
+
+        needed = sort->config.serialize(data, sort->record, sort->record_capacity, sort->config.context);
+
+        if(needed > sort->record_capacity){
+            return false;
+        }
+    }
+
+    *size = needed;
+
+    return true;
+}
+
+/*
+    extsort_write_record
+    Append a record to a run
+    @param  ExtSortRun*             Pointer to the run
+    @param  const unsigned char*    Record
+    @param  size_t                  Size of the record
+    @return bool                    true if the operation was successful, false after a write error
+*/
+static bool extsort_write_record(ExtSortRun* run, const unsigned char* record, size_t size){
+    uint32_t length = (uint32_t)size;
+
+    if(fwrite(&length, sizeof(length), 1, run->file) != 1 || (size && fwrite(record, 1, size, run->file) != size)){
+        return false;
+    }
+
+    run->size += sizeof(length) + size;
+    run->count++;
+
+    return true;
+}
+
+
+/*
+    Runs
+*/
+
+/*
+    extsort_run_open
+    Create an empty run file in the directory of the sort. The file is unlinked at once and only lives through its descriptor.
+    @param  ExtSort*        Pointer to the sort
+    @param  ExtSortRun*     Receives the run
+    @return bool            true if the operation was successful, false otherwise
+*/
+static bool extsort_run_open(ExtSort* sort, ExtSortRun* run){
+    const char* directory = sort->config.directory;
+    size_t length = strlen(directory);
+    char* path = (char*)malloc(length + sizeof("/dsl_extsort_XXXXXX"));
+
+    if(!path){
+        return false;
+    }
+
+    memcpy(path, directory, length);
+    memcpy(path + length, "/dsl_extsort_XXXXXX", sizeof("/dsl_extsort_XXXXXX"));
+
+    int fd = mkstemp(path);
+
+    if(fd < 0){
+        free(path);
+        return false;
+    }
+
+    unlink(path);
+    free(path);
+
+    run->file = fdopen(fd, "w+b");
+
+    if(!run->file){
+        close(fd);
+        return false;
+    }
+
+    run->size = 0;
+    run->count = 0;
+
+    return true;
+}
+
+/*
+    extsort_run_close
+    Close a run file, which removes it
+    @param  ExtSortRun*     Pointer to the run
+    @return void
+*/
+static void extsort_run_close(ExtSortRun* run){
+    if(run->file){
+        fclose(run->file);
+        run->file = NULL;
+    }
+}
+
+/*
+    extsort_add_run
+    Append a run to the runs of the sort
+    @param  ExtSort*        Pointer to the sort
+    @param  ExtSortRun*     Pointer to the run
+    @return bool            true if the operation was successful, false if the allocation failed
+*/
+static bool extsort_add_run(ExtSort* sort, ExtSortRun* run){
+    if(sort->nruns == sort->runs_capacity){
+        size_t capacity = sort->runs_capacity ? 2 * sort->runs_capacity : 16;
+        ExtSortRun* runs = (ExtSortRun*)realloc(sort->runs, capacity * sizeof(ExtSortRun));
+
+        if(!runs){
+            return false;
+        }
+
+        sort->runs = runs;
+        sort->runs_capacity = capacity;
+    }
+
+    sort->runs[sort->nruns++] = *run;
+
+    return true;
+}
+
+/*
+    extsort_sort_pending
+    Sort the elements held in memory, stably, with the natural merge sort of `dsl_listsort.h`
+    @param  ExtSort*    Pointer to the sort
+    @return void
+*/
+static void extsort_sort_pending(ExtSort* sort){
+    SinglyLinkedList chain = {sort->pending, sort->npending, NULL};
+
+    sll_natural_mergesort(&chain, sort->config.compare);
+
+    sort->pending = chain.head;
+    sort->pending_tail = NULL;
+
+    for(SLLNode* current = sort->pending; current; current = current->next){
+        sort->pending_tail = current;
+    }
+}
+
+/*
+    extsort_drop_pending
+    Free the elements held in memory and their nodes
+    @param  ExtSort*    Pointer to the sort
+    @return void
+*/
+static void extsort_drop_pending(ExtSort* sort){
+    SLLNode* current = sort->pending;
+
+    while(current){
+        SLLNode* next = current->next;
+
+        extsort_free_data(sort, current->data);
+        sllnode_free(current);
+
+        current = next;
+    }
+
+    sort->pending = NULL;
+    sort->pending_tail = NULL;
+    sort->npending = 0;
+    sort->pending_bytes = 0;
+}
+
+/*
+    extsort_spill
+    Sort the elements held in memory and write them to a new run. The nodes are freed, and the elements with `free_data`.
+    @param  ExtSort*    Pointer to the sort
+    @return bool        true if the operation was successful, false otherwise (the sort is then marked as failed)
+*/
+static bool extsort_spill(ExtSort* sort){
+    if(!sort->pending){
+        return true;
+    }
+
+    extsort_sort_pending(sort);
+
+    ExtSortRun run;
+
+    if(!extsort_run_open(sort, &run)){
+        sort->failed = true;
+        return false;
+    }
+
+    bool ok = true;
+
+    while(sort->pending && ok){
+        SLLNode* node = sort->pending;
+        size_t size;
+
+        ok = extsort_serialize(sort, node->data, &size) && extsort_write_record(&run, sort->record, size);
+
+        sort->pending = node->next;
+        extsort_free_data(sort, node->data);
+        sllnode_free(node);
+    }
+
+    ok = ok && fflush(run.file) == 0 && extsort_add_run(sort, &run);
+
+    extsort_drop_pending(sort);
+
+    if(!ok){
+        extsort_run_close(&run);
+        sort->failed = true;
+    }
+
+    return ok;
+}
+
+
+/*
+    Read-ahead
+*/
+
+/*
+    extsort_io_main
+    Body of the I/O thread: read the requested blocks, in the order of the requests, until asked to stop
+    @param  void*   Pointer to the `ExtSortIO`
+    @return void*   NULL
+*/
+static void* extsort_io_main(void* argument){
+    ExtSortIO* io = (ExtSortIO*)argument;
+
+    pthread_mutex_lock(&io->lock);
+
+    while(true){
+        while(io->count == 0 && !io->stop){
+            pthread_cond_wait(&io->requested, &io->lock);
+        }
+
+        if(io->count == 0){
+            break;
+        }
+
+        ExtSortRequest request = io->requests[io->first];
+        io->first = (io->first + 1) % io->capacity;
+        io->count--;
+
+        pthread_mutex_unlock(&io->lock);
+
+        //  Only this thread touches the offset and the block being refilled
+        ExtSortReader* reader = request.reader;
+        unsigned char* block = reader->blocks[request.block];
+        int fd = fileno(reader->run->file);
+        size_t length = 0;
+        bool failed = false;
+
+        while(length < io->block_size){
+            ssize_t got = pread(fd, block + length, io->block_size - length, (off_t)(reader->offset + length));
+
+            if(got < 0 && errno == EINTR){
+                continue;
+            }
+
+            if(got <= 0){
+                failed = got < 0;
+                break;
+            }
+
+            length += (size_t)got;
+        }
+
+        reader->offset += length;
+
+        pthread_mutex_lock(&io->lock);
+
+        reader->lengths[request.block] = length;
+        reader->ready[request.block] = true;
+        reader->io_error = reader->io_error || failed;
+
+        pthread_cond_broadcast(&io->completed);
+    }
+
+    pthread_mutex_unlock(&io->lock);
+
+    return NULL;
+}
+
+/*
+    extsort_io_request
+    Queue the refill of a block of a reader
+    @param  ExtSortIO*      Pointer to the I/O thread
+    @param  ExtSortReader*  Pointer to the reader
+    @param  int             Block to refill
+    @return void
+*/
+static void extsort_io_request(ExtSortIO* io, ExtSortReader* reader, int block){
+    pthread_mutex_lock(&io->lock);
+
+    reader->ready[block] = false;
+
+    //  Each reader has at most two requests pending, so the ring never overflows
+    io->requests[(io->first + io->count) % io->capacity] = (ExtSortRequest){reader, block};
+    io->count++;
+
+    pthread_cond_signal(&io->requested);
+    pthread_mutex_unlock(&io->lock);
+}
+
+/*
+    extsort_io_wait
+    Wait until a block of a reader is read
+    @param  ExtSortIO*      Pointer to the I/O thread
+    @param  ExtSortReader*  Pointer to the reader
+    @param  int             Block to wait for
+    @return bool            true if the block was read, false after a read error
+*/
+static bool extsort_io_wait(ExtSortIO* io, ExtSortReader* reader, int block){
+    pthread_mutex_lock(&io->lock);
+
+    while(!reader->ready[block]){
+        pthread_cond_wait(&io->completed, &io->lock);
+    }
+
+    bool ok = !reader->io_error;
+
+    pthread_mutex_unlock(&io->lock);
+
+    return ok;
+}
+
+/*
+    extsort_reader_read
+    Copy the next bytes of a run. When the current block is consumed, it is queued for refill and the reader moves to the other block, read ahead in the meantime.
+    @param  ExtSortIO*      Pointer to the I/O thread
+    @param  ExtSortReader*  Pointer to the reader
+    @param  void*           Destination of the bytes
+    @param  size_t          Number of bytes
+    @return bool            true if the operation was successful, false after a read error or if the run is truncated
+*/
+static bool extsort_reader_read(ExtSortIO* io, ExtSortReader* reader, void* destination, size_t n){
+    unsigned char* output = (unsigned char*)destination;
+
+    while(n > 0){
+        if(reader->position == reader->lengths[reader->current]){
+            if(reader->lengths[reader->current] == 0){
+                return false;
+            }
+
+            extsort_io_request(io, reader, reader->current);
+
+            reader->current ^= 1;
+            reader->position = 0;
+
+            if(!extsort_io_wait(io, reader, reader->current)){
+                return false;
+            }
+
+            continue;
+        }
+
+        size_t available = reader->lengths[reader->current] - reader->position;
+        size_t count = n < available ? n : available;
+
+        memcpy(output, reader->blocks[reader->current] + reader->position, count);
+
+        reader->position += count;
+        output += count;
+        n -= count;
+    }
+
+    return true;
+}
+
+/*
+    extsort_reader_next
+    Read the next record of a run and build its element
+    @param  ExtSortIO*      Pointer to the I/O thread
+    @param  ExtSortReader*  Pointer to the reader
+    @return bool            true if a record was read, false at the end of the run or after an error (`failed` is then set)
+*/
+static bool extsort_reader_next(ExtSortIO* io, ExtSortReader* reader){
+    reader->data = NULL;
+
+    if(reader->remaining == 0){
+        return false;
+    }
+
+    uint32_t length;
+
+    if(!extsort_reader_read(io, reader, &length, sizeof(length))){
+        reader->failed = true;
+        return false;
+    }
+
+    if(length > reader->record_capacity){
+        unsigned char* record = (unsigned char*)realloc(reader->record, length);
+
+        if(!record){
+            reader->failed = true;
+            return false;
+        }
+
+        reader->record = record;
+        reader->record_capacity = length;
+    }
+
+    if(!extsort_reader_read(io, reader, reader->record, length)){
+        reader->failed = true;
+        return false;
+    }
+
+    reader->record_size = length;
+    reader->remaining--;
+    reader->data = reader->sort->config.deserialize(reader->record, length, reader->sort->config.context);
+
+    if(!reader->data){
+        reader->failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    extsort_reader_compare
+    Compare the current elements of two readers; equal elements are ordered by the position of their run, which keeps the merge stable
+    @param  void*   Pointer to the first reader
+    @param  void*   Pointer to the second reader
+    @return int     Negative, zero or positive as the first reader comes before, with or after the second
+*/
+static int extsort_reader_compare(void* a, void* b){
+    ExtSortReader* first = (ExtSortReader*)a;
+    ExtSortReader* second = (ExtSortReader*)b;
+    int result = first->sort->config.compare(first->data, second->data);
+
+    if(result != 0){
+        return result;
+    }
+
+    return first->order < second->order ? -1 : (first->order > second->order ? 1 : 0);
+}
+
+
+/*
+    Merge
+*/
+
+/*
+    extsort_merge
+    Merge runs through a heap of readers, the I/O thread reading every run ahead of the merge
+    @param  ExtSort*        Pointer to the sort
+    @param  ExtSortRun*     Array of the runs, in the order of the elements they hold
+    @param  size_t          Number of runs
+    @param  ExtSortSink     Receiver of the elements, in order
+    @param  void*           Context of the receiver
+    @return bool            true if every element was received, false otherwise
+*/
+static bool extsort_merge(ExtSort* sort, ExtSortRun* runs, size_t k, ExtSortSink sink, void* context){
+    size_t block_size = sort->config.block_size;
+    ExtSortReader* readers = (ExtSortReader*)calloc(k, sizeof(ExtSortReader));
+    unsigned char* blocks = (unsigned char*)malloc(2 * k * block_size);
+    ExtSortRequest* requests = (ExtSortRequest*)malloc(2 * k * sizeof(ExtSortRequest));
+    Heap* heap = heap_create(HEAP_DEFAULT_ARITY, extsort_reader_compare);
+
+    if(!readers || !blocks || !requests || !heap){
+        free(readers);
+        free(blocks);
+        free(requests);
+        heap_destroy(heap);
+        return false;
+    }
+
+    ExtSortIO io = {
+        .requests = requests,
+        .capacity = 2 * k,
+        .first = 0,
+        .count = 0,
+        .block_size = block_size,
+        .stop = false
+    };
+
+    pthread_mutex_init(&io.lock, NULL);
+    pthread_cond_init(&io.requested, NULL);
+    pthread_cond_init(&io.completed, NULL);
+
+    bool ok = pthread_create(&io.thread, NULL, extsort_io_main, &io) == 0;
+    bool started = ok;
+
+    //  Both blocks of every run are requested at once, so the first blocks of the last runs are read while the first runs are loaded
+    for(size_t i = 0; i < k && ok; i++){
+        ExtSortReader* reader = &readers[i];
+
+        reader->sort = sort;
+        reader->run = &runs[i];
+        reader->order = i;
+        reader->blocks[0] = blocks + 2 * i * block_size;
+        reader->blocks[1] = reader->blocks[0] + block_size;
+        reader->remaining = runs[i].count;
+
+        extsort_io_request(&io, reader, 0);
+        extsort_io_request(&io, reader, 1);
+    }
+
+    for(size_t i = 0; i < k && ok; i++){
+        ExtSortReader* reader = &readers[i];
+
+        ok = extsort_io_wait(&io, reader, 0);
+
+        if(ok && extsort_reader_next(&io, reader)){
+            ok = heap_push(heap, reader, &reader->handle);
+        }   else{
+                ok = ok && !reader->failed;
+        }
+    }
+
+    while(ok && heap_size(heap) > 0){
+        ExtSortReader* reader = (ExtSortReader*)heap_peek(heap);
+
+        ok = sink(reader, context);
+        reader->data = NULL;
+
+        if(!ok){
+            break;
+        }
+
+        if(extsort_reader_next(&io, reader)){
+            heap_update(heap, reader->handle);
+        }   else{
+                heap_remove(heap, reader->handle);
+                ok = !reader->failed;
+        }
+    }
+
+    if(started){
+        pthread_mutex_lock(&io.lock);
+        io.stop = true;
+        pthread_cond_signal(&io.requested);
+        pthread_mutex_unlock(&io.lock);
+
+        pthread_join(io.thread, NULL);
+    }
+
+    for(size_t i = 0; i < k; i++){
+        extsort_free_data(sort, readers[i].data);
+        free(readers[i].record);
+    }
+
+    pthread_mutex_destroy(&io.lock);
+    pthread_cond_destroy(&io.requested);
+    pthread_cond_destroy(&io.completed);
+
+    heap_destroy(heap);
+    free(requests);
+    free(blocks);
+    free(readers);
+
+    return ok;
+}
+
+/*
+    extsort_sink_run
+    Receiver writing the records to a run; the element is freed
+    @param  ExtSortReader*  Reader holding the element
+    @param  void*           Pointer to the run
+    @return bool            true if the operation was successful, false after a write error
+*/
+static bool extsort_sink_run(ExtSortReader* reader, void* context){
+    extsort_free_data(reader->sort, reader->data);
+
+    return extsort_write_record((ExtSortRun*)context, reader->record, reader->record_size);
+}
+
+/*
+    extsort_sink_chain
+    Receiver appending the elements to a chain of nodes
+    @param  ExtSortReader*  Reader holding the element
+    @param  void*           Pointer to the chain
+    @return bool            true if the operation was successful, false if the allocation failed (the element is then freed)
+*/
+static bool extsort_sink_chain(ExtSortReader* reader, void* context){
+    ExtSortChain* chain = (ExtSortChain*)context;
+    SLLNode* node = (SLLNode*)malloc(sizeof(SLLNode));
+
+    if(!node){
+        extsort_free_data(reader->sort, reader->data);
+        return false;
+    }
+
+    node->data = reader->data;
+    node->next = NULL;
+
+    if(chain->tail){
+        chain->tail->next = node;
+    }   else{
+            chain->head = node;
+    }
+
+    chain->tail = node;
+    chain->size++;
+
+    return true;
+}
+
+/*
+    extsort_sink_stream
+    Receiver handing the elements to the output callback of `extsort_finish_stream`
+    @param  ExtSortReader*  Reader holding the element
+    @param  void*           Pointer to the `ExtSortStream`
+    @return bool            Result of the callback
+*/
+static bool extsort_sink_stream(ExtSortReader* reader, void* context){
+    ExtSortStream* stream = (ExtSortStream*)context;
+
+    return stream->emit(reader->data, stream->context);
+}
+
+/*
+    extsort_fan_in
+    Get the number of runs merged at once: two read-ahead blocks per run must fit in the memory budget
+    @param  ExtSort*    Pointer to the sort
+    @return size_t      Number of runs, at least 2
+*/
+static size_t extsort_fan_in(ExtSort* sort){
+    size_t fan_in = sort->config.memory_budget / (2 * sort->config.block_size);
+
+    return fan_in < 2 ? 2 : fan_in;
+}
+
+/*
+    extsort_reduce_runs
+    Merge consecutive groups of runs into longer runs until they can all be merged at once
+    @param  ExtSort*    Pointer to the sort
+    @return bool        true if the operation was successful, false otherwise (the sort is then marked as failed)
+*/
+static bool extsort_reduce_runs(ExtSort* sort){
+    size_t fan_in = extsort_fan_in(sort);
+
+    while(sort->nruns > fan_in){
+        size_t merged = 0;
+
+        for(size_t first = 0; first < sort->nruns; first += fan_in){
+            size_t k = sort->nruns - first < fan_in ? sort->nruns - first : fan_in;
+            ExtSortRun run;
+
+            if(k == 1){
+                run = sort->runs[first];
+                sort->runs[first].file = NULL;
+            }   else{
+                    if(!extsort_run_open(sort, &run)){
+                        sort->failed = true;
+                        return false;
+                    }
+
+                    if(!extsort_merge(sort, &sort->runs[first], k, extsort_sink_run, &run) || fflush(run.file) != 0){
+                        extsort_run_close(&run);
+                        sort->failed = true;
+                        return false;
+                    }
+
+                    for(size_t i = first; i < first + k; i++){
+                        extsort_run_close(&sort->runs[i]);
+                    }
+            }
+
+            //  The merged runs keep the order of their groups, so the sort stays stable
+            sort->runs[merged++] = run;
+        }
+
+        sort->nruns = merged;
+    }
+
+    return true;
+}
+
+/*
+    extsort_close_runs
+    Close every run of the sort
+    @param  ExtSort*    Pointer to the sort
+    @return void
+*/
+static void extsort_close_runs(ExtSort* sort){
+    for(size_t i = 0; i < sort->nruns; i++){
+        extsort_run_close(&sort->runs[i]);
+    }
+
+    sort->nruns = 0;
+}
+
+/*
+    extsort_merge_all
+    Write the elements held in memory to a last run and merge every run into a receiver. The sort is left empty.
+    @param  ExtSort*        Pointer to the sort
+    @param  ExtSortSink     Receiver of the elements, in order
+    @param  void*           Context of the receiver
+    @return bool            true if every element was received, false otherwise
+*/
+static bool extsort_merge_all(ExtSort* sort, ExtSortSink sink, void* context){
+    bool ok = extsort_spill(sort) && extsort_reduce_runs(sort) && extsort_merge(sort, sort->runs, sort->nruns, sink, context);
+
+    extsort_close_runs(sort);
+    sort->count = 0;
+
+    return ok;
+}
+
+
+/*
+    ExtSort methods
+*/
+
+/*
+    extsort_create
+    Create a new, empty, external sort
+    @param  const ExtSortConfig*    Configuration; `compare`, `serialize` and `deserialize` are required
+    @return ExtSort*                Pointer to the new sort, NULL if the configuration is incomplete or the allocation failed
+*/
+ExtSort* extsort_create(const ExtSortConfig* config){
+    if(!config || !config->compare || !config->serialize || !config->deserialize){
+        return NULL;
+    }
+
+    ExtSort* sort = (ExtSort*)calloc(1, sizeof(ExtSort));
+
+    if(!sort){
+        return NULL;
+    }
+
+    sort->config = *config;
+
+    if(sort->config.memory_budget == 0){
+        sort->config.memory_budget = EXTSORT_DEFAULT_BUDGET;
+    }
+
+    if(sort->config.block_size == 0){
+        sort->config.block_size = EXTSORT_DEFAULT_BLOCK;
+    }
+
+    if(!sort->config.directory){
+        const char* directory = getenv("TMPDIR");
+        sort->config.directory = directory && directory[0] ? directory : "/tmp";
+    }
+
+    sort->record = (unsigned char*)malloc(EXTSORT_RECORD_CAPACITY);
+
+    if(!sort->record){
+        free(sort);
+        return NULL;
+    }
+
+    sort->record_capacity = EXTSORT_RECORD_CAPACITY;
+
+    return sort;
+}
+
+/*
+    extsort_destroy
+    Destroy an external sort and close its runs. The elements still held in memory are freed with `free_data`, if set.
+    @param  ExtSort*    Pointer to the sort
+    @return void
+*/
+void extsort_destroy(ExtSort* sort){
+    if(!sort){
+        return;
+    }
+
+    extsort_drop_pending(sort);
+    extsort_close_runs(sort);
+
+    free(sort->runs);
+    free(sort->record);
+    free(sort);
+}
+
+/*
+    extsort_hold
+    Append a node to the elements held in memory. On a failure the node is not held: it is left to the caller, with its link unchanged.
+    @param  ExtSort*    Pointer to the sort
+    @param  SLLNode*    Node of the element
+    @return bool        true if the operation was successful, false otherwise (the sort is then marked as failed)
+*/
+static bool extsort_hold(ExtSort* sort, SLLNode* node){
+    size_t size;
+
+    //  The element is costed by its record, which is written again when the run is spilled
+    if(!extsort_serialize(sort, node->data, &size)){
+        sort->failed = true;
+        return false;
+    }
+
+    node->next = NULL;
+
+    if(sort->pending_tail){
+        sort->pending_tail->next = node;
+    }   else{
+            sort->pending = node;
+    }
+
+    sort->pending_tail = node;
+    sort->npending++;
+    sort->pending_bytes += size + EXTSORT_ELEMENT_OVERHEAD;
+    sort->count++;
+
+    return true;
+}
+
+/*
+    extsort_check_budget
+    Write the elements held in memory to a run once the memory budget is reached
+    @param  ExtSort*    Pointer to the sort
+    @return bool        true if the operation was successful, false otherwise
+*/
+static bool extsort_check_budget(ExtSort* sort){
+    if(sort->pending_bytes >= sort->config.memory_budget){
+        return extsort_spill(sort);
+    }
+
+    return true;
+}
+
+/*
+    extsort_push
+    Push an element. When the memory budget is reached, the elements held are sorted and written to a new run.
+    @param  ExtSort*    Pointer to the sort
+    @param  void*       Pointer to the element
+    @return bool        true if the operation was successful, false after an I/O or allocation error
+*/
+bool extsort_push(ExtSort* sort, void* data){
+    if(!sort || sort->failed){
+        return false;
+    }
+
+    SLLNode* node = (SLLNode*)malloc(sizeof(SLLNode));
+
+    if(!node){
+        return false;
+    }
+
+    node->data = data;
+
+    if(!extsort_hold(sort, node)){
+        free(node);
+        return false;
+    }
+
+    return extsort_check_budget(sort);
+}
+
+/*
+    extsort_push_sll
+    Push every element of a singly linked list, in order. The nodes are moved into the sort, so the list is left empty and no node is allocated.
+    @param  ExtSort*            Pointer to the sort
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false after an I/O error
+*/
+bool extsort_push_sll(ExtSort* sort, SinglyLinkedList* list){
+    if(!sort || !list || sort->failed){
+        return false;
+    }
+
+    bool ok = true;
+
+    while(list->head && ok){
+        SLLNode* node = list->head;
+        SLLNode* next = node->next;
+
+        //  The node leaves the list only once it is held: an element that could not be serialized stays at the head
+        if(!extsort_hold(sort, node)){
+            ok = false;
+            break;
+        }
+
+        list->head = next;
+        list->size--;
+
+        ok = extsort_check_budget(sort);
+    }
+
+    if(list->index){
+        sll_index_rebuild(list);
+    }
+
+    return ok;
+}
+
+/*
+    extsort_finish
+    Merge every element pushed into a new sorted list. The sort is left empty.
+    @param  ExtSort*            Pointer to the sort
+    @return SinglyLinkedList*   Pointer to the new list, NULL after an I/O or allocation error
+*/
+SinglyLinkedList* extsort_finish(ExtSort* sort){
+    if(!sort || sort->failed){
+        return NULL;
+    }
+
+    SinglyLinkedList* list = sll_create();
+
+    if(!list){
+        return NULL;
+    }
+
+    //  Everything fits in memory: the elements are sorted in place and their nodes handed over
+    if(sort->nruns == 0){
+        extsort_sort_pending(sort);
+
+        list->head = sort->pending;
+        list->size = sort->npending;
+
+        sort->pending = NULL;
+        sort->npending = 0;
+        sort->pending_bytes = 0;
+        sort->count = 0;
+
+        return list;
+    }
+
+    ExtSortChain chain = {NULL, NULL, 0};
+
+    if(!extsort_merge_all(sort, extsort_sink_chain, &chain)){
+        while(chain.head){
+            SLLNode* next = chain.head->next;
+
+            extsort_free_data(sort, chain.head->data);
+            sllnode_free(chain.head);
+
+            chain.head = next;
+        }
+
+        free(list);
+
+        return NULL;
+    }
+
+    list->head = chain.head;
+    list->size = chain.size;
+
+    return list;
+}
+
+/*
+    extsort_finish_stream
+    Merge every element pushed, in order, into an output callback, without building a list. The sort is left empty.
+    @param  ExtSort*                Pointer to the sort
+    @param  ExtSortEmitFunction     Output callback, which receives the ownership of each element
+    @param  void*                   Context of the callback
+    @return bool                    true if every element was emitted, false after an error or if the callback stopped the merge
+*/
+bool extsort_finish_stream(ExtSort* sort, ExtSortEmitFunction emit, void* context){
+    if(!sort || !emit || sort->failed){
+        return false;
+    }
+
+    if(sort->nruns == 0){
+        extsort_sort_pending(sort);
+
+        bool ok = true;
+
+        while(sort->pending && ok){
+            SLLNode* node = sort->pending;
+
+            sort->pending = node->next;
+            ok = emit(node->data, context);
+
+            sllnode_free(node);
+        }
+
+        //  The elements not emitted when the callback stops the merge are freed with `free_data`
+        extsort_drop_pending(sort);
+        sort->count = 0;
+
+        return ok;
+    }
+
+    ExtSortStream stream = {emit, context};
+
+    return extsort_merge_all(sort, extsort_sink_stream, &stream);
+}
+
+/*
+    extsort_size
+    Get the number of elements pushed since the sort was created or last finished
+    @param  ExtSort*    Pointer to the sort
+    @return size_t      Number of elements
+*/
+size_t extsort_size(ExtSort* sort){
+    return sort ? sort->count : 0;
+}
+
+/*
+    extsort_runs
+    Get the number of runs written to disk and not yet merged
+    @param  ExtSort*    Pointer to the sort
+    @return size_t      Number of runs
+*/
+size_t extsort_runs(ExtSort* sort){
+    return sort ? sort->nruns : 0;
+}
@@ -0,0 +1,189 @@
+#ifndef DSL_EXTSORT_H
+#define DSL_EXTSORT_H
+/*
+    Interface for the implementation of the external-memory sort.
+
+    An `ExtSort` sorts more elements than fit in memory. Elements are pushed one by one (`extsort_push`) or a whole list at a time (`extsort_push_sll`);
+    they are held in memory until the memory budget is reached, then sorted and written to a run file, serialized by a user callback.
+    Once every element is pushed, the runs are merged back, through a heap of run readers, into a new list (`extsort_finish`) or an output callback (`extsort_finish_stream`).
+    When there are more runs than the memory budget can read at once, groups of runs are first merged into longer runs.
+
+    Each run is read in blocks by a background I/O thread, with two blocks per run: while the merge consumes one block, the next one is already being read.
+
+    The serialization callbacks are:
+    - `serialize`: write the record of an element into a buffer, and return its size. If the size exceeds the capacity of the buffer, nothing needs to be written: the callback is called again with a larger buffer;
+    - `deserialize`: build an element from its record;
+    - `free_data`: free an element that is no longer needed: a pushed element once it has been written to a run, and the elements deserialized while merging runs into longer runs.
+      It should be set whenever `deserialize` allocates; NULL leaves the pushed elements to the caller.
+
+    The run files are created in the configured directory (`TMPDIR` or /tmp by default) and unlinked at once, so they are removed even if the program stops.
+    The sort is stable: equal elements come out in the order they were pushed.
+
+    The current `ExtSort` methods are:
+    - `extsort_create`: Create a new external sort
+    - `extsort_destroy`: Destroy an external sort and its runs
+    - `extsort_push`: Push an element
+    - `extsort_push_sll`: Push every element of a list, moving its nodes
+    - `extsort_finish`: Merge the elements into a new sorted list
+    - `extsort_finish_stream`: Merge the elements into an output callback
+    - `extsort_size`: Get the number of elements pushed
+    - `extsort_runs`: Get the number of runs written
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "dsl_lists.h"
+
+//  Memory budget of the sorts configured with a budget of 0
+#define EXTSORT_DEFAULT_BUDGET (64 * 1024 * 1024)
+
+//  Read-ahead block of the sorts configured with a block size of 0
+#define EXTSORT_DEFAULT_BLOCK (64 * 1024)
+
+/*
+    Serialization callbacks
+    - `ExtSortSerializeFunction` writes the record of `data` into `buffer` if it fits in `capacity` bytes, and returns its size
+    - `ExtSortDeserializeFunction` returns a new element built from the `size` bytes of `record`
+    - `ExtSortFreeFunction` frees an element
+    - `ExtSortEmitFunction` receives the sorted elements of `extsort_finish_stream`, which then belong to it; returning false stops the merge
+    `context` is the pointer given in the configuration, or to `extsort_finish_stream` for `ExtSortEmitFunction`
+*/
+typedef size_t (*ExtSortSerializeFunction)(void* data, void* buffer, size_t capacity, void* context);
+typedef void* (*ExtSortDeserializeFunction)(const void* record, size_t size, void* context);
+typedef void (*ExtSortFreeFunction)(void* data, void* context);
+typedef bool (*ExtSortEmitFunction)(void* data, void* context);
+
+/*
+    Configuration of an external sort
+    - `compare` is the comparison function of the elements, with the convention of `dsl_listsort.h`
+    - `serialize`, `deserialize` and `free_data` are the serialization callbacks, `context` their context
+    - `memory_budget` is the number of bytes the sort may hold: pushed elements (counted by their records and nodes) and read-ahead blocks; 0 for `EXTSORT_DEFAULT_BUDGET`
+    - `block_size` is the size of the read-ahead blocks, 0 for `EXTSORT_DEFAULT_BLOCK`
+    - `directory` is the directory of the run files, NULL for `TMPDIR` or /tmp
+*/
+typedef struct ExtSortConfig {
+    int (*compare)(void*, void*);
+    ExtSortSerializeFunction serialize;
+    ExtSortDeserializeFunction deserialize;
+    ExtSortFreeFunction free_data;
+    void *context;
+    size_t memory_budget;
+    size_t block_size;
+    const char *directory;
+} ExtSortConfig;
+
+/*
+    Sorted run written to disk
+    - `file` is the run file, already unlinked
+    - `size` is the number of bytes of the run
+    - `count` is the number of records of the run
+*/
+typedef struct ExtSortRun {
+    FILE *file;
+    size_t size;
+    size_t count;
+} ExtSortRun;
+
+/*
+    External sort
+    - `config` is the configuration, with the defaults filled in
+    - `pending` and `pending_tail` are the chain of the elements held in memory, `npending` their number and `pending_bytes` their cost against the budget
+    - `record` is the buffer of the serialized records, `record_capacity` its size
+    - `runs` is the array of the runs written, `nruns` their number and `runs_capacity` the size of the array
+    - `count` is the number of elements pushed
+    - `failed` is set after an I/O or allocation error; the sort then refuses any further operation
+*/
+typedef struct ExtSort {
+    ExtSortConfig config;
+    SLLNode *pending;
+    SLLNode *pending_tail;
+    size_t npending;
+    size_t pending_bytes;
+    unsigned char *record;
+    size_t record_capacity;
+    ExtSortRun *runs;
+    size_t nruns;
+    size_t runs_capacity;
+    size_t count;
+    bool failed;
+} ExtSort;
+
+//  ExtSort methods
+
+/*
+    extsort_create
+    Create a new, empty, external sort
+    @param  const ExtSortConfig*    Configuration; `compare`, `serialize` and `deserialize` are required
+    @return ExtSort*                Pointer to the new sort, NULL if the configuration is incomplete or the allocation failed
+*/
+ExtSort* extsort_create(const ExtSortConfig* config);
+
+/*
+    extsort_destroy
+    Destroy an external sort and close its runs. The elements still held in memory are freed with `free_data`, if set.
+    @param  ExtSort*    Pointer to the sort
+    @return void
+*/
+void extsort_destroy(ExtSort* sort);
+
+/*
+    extsort_push
+    Push an element. When the memory budget is reached, the elements held are sorted and written to a new run.
+    @param  ExtSort*    Pointer to the sort
+    @param  void*       Pointer to the element
+    @return bool        true if the operation was successful, false after an I/O or allocation error
+*/
+bool extsort_push(ExtSort* sort, void* data);
+
+/*
+    extsort_push_sll
+    Push every element of a singly linked list, in order. The nodes are moved into the sort, so the list is left empty and no node is allocated.
+    @param  ExtSort*            Pointer to the sort
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false after an I/O error (the elements not yet pushed stay in the list)
+*/
+bool extsort_push_sll(ExtSort* sort, SinglyLinkedList* list);
+
+/*
+    extsort_finish
+    Merge every element pushed into a new sorted list. If no run was written, the elements are sorted in memory and returned as they were pushed;
+    otherwise the list holds the elements built by `deserialize`. The sort is left empty, ready for new elements.
+    @param  ExtSort*            Pointer to the sort
+    @return SinglyLinkedList*   Pointer to the new list, NULL after an I/O or allocation error
+*/
+SinglyLinkedList* extsort_finish(ExtSort* sort);
+
+/*
+    extsort_finish_stream
+    Merge every element pushed, in order, into an output callback, without building a list. The sort is left empty, ready for new elements;
+    if the callback stops the merge, the elements not emitted are freed with `free_data`.
+    @param  ExtSort*                Pointer to the sort
+    @param  ExtSortEmitFunction     Output callback, which receives the ownership of each element
+    @param  void*                   Context of the callback
+    @return bool                    true if every element was emitted, false after an error or if the callback stopped the merge
+*/
+bool extsort_finish_stream(ExtSort* sort, ExtSortEmitFunction emit, void* context);
+
+/*
+    extsort_size
+    Get the number of elements pushed since the sort was created or last finished
+    @param  ExtSort*    Pointer to the sort
+    @return size_t      Number of elements
+*/
+size_t extsort_size(ExtSort* sort);
+
+/*
+    extsort_runs
+    Get the number of runs written to disk and not yet merged
+    @param  ExtSort*    Pointer to the sort
+    @return size_t      Number of runs
+*/
+size_t extsort_runs(ExtSort* sort);
+
+#endif // DSL_EXTSORT_H
@@ -0,0 +1,331 @@
+/*
+    Implementation of the hash index.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsl_hashindex.h"
+
+/*
+    hashindex_hash
+    Hash a key with the function of the index, or by mixing the bits of the pointer
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       Key to be hashed
+    @return size_t      Hash of the key
+*/
+static size_t hashindex_hash(HashIndex* index, void* data){
+    return index->hash ? index->hash(data) : hashindex_pointer_hash(data);
+}
+
+/*
+    hashindex_equal
+    Compare two keys with the function of the index, or by pointer
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       First key
+    @param  void*       Second key
+    @return bool        true if the keys are equal, false otherwise
+*/
+static bool hashindex_equal(HashIndex* index, void* a, void* b){
+    return index->equal ? index->equal(a, b) : a == b;
+}
+
+/*
+    hashindex_grow
+    Double the number of buckets. The relative order of the entries of a bucket is kept, so that entries with equal keys stay in list order.
+    @param  HashIndex*  Pointer to the hash index
+    @return bool        true if the operation was successful, false otherwise
+*/
+static bool hashindex_grow(HashIndex* index){
+    size_t capacity = index->capacity * 2;
+    HashIndexEntry** buckets = (HashIndexEntry**)calloc(capacity, sizeof(HashIndexEntry*));
+
+    if(!buckets){
+        return false;
+    }
+
+    HashIndexEntry** tails = (HashIndexEntry**)calloc(capacity, sizeof(HashIndexEntry*));
+
+    if(!tails){
+        free(buckets);
+        return false;
+    }
+
+    for(size_t i = 0; i < index->capacity; i++){
+        HashIndexEntry* entry = index->buckets[i];
+
+        while(entry){
+            HashIndexEntry* next = entry->next;
+            size_t bucket = entry->hash & (capacity - 1);
+
+            entry->next = NULL;
+            if(tails[bucket]){
+                tails[bucket]->next = entry;
+            }   else{
+                    buckets[bucket] = entry;
+            }
+            tails[bucket] = entry;
+
+            entry = next;
+        }
+    }
+
+    free(tails);
+    free(index->buckets);
+    index->buckets = buckets;
+    index->capacity = capacity;
+
+    return true;
+}
+
+/*
+    hashindex_entry_create
+    Allocate an entry, growing the index first when it is full
+    @param  HashIndex*          Pointer to the hash index
+    @param  void*               Key of the entry
+    @param  void*               Pointer to the node
+    @param  void*               Pointer to the previous node
+    @return HashIndexEntry*     Pointer to the new entry, NULL if the allocation failed
+*/
+static HashIndexEntry* hashindex_entry_create(HashIndex* index, void* data, void* node, void* previous){
+    //  Keep the load factor under 1; a failed growth only makes the chains longer
+    if(index->size >= index->capacity){
+        hashindex_grow(index);
+    }
+
+    HashIndexEntry* entry = (HashIndexEntry*)malloc(sizeof(HashIndexEntry));
+
+    if(!entry){
+        return NULL;
+    }
+
+    entry->data = data;
+    entry->node = node;
+    entry->previous = previous;
+    entry->hash = hashindex_hash(index, data);
+    entry->next = NULL;
+
+    return entry;
+}
+
+/*
+    hashindex_create
+    Create a new, empty, hash index
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return HashIndex*                      Pointer to the new hash index, NULL if the allocation failed
+*/
+HashIndex* hashindex_create(size_t (*hash)(void*), bool (*equal)(void*, void*)){
+    HashIndex* index = (HashIndex*)malloc(sizeof(HashIndex));
+
+    if(!index){
+        return NULL;
+    }
+
+    index->buckets = (HashIndexEntry**)calloc(HASHINDEX_INITIAL_CAPACITY, sizeof(HashIndexEntry*));
+
+    if(!index->buckets){
+        free(index);
+        return NULL;
+    }
+
+    index->capacity = HASHINDEX_INITIAL_CAPACITY;
+    index->size = 0;
+    index->hash = hash;
+    index->equal = equal;
+
+    return index;
+}
+
+/*
+    hashindex_destroy
+    Destroy a hash index. The indexed nodes are not freed.
+    @param  HashIndex*  Pointer to the hash index
+    @return void
+*/
+void hashindex_destroy(HashIndex* index){
+    hashindex_clear(index);
+    free(index->buckets);
+    free(index);
+}
+
+/*
+    hashindex_clear
+    Remove every entry of a hash index
+    @param  HashIndex*  Pointer to the hash index
+    @return void
+*/
+void hashindex_clear(HashIndex* index){
+    for(size_t i = 0; i < index->capacity; i++){
+        HashIndexEntry* entry = index->buckets[i];
+        HashIndexEntry* next = NULL;
+
+        while(entry){
+            next = entry->next;
+            free(entry);
+            entry = next;
+        }
+
+        index->buckets[i] = NULL;
+    }
+
+    index->size = 0;
+}
+
+/*
+    hashindex_insert
+    Add an entry, placed before the entries with an equal key
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       Key of the entry, the `data` of the node
+    @param  void*       Pointer to the node
+    @param  void*       Pointer to the previous node in the list, or NULL
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool hashindex_insert(HashIndex* index, void* data, void* node, void* previous){
+    HashIndexEntry* entry = hashindex_entry_create(index, data, node, previous);
+
+    if(!entry){
+        return false;
+    }
+
+    //  The head of the chain comes before every entry with an equal key
+    size_t bucket = entry->hash & (index->capacity - 1);
+    entry->next = index->buckets[bucket];
+    index->buckets[bucket] = entry;
+    index->size++;
+
+    return true;
+}
+
+/*
+    hashindex_append
+    Add an entry, placed after the entries with an equal key
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       Key of the entry, the `data` of the node
+    @param  void*       Pointer to the node
+    @param  void*       Pointer to the previous node in the list, or NULL
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool hashindex_append(HashIndex* index, void* data, void* node, void* previous){
+    HashIndexEntry* entry = hashindex_entry_create(index, data, node, previous);
+
+    if(!entry){
+        return false;
+    }
+
+    //  The tail of the chain comes after every entry with an equal key
+    HashIndexEntry** link = &index->buckets[entry->hash & (index->capacity - 1)];
+    while(*link){
+        link = &(*link)->next;
+    }
+
+    *link = entry;
+    index->size++;
+
+    return true;
+}
+
+/*
+    hashindex_find
+    Find the first entry with a key equal to `data`
+    @param  HashIndex*          Pointer to the hash index
+    @param  void*               Key to be searched
+    @return HashIndexEntry*     Pointer to the entry if found, NULL otherwise
+*/
+HashIndexEntry* hashindex_find(HashIndex* index, void* data){
+    size_t hash = hashindex_hash(index, data);
+    HashIndexEntry* entry = index->buckets[hash & (index->capacity - 1)];
+
+    while(entry){
+        if(entry->hash == hash && hashindex_equal(index, entry->data, data)){
+            return entry;
+        }
+
+        entry = entry->next;
+    }
+
+    return NULL;
+}
+
+/*
+    hashindex_find_node
+    Find the entry of a given node
+    @param  HashIndex*          Pointer to the hash index
+    @param  void*               Key of the entry, the `data` of the node
+    @param  void*               Pointer to the node
+    @return HashIndexEntry*     Pointer to the entry if found, NULL otherwise
+*/
+HashIndexEntry* hashindex_find_node(HashIndex* index, void* data, void* node){
+    size_t hash = hashindex_hash(index, data);
+    HashIndexEntry* entry = index->buckets[hash & (index->capacity - 1)];
+
+    while(entry){
+        if(entry->node == node){
+            return entry;
+        }
+
+        entry = entry->next;
+    }
+
+    return NULL;
+}
+
+/*
+    hashindex_remove
+    Remove an entry from a hash index and free it
+    @param  HashIndex*          Pointer to the hash index
+    @param  HashIndexEntry*     Pointer to the entry
+    @return bool                true if the operation was successful, false otherwise
+*/
+bool hashindex_remove(HashIndex* index, HashIndexEntry* entry){
+    HashIndexEntry** link = &index->buckets[entry->hash & (index->capacity - 1)];
+
+    while(*link){
+        if(*link == entry){
+            *link = entry->next;
+            free(entry);
+            index->size--;
+
+            return true;
+        }
+
+        link = &(*link)->next;
+    }
+
+    return false;
+}
+
+/*
+    hashindex_size
+    Get the number of entries of a hash index
+    @param  HashIndex*  Pointer to the hash index
+    @return size_t      Number of entries
+*/
+size_t hashindex_size(HashIndex* index){
+    return index->size;
+}
+
+/*
+    hashindex_pointer_hash
+    Hash a pointer by mixing its bits, as the index does when no hash function is given
+    @param  void*   Pointer to be hashed
+    @return size_t  Hash of the pointer
+*/
+size_t hashindex_pointer_hash(void* data){
+    //  Allocated pointers share their low bits: mix them (murmur3 finalizer)
+    uint64_t x = (uint64_t)(uintptr_t)data;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+
+    return (size_t)x;
+}
@@ -0,0 +1,168 @@
+#ifndef DSL_HASHINDEX_H
+#define DSL_HASHINDEX_H
+/*
+    Interface for the implementation of the hash index.
+
+    A `HashIndex` is a chained hash table that maps the `data` of the nodes of a list to the nodes themselves.
+    It is the side index of the lists in `dsl_lists.h` (see `sll_index_attach` and `dll_index_attach`): once attached, it is maintained by the insert, append and remove functions of the list, and search and remove take O(1) expected time instead of a linear scan.
+
+    The index holds one entry per node. An entry records:
+    - the `data` of the node, which is the key of the entry;
+    - the `node` itself;
+    - the node that `previous`ly comes in the list, which a singly linked list needs to unlink a node in O(1).
+    The nodes are stored as `void*`, so the index does not depend on the node types.
+
+    Keys are compared by pointer by default. A `hash` and `equal` pair can be given instead to index the lists by the pointed values.
+    Entries with equal keys keep the order of their nodes in the list: `hashindex_find` returns the entry of the first one, like the linear search does.
+
+    The current `HashIndex` methods are:
+    - `hashindex_create`: Create a new hash index
+    - `hashindex_destroy`: Destroy a hash index
+    - `hashindex_clear`: Remove every entry of a hash index
+    - `hashindex_insert`: Add an entry before the entries with an equal key
+    - `hashindex_append`: Add an entry after the entries with an equal key
+    - `hashindex_find`: Find the first entry with a given key
+    - `hashindex_find_node`: Find the entry of a given node
+    - `hashindex_remove`: Remove an entry
+    - `hashindex_size`: Get the number of entries of a hash index
+    - `hashindex_pointer_hash`: Hash a pointer, as the index does by default
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//  Initial number of buckets of a hash index (a power of two)
+#define HASHINDEX_INITIAL_CAPACITY 16
+
+/*
+    Entry of a hash index
+    - `data` is the key of the entry, the `data` of the indexed node
+    - `node` is a pointer to the indexed node
+    - `previous` is a pointer to the node before `node` in the list, NULL for the first node (only maintained for singly linked lists)
+    - `hash` is the hash of `data`
+    - `next` is a pointer to the next entry of the bucket
+*/
+typedef struct HashIndexEntry {
+    void *data;
+    void *node;
+    void *previous;
+    size_t hash;
+    struct HashIndexEntry *next;
+} HashIndexEntry;
+
+/*
+    Hash index
+    - `buckets` is the array of the entry chains
+    - `capacity` is the number of buckets, a power of two
+    - `size` is the number of entries
+    - `hash` is the hash function of the keys, NULL to hash the pointers
+    - `equal` is the equality function of the keys, NULL to compare the pointers
+*/
+typedef struct HashIndex {
+    HashIndexEntry **buckets;
+    size_t capacity;
+    size_t size;
+    size_t (*hash)(void*);
+    bool (*equal)(void*, void*);
+} HashIndex;
+
+//  Hash Index methods
+
+/*
+    hashindex_create
+    Create a new, empty, hash index
+    @param  size_t (*hash)(void*)           Hash function of the keys, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the keys, NULL to compare the pointers
+    @return HashIndex*                      Pointer to the new hash index, NULL if the allocation failed
+*/
+HashIndex* hashindex_create(size_t (*hash)(void*), bool (*equal)(void*, void*));
+
+/*
+    hashindex_destroy
+    Destroy a hash index. The indexed nodes are not freed.
+    @param  HashIndex*  Pointer to the hash index
+    @return void
+*/
+void hashindex_destroy(HashIndex* index);
+
+/*
+    hashindex_clear
+    Remove every entry of a hash index
+    @param  HashIndex*  Pointer to the hash index
+    @return void
+*/
+void hashindex_clear(HashIndex* index);
+
+/*
+    hashindex_insert
+    Add an entry, placed before the entries with an equal key (the node was inserted before them in the list)
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       Key of the entry, the `data` of the node
+    @param  void*       Pointer to the node
+    @param  void*       Pointer to the previous node in the list, or NULL
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool hashindex_insert(HashIndex* index, void* data, void* node, void* previous);
+
+/*
+    hashindex_append
+    Add an entry, placed after the entries with an equal key (the node was appended after them in the list)
+    @param  HashIndex*  Pointer to the hash index
+    @param  void*       Key of the entry, the `data` of the node
+    @param  void*       Pointer to the node
+    @param  void*       Pointer to the previous node in the list, or NULL
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool hashindex_append(HashIndex* index, void* data, void* node, void* previous);
+
+/*
+    hashindex_find
+    Find the first entry with a key equal to `data`
+    @param  HashIndex*          Pointer to the hash index
+    @param  void*               Key to be searched
+    @return HashIndexEntry*     Pointer to the entry if found, NULL otherwise
+*/
+HashIndexEntry* hashindex_find(HashIndex* index, void* data);
+
+/*
+    hashindex_find_node
+    Find the entry of a given node
+    @param  HashIndex*          Pointer to the hash index
+    @param  void*               Key of the entry, the `data` of the node
+    @param  void*               Pointer to the node
+    @return HashIndexEntry*     Pointer to the entry if found, NULL otherwise
+*/
+HashIndexEntry* hashindex_find_node(HashIndex* index, void* data, void* node);
+
+/*
+    hashindex_remove
+    Remove an entry from a hash index and free it
+    @param  HashIndex*          Pointer to the hash index
+    @param  HashIndexEntry*     Pointer to the entry, as returned by `hashindex_find` or `hashindex_find_node`
+    @return bool                true if the operation was successful, false otherwise
+*/
+bool hashindex_remove(HashIndex* index, HashIndexEntry* entry);
+
+/*
+    hashindex_size
+    Get the number of entries of a hash index
+    @param  HashIndex*  Pointer to the hash index
+    @return size_t      Number of entries
+*/
+size_t hashindex_size(HashIndex* index);
+
+/*
+    hashindex_pointer_hash
+    Hash a pointer by mixing its bits, as the index does when no hash function is given
+    @param  void*   Pointer to be hashed
+    @return size_t  Hash of the pointer
+*/
+size_t hashindex_pointer_hash(void* data);
+
+#endif // DSL_HASHINDEX_H
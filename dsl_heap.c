@@ -0,0 +1,501 @@
+/*
+    Implementation of the d-ary heap priority queue.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "dsl_heap.h"
+
+/*
+    heap_place
+    Store an element at a position of the heap array and record the position of its handle
+    @param  Heap*       Pointer to the heap
+    @param  size_t      Position in the heap array
+    @param  void*       Pointer to the data of the element
+    @param  HeapHandle  Handle of the element
+    @return void
+*/
+static void heap_place(Heap* heap, size_t position, void* data, HeapHandle handle){
+    heap->items[position] = data;
+    heap->handles[position] = handle;
+    heap->positions[handle] = position;
+}
+
+/*
+    heap_sift_up
+    Move the element at a position up until its parent is not greater than it
+    @param  Heap*   Pointer to the heap
+    @param  size_t  Position of the element
+    @return void
+*/
+static void heap_sift_up(Heap* heap, size_t position){
+    void* data = heap->items[position];
+    HeapHandle handle = heap->handles[position];
+
+    //  Move the parents down into the hole instead of swapping
+    while(position > 0){
+        size_t parent = (position - 1) / heap->arity;
+
+        if(heap->compare(data, heap->items[parent]) >= 0){
+            break;
+        }
+
+        heap_place(heap, position, heap->items[parent], heap->handles[parent]);
+        position = parent;
+    }
+
+    heap_place(heap, position, data, handle);
+}
+
+/*
+    heap_sift_down
+    Move the element at a position down until none of its children is less than it
+    @param  Heap*   Pointer to the heap
+    @param  size_t  Position of the element
+    @return void
+*/
+static void heap_sift_down(Heap* heap, size_t position){
+    void* data = heap->items[position];
+    HeapHandle handle = heap->handles[position];
+
+    for(;;){
+        size_t first = position * heap->arity + 1;
+
+        if(first >= heap->size){
+            break;
+        }
+
+        size_t last = first + heap->arity < heap->size ? first + heap->arity : heap->size;
+        size_t smallest = first;
+
+        for(size_t child = first + 1; child < last; child++){
+            if(heap->compare(heap->items[child], heap->items[smallest]) < 0){
+                smallest = child;
+            }
+        }
+
+        if(heap->compare(heap->items[smallest], data) >= 0){
+            break;
+        }
+
+        heap_place(heap, position, heap->items[smallest], heap->handles[smallest]);
+        position = smallest;
+    }
+
+    heap_place(heap, position, data, handle);
+}
+
+/*
+    heap_heapify
+    Establish the heap order over the whole array (Floyd's method, O(N))
+    @param  Heap*   Pointer to the heap
+    @return void
+*/
+static void heap_heapify(Heap* heap){
+    if(heap->size < 2){
+        return;
+    }
+
+    for(size_t i = (heap->size - 2) / heap->arity + 1; i-- > 0;){
+        heap_sift_down(heap, i);
+    }
+}
+
+/*
+    heap_reserve
+    Grow the arrays of a heap to hold at least `size` elements and `nhandles` handles
+    @param  Heap*   Pointer to the heap
+    @param  size_t  Number of elements
+    @param  size_t  Number of handles
+    @return bool    true if the operation was successful, false otherwise
+*/
+static bool heap_reserve(Heap* heap, size_t size, size_t nhandles){
+    if(size > heap->capacity){
+        size_t capacity = heap->capacity ? heap->capacity : 16;
+        while(capacity < size){
+            capacity *= 2;
+        }
+
+        void** items = (void**)realloc(heap->items, capacity * sizeof(void*));
+        if(!items){
+            return false;
+        }
+        heap->items = items;
+
+        HeapHandle* handles = (HeapHandle*)realloc(heap->handles, capacity * sizeof(HeapHandle));
+        if(!handles){
+            return false;
+        }
+        heap->handles = handles;
+
+        heap->capacity = capacity;
+    }
+
+    if(nhandles > heap->handle_capacity){
+        size_t capacity = heap->handle_capacity ? heap->handle_capacity : 16;
+        while(capacity < nhandles){
+            capacity *= 2;
+        }
+
+        size_t* positions = (size_t*)realloc(heap->positions, capacity * sizeof(size_t));
+        if(!positions){
+            return false;
+        }
+        heap->positions = positions;
+
+        HeapHandle* free_handles = (HeapHandle*)realloc(heap->free_handles, capacity * sizeof(HeapHandle));
+        if(!free_handles){
+            return false;
+        }
+        heap->free_handles = free_handles;
+
+        heap->handle_capacity = capacity;
+    }
+
+    return true;
+}
+
+/*
+    heap_release
+    Remove the element at a position and recycle its handle
+    @param  Heap*   Pointer to the heap
+    @param  size_t  Position of the element
+    @return void*   Pointer to the data of the element
+*/
+static void* heap_release(Heap* heap, size_t position){
+    void* data = heap->items[position];
+    HeapHandle handle = heap->handles[position];
+
+    heap->positions[handle] = HEAP_NO_POSITION;
+    heap->free_handles[heap->nfree++] = handle;
+    heap->size--;
+
+    //  Fill the hole with the last element, which may have to move either way
+    if(position < heap->size){
+        HeapHandle moved = heap->handles[heap->size];
+
+        heap_place(heap, position, heap->items[heap->size], moved);
+        heap_sift_up(heap, position);
+        heap_sift_down(heap, heap->positions[moved]);
+    }
+
+    return data;
+}
+
+/*
+    heap_create
+    Create a new, empty, heap
+    @param  size_t                          Number of children of each element, `HEAP_DEFAULT_ARITY` if below 2
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_create(size_t arity, int (*compare)(void*, void*)){
+    Heap* heap = (Heap*)malloc(sizeof(Heap));
+
+    if(!heap){
+        return NULL;
+    }
+
+    heap->items = NULL;
+    heap->handles = NULL;
+    heap->positions = NULL;
+    heap->free_handles = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+    heap->nhandles = 0;
+    heap->handle_capacity = 0;
+    heap->nfree = 0;
+    heap->arity = arity < 2 ? HEAP_DEFAULT_ARITY : arity;
+    heap->compare = compare;
+
+    return heap;
+}
+
+/*
+    heap_destroy
+    Destroy a heap. The data of the elements is not freed.
+    @param  Heap*   Pointer to the heap
+    @return void
+*/
+void heap_destroy(Heap* heap){
+    free(heap->items);
+    free(heap->handles);
+    free(heap->positions);
+    free(heap->free_handles);
+    free(heap);
+}
+
+/*
+    heap_push
+    Insert a new element
+    @param  Heap*           Pointer to the heap
+    @param  void*           Pointer to the data of the element
+    @param  HeapHandle*     If not NULL, receives the handle of the element
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool heap_push(Heap* heap, void* data, HeapHandle* handle){
+    if(!heap_reserve(heap, heap->size + 1, heap->nfree ? heap->nhandles : heap->nhandles + 1)){
+        return false;
+    }
+
+    HeapHandle id = heap->nfree ? heap->free_handles[--heap->nfree] : heap->nhandles++;
+
+    heap_place(heap, heap->size, data, id);
+    heap->size++;
+    heap_sift_up(heap, heap->size - 1);
+
+    if(handle){
+        *handle = id;
+    }
+
+    return true;
+}
+
+/*
+    heap_pop_min
+    Remove the minimum element
+    @param  Heap*   Pointer to the heap
+    @return void*   Pointer to the data of the minimum element, NULL if the heap is empty
+*/
+void* heap_pop_min(Heap* heap){
+    if(heap->size == 0){
+        return NULL;
+    }
+
+    return heap_release(heap, 0);
+}
+
+/*
+    heap_peek
+    Get the minimum element
+    @param  Heap*   Pointer to the heap
+    @return void*   Pointer to the data of the minimum element, NULL if the heap is empty
+*/
+void* heap_peek(Heap* heap){
+    return heap->size ? heap->items[0] : NULL;
+}
+
+/*
+    heap_decrease_key
+    Restore the heap order after the priority of an element decreased
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return bool        true if the operation was successful, false if the handle is not in the heap
+*/
+bool heap_decrease_key(Heap* heap, HeapHandle handle){
+    if(!heap_contains(heap, handle)){
+        return false;
+    }
+
+    heap_sift_up(heap, heap->positions[handle]);
+
+    return true;
+}
+
+/*
+    heap_update
+    Restore the heap order after the priority of an element changed in either direction
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return bool        true if the operation was successful, false if the handle is not in the heap
+*/
+bool heap_update(Heap* heap, HeapHandle handle){
+    if(!heap_contains(heap, handle)){
+        return false;
+    }
+
+    heap_sift_up(heap, heap->positions[handle]);
+    heap_sift_down(heap, heap->positions[handle]);
+
+    return true;
+}
+
+/*
+    heap_remove
+    Remove an element
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return void*       Pointer to the data of the element, NULL if the handle is not in the heap
+*/
+void* heap_remove(Heap* heap, HeapHandle handle){
+    if(!heap_contains(heap, handle)){
+        return NULL;
+    }
+
+    return heap_release(heap, heap->positions[handle]);
+}
+
+/*
+    heap_contains
+    Check whether a handle refers to an element of the heap
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle to be checked
+    @return bool        true if the element is in the heap, false otherwise
+*/
+bool heap_contains(Heap* heap, HeapHandle handle){
+    return handle < heap->nhandles && heap->positions[handle] != HEAP_NO_POSITION;
+}
+
+/*
+    heap_merge
+    Move every element of `source` into `heap`, leaving `source` empty
+    The handles of `source` are invalidated: the moved elements get new handles of `heap`, which are written to `handles` at the index of their old handle.
+    @param  Heap*           Pointer to the destination heap
+    @param  Heap*           Pointer to the source heap, which must not be `heap`
+    @param  HeapHandle*     Receives the new handle of each handle of `source`, `HEAP_NO_POSITION` for an unused one; `source->nhandles` entries, or NULL
+    @return bool            true if the operation was successful, false if `source` is `heap` or the allocation failed (both heaps are then left unchanged)
+*/
+bool heap_merge(Heap* heap, Heap* source, HeapHandle* handles){
+    if(heap == source){
+        return false;
+    }
+
+    size_t total = heap->size + source->size;
+
+    if(!heap_reserve(heap, total, heap->nhandles + source->size)){
+        return false;
+    }
+
+    //  Pushing costs about k log(N) comparisons, rebuilding about 2N
+    size_t depth = 1;
+    for(size_t n = total; n > 1; n /= heap->arity){
+        depth++;
+    }
+    bool rebuild = source->size * depth > 2 * total;
+
+    if(handles){
+        for(size_t i = 0; i < source->nhandles; i++){
+            handles[i] = HEAP_NO_POSITION;
+        }
+    }
+
+    for(size_t i = 0; i < source->size; i++){
+        HeapHandle id = heap->nhandles++;
+
+        if(handles){
+            handles[source->handles[i]] = id;
+        }
+
+        heap_place(heap, heap->size, source->items[i], id);
+        heap->size++;
+
+        if(!rebuild){
+            heap_sift_up(heap, heap->size - 1);
+        }
+    }
+
+    if(rebuild){
+        heap_heapify(heap);
+    }
+
+    //  Every handle of `source` is released
+    source->size = 0;
+    source->nhandles = 0;
+    source->nfree = 0;
+
+    return true;
+}
+
+/*
+    heap_from_sll
+    Build a heap from the elements of a singly linked list, in O(N)
+    @param  SinglyLinkedList*               Pointer to the list
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_sll(SinglyLinkedList* list, size_t arity, int (*compare)(void*, void*)){
+    Heap* heap = heap_create(arity, compare);
+
+    if(!heap || !heap_reserve(heap, list->size, list->size)){
+        if(heap){
+            heap_destroy(heap);
+        }
+        return NULL;
+    }
+
+    for(SLLNode* current = list->head; current; current = current->next){
+        heap_place(heap, heap->size, current->data, heap->size);
+        heap->size++;
+    }
+
+    heap->nhandles = heap->size;
+    heap_heapify(heap);
+
+    return heap;
+}
+
+/*
+    heap_from_dll
+    Build a heap from the elements of a doubly linked list, in O(N)
+    @param  DoublyLinkedList*               Pointer to the list
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_dll(DoublyLinkedList* list, size_t arity, int (*compare)(void*, void*)){
+    Heap* heap = heap_create(arity, compare);
+
+    if(!heap || !heap_reserve(heap, list->size, list->size)){
+        if(heap){
+            heap_destroy(heap);
+        }
+        return NULL;
+    }
+
+    for(DLLNode* current = list->head; current; current = current->next){
+        heap_place(heap, heap->size, current->data, heap->size);
+        heap->size++;
+    }
+
+    heap->nhandles = heap->size;
+    heap_heapify(heap);
+
+    return heap;
+}
+
+/*
+    heap_from_queue
+    Build a heap from the elements of a queue, in O(N)
+    @param  Queue*                          Pointer to the queue
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_queue(Queue* queue, size_t arity, int (*compare)(void*, void*)){
+    Heap* heap = heap_create(arity, compare);
+
+    if(!heap || !heap_reserve(heap, queue->size, queue->size)){
+        if(heap){
+            heap_destroy(heap);
+        }
+        return NULL;
+    }
+
+    for(DLLNode* current = queue->front; current; current = current->next){
+        heap_place(heap, heap->size, current->data, heap->size);
+        heap->size++;
+    }
+
+    heap->nhandles = heap->size;
+    heap_heapify(heap);
+
+    return heap;
+}
+
+/*
+    heap_size
+    Get the number of elements in a heap
+    @param  Heap*   Pointer to the heap
+    @return size_t  Number of elements in the heap
+*/
+size_t heap_size(Heap* heap){
+    return heap->size;
+}
@@ -0,0 +1,215 @@
+#ifndef DSL_HEAP_H
+#define DSL_HEAP_H
+/*
+    Interface for the implementation of the d-ary heap priority queue.
+
+    A `Heap` keeps its elements in a contiguous array ordered as a d-ary min-heap: every element compares less than or equal to its `arity` children.
+    The minimum is read in O(1), push, pop and priority updates take O(log N), and a heap is built from a list in O(N).
+    A larger arity makes the heap shallower (cheaper push and decrease-key, more comparisons per pop); 4 is a good default.
+
+    The elements are ordered by a comparison function with the same convention as the sorting functions of `dsl_listsort.h`:
+    int compare(void* a, void* b);
+
+    Every element gets a `HeapHandle` when it enters the heap. The handle stays valid while the element is in the heap, whatever its position, and is used to update its priority or remove it.
+    Handles are recycled once their element leaves the heap.
+
+    The current `Heap` methods are:
+    - `heap_create`: Create a new heap
+    - `heap_destroy`: Destroy a heap
+    - `heap_push`: Insert a new element
+    - `heap_pop_min`: Remove the minimum element
+    - `heap_peek`: Get the minimum element
+    - `heap_decrease_key`: Restore the order after the priority of an element decreased
+    - `heap_update`: Restore the order after the priority of an element changed
+    - `heap_remove`: Remove an element
+    - `heap_contains`: Check whether a handle refers to an element of the heap
+    - `heap_merge`: Move every element of a heap into another
+    - `heap_from_sll`, `heap_from_dll`, `heap_from_queue`: Build a heap from a list
+    - `heap_size`: Get the number of elements in a heap
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dsl_lists.h"
+
+//  Arity of the heaps created with an arity below 2
+#define HEAP_DEFAULT_ARITY 4
+
+//  Position of a handle whose element is not in the heap
+#define HEAP_NO_POSITION ((size_t)-1)
+
+/*
+    Handle of an element of a heap
+*/
+typedef size_t HeapHandle;
+
+/*
+    d-ary heap
+    - `items` is the array of the elements, in heap order
+    - `handles` is the handle of the element at each position of `items`
+    - `positions` is the position in `items` of the element of each handle, `HEAP_NO_POSITION` for unused handles
+    - `size` is the number of elements
+    - `capacity` is the number of elements `items` can hold
+    - `nhandles` is the number of handles issued, the length of `positions`
+    - `handle_capacity` is the number of handles `positions` can hold
+    - `free_handles` is the stack of the handles to recycle, `nfree` its size
+    - `arity` is the number of children of each element
+    - `compare` is the comparison function ordering the elements
+*/
+typedef struct Heap {
+    void **items;
+    HeapHandle *handles;
+    size_t *positions;
+    size_t size;
+    size_t capacity;
+    size_t nhandles;
+    size_t handle_capacity;
+    HeapHandle *free_handles;
+    size_t nfree;
+    size_t arity;
+    int (*compare)(void*, void*);
+} Heap;
+
+//  Heap methods
+
+/*
+    heap_create
+    Create a new, empty, heap
+    @param  size_t                          Number of children of each element, `HEAP_DEFAULT_ARITY` if below 2
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_create(size_t arity, int (*compare)(void*, void*));
+
+/*
+    heap_destroy
+    Destroy a heap. The data of the elements is not freed.
+    @param  Heap*   Pointer to the heap
+    @return void
+*/
+void heap_destroy(Heap* heap);
+
+/*
+    heap_push
+    Insert a new element
+    @param  Heap*           Pointer to the heap
+    @param  void*           Pointer to the data of the element
+    @param  HeapHandle*     If not NULL, receives the handle of the element
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool heap_push(Heap* heap, void* data, HeapHandle* handle);
+
+/*
+    heap_pop_min
+    Remove the minimum element
+    @param  Heap*   Pointer to the heap
+    @return void*   Pointer to the data of the minimum element, NULL if the heap is empty
+*/
+void* heap_pop_min(Heap* heap);
+
+/*
+    heap_peek
+    Get the minimum element
+    @param  Heap*   Pointer to the heap
+    @return void*   Pointer to the data of the minimum element, NULL if the heap is empty
+*/
+void* heap_peek(Heap* heap);
+
+/*
+    heap_decrease_key
+    Restore the heap order after the priority of an element decreased (its data compares less than before)
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return bool        true if the operation was successful, false if the handle is not in the heap
+*/
+bool heap_decrease_key(Heap* heap, HeapHandle handle);
+
+/*
+    heap_update
+    Restore the heap order after the priority of an element changed in either direction
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return bool        true if the operation was successful, false if the handle is not in the heap
+*/
+bool heap_update(Heap* heap, HeapHandle handle);
+
+/*
+    heap_remove
+    Remove an element
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle of the element
+    @return void*       Pointer to the data of the element, NULL if the handle is not in the heap
+*/
+void* heap_remove(Heap* heap, HeapHandle handle);
+
+/*
+    heap_contains
+    Check whether a handle refers to an element of the heap
+    @param  Heap*       Pointer to the heap
+    @param  HeapHandle  Handle to be checked
+    @return bool        true if the element is in the heap, false otherwise
+*/
+bool heap_contains(Heap* heap, HeapHandle handle);
+
+/*
+    heap_merge
+    Move every element of `source` into `heap`, leaving `source` empty.
+    A small `source` is pushed element by element; otherwise the merged array is heapified in O(N).
+    The handles of `source` are invalidated: the moved elements get new handles of `heap`, which are written to `handles` at the index of their old handle.
+    @param  Heap*           Pointer to the destination heap
+    @param  Heap*           Pointer to the source heap, which must not be `heap`
+    @param  HeapHandle*     Receives the new handle of each handle of `source`, `HEAP_NO_POSITION` for an unused one; `source->nhandles` entries, or NULL
+    @return bool            true if the operation was successful, false if `source` is `heap` or the allocation failed (both heaps are then left unchanged)
+*/
+bool heap_merge(Heap* heap, Heap* source, HeapHandle* handles);
+
+/*
+    heap_from_sll
+    Build a heap from the elements of a singly linked list, in O(N). The list is not modified.
+    The handle of each element is its index in the list.
+    @param  SinglyLinkedList*               Pointer to the list
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_sll(SinglyLinkedList* list, size_t arity, int (*compare)(void*, void*));
+
+/*
+    heap_from_dll
+    Build a heap from the elements of a doubly linked list, in O(N). The list is not modified.
+    The handle of each element is its index in the list.
+    @param  DoublyLinkedList*               Pointer to the list
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_dll(DoublyLinkedList* list, size_t arity, int (*compare)(void*, void*));
+
+/*
+    heap_from_queue
+    Build a heap from the elements of a queue, in O(N). The queue is not modified.
+    The handle of each element is its index in the queue, from the front.
+    @param  Queue*                          Pointer to the queue
+    @param  size_t                          Number of children of each element
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return Heap*                           Pointer to the new heap, NULL if the allocation failed
+*/
+Heap* heap_from_queue(Queue* queue, size_t arity, int (*compare)(void*, void*));
+
+/*
+    heap_size
+    Get the number of elements in a heap
+    @param  Heap*   Pointer to the heap
+    @return size_t  Number of elements in the heap
+*/
+size_t heap_size(Heap* heap);
+
+#endif // DSL_HEAP_H
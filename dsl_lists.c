@@ -15,8 +15,295 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 #include "dsl_lists.h"
+#include "dsl_hashindex.h"
+#include "dsl_cursor.h"
+#include "dsl_nodecache.h"
+
+/*
+    0. Node blocks
+    The bulk constructors allocate all the nodes of a list, and optionally their payloads, in one block.
+    A block starts with a header holding its number of live nodes, and covers whole pages of `NODE_BLOCK_PAGE_SIZE` bytes that belong to it alone.
+    A page map, as in memory allocators, gives the block of every such page: the node free functions look up the page of a node without any lock,
+    recognize a node of a block, and only decrement the count of the block, which is freed with its last node. Any other node finds no block and goes
+    straight to its node cache. The map is only locked to register and unregister a block.
+    Nodes of a block can therefore be removed, moved to other lists and freed like any other node.
+    The other nodes are allocated from, and released into, the node cache of their type.
+*/
+
+//  Caches of the nodes allocated one by one, one per node type
+static NodeCache sll_node_cache = NODECACHE_INITIALIZER(sizeof(SLLNode));
+static NodeCache dll_node_cache = NODECACHE_INITIALIZER(sizeof(DLLNode));
+static NodeCache cll_node_cache = NODECACHE_INITIALIZER(sizeof(CLLNode));
+
+//  Size of a page of the page map: blocks are aligned on pages and span whole pages
+#define NODE_BLOCK_PAGE_SHIFT 12
+#define NODE_BLOCK_PAGE_SIZE ((size_t)1 << NODE_BLOCK_PAGE_SHIFT)
+
+//  Bits of a page number resolved by each of the 3 levels of the page map, which covers 48-bit addresses
+#define NODE_MAP_LEVEL_BITS 12
+#define NODE_MAP_LEVEL_SIZE ((size_t)1 << NODE_MAP_LEVEL_BITS)
+
+/*
+    Header of a node block
+    - `live` is the number of nodes of the block not yet freed
+    - `nodes` is the address of the first node, `payloads` of the first payload, and `end` of the end of the pages of the block
+*/
+typedef struct NodeBlock {
+    atomic_size_t live;
+    uintptr_t nodes;
+    uintptr_t payloads;
+    uintptr_t end;
+} NodeBlock;
+
+/*
+    Levels of the page map: a leaf gives the block of each of its pages, NULL for a page outside any block, and a middle level gives its leaves.
+    The levels are allocated on the first block registered in their range and never freed, so they can be read without the lock.
+*/
+typedef struct NodeMapLeaf {
+    _Atomic(NodeBlock*) blocks[NODE_MAP_LEVEL_SIZE];
+} NodeMapLeaf;
+
+typedef struct NodeMapMiddle {
+    _Atomic(NodeMapLeaf*) leaves[NODE_MAP_LEVEL_SIZE];
+} NodeMapMiddle;
+
+//  Root of the page map, and the lock serializing the registrations
+static _Atomic(NodeMapMiddle*) node_map[NODE_MAP_LEVEL_SIZE];
+static pthread_mutex_t node_map_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+    node_map_slot
+    Get the entry of a page in the page map, allocating the levels leading to it if requested. The lock must be held to allocate.
+    @param  uintptr_t               Page number
+    @param  bool                    true to allocate the missing levels
+    @return _Atomic(NodeBlock*)*    Pointer to the entry, NULL if the page is out of the map or its levels are missing
+*/
+static _Atomic(NodeBlock*)* node_map_slot(uintptr_t page, bool allocate){
+    if(page >> (3 * NODE_MAP_LEVEL_BITS)){
+        return NULL;
+    }
+
+    _Atomic(NodeMapMiddle*)* root = &node_map[page >> (2 * NODE_MAP_LEVEL_BITS)];
+    NodeMapMiddle* middle = atomic_load_explicit(root, memory_order_acquire);
+
+    if(!middle){
+        if(!allocate || !(middle = (NodeMapMiddle*)calloc(1, sizeof(NodeMapMiddle)))){
+            return NULL;
+        }
+        atomic_store_explicit(root, middle, memory_order_release);
+    }
+
+    _Atomic(NodeMapLeaf*)* branch = &middle->leaves[(page >> NODE_MAP_LEVEL_BITS) & (NODE_MAP_LEVEL_SIZE - 1)];
+    NodeMapLeaf* leaf = atomic_load_explicit(branch, memory_order_acquire);
+
+    if(!leaf){
+        if(!allocate || !(leaf = (NodeMapLeaf*)calloc(1, sizeof(NodeMapLeaf)))){
+            return NULL;
+        }
+        atomic_store_explicit(branch, leaf, memory_order_release);
+    }
+
+    return &leaf->blocks[page & (NODE_MAP_LEVEL_SIZE - 1)];
+}
+
+/*
+    node_block_find
+    Find the block containing an address, without any lock
+    @param  const void*     Address of a node or of a payload
+    @return NodeBlock*      Pointer to the block, NULL if the address is in no block
+*/
+static inline NodeBlock* node_block_find(const void* address){
+    _Atomic(NodeBlock*)* slot = node_map_slot((uintptr_t)address >> NODE_BLOCK_PAGE_SHIFT, false);
+
+    return slot ? atomic_load_explicit(slot, memory_order_acquire) : NULL;
+}
+
+/*
+    node_block_map
+    Set the page map entries of the pages of a block. The lock must be held.
+    @param  NodeBlock*  Pointer to the block
+    @param  NodeBlock*  Value of the entries: the block to register it, NULL to unregister it
+    @return bool        true if the operation was successful, false if a level of the map could not be allocated
+*/
+static bool node_block_map(NodeBlock* block, NodeBlock* value){
+    uintptr_t first = (uintptr_t)block >> NODE_BLOCK_PAGE_SHIFT;
+    uintptr_t last = (block->end - 1) >> NODE_BLOCK_PAGE_SHIFT;
+
+    for(uintptr_t page = first; page <= last; page++){
+        _Atomic(NodeBlock*)* slot = node_map_slot(page, value != NULL);
+
+        if(!slot){
+            if(value){
+                //  Undo the pages already registered
+                for(uintptr_t done = first; done < page; done++){
+                    atomic_store_explicit(node_map_slot(done, false), NULL, memory_order_release);
+                }
+                return false;
+            }
+            continue;
+        }
+
+        atomic_store_explicit(slot, value, memory_order_release);
+    }
+
+    return true;
+}
+
+/*
+    node_block_alloc
+    Allocate and register a block of `count` nodes followed by `count` payloads of `element_size` bytes
+    @param  size_t      Number of nodes
+    @param  size_t      Size of a node
+    @param  size_t      Size of a payload, 0 for none
+    @param  void**      Receives the address of the first payload
+    @return void*       Pointer to the first node, NULL if the allocation failed
+*/
+static void* node_block_alloc(size_t count, size_t node_size, size_t element_size, void** payload){
+    if(count > (SIZE_MAX / 4) / node_size || (element_size && count > (SIZE_MAX / 4) / element_size)){
+        return NULL;
+    }
+
+    //  The nodes and the payloads start on the strictest alignment, like arrays of them would
+    size_t header_bytes = (sizeof(NodeBlock) + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+    size_t nodes_bytes = (count * node_size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+    size_t bytes = (header_bytes + nodes_bytes + count * element_size + NODE_BLOCK_PAGE_SIZE - 1) / NODE_BLOCK_PAGE_SIZE * NODE_BLOCK_PAGE_SIZE;
+    unsigned char* memory = (unsigned char*)aligned_alloc(NODE_BLOCK_PAGE_SIZE, bytes);
+
+    if(!memory){
+        return NULL;
+    }
+
+    NodeBlock* block = (NodeBlock*)memory;
+
+    atomic_init(&block->live, count);
+    block->nodes = (uintptr_t)(memory + header_bytes);
+    block->payloads = block->nodes + nodes_bytes;
+    block->end = (uintptr_t)(memory + bytes);
+
+    pthread_mutex_lock(&node_map_lock);
+    bool registered = node_block_map(block, block);
+    pthread_mutex_unlock(&node_map_lock);
+
+    if(!registered){
+        free(memory);
+        return NULL;
+    }
+
+    *payload = (void*)block->payloads;
+
+    return (void*)block->nodes;
+}
+
+/*
+    node_block_release
+    Release nodes from their block, and unregister and free the block if they were its last nodes
+    @param  NodeBlock*  Pointer to the block
+    @param  size_t      Number of released nodes
+    @return void
+*/
+static void node_block_release(NodeBlock* block, size_t count){
+    if(atomic_fetch_sub_explicit(&block->live, count, memory_order_acq_rel) != count){
+        return;
+    }
+
+    pthread_mutex_lock(&node_map_lock);
+    node_block_map(block, NULL);
+    pthread_mutex_unlock(&node_map_lock);
+
+    free(block);
+}
+
+/*
+    node_release
+    Free a node: a node of a block is released from its block, which is freed with its last node; any other node is released into its node cache
+    @param  void*       Pointer to the node
+    @param  NodeCache*  Pointer to the node cache of its type
+    @return void
+*/
+static void node_release(void* node, NodeCache* cache){
+    NodeBlock* block = node_block_find(node);
+
+    if(block){
+        node_block_release(block, 1);
+    }   else{
+            nodecache_free(cache, node);
+    }
+}
+
+/*
+    node_data_free
+    Free the data of a node with a free function, unless it is a payload copied into a node block, which is freed with its block
+    @param  void*               Data of the node
+    @param  ListFreeFunction    Function freeing the data, NULL to leave the data to the caller
+    @return void
+*/
+static inline void node_data_free(void* data, ListFreeFunction free_data){
+    if(free_data && !node_block_find(data)){
+        free_data(data);
+    }
+}
+
+/*
+    Batch of nodes released by a teardown
+    The consecutive nodes of a same block are only counted, and released from their block at once when the batch is flushed,
+    so tearing down a list built in bulk takes one atomic update and one free per block instead of one per node.
+    - `block` is the block of the batch
+    - `count` is the number of nodes of the batch, 0 if the batch is empty
+*/
+typedef struct NodeRelease {
+    NodeBlock* block;
+    size_t count;
+} NodeRelease;
+
+/*
+    node_release_flush
+    Release the nodes of a batch from their block, and free the block if they were its last nodes
+    @param  NodeRelease*    Pointer to the batch, left empty
+    @return void
+*/
+static void node_release_flush(NodeRelease* release){
+    if(release->count == 0){
+        return;
+    }
+
+    node_block_release(release->block, release->count);
+    release->count = 0;
+}
+
+/*
+    node_release_add
+    Add a node to a batch: a node of the block of the batch is counted, a node of another block starts a new batch, and any other node is released into its node cache
+    @param  NodeRelease*    Pointer to the batch
+    @param  void*           Pointer to the node, which must not be read anymore
+    @param  NodeCache*      Pointer to the node cache of its type
+    @return void
+*/
+static void node_release_add(NodeRelease* release, void* node, NodeCache* cache){
+    uintptr_t address = (uintptr_t)node;
+
+    //  The block of the batch still has live nodes, those of the batch, so its header can be read
+    if(release->count && address >= (uintptr_t)release->block && address < release->block->end){
+        release->count++;
+        return;
+    }
+
+    node_release_flush(release);
+
+    NodeBlock* block = node_block_find(node);
+
+    if(block){
+        release->block = block;
+        release->count = 1;
+    }   else{
+            nodecache_free(cache, node);
+    }
+}
 
 /*
     1. Singly linked list
@@ -29,7 +316,7 @@
 */
 SLLNode* sllnode_create(void* data){
     //  Allocate memory for the node
-    SLLNode* node = (SLLNode*)malloc(sizeof(SLLNode));
+    SLLNode* node = (SLLNode*)nodecache_alloc(&sll_node_cache);
 
     //  Initialize the node
     node->data = data;
@@ -49,7 +336,7 @@ SLLNode* sllnode_create(void* data){
     @return void
 */
 void sllnode_free(SLLNode* node){
-    free(node);
+    node_release(node, &sll_node_cache);
 }
 
 /*
@@ -75,6 +362,7 @@ SinglyLinkedList* sll_create(void){
     //  Initialize the list
     sll->head = NULL;
     sll->size = 0;
+    sll->index = NULL;
 
     if(!sll){
         return NULL;
@@ -90,15 +378,42 @@ SinglyLinkedList* sll_create(void){
     @return void
 */
 void sll_destroy(SinglyLinkedList* sll){
-    SLLNode* current = sll->head;
+    sll_destroy_with(sll, NULL);
+}
+
+/*
+    sll_destroy_with
+    Destroy a singly linked list and the data of its nodes, the data first
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListFreeFunction    Function freeing the data of a node, NULL to leave the data to the caller
+    @return void
+*/
+void sll_destroy_with(SinglyLinkedList* sll, ListFreeFunction free_data){
+    SLLNode* current = NULL;
     SLLNode* next = NULL;
+    NodeRelease release = {0};
+
+    //  Every data is freed before any block is released: a data moved to a node of another block by a sort is still recognized as a payload
+    if(free_data){
+        for(current = sll->head; current; current = current->next){
+            node_data_free(current->data, free_data);
+        }
+    }
 
+    current = sll->head;
     while(current){
         next = current->next;
-        sllnode_free(current);
+
+        node_release_add(&release, current, &sll_node_cache);
         current = next;
     }
 
+    node_release_flush(&release);
+
+    if(sll->index){
+        hashindex_destroy(sll->index);
+    }
+
     free(sll);
 }
 
@@ -117,6 +432,18 @@ bool sll_insert(SinglyLinkedList* sll, void* data){
         return false;
     }
 
+    //  Index the new node, which becomes the predecessor of the old head
+    if(sll->index){
+        if(!hashindex_insert(sll->index, data, node, NULL)){
+            sllnode_free(node);
+            return false;
+        }
+
+        if(sll->head){
+            hashindex_find_node(sll->index, sll->head->data, sll->head)->previous = node;
+        }
+    }
+
     //  Insert the new node at the beginning of the list
     node->next = sll->head;
     sll->head = node;
@@ -142,12 +469,21 @@ bool sll_append(SinglyLinkedList* sll, void* data){
 
     //  Find the last node in the list
     SLLNode* current = sll->head;
-    while(current->next){
+    while(current && current->next){
         current = current->next;
     }
 
+    if(sll->index && !hashindex_append(sll->index, data, node, current)){
+        sllnode_free(node);
+        return false;
+    }
+
     //  Append the new node to the list
-    current->next = node;
+    if(current){
+        current->next = node;
+    }   else{
+            sll->head = node;
+    }
     sll->size++;
 
     return true;
@@ -164,6 +500,34 @@ bool sll_remove(SinglyLinkedList* sll, void* data){
     SLLNode* current = sll->head;
     SLLNode* previous = NULL;
 
+    //  With an index, the node and its predecessor are known without a scan
+    if(sll->index){
+        HashIndexEntry* entry = hashindex_find(sll->index, data);
+
+        if(!entry){
+            return false;
+        }
+
+        current = (SLLNode*)entry->node;
+        previous = (SLLNode*)entry->previous;
+        hashindex_remove(sll->index, entry);
+
+        if(previous){
+            previous->next = current->next;
+        }   else{
+                sll->head = current->next;
+        }
+
+        if(current->next){
+            hashindex_find_node(sll->index, current->next->data, current->next)->previous = previous;
+        }
+
+        sllnode_free(current);
+        sll->size--;
+
+        return true;
+    }
+
     while(current){
         if(current->data == data){
             if(previous){
@@ -193,14 +557,19 @@ bool sll_remove(SinglyLinkedList* sll, void* data){
     @return SLLNode*            Pointer to the node if found, NULL otherwise
 */
 SLLNode* sll_search(SinglyLinkedList* sll, void* data){
-    SLLNode* current = sll->head;
+    if(sll->index){
+        HashIndexEntry* entry = hashindex_find(sll->index, data);
+        return entry ? (SLLNode*)entry->node : NULL;
+    }
 
-    while(current){
+    //  Only the pointers are compared: the nodes are prefetched, not their data
+    SLLCursor cursor = sll_cursor_at(sll->head, DSL_PREFETCH_DISTANCE, false);
+    SLLNode* current = NULL;
+
+    while((current = sll_cursor_next(&cursor))){
         if(current->data == data){
             return current;
         }
-
-        current = current->next;
     }
 
     return NULL;
@@ -213,11 +582,10 @@ SLLNode* sll_search(SinglyLinkedList* sll, void* data){
     @return void
 */
 void sll_print(SinglyLinkedList* sll){
-    SLLNode* current = sll->head;
+    SLLNode* current = NULL;
 
-    while(current){
+    SLL_FOREACH(current, sll){
         printf("%d\n", *(int*)current->data);
-        current = current->next;
     }
 };
 
@@ -231,6 +599,65 @@ int sll_len(SinglyLinkedList* sll){
     return sll->size;
 };
 
+/*
+    sll_index_attach
+    Attach a hash index to a singly linked list, indexing its current nodes
+    @param  SinglyLinkedList*               Pointer to the list
+    @param  size_t (*hash)(void*)           Hash function of the data, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the data, NULL to compare the pointers
+    @return bool                            true if the operation was successful, false otherwise
+*/
+bool sll_index_attach(SinglyLinkedList* sll, size_t (*hash)(void*), bool (*equal)(void*, void*)){
+    HashIndex* index = hashindex_create(hash, equal);
+
+    if(!index){
+        return false;
+    }
+
+    sll_index_detach(sll);
+    sll->index = index;
+
+    return sll_index_rebuild(sll);
+};
+
+/*
+    sll_index_detach
+    Detach and destroy the hash index of a singly linked list
+    @param  SinglyLinkedList*   Pointer to the list
+    @return void
+*/
+void sll_index_detach(SinglyLinkedList* sll){
+    if(sll->index){
+        hashindex_destroy(sll->index);
+        sll->index = NULL;
+    }
+};
+
+/*
+    sll_index_rebuild
+    Rebuild the hash index of a singly linked list from its nodes
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false otherwise (the index is then detached)
+*/
+bool sll_index_rebuild(SinglyLinkedList* sll){
+    if(!sll->index){
+        return false;
+    }
+
+    hashindex_clear(sll->index);
+
+    //  Appending in list order keeps the entries with equal keys in list order
+    SLLNode* previous = NULL;
+    for(SLLNode* current = sll->head; current; previous = current, current = current->next){
+        if(!hashindex_append(sll->index, current->data, current, previous)){
+            sll_index_detach(sll);
+            return false;
+        }
+    }
+
+    return true;
+};
+
 
 /*
     2. Doubly linked list
@@ -243,7 +670,7 @@ int sll_len(SinglyLinkedList* sll){
     @returns pointer to the new doubly linked list node
 */
 DLLNode* dllnode_create(void* data){
-    DLLNode* node = (DLLNode*)malloc(sizeof(DLLNode));
+    DLLNode* node = (DLLNode*)nodecache_alloc(&dll_node_cache);
 
     node->data = data;
     node->next = NULL;
@@ -263,7 +690,7 @@ DLLNode* dllnode_create(void* data){
     @return void
 */
 void dllnode_free(DLLNode* node){
-    free(node);
+    node_release(node, &dll_node_cache);
 };
 
 /*
@@ -278,6 +705,7 @@ DoublyLinkedList* dll_create(void){
     dll->head = NULL;
     dll->tail = NULL;
     dll->size = 0;
+    dll->index = NULL;
 
     if(!dll){
         return NULL;
@@ -293,15 +721,51 @@ DoublyLinkedList* dll_create(void){
     @return void
 */
 void dll_destroy(DoublyLinkedList* dll){
-    DLLNode* current = dll->head;
+    dll_destroy_with(dll, NULL);
+};
+
+/*
+    dllnode_chain_free
+    Free a chain of doubly linked list nodes and their data, the data first
+    @param  DLLNode*            Pointer to the first node of the chain
+    @param  ListFreeFunction    Function freeing the data of a node, NULL to leave the data
+    @return void
+*/
+static void dllnode_chain_free(DLLNode* current, ListFreeFunction free_data){
     DLLNode* next = NULL;
+    NodeRelease release = {0};
+
+    //  Every data is freed before any block is released, see `sll_destroy_with`
+    if(free_data){
+        for(next = current; next; next = next->next){
+            node_data_free(next->data, free_data);
+        }
+    }
 
     while(current){
         next = current->next;
-        dllnode_free(current);
+
+        node_release_add(&release, current, &dll_node_cache);
         current = next;
     }
 
+    node_release_flush(&release);
+}
+
+/*
+    dll_destroy_with
+    Destroy a doubly linked list and the data of its nodes, the data first
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  ListFreeFunction    Function freeing the data of a node, NULL to leave the data to the caller
+    @return void
+*/
+void dll_destroy_with(DoublyLinkedList* dll, ListFreeFunction free_data){
+    dllnode_chain_free(dll->head, free_data);
+
+    if(dll->index){
+        hashindex_destroy(dll->index);
+    }
+
     free(dll);
 };
 
@@ -319,6 +783,11 @@ bool dll_insert(DoublyLinkedList* dll, void* data){
         return false;
     }
 
+    if(dll->index && !hashindex_insert(dll->index, data, node, NULL)){
+        dllnode_free(node);
+        return false;
+    }
+
     node->next = dll->head;
     node->prev = NULL;
 
@@ -348,6 +817,11 @@ bool dll_append(DoublyLinkedList* dll, void* data){
         return false;
     }
 
+    if(dll->index && !hashindex_append(dll->index, data, node, NULL)){
+        dllnode_free(node);
+        return false;
+    }
+
     node->next = NULL;
     node->prev = dll->tail;
 
@@ -373,6 +847,35 @@ bool dll_append(DoublyLinkedList* dll, void* data){
 bool dll_remove(DoublyLinkedList* dll, void* data){
     DLLNode* current = dll->head;
 
+    //  With an index, the node is found without a scan
+    if(dll->index){
+        HashIndexEntry* entry = hashindex_find(dll->index, data);
+
+        if(!entry){
+            return false;
+        }
+
+        current = (DLLNode*)entry->node;
+        hashindex_remove(dll->index, entry);
+
+        if(current->prev){
+            current->prev->next = current->next;
+        }   else{
+                dll->head = current->next;
+        }
+
+        if(current->next){
+            current->next->prev = current->prev;
+        }   else{
+                dll->tail = current->prev;
+        }
+
+        dllnode_free(current);
+        dll->size--;
+
+        return true;
+    }
+
     while(current){
         if(current->data == data){
             if(current->prev){
@@ -407,14 +910,19 @@ bool dll_remove(DoublyLinkedList* dll, void* data){
     @return DLLNode*            Pointer to the node if found, NULL otherwise
 */
 DLLNode* dll_search(DoublyLinkedList* dll, void* data){
-    DLLNode* current = dll->head;
+    if(dll->index){
+        HashIndexEntry* entry = hashindex_find(dll->index, data);
+        return entry ? (DLLNode*)entry->node : NULL;
+    }
 
-    while(current){
+    //  Only the pointers are compared: the nodes are prefetched, not their data
+    DLLCursor cursor = dll_cursor_at(dll->head, DSL_PREFETCH_DISTANCE, false);
+    DLLNode* current = NULL;
+
+    while((current = dll_cursor_next(&cursor))){
         if(current->data == data){
             return current;
         }
-
-        current = current->next;
     }
 
     return NULL;
@@ -427,11 +935,10 @@ DLLNode* dll_search(DoublyLinkedList* dll, void* data){
     @return void
 */
 void dll_print(DoublyLinkedList* dll){
-    DLLNode* current = dll->head;
+    DLLNode* current = NULL;
 
-    while(current){
+    DLL_FOREACH(current, dll){
         printf("%d\n", *(int*)current->data);
-        current = current->next;
     }
 };
 
@@ -446,44 +953,102 @@ size_t dll_len(DoublyLinkedList* dll){
     return dll->size;
 };
 
-
-
 /*
-    3. Circular linked list
+    dll_index_attach
+    Attach a hash index to a doubly linked list, indexing its current nodes
+    @param  DoublyLinkedList*               Pointer to the list
+    @param  size_t (*hash)(void*)           Hash function of the data, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the data, NULL to compare the pointers
+    @return bool                            true if the operation was successful, false otherwise
 */
+bool dll_index_attach(DoublyLinkedList* dll, size_t (*hash)(void*), bool (*equal)(void*, void*)){
+    HashIndex* index = hashindex_create(hash, equal);
 
-/*
-    cllnode_create
-    Create a new circular linked list node
-    @param `data` is a pointer to the data to store in the node
-    @returns pointer to the new circular linked list node
-*/
-CLLNode* cllnode_create(void* data){
-    CLLNode* node = (CLLNode*)malloc(sizeof(CLLNode));
+    if(!index){
+        return false;
+    }
 
-    node->data = data;
-    node->next = NULL;
+    dll_index_detach(dll);
+    dll->index = index;
 
-    if(!node){
-        return NULL;
-    }   else{
-            return node;
-    }
+    return dll_index_rebuild(dll);
 };
 
 /*
-    cllnode_free
-    Free a node from a circular linked list
-    @param  CLLNode*    Pointer to the node to be freed
+    dll_index_detach
+    Detach and destroy the hash index of a doubly linked list
+    @param  DoublyLinkedList*   Pointer to the list
     @return void
 */
-void cllnode_free(CLLNode* node){
-    free(node);
+void dll_index_detach(DoublyLinkedList* dll){
+    if(dll->index){
+        hashindex_destroy(dll->index);
+        dll->index = NULL;
+    }
 };
 
 /*
-    cll_create
-    Create a new circular linked list
+    dll_index_rebuild
+    Rebuild the hash index of a doubly linked list from its nodes
+    @param  DoublyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false otherwise (the index is then detached)
+*/
+bool dll_index_rebuild(DoublyLinkedList* dll){
+    if(!dll->index){
+        return false;
+    }
+
+    hashindex_clear(dll->index);
+
+    //  Appending in list order keeps the entries with equal keys in list order
+    for(DLLNode* current = dll->head; current; current = current->next){
+        if(!hashindex_append(dll->index, current->data, current, NULL)){
+            dll_index_detach(dll);
+            return false;
+        }
+    }
+
+    return true;
+};
+
+
+
+/*
+    3. Circular linked list
+*/
+
+/*
+    cllnode_create
+    Create a new circular linked list node
+    @param `data` is a pointer to the data to store in the node
+    @returns pointer to the new circular linked list node
+*/
+CLLNode* cllnode_create(void* data){
+    CLLNode* node = (CLLNode*)nodecache_alloc(&cll_node_cache);
+
+    node->data = data;
+    node->next = NULL;
+
+    if(!node){
+        return NULL;
+    }   else{
+            return node;
+    }
+};
+
+/*
+    cllnode_free
+    Free a node from a circular linked list
+    @param  CLLNode*    Pointer to the node to be freed
+    @return void
+*/
+void cllnode_free(CLLNode* node){
+    node_release(node, &cll_node_cache);
+};
+
+/*
+    cll_create
+    Create a new circular linked list
     @param  void
     @return CircularLinkedList*   Pointer to the new list
 */
@@ -507,15 +1072,39 @@ CircularLinkedList* cll_create(void){
     @return void
 */
 void cll_destroy(CircularLinkedList* cll){
+    cll_destroy_with(cll, NULL);
+};
+
+/*
+    cll_destroy_with
+    Destroy a circular linked list and the data of its nodes, the data first
+    @param  CircularLinkedList*   Pointer to the list
+    @param  ListFreeFunction      Function freeing the data of a node, NULL to leave the data to the caller
+    @return void
+*/
+void cll_destroy_with(CircularLinkedList* cll, ListFreeFunction free_data){
     CLLNode* current = cll->head;
     CLLNode* next = NULL;
+    NodeRelease release = {0};
 
-    while(current){
+    //  Every data is freed before any block is released, see `sll_destroy_with`
+    if(free_data){
+        for(size_t i = 0; i < cll->size; i++){
+            node_data_free(current->data, free_data);
+            current = current->next;
+        }
+    }
+
+    //  The last node links back to the head, so the nodes are counted rather than followed to NULL
+    for(size_t i = 0; i < cll->size; i++){
         next = current->next;
-        cllnode_free(current);
+
+        node_release_add(&release, current, &cll_node_cache);
         current = next;
     }
 
+    node_release_flush(&release);
+
     free(cll);
 };
 
@@ -698,17 +1287,20 @@ Stack* stack_create(void){
     @return void
 */
 void stack_destroy(Stack* stack){
-    DLLNode* current = stack->top;
-    DLLNode* next = NULL;
+    stack_destroy_with(stack, NULL);
+}
 
-    while(current){
-        next = current->next;
-        dllnode_free(current);
-        current = next;
-    }
+/*
+    stack_destroy_with
+    Destroy a stack and the data of its elements, the data first
+    @param  Stack*              Pointer to the stack
+    @param  ListFreeFunction    Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void stack_destroy_with(Stack* stack, ListFreeFunction free_data){
+    dllnode_chain_free(stack->top, free_data);
 
     free(stack);
-
 }
 
 /*
@@ -811,14 +1403,18 @@ Queue* queue_create(void){
     @return void
 */
 void queue_destroy(Queue* queue){
-    DLLNode* current = queue->front;
-    DLLNode* next = NULL;
+    queue_destroy_with(queue, NULL);
+};
 
-    while(current){
-        next = current->next;
-        dllnode_free(current);
-        current = next;
-    }
+/*
+    queue_destroy_with
+    Destroy a queue and the data of its elements, the data first
+    @param  Queue*              Pointer to the queue
+    @param  ListFreeFunction    Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void queue_destroy_with(Queue* queue, ListFreeFunction free_data){
+    dllnode_chain_free(queue->front, free_data);
 
     free(queue);
 };
@@ -950,3 +1546,963 @@ SinglyLinkedList* dll_to_sll(DoublyLinkedList* dll){
 
     return sll;
 };
+
+
+
+/*
+    7.  Bulk construction
+*/
+/*
+    sll_bulk
+    Build a singly linked list of `count` nodes allocated in one block, in traversal order
+    @param  size_t                  Number of elements
+    @param  size_t                  Size of the payloads copied into the block, 0 for none
+    @param  const unsigned char*    Array of the elements, used without a generator
+    @param  size_t                  Size of the elements of the array
+    @param  ListGenerateFunction    Generator of the elements, NULL to read the array
+    @param  void*                   Context of the generator
+    @return SinglyLinkedList*       Pointer to the new list, NULL if the allocation failed
+*/
+static SinglyLinkedList* sll_bulk(size_t count, size_t element_size, const unsigned char* array, size_t stride, ListGenerateFunction generate, void* context){
+    SinglyLinkedList* sll = sll_create();
+
+    if(!sll || count == 0){
+        return sll;
+    }
+
+    void* payload = NULL;
+    SLLNode* nodes = (SLLNode*)node_block_alloc(count, sizeof(SLLNode), element_size, &payload);
+
+    if(!nodes){
+        free(sll);
+        return NULL;
+    }
+
+    unsigned char* slot = (unsigned char*)payload;
+
+    for(size_t i = 0; i < count; i++){
+        if(generate){
+            nodes[i].data = generate(i, element_size ? slot : NULL, context);
+        }   else if(element_size){
+                memcpy(slot, array + i * stride, element_size);
+                nodes[i].data = slot;
+        }   else{
+                nodes[i].data = (void*)(array + i * stride);
+        }
+
+        nodes[i].next = &nodes[i + 1];
+        slot += element_size;
+    }
+
+    nodes[count - 1].next = NULL;
+
+    sll->head = nodes;
+    sll->size = count;
+
+    return sll;
+}
+
+/*
+    dllnode_bulk
+    Allocate `count` doubly linked nodes in one block and link them in traversal order. See `sll_bulk`.
+    @return DLLNode*    Pointer to the first node, NULL if the allocation failed
+*/
+static DLLNode* dllnode_bulk(size_t count, size_t element_size, const unsigned char* array, size_t stride, ListGenerateFunction generate, void* context){
+    void* payload = NULL;
+    DLLNode* nodes = (DLLNode*)node_block_alloc(count, sizeof(DLLNode), element_size, &payload);
+
+    if(!nodes){
+        return NULL;
+    }
+
+    unsigned char* slot = (unsigned char*)payload;
+
+    for(size_t i = 0; i < count; i++){
+        if(generate){
+            nodes[i].data = generate(i, element_size ? slot : NULL, context);
+        }   else if(element_size){
+                memcpy(slot, array + i * stride, element_size);
+                nodes[i].data = slot;
+        }   else{
+                nodes[i].data = (void*)(array + i * stride);
+        }
+
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = &nodes[i + 1];
+        slot += element_size;
+    }
+
+    nodes[count - 1].next = NULL;
+
+    return nodes;
+}
+
+/*
+    dll_bulk
+    Build a doubly linked list of `count` nodes allocated in one block. See `sll_bulk`.
+    @return DoublyLinkedList*   Pointer to the new list, NULL if the allocation failed
+*/
+static DoublyLinkedList* dll_bulk(size_t count, size_t element_size, const unsigned char* array, size_t stride, ListGenerateFunction generate, void* context){
+    DoublyLinkedList* dll = dll_create();
+
+    if(!dll || count == 0){
+        return dll;
+    }
+
+    DLLNode* nodes = dllnode_bulk(count, element_size, array, stride, generate, context);
+
+    if(!nodes){
+        free(dll);
+        return NULL;
+    }
+
+    dll->head = nodes;
+    dll->tail = &nodes[count - 1];
+    dll->size = count;
+
+    return dll;
+}
+
+/*
+    queue_bulk
+    Build a queue of `count` nodes allocated in one block, the first element at the front. See `sll_bulk`.
+    @return Queue*  Pointer to the new queue, NULL if the allocation failed
+*/
+static Queue* queue_bulk(size_t count, size_t element_size, const unsigned char* array, size_t stride, ListGenerateFunction generate, void* context){
+    Queue* queue = queue_create();
+
+    if(!queue || count == 0){
+        return queue;
+    }
+
+    DLLNode* nodes = dllnode_bulk(count, element_size, array, stride, generate, context);
+
+    if(!nodes){
+        free(queue);
+        return NULL;
+    }
+
+    queue->front = nodes;
+    queue->back = &nodes[count - 1];
+    queue->size = count;
+
+    return queue;
+}
+
+/*
+    sll_from_array
+    Build a singly linked list from the elements of an array, with all its nodes allocated in one block in traversal order
+    @param  const void*         Array of the elements
+    @param  size_t              Number of elements
+    @param  size_t              Size of an element
+    @param  bool                true to copy the elements into the block, false to point the nodes into the array
+    @return SinglyLinkedList*   Pointer to the new list, NULL if the allocation failed
+*/
+SinglyLinkedList* sll_from_array(const void* array, size_t count, size_t element_size, bool copy){
+    if((!array && count > 0) || element_size == 0){
+        return NULL;
+    }
+
+    return sll_bulk(count, copy ? element_size : 0, (const unsigned char*)array, element_size, NULL, NULL);
+}
+
+/*
+    sll_from_generator
+    Build a singly linked list from a generator, with all its nodes allocated in one block in traversal order
+    @param  size_t                  Number of elements
+    @param  size_t                  Size of the payload of each element in the block, 0 for none
+    @param  ListGenerateFunction    Generator of the elements
+    @param  void*                   Context of the generator
+    @return SinglyLinkedList*       Pointer to the new list, NULL if the allocation failed
+*/
+SinglyLinkedList* sll_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context){
+    if(!generate){
+        return NULL;
+    }
+
+    return sll_bulk(count, element_size, NULL, 0, generate, context);
+}
+
+/*
+    dll_from_array
+    Build a doubly linked list from the elements of an array. See `sll_from_array`.
+*/
+DoublyLinkedList* dll_from_array(const void* array, size_t count, size_t element_size, bool copy){
+    if((!array && count > 0) || element_size == 0){
+        return NULL;
+    }
+
+    return dll_bulk(count, copy ? element_size : 0, (const unsigned char*)array, element_size, NULL, NULL);
+}
+
+/*
+    dll_from_generator
+    Build a doubly linked list from a generator. See `sll_from_generator`.
+*/
+DoublyLinkedList* dll_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context){
+    if(!generate){
+        return NULL;
+    }
+
+    return dll_bulk(count, element_size, NULL, 0, generate, context);
+}
+
+/*
+    queue_from_array
+    Build a queue from the elements of an array, the first element at the front. See `sll_from_array`.
+*/
+Queue* queue_from_array(const void* array, size_t count, size_t element_size, bool copy){
+    if((!array && count > 0) || element_size == 0){
+        return NULL;
+    }
+
+    return queue_bulk(count, copy ? element_size : 0, (const unsigned char*)array, element_size, NULL, NULL);
+}
+
+/*
+    queue_from_generator
+    Build a queue from a generator, the first element at the front. See `sll_from_generator`.
+*/
+Queue* queue_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context){
+    if(!generate){
+        return NULL;
+    }
+
+    return queue_bulk(count, element_size, NULL, 0, generate, context);
+}
+
+/*
+    list_data_in_block
+    Check whether a data pointer lies in a node block, i.e. is a payload copied into the block by a bulk constructor, which must not be freed on its own
+    @param  const void*     Data pointer
+    @return bool            true if the pointer lies in a node block, false otherwise
+*/
+bool list_data_in_block(const void* data){
+    return node_block_find(data) != NULL;
+}
+
+
+
+/*
+    8.  Splicing
+*/
+/*
+    dll_reindex
+    Rebuild the hash indexes of two lists after nodes moved between them, if they are attached
+    @param  DoublyLinkedList*   Pointer to the first list
+    @param  DoublyLinkedList*   Pointer to the second list
+    @return void
+*/
+static void dll_reindex(DoublyLinkedList* first, DoublyLinkedList* second){
+    if(first->index){
+        dll_index_rebuild(first);
+    }
+
+    if(second->index){
+        dll_index_rebuild(second);
+    }
+}
+
+/*
+    sll_reindex
+    Rebuild the hash indexes of two lists after nodes moved between them, if they are attached
+    @param  SinglyLinkedList*   Pointer to the first list
+    @param  SinglyLinkedList*   Pointer to the second list
+    @return void
+*/
+static void sll_reindex(SinglyLinkedList* first, SinglyLinkedList* second){
+    if(first->index){
+        sll_index_rebuild(first);
+    }
+
+    if(second->index){
+        sll_index_rebuild(second);
+    }
+}
+
+/*
+    dll_splice
+    Move every node of `source` before `position`, a node of `dll`, in O(1), leaving `source` empty
+    @param  DoublyLinkedList*   Pointer to the destination list
+    @param  DLLNode*            Node of `dll` before which the nodes are inserted, NULL to insert them at the end
+    @param  DoublyLinkedList*   Pointer to the source list
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool dll_splice(DoublyLinkedList* dll, DLLNode* position, DoublyLinkedList* source){
+    if(!dll || !source || dll == source){
+        return false;
+    }
+
+    if(!source->head){
+        return true;
+    }
+
+    DLLNode* first = source->head;
+    DLLNode* last = source->tail;
+    DLLNode* before = position ? position->prev : dll->tail;
+
+    first->prev = before;
+    last->next = position;
+
+    if(before){
+        before->next = first;
+    }   else{
+            dll->head = first;
+    }
+
+    if(position){
+        position->prev = last;
+    }   else{
+            dll->tail = last;
+    }
+
+    dll->size += source->size;
+
+    source->head = NULL;
+    source->tail = NULL;
+    source->size = 0;
+
+    dll_reindex(dll, source);
+
+    return true;
+};
+
+/*
+    dll_concat
+    Move every node of `source` to the end of `dll`, in O(1), leaving `source` empty
+    @param  DoublyLinkedList*   Pointer to the destination list
+    @param  DoublyLinkedList*   Pointer to the source list
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool dll_concat(DoublyLinkedList* dll, DoublyLinkedList* source){
+    return dll_splice(dll, NULL, source);
+};
+
+/*
+    dll_split_at
+    Move `node`, a node of `dll`, and every node after it to the empty list `rest`.
+    The nodes moved are counted from both ends of the split at once, in O(min(K, N - K)) for a split at position K.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  DLLNode*            First node moved
+    @param  DoublyLinkedList*   Pointer to the empty list receiving the nodes
+    @return bool                true if the operation was successful, false if a pointer is NULL or `rest` is not empty
+*/
+bool dll_split_at(DoublyLinkedList* dll, DLLNode* node, DoublyLinkedList* rest){
+    if(!dll || !node || !rest || rest == dll || rest->head){
+        return false;
+    }
+
+    //  Walk away from the split in both directions: the first walk to reach an end gives the size of its side
+    DLLNode* forward = node;
+    DLLNode* backward = node->prev;
+    size_t moved = 0;
+    size_t kept = 0;
+
+    while(forward && backward){
+        forward = forward->next;
+        backward = backward->prev;
+        moved++;
+        kept++;
+    }
+
+    size_t count;
+
+    if(!backward){
+        count = dll->size - kept;
+    }   else{
+            count = moved;
+    }
+
+    rest->head = node;
+    rest->tail = dll->tail;
+    rest->size = count;
+
+    dll->tail = node->prev;
+    dll->size -= count;
+
+    if(node->prev){
+        node->prev->next = NULL;
+    }   else{
+            dll->head = NULL;
+    }
+
+    node->prev = NULL;
+
+    dll_reindex(dll, rest);
+
+    return true;
+};
+
+/*
+    queue_concat
+    Move every element of `source` to the back of `queue`, in O(1), leaving `source` empty
+    @param  Queue*  Pointer to the destination queue
+    @param  Queue*  Pointer to the source queue
+    @return bool    true if the operation was successful, false if a queue is NULL or both are the same queue
+*/
+bool queue_concat(Queue* queue, Queue* source){
+    if(!queue || !source || queue == source){
+        return false;
+    }
+
+    if(!source->front){
+        return true;
+    }
+
+    if(queue->back){
+        queue->back->next = source->front;
+        source->front->prev = queue->back;
+    }   else{
+            queue->front = source->front;
+    }
+
+    queue->back = source->back;
+    queue->size += source->size;
+
+    source->front = NULL;
+    source->back = NULL;
+    source->size = 0;
+
+    return true;
+};
+
+/*
+    sll_concat
+    Move every node of `source` to the end of `sll`, leaving `source` empty.
+    A singly linked list does not know its last node: given it, the concatenation runs in O(1), otherwise the list is walked to find it.
+    The last node of the result is the last node of `source`, if it was not empty: a caller concatenating repeatedly keeps track of it.
+    @param  SinglyLinkedList*   Pointer to the destination list
+    @param  SinglyLinkedList*   Pointer to the source list
+    @param  SLLNode*            Last node of `sll`, NULL to find it
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool sll_concat(SinglyLinkedList* sll, SinglyLinkedList* source, SLLNode* tail){
+    if(!sll || !source || sll == source){
+        return false;
+    }
+
+    if(!source->head){
+        return true;
+    }
+
+    if(!tail && sll->head){
+        tail = sll->head;
+
+        while(tail->next){
+            tail = tail->next;
+        }
+    }
+
+    if(tail){
+        tail->next = source->head;
+    }   else{
+            sll->head = source->head;
+    }
+
+    sll->size += source->size;
+
+    source->head = NULL;
+    source->size = 0;
+
+    sll_reindex(sll, source);
+
+    return true;
+};
+
+/*
+    sll_split_after
+    Move every node after `node`, a node of `sll`, to the empty list `rest`, in O(K) for the K nodes moved
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  SLLNode*            Last node kept in `sll`
+    @param  SinglyLinkedList*   Pointer to the empty list receiving the nodes
+    @return bool                true if the operation was successful, false if a pointer is NULL or `rest` is not empty
+*/
+bool sll_split_after(SinglyLinkedList* sll, SLLNode* node, SinglyLinkedList* rest){
+    if(!sll || !node || !rest || rest == sll || rest->head){
+        return false;
+    }
+
+    size_t count = 0;
+
+    for(SLLNode* current = node->next; current; current = current->next){
+        count++;
+    }
+
+    rest->head = node->next;
+    rest->size = count;
+
+    node->next = NULL;
+    sll->size -= count;
+
+    sll_reindex(sll, rest);
+
+    return true;
+};
+
+/*
+    9. Compaction
+*/
+
+//  Bits of the digits of the radix sort of node addresses
+#define NODE_RADIX_BITS 11
+
+/*
+    node_address_compare
+    Order node pointers by address, for `qsort`
+*/
+static int node_address_compare(const void* a, const void* b){
+    uintptr_t x = (uintptr_t)*(void* const*)a;
+    uintptr_t y = (uintptr_t)*(void* const*)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+    node_addresses_sort
+    Sort an array of nodes by address, unless it already is.
+    The addresses are sorted by a least significant digit radix sort over the bits that differ between them, with `qsort` as a fallback if the scratch array cannot be allocated.
+    @param  void**      Array of the nodes
+    @param  size_t      Number of nodes
+    @return bool        true if the nodes were sorted, false if they already were in address order
+*/
+static bool node_addresses_sort(void** nodes, size_t count){
+    size_t i = 1;
+
+    while(i < count && (uintptr_t)nodes[i - 1] < (uintptr_t)nodes[i]){
+        i++;
+    }
+
+    if(i >= count){
+        return false;
+    }
+
+    void** scratch = (void**)malloc(count * sizeof(void*));
+
+    if(!scratch){
+        qsort(nodes, count, sizeof(void*), node_address_compare);
+        return true;
+    }
+
+    //  The low bits are the same for aligned nodes, and the high bits for nodes of one heap: only the bits that differ are sorted
+    uintptr_t varying = 0;
+    for(i = 1; i < count; i++){
+        varying |= (uintptr_t)nodes[i] ^ (uintptr_t)nodes[0];
+    }
+
+    unsigned shift = 0;
+    while(!((varying >> shift) & 1)){
+        shift++;
+    }
+
+    void** from = nodes;
+    void** to = scratch;
+
+    for(; shift < sizeof(uintptr_t) * 8 && (varying >> shift); shift += NODE_RADIX_BITS){
+        size_t offsets[1 << NODE_RADIX_BITS] = {0};
+
+        for(i = 0; i < count; i++){
+            offsets[((uintptr_t)from[i] >> shift) & ((1 << NODE_RADIX_BITS) - 1)]++;
+        }
+
+        size_t total = 0;
+        for(size_t digit = 0; digit < (1 << NODE_RADIX_BITS); digit++){
+            size_t digit_count = offsets[digit];
+            offsets[digit] = total;
+            total += digit_count;
+        }
+
+        for(i = 0; i < count; i++){
+            to[offsets[((uintptr_t)from[i] >> shift) & ((1 << NODE_RADIX_BITS) - 1)]++] = from[i];
+        }
+
+        void** swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if(from != nodes){
+        memcpy(nodes, from, count * sizeof(void*));
+    }
+
+    free(scratch);
+
+    return true;
+}
+
+/*
+    node_compact_order
+    Order the nodes of a list for its compaction. A position gets a node of the block of the node it had, or a node of no block if it had one,
+    the nodes of each block and the nodes of no block taking their positions in address order: a data pointer never moves to a node of another block,
+    so a payload copied into a block stays held by the nodes of its block.
+    The nodes of a block are consecutive once sorted by address, since a block holds no other node.
+    @param  void**      Array of the nodes in list order, receives the nodes in their new order
+    @param  size_t      Number of nodes
+    @return int         1 if the order changed, 0 if it did not, -1 if the allocation failed (the array is unchanged)
+*/
+static int node_compact_order(void** nodes, size_t count){
+    void** sorted = (void**)malloc(count * sizeof(void*));
+    size_t* taken = (size_t*)calloc(count, sizeof(size_t));
+
+    if(!sorted || !taken){
+        free(sorted);
+        free(taken);
+        return -1;
+    }
+
+    memcpy(sorted, nodes, count * sizeof(void*));
+
+    if(!node_addresses_sort(sorted, count)){
+        free(sorted);
+        free(taken);
+        return 0;
+    }
+
+    //  `taken` counts, at the first node of each block, the nodes of the block already placed
+    NodeBlock* block = NULL;
+    size_t first = 0;
+    size_t loose = 0;
+    int moved = 0;
+
+    for(size_t i = 0; i < count; i++){
+        NodeBlock* owner = node_block_find(nodes[i]);
+        void* node = NULL;
+
+        if(owner){
+            if(owner != block){
+                size_t low = 0;
+                size_t high = count;
+
+                while(low < high){
+                    size_t middle = low + (high - low) / 2;
+
+                    if((uintptr_t)sorted[middle] < (uintptr_t)owner){
+                        low = middle + 1;
+                    }   else{
+                            high = middle;
+                    }
+                }
+
+                block = owner;
+                first = low;
+            }
+
+            node = sorted[first + taken[first]++];
+        }   else{
+                while(node_block_find(sorted[loose])){
+                    loose++;
+                }
+
+                node = sorted[loose++];
+        }
+
+        if(node != nodes[i]){
+            nodes[i] = node;
+            moved = 1;
+        }
+    }
+
+    free(sorted);
+    free(taken);
+
+    return moved;
+}
+
+/*
+    node_distance
+    Get the distance in bytes between the addresses of two nodes
+    @param  const void*     Pointer to a node
+    @param  const void*     Pointer to another node
+    @return double          Distance
+*/
+static double node_distance(const void* a, const void* b){
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+
+    return x > y ? (double)(x - y) : (double)(y - x);
+}
+
+/*
+    sll_compact
+    Relink the nodes of a singly linked list in address order within each block, moving their data, so that a traversal reads memory forward
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false if the allocation failed (the list is unchanged)
+*/
+bool sll_compact(SinglyLinkedList* sll){
+    size_t count = sll->size;
+
+    if(count < 2){
+        return true;
+    }
+
+    SLLNode** nodes = (SLLNode**)malloc(count * sizeof(SLLNode*));
+    void** data = (void**)malloc(count * sizeof(void*));
+
+    if(!nodes || !data){
+        free(nodes);
+        free(data);
+        return false;
+    }
+
+    size_t i = 0;
+    for(SLLNode* current = sll->head; current; current = current->next){
+        nodes[i] = current;
+        data[i] = current->data;
+        i++;
+    }
+
+    int moved = node_compact_order((void**)nodes, count);
+
+    if(moved > 0){
+        for(i = 0; i < count; i++){
+            nodes[i]->data = data[i];
+            nodes[i]->next = i + 1 < count ? nodes[i + 1] : NULL;
+        }
+
+        sll->head = nodes[0];
+
+        //  The data moved to other nodes
+        if(sll->index){
+            sll_index_rebuild(sll);
+        }
+    }
+
+    free(nodes);
+    free(data);
+
+    return moved >= 0;
+}
+
+/*
+    dllnode_chain_compact
+    Relink a chain of doubly linked list nodes in address order within each block, moving their data
+    @param  DLLNode*    Pointer to the first node of the chain
+    @param  size_t      Number of nodes
+    @param  DLLNode**   Receives the first node
+    @param  DLLNode**   Receives the last node
+    @return int         1 if the nodes were relinked, 0 if their order did not change, -1 if the allocation failed
+*/
+static int dllnode_chain_compact(DLLNode* head, size_t count, DLLNode** first, DLLNode** last){
+    DLLNode** nodes = (DLLNode**)malloc(count * sizeof(DLLNode*));
+    void** data = (void**)malloc(count * sizeof(void*));
+
+    if(!nodes || !data){
+        free(nodes);
+        free(data);
+        return -1;
+    }
+
+    size_t i = 0;
+    for(DLLNode* current = head; current; current = current->next){
+        nodes[i] = current;
+        data[i] = current->data;
+        i++;
+    }
+
+    int moved = node_compact_order((void**)nodes, count);
+
+    if(moved){
+        for(i = 0; i < count; i++){
+            nodes[i]->data = data[i];
+            nodes[i]->prev = i > 0 ? nodes[i - 1] : NULL;
+            nodes[i]->next = i + 1 < count ? nodes[i + 1] : NULL;
+        }
+
+        *first = nodes[0];
+        *last = nodes[count - 1];
+    }
+
+    free(nodes);
+    free(data);
+
+    return moved;
+}
+
+/*
+    dll_compact
+    Relink the nodes of a doubly linked list in address order, moving their data. See `sll_compact`.
+*/
+bool dll_compact(DoublyLinkedList* dll){
+    if(dll->size < 2){
+        return true;
+    }
+
+    int moved = dllnode_chain_compact(dll->head, dll->size, &dll->head, &dll->tail);
+
+    if(moved > 0 && dll->index){
+        dll_index_rebuild(dll);
+    }
+
+    return moved >= 0;
+}
+
+/*
+    cll_compact
+    Relink the nodes of a circular linked list in address order, moving their data, the head first. See `sll_compact`.
+*/
+bool cll_compact(CircularLinkedList* cll){
+    size_t count = cll->size;
+
+    if(count < 2){
+        return true;
+    }
+
+    CLLNode** nodes = (CLLNode**)malloc(count * sizeof(CLLNode*));
+    void** data = (void**)malloc(count * sizeof(void*));
+
+    if(!nodes || !data){
+        free(nodes);
+        free(data);
+        return false;
+    }
+
+    CLLNode* current = cll->head;
+    for(size_t i = 0; i < count; i++){
+        nodes[i] = current;
+        data[i] = current->data;
+        current = current->next;
+    }
+
+    int moved = node_compact_order((void**)nodes, count);
+
+    if(moved > 0){
+        for(size_t i = 0; i < count; i++){
+            nodes[i]->data = data[i];
+            nodes[i]->next = nodes[(i + 1) % count];
+        }
+
+        cll->head = nodes[0];
+    }
+
+    free(nodes);
+    free(data);
+
+    return moved >= 0;
+}
+
+/*
+    stack_compact
+    Relink the nodes of a stack in address order, moving their data, the top first. See `sll_compact`.
+*/
+bool stack_compact(Stack* stack){
+    if(stack->size < 2){
+        return true;
+    }
+
+    DLLNode* last = NULL;
+
+    return dllnode_chain_compact(stack->top, stack->size, &stack->top, &last) >= 0;
+}
+
+/*
+    queue_compact
+    Relink the nodes of a queue in address order, moving their data, the front first. See `sll_compact`.
+*/
+bool queue_compact(Queue* queue){
+    if(queue->size < 2){
+        return true;
+    }
+
+    return dllnode_chain_compact(queue->front, queue->size, &queue->front, &queue->back) >= 0;
+}
+
+/*
+    sll_locality
+    Get the average distance in bytes between the addresses of consecutive nodes of a singly linked list
+    @param  SinglyLinkedList*   Pointer to the list
+    @return double              Average distance, 0 for fewer than two nodes
+*/
+double sll_locality(SinglyLinkedList* sll){
+    if(sll->size < 2){
+        return 0.0;
+    }
+
+    double total = 0.0;
+
+    for(SLLNode* current = sll->head; current->next; current = current->next){
+        total += node_distance(current, current->next);
+    }
+
+    return total / (double)(sll->size - 1);
+}
+
+/*
+    dllnode_chain_locality
+    Get the average distance in bytes between the addresses of consecutive nodes of a chain of doubly linked list nodes
+    @param  DLLNode*    Pointer to the first node of the chain
+    @param  size_t      Number of nodes
+    @return double      Average distance, 0 for fewer than two nodes
+*/
+static double dllnode_chain_locality(DLLNode* head, size_t count){
+    if(count < 2){
+        return 0.0;
+    }
+
+    double total = 0.0;
+
+    for(DLLNode* current = head; current->next; current = current->next){
+        total += node_distance(current, current->next);
+    }
+
+    return total / (double)(count - 1);
+}
+
+/*
+    dll_locality
+    Get the average distance in bytes between consecutive nodes of a doubly linked list. See `sll_locality`.
+*/
+double dll_locality(DoublyLinkedList* dll){
+    return dllnode_chain_locality(dll->head, dll->size);
+}
+
+/*
+    cll_locality
+    Get the average distance in bytes between consecutive nodes of a circular linked list, from the head to the last node. See `sll_locality`.
+*/
+double cll_locality(CircularLinkedList* cll){
+    if(cll->size < 2){
+        return 0.0;
+    }
+
+    double total = 0.0;
+    CLLNode* current = cll->head;
+
+    for(size_t i = 1; i < cll->size; i++){
+        total += node_distance(current, current->next);
+        current = current->next;
+    }
+
+    return total / (double)(cll->size - 1);
+}
+
+/*
+    stack_locality
+    Get the average distance in bytes between consecutive nodes of a stack. See `sll_locality`.
+*/
+double stack_locality(Stack* stack){
+    return dllnode_chain_locality(stack->top, stack->size);
+}
+
+/*
+    queue_locality
+    Get the average distance in bytes between consecutive nodes of a queue. See `sll_locality`.
+*/
+double queue_locality(Queue* queue){
+    return dllnode_chain_locality(queue->front, queue->size);
+}
+
+/*
+    10. Node caches
+*/
+
+/*
+    list_nodes_trim
+    Return the cached free nodes of the calling thread to their depots, then the nodes of the depots to `free`, e.g. after tearing down large lists
+    @param  void
+    @return void
+*/
+void list_nodes_trim(void){
+    nodecache_flush();
+    nodecache_trim(&sll_node_cache);
+    nodecache_trim(&dll_node_cache);
+    nodecache_trim(&cll_node_cache);
+}
@@ -9,6 +9,11 @@
     - Stack
     - Queue
 
+    Singly and doubly linked lists and queues can also be built in bulk, with all their nodes allocated in one block (see 7. Bulk construction),
+    and their node chains moved between lists without allocation (see 8. Splicing).
+    Lists whose nodes are scattered in memory can be relinked in address order (see 9. Compaction).
+    Nodes allocated one by one come from thread-local node caches, so threads building and tearing down lists concurrently do not contend in `malloc` (see 10. Node caches).
+
 
     nrdc
     v1.0 2024-03-27
@@ -20,6 +25,12 @@
 #include <string.h>
 #include <stdbool.h>
 
+//  Side index of the singly and doubly linked lists, see `dsl_hashindex.h`
+struct HashIndex;
+
+//  Function freeing the data of a node, e.g. `free`, given to the `*_destroy_with` methods
+typedef void (*ListFreeFunction)(void* data);
+
 /*
     1. Singly linked list
     A `SinglyLinkedList` is a list of elements, where each element has a reference to the next element in the list.
@@ -39,10 +50,12 @@ typedef struct SinglyLinkedListNode {
     Singly linked list
     - `head` is a pointer to the first node in the list
     - `size` is the number of nodes in the list
+    - `index` is a pointer to the hash index of the nodes, NULL if no index is attached
 */
 typedef struct SinglyLinkedList {
     SLLNode *head;
     size_t size;
+    struct HashIndex *index;
 } SinglyLinkedList;
 
 //  Singly Linked List methods
@@ -85,6 +98,17 @@ SinglyLinkedList *sll_create();
 */
 void sll_destroy(SinglyLinkedList *sll);
 
+/*
+    sll_destroy_with
+    Destroy a singly linked list and free the data of its nodes.
+    Every data is freed before any node is released, so a payload copied into a block is not passed to `free_data` even when a sort moved it to a node of another block.
+    The nodes of a list built in bulk are then released from their block in batches, with one free per block.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListFreeFunction    Function freeing the data of a node, NULL to leave the data to the caller
+    @return void
+*/
+void sll_destroy_with(SinglyLinkedList* sll, ListFreeFunction free_data);
+
 /*
     sll_insert
     Insert a new node at the beginning of a singly linked list
@@ -137,6 +161,35 @@ void sll_print(SinglyLinkedList* sll);
 */
 int sll_len(SinglyLinkedList* sll);
 
+/*
+    sll_index_attach
+    Attach a hash index to a singly linked list, indexing its current nodes.
+    While the index is attached, `sll_insert`, `sll_append` and `sll_remove` maintain it, and `sll_search` and `sll_remove` find the nodes in O(1) expected time.
+    With a `hash` and `equal` pair, the nodes are found by the value of their data instead of by pointer.
+    Functions that reorder the nodes or their data (the sorting algorithms) do not maintain the index: call `sll_index_rebuild` afterwards.
+    @param  SinglyLinkedList*               Pointer to the list
+    @param  size_t (*hash)(void*)           Hash function of the data, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the data, NULL to compare the pointers
+    @return bool                            true if the operation was successful, false otherwise
+*/
+bool sll_index_attach(SinglyLinkedList* sll, size_t (*hash)(void*), bool (*equal)(void*, void*));
+
+/*
+    sll_index_detach
+    Detach and destroy the hash index of a singly linked list
+    @param  SinglyLinkedList*   Pointer to the list
+    @return void
+*/
+void sll_index_detach(SinglyLinkedList* sll);
+
+/*
+    sll_index_rebuild
+    Rebuild the hash index of a singly linked list from its nodes
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false otherwise (the index is then detached)
+*/
+bool sll_index_rebuild(SinglyLinkedList* sll);
+
 
 
 /*
@@ -150,12 +203,16 @@ int sll_len(SinglyLinkedList* sll);
     The following functions are provided for working with doubly linked lists:
     - `dll_create`: Create a new doubly linked list
     - `dll_destroy`: Destroy a doubly linked list
+    - `dll_destroy_with`: Destroy a doubly linked list and the data of its nodes
     - `dll_insert`: Insert a new node at the beginning of a doubly linked list
     - `dll_append`: Append a new node at the end of a doubly linked list
     - `dll_remove`: Remove a node from a doubly linked list
     - `dll_search`: Search for a node in a doubly linked list
     - `dll_print`: Print the contents of a doubly linked list
     - `dll_len`: Get the number of nodes in a doubly linked list
+    - `dll_index_attach`: Attach a hash index to a doubly linked list
+    - `dll_index_detach`: Detach the hash index of a doubly linked list
+    - `dll_index_rebuild`: Rebuild the hash index of a doubly linked list
 
     Note that, unlike the implementation for singly linked lists, the `dll_insert` and `dll_append` functions take a pointer to the data to be stored in the new node, rather than the data itself. This allows the functions to work with data of any type. Also, a `tail` pointer to the last node in the list is maintained to allow for efficient appending of new nodes.
 */
@@ -177,11 +234,13 @@ typedef struct DoublyLinkedListNode {
     - `head` is a pointer to the first node in the list
     - `tail` is a pointer to the last node in the list
     - `size` is the number of nodes in the list
+    - `index` is a pointer to the hash index of the nodes, NULL if no index is attached
 */
 typedef struct DoublyLinkedList {
     DLLNode *head;
     DLLNode *tail;
     size_t size;
+    struct HashIndex *index;
 } DoublyLinkedList;
 
 //  Doubly Linked List methods
@@ -218,6 +277,12 @@ DoublyLinkedList* dll_create(void);
 */
 void dll_destroy(DoublyLinkedList* dll);
 
+/*
+    dll_destroy_with
+    Destroy a doubly linked list and free the data of its nodes. See `sll_destroy_with`.
+*/
+void dll_destroy_with(DoublyLinkedList* dll, ListFreeFunction free_data);
+
 /*
     dll_insert
     Insert a new node at the beginning of a doubly linked list
@@ -271,6 +336,35 @@ void dll_print(DoublyLinkedList* dll);
 */
 size_t dll_len(DoublyLinkedList* dll);
 
+/*
+    dll_index_attach
+    Attach a hash index to a doubly linked list, indexing its current nodes.
+    While the index is attached, `dll_insert`, `dll_append` and `dll_remove` maintain it, and `dll_search` and `dll_remove` find the nodes in O(1) expected time.
+    With a `hash` and `equal` pair, the nodes are found by the value of their data instead of by pointer.
+    Functions that reorder the nodes or their data (the sorting algorithms) do not maintain the index: call `dll_index_rebuild` afterwards.
+    @param  DoublyLinkedList*               Pointer to the list
+    @param  size_t (*hash)(void*)           Hash function of the data, NULL to hash the pointers
+    @param  bool (*equal)(void*, void*)     Equality function of the data, NULL to compare the pointers
+    @return bool                            true if the operation was successful, false otherwise
+*/
+bool dll_index_attach(DoublyLinkedList* dll, size_t (*hash)(void*), bool (*equal)(void*, void*));
+
+/*
+    dll_index_detach
+    Detach and destroy the hash index of a doubly linked list
+    @param  DoublyLinkedList*   Pointer to the list
+    @return void
+*/
+void dll_index_detach(DoublyLinkedList* dll);
+
+/*
+    dll_index_rebuild
+    Rebuild the hash index of a doubly linked list from its nodes
+    @param  DoublyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false otherwise (the index is then detached)
+*/
+bool dll_index_rebuild(DoublyLinkedList* dll);
+
 
 
 /*
@@ -284,6 +378,7 @@ size_t dll_len(DoublyLinkedList* dll);
     The following functions are provided for working with circular linked lists:
     - `cll_create`: Create a new circular linked list
     - `cll_destroy`: Destroy a circular linked list
+    - `cll_destroy_with`: Destroy a circular linked list and the data of its nodes
     - `cll_insert`: Insert a new node at the beginning of a circular linked list
     - `cll_append`: Append a new node at the end of a circular linked list
     - `cll_remove`: Remove a node from a circular linked list
@@ -346,6 +441,12 @@ CircularLinkedList* cll_create(void);
 */
 void cll_destroy(CircularLinkedList* cll);
 
+/*
+    cll_destroy_with
+    Destroy a circular linked list and free the data of its nodes. See `sll_destroy_with`.
+*/
+void cll_destroy_with(CircularLinkedList* cll, ListFreeFunction free_data);
+
 /*
     cll_insert
     Insert a new node at the beginning of a circular linked list
@@ -410,6 +511,7 @@ size_t cll_len(CircularLinkedList* cll);
     The current `Stack` methods are:
     - `stack_create`: Create a new stack
     - `stack_destroy`: Destroy a stack
+    - `stack_destroy_with`: Destroy a stack and the data of its elements
     - `stack_push`: Push a new element onto the stack
     - `stack_pop`: Pop the top element from the stack
     - `stack_top`: Get the top element of the stack
@@ -445,6 +547,12 @@ Stack* stack_create(void);
 */
 void stack_destroy(Stack* stack);
 
+/*
+    stack_destroy_with
+    Destroy a stack and free the data of its elements. See `sll_destroy_with`.
+*/
+void stack_destroy_with(Stack* stack, ListFreeFunction free_data);
+
 /*
     stack_push
     Push a new element onto the stack
@@ -491,6 +599,7 @@ size_t stack_size(Stack* stack);
     The current `Queue` implemented methods are:
     -   `queue_create`: Create a new queue
     -   `queue_destroy`: Destroy a queue
+    -   `queue_destroy_with`: Destroy a queue and the data of its elements
     -   `queue_enqueue`: Enqueue a new element into the queue
     -   `queue_dequeue`: Dequeue the front element from the queue
     -   `queue_front`: Get the front element of the queue
@@ -529,6 +638,12 @@ Queue* queue_create(void);
 */
 void queue_destroy(Queue* queue);
 
+/*
+    queue_destroy_with
+    Destroy a queue and free the data of its elements. See `sll_destroy_with`.
+*/
+void queue_destroy_with(Queue* queue, ListFreeFunction free_data);
+
 /*
     queue_enqueue
     Enqueue a new element into the queue
@@ -600,4 +715,246 @@ DoublyLinkedList* sll_to_dll(SinglyLinkedList* sll);
 */
 SinglyLinkedList* dll_to_sll(DoublyLinkedList* dll);
 
-#endif // DSL_LISTS_H
\ No newline at end of file
+
+
+/*
+    7. Bulk construction
+    The bulk constructors build a list of N elements with one allocation instead of N: the nodes are allocated in one contiguous block, laid out in traversal order, and linked in one pass.
+    The elements come from an array, or from a generator called once per element in order. Their payloads may be copied into the same block, after the nodes.
+
+    The nodes of a block behave like any other node: they can be removed, moved to other lists and freed by the usual functions, and the block is freed with its last node.
+    Freeing a node finds its block without a lock, through a page map of the blocks: a block is aligned on, and rounded up to, whole pages of 4 KiB.
+    A payload copied into the block lives as long as the block, so it must not be freed by the caller, nor used once every node of its block is freed.
+    The `*_destroy_with` methods recognize such payloads and do not pass them to their free function: a list built in bulk can be destroyed with `free`
+    whether its data was copied into the block or allocated by a generator, even after a sort moved data between the nodes of several blocks.
+
+    The lifetime of a payload follows the nodes of its block, not the nodes holding it. The sorts that exchange data between nodes instead of relinking them
+    (bubble, selection and insertion sorts, heapsorts) can give a payload of one block to a node of another when a list holds the nodes of several blocks
+    with copied payloads, as after concatenating two such lists. Such a list must then be destroyed whole: freeing part of it, after a split or a removal,
+    may free payloads the rest still holds. The relinking sorts, the splicing functions and the compaction functions never move a payload to another block.
+    Lists built with `copy` false, or from a generator returning its own data, have no payloads and no such restriction.
+
+    The current methods are:
+    -   `sll_from_array`, `dll_from_array`, `queue_from_array`: Build a list from an array
+    -   `sll_from_generator`, `dll_from_generator`, `queue_from_generator`: Build a list from a generator
+    -   `list_data_in_block`: Check whether a data pointer is a payload of a node block
+*/
+
+/*
+    Generator of the elements of a bulk constructor
+    - `index` is the position of the element, from 0
+    - `slot` is the payload of the element in the block, NULL if the constructor copies no payload
+    - `context` is the pointer given to the constructor
+    Returns the data of the node, usually `slot` once it is filled
+*/
+typedef void* (*ListGenerateFunction)(size_t index, void* slot, void* context);
+
+/*
+    sll_from_array
+    Build a singly linked list from the elements of an array, with all its nodes allocated in one block in traversal order
+    @param  const void*         Array of the elements
+    @param  size_t              Number of elements
+    @param  size_t              Size of an element
+    @param  bool                true to copy the elements into the block, false to point the nodes into the array
+    @return SinglyLinkedList*   Pointer to the new list, NULL if the allocation failed
+*/
+SinglyLinkedList* sll_from_array(const void* array, size_t count, size_t element_size, bool copy);
+
+/*
+    sll_from_generator
+    Build a singly linked list from a generator, with all its nodes allocated in one block in traversal order
+    @param  size_t                  Number of elements
+    @param  size_t                  Size of the payload of each element in the block, 0 for none
+    @param  ListGenerateFunction    Generator of the elements
+    @param  void*                   Context of the generator
+    @return SinglyLinkedList*       Pointer to the new list, NULL if the allocation failed
+*/
+SinglyLinkedList* sll_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context);
+
+/*
+    dll_from_array
+    Build a doubly linked list from the elements of an array. See `sll_from_array`.
+*/
+DoublyLinkedList* dll_from_array(const void* array, size_t count, size_t element_size, bool copy);
+
+/*
+    dll_from_generator
+    Build a doubly linked list from a generator. See `sll_from_generator`.
+*/
+DoublyLinkedList* dll_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context);
+
+/*
+    queue_from_array
+    Build a queue from the elements of an array, the first element at the front. See `sll_from_array`.
+*/
+Queue* queue_from_array(const void* array, size_t count, size_t element_size, bool copy);
+
+/*
+    queue_from_generator
+    Build a queue from a generator, the first element at the front. See `sll_from_generator`.
+*/
+Queue* queue_from_generator(size_t count, size_t element_size, ListGenerateFunction generate, void* context);
+
+/*
+    list_data_in_block
+    Check whether a data pointer lies in a node block, i.e. is a payload copied into the block by a bulk constructor, which must not be freed on its own
+    @param  const void*     Data pointer
+    @return bool            true if the pointer lies in a node block, false otherwise
+*/
+bool list_data_in_block(const void* data);
+
+
+
+/*
+    8. Splicing
+    The splicing functions move whole node chains from one list to another by relinking the nodes at the ends of the chains: nothing is allocated or copied, and the moved nodes keep their addresses.
+    Concatenation and splicing run in O(1); splitting has to count the nodes moved. The source list is left empty, or holds what remains of it.
+    A hash index attached to a list involved is rebuilt, which costs O(N).
+
+    The current methods are:
+    -   `dll_concat`, `queue_concat`: Move every node of a list to the end of another
+    -   `dll_splice`: Move every node of a list before a node of another
+    -   `dll_split_at`: Move a node and every node after it to an empty list
+    -   `sll_concat`: Move every node of a singly linked list to the end of another, in O(1) given the last node
+    -   `sll_split_after`: Move every node after a node to an empty list
+*/
+
+/*
+    dll_concat
+    Move every node of `source` to the end of `dll`, in O(1), leaving `source` empty
+    @param  DoublyLinkedList*   Pointer to the destination list
+    @param  DoublyLinkedList*   Pointer to the source list
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool dll_concat(DoublyLinkedList* dll, DoublyLinkedList* source);
+
+/*
+    dll_splice
+    Move every node of `source` before `position`, a node of `dll`, in O(1), leaving `source` empty
+    @param  DoublyLinkedList*   Pointer to the destination list
+    @param  DLLNode*            Node of `dll` before which the nodes are inserted, NULL to insert them at the end
+    @param  DoublyLinkedList*   Pointer to the source list
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool dll_splice(DoublyLinkedList* dll, DLLNode* position, DoublyLinkedList* source);
+
+/*
+    dll_split_at
+    Move `node`, a node of `dll`, and every node after it to the empty list `rest`.
+    The nodes moved are counted from both ends of the split at once, in O(min(K, N - K)) for a split at position K.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  DLLNode*            First node moved
+    @param  DoublyLinkedList*   Pointer to the empty list receiving the nodes
+    @return bool                true if the operation was successful, false if a pointer is NULL or `rest` is not empty
+*/
+bool dll_split_at(DoublyLinkedList* dll, DLLNode* node, DoublyLinkedList* rest);
+
+/*
+    queue_concat
+    Move every element of `source` to the back of `queue`, in O(1), leaving `source` empty
+    @param  Queue*  Pointer to the destination queue
+    @param  Queue*  Pointer to the source queue
+    @return bool    true if the operation was successful, false if a queue is NULL or both are the same queue
+*/
+bool queue_concat(Queue* queue, Queue* source);
+
+/*
+    sll_concat
+    Move every node of `source` to the end of `sll`, leaving `source` empty.
+    A singly linked list does not know its last node: given it, the concatenation runs in O(1), otherwise the list is walked to find it.
+    The last node of the result is the last node of `source`, if it was not empty: a caller concatenating repeatedly keeps track of it.
+    @param  SinglyLinkedList*   Pointer to the destination list
+    @param  SinglyLinkedList*   Pointer to the source list
+    @param  SLLNode*            Last node of `sll`, NULL to find it
+    @return bool                true if the operation was successful, false if a list is NULL or both are the same list
+*/
+bool sll_concat(SinglyLinkedList* sll, SinglyLinkedList* source, SLLNode* tail);
+
+/*
+    sll_split_after
+    Move every node after `node`, a node of `sll`, to the empty list `rest`, in O(K) for the K nodes moved
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  SLLNode*            Last node kept in `sll`
+    @param  SinglyLinkedList*   Pointer to the empty list receiving the nodes
+    @return bool                true if the operation was successful, false if a pointer is NULL or `rest` is not empty
+*/
+bool sll_split_after(SinglyLinkedList* sll, SLLNode* node, SinglyLinkedList* rest);
+
+/*
+    9. Compaction
+    After many insertions, removals and relinking sorts, the order of the nodes in a list no longer follows their order in memory, and every step of a traversal may miss the cache.
+    The compaction functions relink the nodes of a list in increasing address order and move the data pointers between them, so that the list holds the same data in the same order
+    but a traversal reads memory forward: nodes allocated together, like the nodes of a bulk-built list or nodes allocated in sequence, become consecutive.
+    A data pointer only moves between nodes of the same block, or between nodes of no block: the positions held by the nodes of a block get the nodes of that block in address order,
+    and the other positions get the other nodes in address order. A payload copied into a block thus stays held by the nodes of its block, and lists built in bulk and concatenated
+    can still be split and freed in parts after a compaction. Nothing is allocated but three arrays for the duration of the call, and the data itself is not moved.
+    A node no longer holds the same data afterwards: pointers to nodes kept by the caller must be looked up again, and an attached hash index is rebuilt.
+
+    The locality of a list is measured by the average distance in bytes between the addresses of consecutive nodes: the size of a node is the best case.
+*/
+
+/*
+    sll_compact
+    Relink the nodes of a singly linked list in address order within each block, moving their data, in O(N) with a radix sort of the addresses; the order of a list already in address order does not change
+    @param  SinglyLinkedList*   Pointer to the list
+    @return bool                true if the operation was successful, false if the allocation failed (the list is unchanged)
+*/
+bool sll_compact(SinglyLinkedList* sll);
+
+/*
+    dll_compact
+    Relink the nodes of a doubly linked list in address order, moving their data. See `sll_compact`.
+*/
+bool dll_compact(DoublyLinkedList* dll);
+
+/*
+    cll_compact
+    Relink the nodes of a circular linked list in address order, moving their data; the head becomes the node of lowest address of its block, or of the nodes of no block. See `sll_compact`.
+*/
+bool cll_compact(CircularLinkedList* cll);
+
+/*
+    stack_compact
+    Relink the nodes of a stack in address order, moving their data. See `sll_compact`.
+*/
+bool stack_compact(Stack* stack);
+
+/*
+    queue_compact
+    Relink the nodes of a queue in address order, moving their data. See `sll_compact`.
+*/
+bool queue_compact(Queue* queue);
+
+/*
+    sll_locality
+    Get the average distance in bytes between the addresses of consecutive nodes of a singly linked list
+    @param  SinglyLinkedList*   Pointer to the list
+    @return double              Average distance, 0 for fewer than two nodes
+*/
+double sll_locality(SinglyLinkedList* sll);
+
+/*
+    dll_locality, cll_locality, stack_locality, queue_locality
+    Get the average distance in bytes between the addresses of consecutive nodes of a list. See `sll_locality`.
+*/
+double dll_locality(DoublyLinkedList* dll);
+double cll_locality(CircularLinkedList* cll);
+double stack_locality(Stack* stack);
+double queue_locality(Queue* queue);
+
+/*
+    10. Node caches
+    `sllnode_create`, `dllnode_create` and `cllnode_create` allocate from one `NodeCache` per node type (see `dsl_nodecache.h`), and the node free functions
+    and the destroy functions release into them: a thread reuses its freed nodes without a lock, and the nodes freed by one thread are reused by the others through
+    the cache's depot. The nodes are still allocated by `malloc` one by one, so a node may be created or freed with `malloc` and `free` as before.
+*/
+
+/*
+    list_nodes_trim
+    Return the cached free nodes of the calling thread to their depots, then the nodes of the depots to `free`, e.g. after tearing down large lists
+    @param  void
+    @return void
+*/
+void list_nodes_trim(void);
+
+#endif // DSL_LISTS_H
@@ -6,6 +6,8 @@
     - Insertion Sort
     - Merge Sort
     - Quick Sort
+    - Natural Merge Sort (adaptive, Timsort-style)
+    - Introsort through an array (gather, sort, relink)
 
     For all data structures:
     - Singly Linked List
@@ -14,11 +16,18 @@
     - Queue?
     - Stack?
 
+    Parallel merge sorts driven by a work-stealing `ThreadPool` (see `dsl_threadpool.h`) are available for singly and doubly linked lists.
+    The `UnrolledList` from `dsl_unrolled.h` is sorted with a merge sort over its element arrays.
+
     nrdc
     v1.0 2024-03-27
 */
 
 #include "dsl_lists.h"
+#include "dsl_unrolled.h"
+#include "dsl_threadpool.h"
+#include "dsl_listsort.h"
+#include "dsl_cursor.h"
 
 /*
     sll_bubblesort
@@ -36,20 +45,24 @@ SinglyLinkedList* sll_bubblesort(SinglyLinkedList* list, int (*compare)(void*, v
 
     int swapped;
     SLLNode* temp;
+    SLLNode* next;
     SLLNode* end = NULL;
 
     do{
         swapped = 0;
         temp = list->head;
 
-        while(temp->next != end){
-            if(compare(temp->data, temp->next->data) > 0){
+        //  The nodes and their data are prefetched ahead of the comparisons
+        SLLCursor cursor = sll_cursor_at(temp->next, DSL_PREFETCH_DISTANCE, true);
+
+        while((next = sll_cursor_next(&cursor)) != end){
+            if(compare(temp->data, next->data) > 0){
                 void* t = temp->data;
-                temp->data = temp->next->data;
-                temp->next->data = t;
+                temp->data = next->data;
+                next->data = t;
                 swapped = 1;
             }
-            temp = temp->next;
+            temp = next;
         }
         end = temp;
     }while(swapped);
@@ -76,13 +89,12 @@ SinglyLinkedList* sll_selectionsort(SinglyLinkedList* list, int (*compare)(void*
 
     while(temp->next != NULL){
         min = temp;
-        SLLNode* r = temp->next;
+        SLLNode* r = NULL;
 
-        while(r != NULL){
+        SLL_FOREACH_AT(r, temp->next, DSL_PREFETCH_DISTANCE){
             if(compare(r->data, min->data) < 0){
                 min = r;
             }
-            r = r->next;
         }
 
         void* t = min->data;
@@ -260,21 +272,17 @@ DoublyLinkedList* dll_bubblesort(DoublyLinkedList* list, int (*compare)(void*, v
     }
 
     DLLNode* current = list->head;
-    DLLNode* next = current->next;
+    DLLNode* next = NULL;
 
     while(current != NULL){
-        while(next != NULL){
+        DLL_FOREACH_AT(next, current->next, DSL_PREFETCH_DISTANCE){
             if(compare(current->data, next->data) > 0){
                 void* temp = current->data;
                 current->data = next->data;
                 next->data = temp;
             }
-            next = next->next;
         }
         current = current->next;
-        if(current != NULL) {
-            next = current->next;
-        }
     }
 
     return list;
@@ -297,13 +305,12 @@ DoublyLinkedList* dll_selectionsort(DoublyLinkedList* list, int (*compare)(void*
 
     while(current->next != NULL){
         min = current;
-        DLLNode* r = current->next;
+        DLLNode* r = NULL;
 
-        while(r != NULL){
+        DLL_FOREACH_AT(r, current->next, DSL_PREFETCH_DISTANCE){
             if(compare(r->data, min->data) < 0){
                 min = r;
             }
-            r = r->next;
         }
 
         void* temp = min->data;
@@ -638,3 +645,2407 @@ CircularLinkedList* cll_quicksort(CircularLinkedList* list, int (*compare)(void*
     return result;
 };
 
+
+
+
+/*
+    Node-relinking helpers
+    The functions below sort chains of nodes by relinking their `next` pointers, instead of allocating new lists.
+*/
+
+/*
+    sllnode_merge
+    Merge two sorted chains of `SLLNode`. Equal elements are taken from `a` first, so the merge is stable.
+    @param SLLNode* a
+    @param SLLNode* b
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* head of the merged chain
+*/
+static SLLNode* sllnode_merge(SLLNode* a, SLLNode* b, int (*compare)(void*, void*)){
+    SLLNode head;
+    SLLNode* tail = &head;
+
+    while(a != NULL && b != NULL){
+        if(compare(a->data, b->data) <= 0){
+            tail->next = a;
+            a = a->next;
+        }else{
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = (a != NULL) ? a : b;
+
+    return head.next;
+};
+
+/*
+    sllnode_split
+    Cut a chain of `SLLNode` after its first `n` nodes.
+    @param SLLNode* chain
+    @param size_t n
+    @returns SLLNode* head of the remaining chain
+*/
+static SLLNode* sllnode_split(SLLNode* chain, size_t n){
+    for(size_t i = 1; i < n; i++){
+        chain = chain->next;
+    }
+
+    SLLNode* rest = chain->next;
+    chain->next = NULL;
+
+    return rest;
+};
+
+/*
+    sllnode_mergesort
+    Sort a chain of `n` `SLLNode` with a top-down merge sort.
+    @param SLLNode* chain
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* head of the sorted chain
+*/
+static SLLNode* sllnode_mergesort(SLLNode* chain, size_t n, int (*compare)(void*, void*)){
+    if(n < 2){
+        return chain;
+    }
+
+    SLLNode* rest = sllnode_split(chain, n / 2);
+
+    chain = sllnode_mergesort(chain, n / 2, compare);
+    rest = sllnode_mergesort(rest, n - n / 2, compare);
+
+    return sllnode_merge(chain, rest, compare);
+};
+
+/*
+    dllnode_merge
+    Merge two sorted chains of `DLLNode`, following `next` only. Equal elements are taken from `a` first.
+    @param DLLNode* a
+    @param DLLNode* b
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* head of the merged chain
+*/
+static DLLNode* dllnode_merge(DLLNode* a, DLLNode* b, int (*compare)(void*, void*)){
+    DLLNode head;
+    DLLNode* tail = &head;
+
+    while(a != NULL && b != NULL){
+        if(compare(a->data, b->data) <= 0){
+            tail->next = a;
+            a = a->next;
+        }else{
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = (a != NULL) ? a : b;
+
+    return head.next;
+};
+
+/*
+    dllnode_split
+    Cut a chain of `DLLNode` after its first `n` nodes.
+    @param DLLNode* chain
+    @param size_t n
+    @returns DLLNode* head of the remaining chain
+*/
+static DLLNode* dllnode_split(DLLNode* chain, size_t n){
+    for(size_t i = 1; i < n; i++){
+        chain = chain->next;
+    }
+
+    DLLNode* rest = chain->next;
+    chain->next = NULL;
+
+    return rest;
+};
+
+/*
+    dllnode_mergesort
+    Sort a chain of `n` `DLLNode` with a top-down merge sort. The `prev` pointers are left stale.
+    @param DLLNode* chain
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* head of the sorted chain
+*/
+static DLLNode* dllnode_mergesort(DLLNode* chain, size_t n, int (*compare)(void*, void*)){
+    if(n < 2){
+        return chain;
+    }
+
+    DLLNode* rest = dllnode_split(chain, n / 2);
+
+    chain = dllnode_mergesort(chain, n / 2, compare);
+    rest = dllnode_mergesort(rest, n - n / 2, compare);
+
+    return dllnode_merge(chain, rest, compare);
+};
+
+/*
+    dll_relink_prev
+    Rebuild the `prev` pointers and the `tail` of a doubly linked list from its `next` chain.
+    @param DoublyLinkedList* list
+    @returns void
+*/
+static void dll_relink_prev(DoublyLinkedList* list){
+    DLLNode* prev = NULL;
+    DLLNode* current = list->head;
+
+    while(current != NULL){
+        current->prev = prev;
+        prev = current;
+        current = current->next;
+    }
+
+    list->tail = prev;
+};
+
+
+/*
+    Parallel sorting functions
+    The chains are split in halves; the left half is sorted by a task of the `ThreadPool` while the calling thread sorts the right half. Below `PARALLEL_SORT_CUTOFF` nodes, the sequential merge sort is used.
+*/
+
+#define PARALLEL_SORT_CUTOFF 4096
+
+/*
+    Arguments of a parallel merge sort task
+*/
+typedef struct SLLSortTask {
+    SLLNode* chain;
+    size_t n;
+    int (*compare)(void*, void*);
+    ThreadPool* pool;
+} SLLSortTask;
+
+typedef struct DLLSortTask {
+    DLLNode* chain;
+    size_t n;
+    int (*compare)(void*, void*);
+    ThreadPool* pool;
+} DLLSortTask;
+
+/*
+    sll_parallel_mergesort_task
+    Sort the chain of a `SLLSortTask`, forking the left half to the pool. The sorted chain is stored back in the task.
+    @param void* arg
+    @returns void
+*/
+static void sll_parallel_mergesort_task(void* arg){
+    SLLSortTask* task = (SLLSortTask*)arg;
+
+    if(task->n < PARALLEL_SORT_CUTOFF){
+        task->chain = sllnode_mergesort(task->chain, task->n, task->compare);
+        return;
+    }
+
+    SLLSortTask left = {task->chain, task->n / 2, task->compare, task->pool};
+    SLLSortTask right = {NULL, task->n - task->n / 2, task->compare, task->pool};
+    right.chain = sllnode_split(left.chain, left.n);
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    if(!threadpool_submit(task->pool, &group, sll_parallel_mergesort_task, &left)){
+        sll_parallel_mergesort_task(&left);
+    }
+    sll_parallel_mergesort_task(&right);
+    threadpool_wait(task->pool, &group);
+
+    task->chain = sllnode_merge(left.chain, right.chain, task->compare);
+};
+
+/*
+    dll_parallel_mergesort_task
+    Sort the chain of a `DLLSortTask`, forking the left half to the pool. The sorted chain is stored back in the task.
+    @param void* arg
+    @returns void
+*/
+static void dll_parallel_mergesort_task(void* arg){
+    DLLSortTask* task = (DLLSortTask*)arg;
+
+    if(task->n < PARALLEL_SORT_CUTOFF){
+        task->chain = dllnode_mergesort(task->chain, task->n, task->compare);
+        return;
+    }
+
+    DLLSortTask left = {task->chain, task->n / 2, task->compare, task->pool};
+    DLLSortTask right = {NULL, task->n - task->n / 2, task->compare, task->pool};
+    right.chain = dllnode_split(left.chain, left.n);
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    if(!threadpool_submit(task->pool, &group, dll_parallel_mergesort_task, &left)){
+        dll_parallel_mergesort_task(&left);
+    }
+    dll_parallel_mergesort_task(&right);
+    threadpool_wait(task->pool, &group);
+
+    task->chain = dllnode_merge(left.chain, right.chain, task->compare);
+};
+
+/*
+    sll_parallel_mergesort
+    Function to sort a `SinglyLinkedList` (sll) in place with a merge sort driven by a `ThreadPool`.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @param ThreadPool* pool
+    @returns SinglyLinkedList* list
+*/
+SinglyLinkedList* sll_parallel_mergesort(SinglyLinkedList* list, int (*compare)(void*, void*), ThreadPool* pool){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    SLLSortTask task = {list->head, list->size, compare, pool};
+    sll_parallel_mergesort_task(&task);
+    list->head = task.chain;
+
+    return list;
+};
+
+/*
+    dll_parallel_mergesort
+    Function to sort a `DoublyLinkedList` (dll) in place with a merge sort driven by a `ThreadPool`.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @param ThreadPool* pool
+    @returns DoublyLinkedList* list
+*/
+DoublyLinkedList* dll_parallel_mergesort(DoublyLinkedList* list, int (*compare)(void*, void*), ThreadPool* pool){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    DLLSortTask task = {list->head, list->size, compare, pool};
+    dll_parallel_mergesort_task(&task);
+    list->head = task.chain;
+    dll_relink_prev(list);
+
+    return list;
+};
+
+
+
+/*
+    `UnrolledList` sorting functions
+*/
+
+/*
+    ptr_mergesort
+    Stable top-down merge sort of an array of data pointers.
+    @param void** items
+    @param void** buffer, scratch array with room for `n` pointers
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void ptr_mergesort(void** items, void** buffer, size_t n, int (*compare)(void*, void*)){
+    if(n < 2){
+        return;
+    }
+
+    if(n <= 16){
+        for(size_t i = 1; i < n; i++){
+            void* item = items[i];
+            size_t j = i;
+
+            while(j > 0 && compare(items[j - 1], item) > 0){
+                items[j] = items[j - 1];
+                j--;
+            }
+            items[j] = item;
+        }
+        return;
+    }
+
+    size_t mid = n / 2;
+    ptr_mergesort(items, buffer, mid, compare);
+    ptr_mergesort(items + mid, buffer, n - mid, compare);
+
+    //  Already in order: nothing to merge
+    if(compare(items[mid - 1], items[mid]) <= 0){
+        return;
+    }
+
+    memcpy(buffer, items, mid * sizeof(void*));
+
+    size_t i = 0, j = mid, k = 0;
+    while(i < mid && j < n){
+        if(compare(buffer[i], items[j]) <= 0){
+            items[k++] = buffer[i++];
+        }else{
+            items[k++] = items[j++];
+        }
+    }
+
+    while(i < mid){
+        items[k++] = buffer[i++];
+    }
+};
+
+/*
+    ull_mergesort
+    Function to sort an `UnrolledList` (ull) using the merge sort algorithm.
+    The elements are gathered from the node arrays, sorted contiguously and written back in place, so the nodes keep their fill.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param UnrolledList* list
+    @param int (*compare)(void*, void*)
+    @returns UnrolledList* list, NULL if the buffers could not be allocated (the list is then left unsorted)
+*/
+UnrolledList* ull_mergesort(UnrolledList* list, int (*compare)(void*, void*)){
+    if(list == NULL || list->size < 2){
+        return list;
+    }
+
+    void** items = (void**)malloc(list->size * sizeof(void*));
+    void** buffer = (void**)malloc((list->size / 2 + 1) * sizeof(void*));
+
+    if(items == NULL || buffer == NULL){
+        free(items);
+        free(buffer);
+        return NULL;
+    }
+
+    size_t k = 0;
+    for(ULLNode* node = list->head; node != NULL; node = node->next){
+        memcpy(&items[k], node->data, node->count * sizeof(void*));
+        k += node->count;
+    }
+
+    ptr_mergesort(items, buffer, k, compare);
+
+    k = 0;
+    for(ULLNode* node = list->head; node != NULL; node = node->next){
+        memcpy(node->data, &items[k], node->count * sizeof(void*));
+        k += node->count;
+    }
+
+    free(items);
+    free(buffer);
+
+    return list;
+};
+
+
+
+/*
+    Queue sorting algorithms
+*/
+
+/*
+    queue_mergesort
+    Function to sort a `Queue` using the merge sort algorithm. The sort is stable.
+    The nodes are relinked in place, from the front to the back, without allocating.
+    The compare function is used to compare two elements in the queue. It must be provided by the user.
+
+    @param Queue* queue
+    @param int (*compare)(void*, void*)
+    @returns Queue* queue
+*/
+Queue* queue_mergesort(Queue* queue, int (*compare)(void*, void*)){
+    if(queue == NULL || queue->front == NULL || queue->front->next == NULL){
+        return queue;
+    }
+
+    queue->front = dllnode_mergesort(queue->front, queue->size, compare);
+
+    DLLNode* back = queue->front;
+    while(back->next != NULL){
+        back = back->next;
+    }
+    queue->back = back;
+
+    return queue;
+};
+
+
+
+/*
+    Selection and heap sorting functions
+*/
+
+/*
+    ptr_heap_sift_down
+    Move the element at position `i` of a binary max-heap of data pointers down to its place.
+    @param void** items
+    @param size_t n, number of elements of the heap
+    @param size_t i
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void ptr_heap_sift_down(void** items, size_t n, size_t i, int (*compare)(void*, void*)){
+    void* item = items[i];
+
+    for(;;){
+        size_t child = 2 * i + 1;
+
+        if(child >= n){
+            break;
+        }
+        if(child + 1 < n && compare(items[child + 1], items[child]) > 0){
+            child++;
+        }
+        if(compare(items[child], item) <= 0){
+            break;
+        }
+
+        items[i] = items[child];
+        i = child;
+    }
+
+    items[i] = item;
+};
+
+/*
+    ptr_heapify
+    Arrange an array of data pointers as a binary max-heap.
+    @param void** items
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void ptr_heapify(void** items, size_t n, int (*compare)(void*, void*)){
+    for(size_t i = n / 2; i-- > 0;){
+        ptr_heap_sift_down(items, n, i, compare);
+    }
+};
+
+/*
+    ptr_heapsort
+    Sort an array of data pointers in place with the heap sort algorithm. The array must already be a max-heap.
+    @param void** items
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void ptr_heapsort(void** items, size_t n, int (*compare)(void*, void*)){
+    while(n > 1){
+        void* max = items[0];
+
+        n--;
+        items[0] = items[n];
+        items[n] = max;
+        ptr_heap_sift_down(items, n, 0, compare);
+    }
+};
+
+/*
+    ptr_topk
+    Collect the `k` smallest data pointers of a sequence with a bounded max-heap, in O(N log K).
+    Called once per element, in order; `count` is the number of elements seen so far.
+    @param void** heap, room for `k` pointers
+    @param size_t k
+    @param size_t count
+    @param void* data
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void ptr_topk(void** heap, size_t k, size_t count, void* data, int (*compare)(void*, void*)){
+    if(count < k){
+        heap[count] = data;
+
+        if(count + 1 == k){
+            ptr_heapify(heap, k, compare);
+        }
+    }else if(compare(data, heap[0]) < 0){
+        //  Smaller than the largest of the `k` kept so far: replace it
+        heap[0] = data;
+        ptr_heap_sift_down(heap, k, 0, compare);
+    }
+};
+
+/*
+    sll_topk
+    Function to get the `k` smallest elements of a `SinglyLinkedList` (sll), in sorted order, with a bounded heap in O(N log K).
+    The list is not modified.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns SinglyLinkedList* new list with the `k` smallest elements
+*/
+SinglyLinkedList* sll_topk(SinglyLinkedList* list, size_t k, int (*compare)(void*, void*)){
+    SinglyLinkedList* result = sll_create();
+
+    if(result == NULL || list == NULL){
+        return result;
+    }
+    if(k > list->size){
+        k = list->size;
+    }
+    if(k == 0){
+        return result;
+    }
+
+    void** heap = (void**)malloc(k * sizeof(void*));
+
+    if(heap == NULL){
+        sll_destroy(result);
+        return NULL;
+    }
+
+    size_t count = 0;
+    for(SLLNode* current = list->head; current != NULL; current = current->next){
+        ptr_topk(heap, k, count++, current->data, compare);
+    }
+
+    ptr_heapsort(heap, k, compare);
+
+    for(size_t i = k; i-- > 0;){
+        if(!sll_insert(result, heap[i])){
+            free(heap);
+            sll_destroy(result);
+            return NULL;
+        }
+    }
+
+    free(heap);
+
+    return result;
+};
+
+/*
+    dll_topk
+    Function to get the `k` smallest elements of a `DoublyLinkedList` (dll), in sorted order, with a bounded heap in O(N log K).
+    The list is not modified.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns DoublyLinkedList* new list with the `k` smallest elements
+*/
+DoublyLinkedList* dll_topk(DoublyLinkedList* list, size_t k, int (*compare)(void*, void*)){
+    DoublyLinkedList* result = dll_create();
+
+    if(result == NULL || list == NULL){
+        return result;
+    }
+    if(k > list->size){
+        k = list->size;
+    }
+    if(k == 0){
+        return result;
+    }
+
+    void** heap = (void**)malloc(k * sizeof(void*));
+
+    if(heap == NULL){
+        dll_destroy(result);
+        return NULL;
+    }
+
+    size_t count = 0;
+    for(DLLNode* current = list->head; current != NULL; current = current->next){
+        ptr_topk(heap, k, count++, current->data, compare);
+    }
+
+    ptr_heapsort(heap, k, compare);
+
+    for(size_t i = 0; i < k; i++){
+        if(!dll_append(result, heap[i])){
+            free(heap);
+            dll_destroy(result);
+            return NULL;
+        }
+    }
+
+    free(heap);
+
+    return result;
+};
+
+/*
+    sllnode_select
+    Quickselect over a chain of `n` `SLLNode`: relink the nodes so that the node at position `rank` holds the element it would hold if the chain were sorted,
+    with no greater element before it and no smaller element after it. Expected O(N).
+    Each round partitions the remaining range in three chains (less than, equal to and greater than a pivot) and keeps the one holding `rank`.
+    The first pivot is the head; the next ones are sampled at random during the partition, so that no round walks the chain twice.
+    @param SLLNode* chain
+    @param size_t n
+    @param size_t rank, less than `n`
+    @param int (*compare)(void*, void*)
+    @param SLLNode** nth, receives the node at position `rank`
+    @returns SLLNode* head of the relinked chain
+*/
+static SLLNode* sllnode_select(SLLNode* chain, size_t n, size_t rank, int (*compare)(void*, void*), SLLNode** nth){
+    SLLNode head;
+    SLLNode* prefix = &head;
+    SLLNode* suffix = NULL;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL ^ n;
+
+    void* value = chain->data;
+
+    for(;;){
+        SLLNode lt, eq, gt;
+        SLLNode* lt_tail = &lt;
+        SLLNode* eq_tail = &eq;
+        SLLNode* gt_tail = &gt;
+        size_t nlt = 0, neq = 0, ngt = 0;
+        void* lt_pivot = NULL;
+        void* gt_pivot = NULL;
+
+        for(SLLNode* current = chain; current != NULL; current = current->next){
+            int order = compare(current->data, value);
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            //  Reservoir sampling: the next pivot is a uniformly random element of the kept chain, drawn without walking it again
+            if(order < 0){
+                lt_tail->next = current;
+                lt_tail = current;
+                if(seed % ++nlt == 0){
+                    lt_pivot = current->data;
+                }
+            }else if(order == 0){
+                eq_tail->next = current;
+                eq_tail = current;
+                neq++;
+            }else{
+                gt_tail->next = current;
+                gt_tail = current;
+                if(seed % ++ngt == 0){
+                    gt_pivot = current->data;
+                }
+            }
+        }
+
+        gt_tail->next = suffix;
+        eq_tail->next = ngt ? gt.next : suffix;
+
+        if(rank < nlt){
+            //  The equal and greater chains are in place after the range
+            suffix = eq.next;
+            lt_tail->next = NULL;
+            chain = lt.next;
+            value = lt_pivot;
+        }else if(rank < nlt + neq){
+            lt_tail->next = eq.next;
+            prefix->next = nlt ? lt.next : eq.next;
+
+            SLLNode* node = eq.next;
+            for(size_t i = nlt; i < rank; i++){
+                node = node->next;
+            }
+            *nth = node;
+
+            return head.next;
+        }else{
+            //  The less and equal chains are in place before the range
+            lt_tail->next = eq.next;
+            prefix->next = nlt ? lt.next : eq.next;
+            prefix = eq_tail;
+            gt_tail->next = NULL;
+            chain = gt.next;
+            value = gt_pivot;
+            rank -= nlt + neq;
+        }
+    }
+};
+
+/*
+    dllnode_select
+    Quickselect over a chain of `n` `DLLNode`, following `next` only. See `sllnode_select`.
+    @param DLLNode* chain
+    @param size_t n
+    @param size_t rank, less than `n`
+    @param int (*compare)(void*, void*)
+    @param DLLNode** nth, receives the node at position `rank`
+    @returns DLLNode* head of the relinked chain
+*/
+static DLLNode* dllnode_select(DLLNode* chain, size_t n, size_t rank, int (*compare)(void*, void*), DLLNode** nth){
+    DLLNode head;
+    DLLNode* prefix = &head;
+    DLLNode* suffix = NULL;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL ^ n;
+
+    void* value = chain->data;
+
+    for(;;){
+        DLLNode lt, eq, gt;
+        DLLNode* lt_tail = &lt;
+        DLLNode* eq_tail = &eq;
+        DLLNode* gt_tail = &gt;
+        size_t nlt = 0, neq = 0, ngt = 0;
+        void* lt_pivot = NULL;
+        void* gt_pivot = NULL;
+
+        for(DLLNode* current = chain; current != NULL; current = current->next){
+            int order = compare(current->data, value);
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            //  Reservoir sampling: the next pivot is a uniformly random element of the kept chain, drawn without walking it again
+            if(order < 0){
+                lt_tail->next = current;
+                lt_tail = current;
+                if(seed % ++nlt == 0){
+                    lt_pivot = current->data;
+                }
+            }else if(order == 0){
+                eq_tail->next = current;
+                eq_tail = current;
+                neq++;
+            }else{
+                gt_tail->next = current;
+                gt_tail = current;
+                if(seed % ++ngt == 0){
+                    gt_pivot = current->data;
+                }
+            }
+        }
+
+        gt_tail->next = suffix;
+        eq_tail->next = ngt ? gt.next : suffix;
+
+        if(rank < nlt){
+            suffix = eq.next;
+            lt_tail->next = NULL;
+            chain = lt.next;
+            value = lt_pivot;
+        }else if(rank < nlt + neq){
+            lt_tail->next = eq.next;
+            prefix->next = nlt ? lt.next : eq.next;
+
+            DLLNode* node = eq.next;
+            for(size_t i = nlt; i < rank; i++){
+                node = node->next;
+            }
+            *nth = node;
+
+            return head.next;
+        }else{
+            lt_tail->next = eq.next;
+            prefix->next = nlt ? lt.next : eq.next;
+            prefix = eq_tail;
+            gt_tail->next = NULL;
+            chain = gt.next;
+            value = gt_pivot;
+            rank -= nlt + neq;
+        }
+    }
+};
+
+/*
+    sll_nth_element
+    Function to place the `n`-th smallest element of a `SinglyLinkedList` (sll) at position `n` (from 0), with a quickselect over the nodes in expected O(N).
+    The nodes are relinked: the elements before position `n` are not greater than it, and the elements after are not smaller, in no particular order.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* node at position `n`, NULL if the list has `n` elements or fewer
+*/
+SLLNode* sll_nth_element(SinglyLinkedList* list, size_t n, int (*compare)(void*, void*)){
+    if(list == NULL || n >= list->size){
+        return NULL;
+    }
+
+    SLLNode* nth = NULL;
+    list->head = sllnode_select(list->head, list->size, n, compare, &nth);
+
+    return nth;
+};
+
+/*
+    dll_nth_element
+    Function to place the `n`-th smallest element of a `DoublyLinkedList` (dll) at position `n` (from 0), with a quickselect over the nodes in expected O(N).
+    The nodes are relinked: the elements before position `n` are not greater than it, and the elements after are not smaller, in no particular order.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* node at position `n`, NULL if the list has `n` elements or fewer
+*/
+DLLNode* dll_nth_element(DoublyLinkedList* list, size_t n, int (*compare)(void*, void*)){
+    if(list == NULL || n >= list->size){
+        return NULL;
+    }
+
+    DLLNode* nth = NULL;
+    list->head = dllnode_select(list->head, list->size, n, compare, &nth);
+    dll_relink_prev(list);
+
+    return nth;
+};
+
+/*
+    sll_partial_sort
+    Function to sort the `k` smallest elements of a `SinglyLinkedList` (sll) into its first `k` nodes, in O(N + K log K).
+    The remaining nodes follow in no particular order. The first `k` nodes are selected with `sll_nth_element`, then merge sorted.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns SinglyLinkedList* list
+*/
+SinglyLinkedList* sll_partial_sort(SinglyLinkedList* list, size_t k, int (*compare)(void*, void*)){
+    if(list == NULL || list->head == NULL || k == 0){
+        return list;
+    }
+    if(k >= list->size){
+        list->head = sllnode_mergesort(list->head, list->size, compare);
+        return list;
+    }
+
+    SLLNode* nth = NULL;
+    list->head = sllnode_select(list->head, list->size, k - 1, compare, &nth);
+
+    SLLNode* rest = sllnode_split(list->head, k);
+    list->head = sllnode_mergesort(list->head, k, compare);
+
+    SLLNode* tail = list->head;
+    while(tail->next != NULL){
+        tail = tail->next;
+    }
+    tail->next = rest;
+
+    return list;
+};
+
+/*
+    dll_partial_sort
+    Function to sort the `k` smallest elements of a `DoublyLinkedList` (dll) into its first `k` nodes, in O(N + K log K).
+    The remaining nodes follow in no particular order. The first `k` nodes are selected with `dll_nth_element`, then merge sorted.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns DoublyLinkedList* list
+*/
+DoublyLinkedList* dll_partial_sort(DoublyLinkedList* list, size_t k, int (*compare)(void*, void*)){
+    if(list == NULL || list->head == NULL || k == 0){
+        return list;
+    }
+
+    if(k >= list->size){
+        list->head = dllnode_mergesort(list->head, list->size, compare);
+    }else{
+        DLLNode* nth = NULL;
+        list->head = dllnode_select(list->head, list->size, k - 1, compare, &nth);
+
+        DLLNode* rest = dllnode_split(list->head, k);
+        list->head = dllnode_mergesort(list->head, k, compare);
+
+        DLLNode* tail = list->head;
+        while(tail->next != NULL){
+            tail = tail->next;
+        }
+        tail->next = rest;
+    }
+
+    dll_relink_prev(list);
+
+    return list;
+};
+
+/*
+    sll_heapsort
+    Function to sort a `SinglyLinkedList` (sll) using the heap sort algorithm, in O(N log N) with no recursion.
+    The data pointers are gathered in an array, sorted, and written back to the nodes in order.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @returns SinglyLinkedList* list, NULL if the array could not be allocated (the list is unchanged)
+*/
+SinglyLinkedList* sll_heapsort(SinglyLinkedList* list, int (*compare)(void*, void*)){
+    if(list == NULL || list->size < 2){
+        return list;
+    }
+
+    void** items = (void**)malloc(list->size * sizeof(void*));
+
+    //  The list is left unsorted, as `ull_mergesort` does
+    if(items == NULL){
+        return NULL;
+    }
+
+    size_t n = 0;
+    for(SLLNode* current = list->head; current != NULL; current = current->next){
+        items[n++] = current->data;
+    }
+
+    ptr_heapify(items, n, compare);
+    ptr_heapsort(items, n, compare);
+
+    n = 0;
+    for(SLLNode* current = list->head; current != NULL; current = current->next){
+        current->data = items[n++];
+    }
+
+    free(items);
+
+    return list;
+};
+
+/*
+    dll_heapsort
+    Function to sort a `DoublyLinkedList` (dll) using the heap sort algorithm, in O(N log N) with no recursion.
+    The data pointers are gathered in an array, sorted, and written back to the nodes in order.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @returns DoublyLinkedList* list, NULL if the array could not be allocated (the list is unchanged)
+*/
+DoublyLinkedList* dll_heapsort(DoublyLinkedList* list, int (*compare)(void*, void*)){
+    if(list == NULL || list->size < 2){
+        return list;
+    }
+
+    void** items = (void**)malloc(list->size * sizeof(void*));
+
+    //  The list is left unsorted, as `ull_mergesort` does
+    if(items == NULL){
+        return NULL;
+    }
+
+    size_t n = 0;
+    for(DLLNode* current = list->head; current != NULL; current = current->next){
+        items[n++] = current->data;
+    }
+
+    ptr_heapify(items, n, compare);
+    ptr_heapsort(items, n, compare);
+
+    n = 0;
+    for(DLLNode* current = list->head; current != NULL; current = current->next){
+        current->data = items[n++];
+    }
+
+    free(items);
+
+    return list;
+};
+
+
+
+/*
+    Adaptive merge sort
+    A natural merge sort in the manner of Timsort: the chain is cut into the runs it already contains, and adjacent runs are merged until one is left.
+    Sorted input is a single run and takes O(N); input made of K sorted batches takes O(N log K).
+*/
+
+//  Minimum number of consecutive nodes taken from one run before a merge starts galloping
+#define LISTSORT_MIN_GALLOP 7
+
+//  Maximum number of pending runs: the run lengths grow faster than the Fibonacci numbers, so 85 covers any `size_t` length
+#define LISTSORT_MAX_RUNS 85
+
+/*
+    Run of a natural merge sort: a sorted chain of `length` nodes, from `head` to `tail`, whose `tail->next` is NULL.
+    The nodes are `SLLNode` or `DLLNode`.
+*/
+typedef struct ListSortRun {
+    void* head;
+    void* tail;
+    size_t length;
+} ListSortRun;
+
+/*
+    listsort_minrun
+    Compute the minimum run length for a chain of `n` nodes: between 32 and 64, such that n / minrun is close to, but not above, a power of 2.
+    Shorter runs are extended with an insertion sort, which is cheaper than merging them.
+    @param size_t n
+    @returns size_t
+*/
+static size_t listsort_minrun(size_t n){
+    size_t remainder = 0;
+
+    while(n >= 64){
+        remainder |= n & 1;
+        n >>= 1;
+    }
+
+    return n + remainder;
+};
+
+/*
+    sllnode_run_push_sorted
+    Insert a node into a sorted run, after the elements equal to it, so that the insertion is stable.
+    @param SLLNode** head
+    @param SLLNode** tail
+    @param SLLNode* node
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void sllnode_run_push_sorted(SLLNode** head, SLLNode** tail, SLLNode* node, int (*compare)(void*, void*)){
+    if(compare(node->data, (*tail)->data) >= 0){
+        (*tail)->next = node;
+        *tail = node;
+    }else if(compare(node->data, (*head)->data) < 0){
+        node->next = *head;
+        *head = node;
+        return;
+    }else{
+        SLLNode* current = *head;
+        while(compare(current->next->data, node->data) <= 0){
+            current = current->next;
+        }
+        node->next = current->next;
+        current->next = node;
+        return;
+    }
+
+    node->next = NULL;
+};
+
+/*
+    sllnode_next_run
+    Cut the next run off a chain of `SLLNode`: the longest non-descending prefix, or the longest strictly descending prefix, reversed in place.
+    Strictly descending runs hold no equal elements, so reversing them keeps the sort stable.
+    A run shorter than `minrun` is extended to `minrun` nodes with an insertion sort.
+    @param SLLNode** chain, receives the rest of the chain
+    @param size_t minrun
+    @param int (*compare)(void*, void*)
+    @returns ListSortRun
+*/
+static ListSortRun sllnode_next_run(SLLNode** chain, size_t minrun, int (*compare)(void*, void*)){
+    SLLNode* head = *chain;
+    SLLNode* tail = head;
+    SLLNode* current = head->next;
+    size_t length = 1;
+
+    if(current != NULL && compare(current->data, head->data) < 0){
+        head->next = NULL;
+        while(current != NULL && compare(current->data, head->data) < 0){
+            SLLNode* next = current->next;
+            current->next = head;
+            head = current;
+            current = next;
+            length++;
+        }
+    }else{
+        while(current != NULL && compare(current->data, tail->data) >= 0){
+            tail = current;
+            current = current->next;
+            length++;
+        }
+        tail->next = NULL;
+    }
+
+    while(length < minrun && current != NULL){
+        SLLNode* next = current->next;
+        sllnode_run_push_sorted(&head, &tail, current, compare);
+        current = next;
+        length++;
+    }
+
+    *chain = current;
+
+    return (ListSortRun){head, tail, length};
+};
+
+/*
+    sllnode_gallop
+    Find the longest prefix of a chain of `SLLNode` whose elements all precede `key`: compare less than `key` if `strict`, less than or equal otherwise.
+    The first node must belong to the prefix. The prefix is probed at exponentially growing distances, then bisected,
+    so a prefix of K nodes costs O(log K) comparisons (and O(K) steps along the chain).
+    @param SLLNode* node
+    @param void* key
+    @param bool strict
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* last node of the prefix
+*/
+static SLLNode* sllnode_gallop(SLLNode* node, void* key, bool strict, int (*compare)(void*, void*)){
+    SLLNode* last = node;
+    size_t step = 1;
+    size_t gap;
+
+    //  Exponential search: `last` precedes `key`, the node `gap` steps after it does not (or is past the end)
+    for(;;){
+        SLLNode* probe = last;
+        size_t walked = 0;
+
+        while(walked < step && probe->next != NULL){
+            probe = probe->next;
+            walked++;
+        }
+        if(walked == 0){
+            return last;
+        }
+
+        int order = compare(probe->data, key);
+        if(order < 0 || (!strict && order == 0)){
+            last = probe;
+            if(walked < step){
+                return last;
+            }
+            step *= 2;
+        }else{
+            gap = walked;
+            break;
+        }
+    }
+
+    //  Bisection between `last` and the node `gap` steps after it
+    while(gap > 1){
+        SLLNode* probe = last;
+        size_t half = gap / 2;
+
+        for(size_t i = 0; i < half; i++){
+            probe = probe->next;
+        }
+
+        int order = compare(probe->data, key);
+        if(order < 0 || (!strict && order == 0)){
+            last = probe;
+            gap -= half;
+        }else{
+            gap = half;
+        }
+    }
+
+    return last;
+};
+
+/*
+    sllnode_merge_runs
+    Merge two adjacent runs of `SLLNode`, stably. Runs that are already in order are joined in O(1).
+    After `LISTSORT_MIN_GALLOP` consecutive nodes taken from the same run, the merge gallops: it finds with `sllnode_gallop` how many more nodes come from that run and moves them at once.
+    @param ListSortRun a, first run
+    @param ListSortRun b, second run
+    @param int (*compare)(void*, void*)
+    @returns ListSortRun merged run
+*/
+static ListSortRun sllnode_merge_runs(ListSortRun a, ListSortRun b, int (*compare)(void*, void*)){
+    ListSortRun merged = {NULL, NULL, a.length + b.length};
+
+    if(compare(((SLLNode*)a.tail)->data, ((SLLNode*)b.head)->data) <= 0){
+        ((SLLNode*)a.tail)->next = (SLLNode*)b.head;
+        merged.head = a.head;
+        merged.tail = b.tail;
+        return merged;
+    }
+
+    SLLNode head;
+    SLLNode* tail = &head;
+    SLLNode* x = (SLLNode*)a.head;
+    SLLNode* y = (SLLNode*)b.head;
+    size_t x_wins = 0, y_wins = 0;
+
+    while(x != NULL && y != NULL){
+        if(compare(x->data, y->data) <= 0){
+            if(++x_wins >= LISTSORT_MIN_GALLOP){
+                SLLNode* last = sllnode_gallop(x, y->data, false, compare);
+                tail->next = x;
+                tail = last;
+                x = last->next;
+                x_wins = 0;
+            }else{
+                tail->next = x;
+                tail = x;
+                x = x->next;
+            }
+            y_wins = 0;
+        }else{
+            if(++y_wins >= LISTSORT_MIN_GALLOP){
+                SLLNode* last = sllnode_gallop(y, x->data, true, compare);
+                tail->next = y;
+                tail = last;
+                y = last->next;
+                y_wins = 0;
+            }else{
+                tail->next = y;
+                tail = y;
+                y = y->next;
+            }
+            x_wins = 0;
+        }
+    }
+
+    if(x != NULL){
+        tail->next = x;
+        merged.tail = a.tail;
+    }else{
+        tail->next = y;
+        merged.tail = b.tail;
+    }
+    merged.head = head.next;
+
+    return merged;
+};
+
+/*
+    sllnode_natural_mergesort
+    Sort a chain of `n` `SLLNode` with an adaptive natural merge sort, stable and without allocation.
+    @param SLLNode* chain
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* head of the sorted chain
+*/
+static SLLNode* sllnode_natural_mergesort(SLLNode* chain, size_t n, int (*compare)(void*, void*)){
+    ListSortRun runs[LISTSORT_MAX_RUNS];
+    size_t nruns = 0;
+    size_t minrun = listsort_minrun(n);
+
+    while(chain != NULL){
+        runs[nruns++] = sllnode_next_run(&chain, minrun, compare);
+
+        //  Keep the run lengths decreasing faster than the Fibonacci numbers, so merges stay balanced and the stack shallow
+        while(nruns > 1){
+            size_t i = nruns - 2;
+
+            if((i > 0 && runs[i - 1].length <= runs[i].length + runs[i + 1].length) ||
+               (i > 1 && runs[i - 2].length <= runs[i - 1].length + runs[i].length)){
+                if(runs[i - 1].length < runs[i + 1].length){
+                    i--;
+                }
+            }else if(runs[i].length > runs[i + 1].length){
+                break;
+            }
+
+            runs[i] = sllnode_merge_runs(runs[i], runs[i + 1], compare);
+            if(i + 2 < nruns){
+                runs[i + 1] = runs[i + 2];
+            }
+            nruns--;
+        }
+    }
+
+    while(nruns > 1){
+        size_t i = nruns - 2;
+
+        if(i > 0 && runs[i - 1].length < runs[i + 1].length){
+            i--;
+        }
+
+        runs[i] = sllnode_merge_runs(runs[i], runs[i + 1], compare);
+        if(i + 2 < nruns){
+            runs[i + 1] = runs[i + 2];
+        }
+        nruns--;
+    }
+
+    return nruns ? (SLLNode*)runs[0].head : NULL;
+};
+
+/*
+    dllnode_run_push_sorted
+    See `sllnode_run_push_sorted`; only the `next` pointers are used.
+    @param DLLNode** head
+    @param DLLNode** tail
+    @param DLLNode* node
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void dllnode_run_push_sorted(DLLNode** head, DLLNode** tail, DLLNode* node, int (*compare)(void*, void*)){
+    if(compare(node->data, (*tail)->data) >= 0){
+        (*tail)->next = node;
+        *tail = node;
+    }else if(compare(node->data, (*head)->data) < 0){
+        node->next = *head;
+        *head = node;
+        return;
+    }else{
+        DLLNode* current = *head;
+        while(compare(current->next->data, node->data) <= 0){
+            current = current->next;
+        }
+        node->next = current->next;
+        current->next = node;
+        return;
+    }
+
+    node->next = NULL;
+};
+
+/*
+    dllnode_next_run
+    See `sllnode_next_run`; only the `next` pointers are used.
+    @param DLLNode** chain, receives the rest of the chain
+    @param size_t minrun
+    @param int (*compare)(void*, void*)
+    @returns ListSortRun
+*/
+static ListSortRun dllnode_next_run(DLLNode** chain, size_t minrun, int (*compare)(void*, void*)){
+    DLLNode* head = *chain;
+    DLLNode* tail = head;
+    DLLNode* current = head->next;
+    size_t length = 1;
+
+    if(current != NULL && compare(current->data, head->data) < 0){
+        head->next = NULL;
+        while(current != NULL && compare(current->data, head->data) < 0){
+            DLLNode* next = current->next;
+            current->next = head;
+            head = current;
+            current = next;
+            length++;
+        }
+    }else{
+        while(current != NULL && compare(current->data, tail->data) >= 0){
+            tail = current;
+            current = current->next;
+            length++;
+        }
+        tail->next = NULL;
+    }
+
+    while(length < minrun && current != NULL){
+        DLLNode* next = current->next;
+        dllnode_run_push_sorted(&head, &tail, current, compare);
+        current = next;
+        length++;
+    }
+
+    *chain = current;
+
+    return (ListSortRun){head, tail, length};
+};
+
+/*
+    dllnode_gallop
+    See `sllnode_gallop`; only the `next` pointers are used.
+    @param DLLNode* node
+    @param void* key
+    @param bool strict
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* last node of the prefix
+*/
+static DLLNode* dllnode_gallop(DLLNode* node, void* key, bool strict, int (*compare)(void*, void*)){
+    DLLNode* last = node;
+    size_t step = 1;
+    size_t gap;
+
+    //  Exponential search: `last` precedes `key`, the node `gap` steps after it does not (or is past the end)
+    for(;;){
+        DLLNode* probe = last;
+        size_t walked = 0;
+
+        while(walked < step && probe->next != NULL){
+            probe = probe->next;
+            walked++;
+        }
+        if(walked == 0){
+            return last;
+        }
+
+        int order = compare(probe->data, key);
+        if(order < 0 || (!strict && order == 0)){
+            last = probe;
+            if(walked < step){
+                return last;
+            }
+            step *= 2;
+        }else{
+            gap = walked;
+            break;
+        }
+    }
+
+    //  Bisection between `last` and the node `gap` steps after it
+    while(gap > 1){
+        DLLNode* probe = last;
+        size_t half = gap / 2;
+
+        for(size_t i = 0; i < half; i++){
+            probe = probe->next;
+        }
+
+        int order = compare(probe->data, key);
+        if(order < 0 || (!strict && order == 0)){
+            last = probe;
+            gap -= half;
+        }else{
+            gap = half;
+        }
+    }
+
+    return last;
+};
+
+/*
+    dllnode_merge_runs
+    See `sllnode_merge_runs`; only the `next` pointers are used.
+    @param ListSortRun a, first run
+    @param ListSortRun b, second run
+    @param int (*compare)(void*, void*)
+    @returns ListSortRun merged run
+*/
+static ListSortRun dllnode_merge_runs(ListSortRun a, ListSortRun b, int (*compare)(void*, void*)){
+    ListSortRun merged = {NULL, NULL, a.length + b.length};
+
+    if(compare(((DLLNode*)a.tail)->data, ((DLLNode*)b.head)->data) <= 0){
+        ((DLLNode*)a.tail)->next = (DLLNode*)b.head;
+        merged.head = a.head;
+        merged.tail = b.tail;
+        return merged;
+    }
+
+    DLLNode head;
+    DLLNode* tail = &head;
+    DLLNode* x = (DLLNode*)a.head;
+    DLLNode* y = (DLLNode*)b.head;
+    size_t x_wins = 0, y_wins = 0;
+
+    while(x != NULL && y != NULL){
+        if(compare(x->data, y->data) <= 0){
+            if(++x_wins >= LISTSORT_MIN_GALLOP){
+                DLLNode* last = dllnode_gallop(x, y->data, false, compare);
+                tail->next = x;
+                tail = last;
+                x = last->next;
+                x_wins = 0;
+            }else{
+                tail->next = x;
+                tail = x;
+                x = x->next;
+            }
+            y_wins = 0;
+        }else{
+            if(++y_wins >= LISTSORT_MIN_GALLOP){
+                DLLNode* last = dllnode_gallop(y, x->data, true, compare);
+                tail->next = y;
+                tail = last;
+                y = last->next;
+                y_wins = 0;
+            }else{
+                tail->next = y;
+                tail = y;
+                y = y->next;
+            }
+            x_wins = 0;
+        }
+    }
+
+    if(x != NULL){
+        tail->next = x;
+        merged.tail = a.tail;
+    }else{
+        tail->next = y;
+        merged.tail = b.tail;
+    }
+    merged.head = head.next;
+
+    return merged;
+};
+
+/*
+    dllnode_natural_mergesort
+    See `sllnode_natural_mergesort`; only the `next` pointers are used.
+    @param DLLNode* chain
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* head of the sorted chain
+*/
+static DLLNode* dllnode_natural_mergesort(DLLNode* chain, size_t n, int (*compare)(void*, void*)){
+    ListSortRun runs[LISTSORT_MAX_RUNS];
+    size_t nruns = 0;
+    size_t minrun = listsort_minrun(n);
+
+    while(chain != NULL){
+        runs[nruns++] = dllnode_next_run(&chain, minrun, compare);
+
+        //  Keep the run lengths decreasing faster than the Fibonacci numbers, so merges stay balanced and the stack shallow
+        while(nruns > 1){
+            size_t i = nruns - 2;
+
+            if((i > 0 && runs[i - 1].length <= runs[i].length + runs[i + 1].length) ||
+               (i > 1 && runs[i - 2].length <= runs[i - 1].length + runs[i].length)){
+                if(runs[i - 1].length < runs[i + 1].length){
+                    i--;
+                }
+            }else if(runs[i].length > runs[i + 1].length){
+                break;
+            }
+
+            runs[i] = dllnode_merge_runs(runs[i], runs[i + 1], compare);
+            if(i + 2 < nruns){
+                runs[i + 1] = runs[i + 2];
+            }
+            nruns--;
+        }
+    }
+
+    while(nruns > 1){
+        size_t i = nruns - 2;
+
+        if(i > 0 && runs[i - 1].length < runs[i + 1].length){
+            i--;
+        }
+
+        runs[i] = dllnode_merge_runs(runs[i], runs[i + 1], compare);
+        if(i + 2 < nruns){
+            runs[i + 1] = runs[i + 2];
+        }
+        nruns--;
+    }
+
+    return nruns ? (DLLNode*)runs[0].head : NULL;
+};
+
+/*
+    sll_natural_mergesort
+    Function to sort a `SinglyLinkedList` (sll) using an adaptive natural merge sort (Timsort-style).
+    Ascending and strictly descending runs are detected, descending runs are reversed in place, short runs are extended by insertion, and the runs are merged with a galloping merge.
+    Already sorted input takes O(N). The sort is stable and relinks the nodes without allocating.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @returns SinglyLinkedList* list
+*/
+SinglyLinkedList* sll_natural_mergesort(SinglyLinkedList* list, int (*compare)(void*, void*)){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    list->head = sllnode_natural_mergesort(list->head, list->size, compare);
+
+    return list;
+};
+
+/*
+    dll_natural_mergesort
+    Function to sort a `DoublyLinkedList` (dll) using an adaptive natural merge sort (Timsort-style).
+    Ascending and strictly descending runs are detected, descending runs are reversed in place, short runs are extended by insertion, and the runs are merged with a galloping merge.
+    Already sorted input takes O(N). The sort is stable and relinks the nodes without allocating.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @returns DoublyLinkedList* list
+*/
+DoublyLinkedList* dll_natural_mergesort(DoublyLinkedList* list, int (*compare)(void*, void*)){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    list->head = dllnode_natural_mergesort(list->head, list->size, compare);
+    dll_relink_prev(list);
+
+    return list;
+};
+
+
+
+/*
+    k-way merge
+    Sorted lists are merged by splicing their nodes into one chain; no node is allocated.
+*/
+
+//  Maximum number of lists merged at once by a loser tree, whose arrays are kept on the stack
+#define LISTSORT_MERGE_WAYS 256
+
+//  Number of lists under which a parallel k-way merge runs sequentially
+#define PARALLEL_MERGE_K_CUTOFF 8
+
+/*
+    sllnode_beats
+    Compare the heads of two input lists of a k-way merge. An exhausted list loses to any other, and ties go to the list with the lower index, so the merge is stable.
+    @param SLLNode** heads
+    @param size_t a
+    @param size_t b
+    @param int (*compare)(void*, void*)
+    @returns bool true if the head of list `a` comes before the head of list `b`
+*/
+static bool sllnode_beats(SLLNode** heads, size_t a, size_t b, int (*compare)(void*, void*)){
+    if(heads[a] == NULL){
+        return false;
+    }
+    if(heads[b] == NULL){
+        return true;
+    }
+
+    int order = compare(heads[a]->data, heads[b]->data);
+
+    return order < 0 || (order == 0 && a < b);
+};
+
+/*
+    sllnode_loser_tree_build
+    Play the tournament of the subtree rooted at `node` of a loser tree over `k` lists. The loser of each match is stored at its node.
+    The internal nodes are numbered 1 to k - 1, and the leaves k to 2k - 1 (leaf k + i is list i).
+    @param size_t* tree
+    @param SLLNode** heads
+    @param size_t k
+    @param size_t node
+    @param int (*compare)(void*, void*)
+    @returns size_t index of the winning list
+*/
+static size_t sllnode_loser_tree_build(size_t* tree, SLLNode** heads, size_t k, size_t node, int (*compare)(void*, void*)){
+    if(node >= k){
+        return node - k;
+    }
+
+    size_t left = sllnode_loser_tree_build(tree, heads, k, 2 * node, compare);
+    size_t right = sllnode_loser_tree_build(tree, heads, k, 2 * node + 1, compare);
+
+    if(sllnode_beats(heads, right, left, compare)){
+        tree[node] = left;
+        return right;
+    }
+
+    tree[node] = right;
+    return left;
+};
+
+/*
+    sllnode_merge_k
+    Merge the chains of `k` sorted `SinglyLinkedList`s into one sorted chain, with a loser tree: each node costs about log2(k) comparisons.
+    Up to `LISTSORT_MERGE_WAYS` lists are merged at once with the tree on the stack; more lists are split in halves, merged separately, then merged together.
+    @param SinglyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns SLLNode* head of the merged chain
+*/
+static SLLNode* sllnode_merge_k(SinglyLinkedList** lists, size_t k, int (*compare)(void*, void*)){
+    if(k == 0){
+        return NULL;
+    }
+    if(k == 1){
+        return lists[0]->head;
+    }
+    if(k > LISTSORT_MERGE_WAYS){
+        SLLNode* left = sllnode_merge_k(lists, k / 2, compare);
+        SLLNode* right = sllnode_merge_k(lists + k / 2, k - k / 2, compare);
+
+        return sllnode_merge(left, right, compare);
+    }
+
+    SLLNode* heads[LISTSORT_MERGE_WAYS];
+    size_t tree[LISTSORT_MERGE_WAYS];
+
+    for(size_t i = 0; i < k; i++){
+        heads[i] = lists[i]->head;
+    }
+
+    size_t winner = sllnode_loser_tree_build(tree, heads, k, 1, compare);
+
+    SLLNode head;
+    SLLNode* tail = &head;
+
+    while(heads[winner] != NULL){
+        tail->next = heads[winner];
+        tail = heads[winner];
+        heads[winner] = heads[winner]->next;
+
+        //  Replay the matches on the path from the leaf of the winner to the root
+        for(size_t node = (winner + k) / 2; node > 0; node /= 2){
+            if(sllnode_beats(heads, tree[node], winner, compare)){
+                size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+    }
+
+    tail->next = NULL;
+
+    return head.next;
+};
+
+/*
+    dllnode_beats
+    See `sllnode_beats`.
+    @param DLLNode** heads
+    @param size_t a
+    @param size_t b
+    @param int (*compare)(void*, void*)
+    @returns bool true if the head of list `a` comes before the head of list `b`
+*/
+static bool dllnode_beats(DLLNode** heads, size_t a, size_t b, int (*compare)(void*, void*)){
+    if(heads[a] == NULL){
+        return false;
+    }
+    if(heads[b] == NULL){
+        return true;
+    }
+
+    int order = compare(heads[a]->data, heads[b]->data);
+
+    return order < 0 || (order == 0 && a < b);
+};
+
+/*
+    dllnode_loser_tree_build
+    See `sllnode_loser_tree_build`.
+    @param size_t* tree
+    @param DLLNode** heads
+    @param size_t k
+    @param size_t node
+    @param int (*compare)(void*, void*)
+    @returns size_t index of the winning list
+*/
+static size_t dllnode_loser_tree_build(size_t* tree, DLLNode** heads, size_t k, size_t node, int (*compare)(void*, void*)){
+    if(node >= k){
+        return node - k;
+    }
+
+    size_t left = dllnode_loser_tree_build(tree, heads, k, 2 * node, compare);
+    size_t right = dllnode_loser_tree_build(tree, heads, k, 2 * node + 1, compare);
+
+    if(dllnode_beats(heads, right, left, compare)){
+        tree[node] = left;
+        return right;
+    }
+
+    tree[node] = right;
+    return left;
+};
+
+/*
+    dllnode_merge_k
+    See `sllnode_merge_k`.
+    @param DoublyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns DLLNode* head of the merged chain
+*/
+static DLLNode* dllnode_merge_k(DoublyLinkedList** lists, size_t k, int (*compare)(void*, void*)){
+    if(k == 0){
+        return NULL;
+    }
+    if(k == 1){
+        return lists[0]->head;
+    }
+    if(k > LISTSORT_MERGE_WAYS){
+        DLLNode* left = dllnode_merge_k(lists, k / 2, compare);
+        DLLNode* right = dllnode_merge_k(lists + k / 2, k - k / 2, compare);
+
+        return dllnode_merge(left, right, compare);
+    }
+
+    DLLNode* heads[LISTSORT_MERGE_WAYS];
+    size_t tree[LISTSORT_MERGE_WAYS];
+
+    for(size_t i = 0; i < k; i++){
+        heads[i] = lists[i]->head;
+    }
+
+    size_t winner = dllnode_loser_tree_build(tree, heads, k, 1, compare);
+
+    DLLNode head;
+    DLLNode* tail = &head;
+
+    while(heads[winner] != NULL){
+        tail->next = heads[winner];
+        tail = heads[winner];
+        heads[winner] = heads[winner]->next;
+
+        //  Replay the matches on the path from the leaf of the winner to the root
+        for(size_t node = (winner + k) / 2; node > 0; node /= 2){
+            if(dllnode_beats(heads, tree[node], winner, compare)){
+                size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+    }
+
+    tail->next = NULL;
+
+    return head.next;
+};
+
+/*
+    sll_merge_k
+    Function to merge `k` sorted `SinglyLinkedList` (sll) into one sorted list, in O(N log k), with a loser tree.
+    The nodes are moved, not copied: the input lists are left empty. The merge is stable: equal elements keep the order of their lists.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns SinglyLinkedList* new list holding every node, NULL if the allocation of the list failed (the input lists are left unchanged)
+*/
+SinglyLinkedList* sll_merge_k(SinglyLinkedList** lists, size_t k, int (*compare)(void*, void*)){
+    SinglyLinkedList* result = sll_create();
+
+    if(result == NULL){
+        return NULL;
+    }
+
+    for(size_t i = 0; i < k; i++){
+        result->size += lists[i]->size;
+    }
+    result->head = sllnode_merge_k(lists, k, compare);
+
+    for(size_t i = 0; i < k; i++){
+        lists[i]->head = NULL;
+        lists[i]->size = 0;
+        if(lists[i]->index != NULL){
+            sll_index_rebuild(lists[i]);
+        }
+    }
+
+    return result;
+};
+
+/*
+    dll_merge_k
+    Function to merge `k` sorted `DoublyLinkedList` (dll) into one sorted list, in O(N log k), with a loser tree.
+    The nodes are moved, not copied: the input lists are left empty. The merge is stable: equal elements keep the order of their lists.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @returns DoublyLinkedList* new list holding every node, NULL if the allocation of the list failed (the input lists are left unchanged)
+*/
+DoublyLinkedList* dll_merge_k(DoublyLinkedList** lists, size_t k, int (*compare)(void*, void*)){
+    DoublyLinkedList* result = dll_create();
+
+    if(result == NULL){
+        return NULL;
+    }
+
+    for(size_t i = 0; i < k; i++){
+        result->size += lists[i]->size;
+    }
+    result->head = dllnode_merge_k(lists, k, compare);
+    dll_relink_prev(result);
+
+    for(size_t i = 0; i < k; i++){
+        lists[i]->head = NULL;
+        lists[i]->tail = NULL;
+        lists[i]->size = 0;
+        if(lists[i]->index != NULL){
+            dll_index_rebuild(lists[i]);
+        }
+    }
+
+    return result;
+};
+
+/*
+    Arguments of a parallel k-way merge task
+*/
+typedef struct SLLMergeTask {
+    SinglyLinkedList** lists;
+    size_t k;
+    SLLNode* chain;
+    int (*compare)(void*, void*);
+    ThreadPool* pool;
+} SLLMergeTask;
+
+typedef struct DLLMergeTask {
+    DoublyLinkedList** lists;
+    size_t k;
+    DLLNode* chain;
+    int (*compare)(void*, void*);
+    ThreadPool* pool;
+} DLLMergeTask;
+
+/*
+    sll_parallel_merge_k_task
+    Merge the lists of a `SLLMergeTask`, forking the first half of the lists to the pool. The merged chain is stored in the task.
+    @param void* arg
+    @returns void
+*/
+static void sll_parallel_merge_k_task(void* arg){
+    SLLMergeTask* task = (SLLMergeTask*)arg;
+
+    if(task->k <= PARALLEL_MERGE_K_CUTOFF){
+        task->chain = sllnode_merge_k(task->lists, task->k, task->compare);
+        return;
+    }
+
+    SLLMergeTask left = {task->lists, task->k / 2, NULL, task->compare, task->pool};
+    SLLMergeTask right = {task->lists + task->k / 2, task->k - task->k / 2, NULL, task->compare, task->pool};
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    if(!threadpool_submit(task->pool, &group, sll_parallel_merge_k_task, &left)){
+        sll_parallel_merge_k_task(&left);
+    }
+    sll_parallel_merge_k_task(&right);
+    threadpool_wait(task->pool, &group);
+
+    task->chain = sllnode_merge(left.chain, right.chain, task->compare);
+};
+
+/*
+    dll_parallel_merge_k_task
+    Merge the lists of a `DLLMergeTask`, forking the first half of the lists to the pool. The merged chain is stored in the task.
+    @param void* arg
+    @returns void
+*/
+static void dll_parallel_merge_k_task(void* arg){
+    DLLMergeTask* task = (DLLMergeTask*)arg;
+
+    if(task->k <= PARALLEL_MERGE_K_CUTOFF){
+        task->chain = dllnode_merge_k(task->lists, task->k, task->compare);
+        return;
+    }
+
+    DLLMergeTask left = {task->lists, task->k / 2, NULL, task->compare, task->pool};
+    DLLMergeTask right = {task->lists + task->k / 2, task->k - task->k / 2, NULL, task->compare, task->pool};
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    if(!threadpool_submit(task->pool, &group, dll_parallel_merge_k_task, &left)){
+        dll_parallel_merge_k_task(&left);
+    }
+    dll_parallel_merge_k_task(&right);
+    threadpool_wait(task->pool, &group);
+
+    task->chain = dllnode_merge(left.chain, right.chain, task->compare);
+};
+
+/*
+    sll_parallel_merge_k
+    Function to merge `k` sorted `SinglyLinkedList` (sll) into one sorted list on a `ThreadPool`.
+    The lists are split in groups of at most `PARALLEL_MERGE_K_CUTOFF`, merged in parallel with loser trees, and the results are merged pairwise.
+    The nodes are moved, not copied: the input lists are left empty. The merge is stable.
+
+    @param SinglyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @param ThreadPool* pool
+    @returns SinglyLinkedList* new list holding every node, NULL if the allocation of the list failed (the input lists are left unchanged)
+*/
+SinglyLinkedList* sll_parallel_merge_k(SinglyLinkedList** lists, size_t k, int (*compare)(void*, void*), ThreadPool* pool){
+    SinglyLinkedList* result = sll_create();
+
+    if(result == NULL){
+        return NULL;
+    }
+
+    for(size_t i = 0; i < k; i++){
+        result->size += lists[i]->size;
+    }
+
+    SLLMergeTask task = {lists, k, NULL, compare, pool};
+    sll_parallel_merge_k_task(&task);
+    result->head = task.chain;
+
+    for(size_t i = 0; i < k; i++){
+        lists[i]->head = NULL;
+        lists[i]->size = 0;
+        if(lists[i]->index != NULL){
+            sll_index_rebuild(lists[i]);
+        }
+    }
+
+    return result;
+};
+
+/*
+    dll_parallel_merge_k
+    Function to merge `k` sorted `DoublyLinkedList` (dll) into one sorted list on a `ThreadPool`.
+    The lists are split in groups of at most `PARALLEL_MERGE_K_CUTOFF`, merged in parallel with loser trees, and the results are merged pairwise.
+    The nodes are moved, not copied: the input lists are left empty. The merge is stable.
+
+    @param DoublyLinkedList** lists
+    @param size_t k
+    @param int (*compare)(void*, void*)
+    @param ThreadPool* pool
+    @returns DoublyLinkedList* new list holding every node, NULL if the allocation of the list failed (the input lists are left unchanged)
+*/
+DoublyLinkedList* dll_parallel_merge_k(DoublyLinkedList** lists, size_t k, int (*compare)(void*, void*), ThreadPool* pool){
+    DoublyLinkedList* result = dll_create();
+
+    if(result == NULL){
+        return NULL;
+    }
+
+    for(size_t i = 0; i < k; i++){
+        result->size += lists[i]->size;
+    }
+
+    DLLMergeTask task = {lists, k, NULL, compare, pool};
+    dll_parallel_merge_k_task(&task);
+    result->head = task.chain;
+    dll_relink_prev(result);
+
+    for(size_t i = 0; i < k; i++){
+        lists[i]->head = NULL;
+        lists[i]->tail = NULL;
+        lists[i]->size = 0;
+        if(lists[i]->index != NULL){
+            dll_index_rebuild(lists[i]);
+        }
+    }
+
+    return result;
+};
+
+
+
+/*
+    Sorting through an array
+    The (data, node) pairs of a list are gathered in a contiguous buffer, sorted there, and the nodes are relinked in one pass.
+    The comparisons read the data pointers from the buffer instead of following the nodes.
+*/
+
+//  Number of items under which the introsort switches to an insertion sort
+#define LISTSORT_INSERTION_CUTOFF 16
+
+/*
+    Element of the buffer of an array sort: the data of a node, and the node
+*/
+typedef struct ListSortItem {
+    void* data;
+    void* node;
+} ListSortItem;
+
+/*
+    listsort_scratch_create
+    Function to create a new, empty, `ListSortScratch`.
+
+    @returns ListSortScratch* new scratch buffer, NULL if the allocation failed
+*/
+ListSortScratch* listsort_scratch_create(){
+    ListSortScratch* scratch = (ListSortScratch*)malloc(sizeof(ListSortScratch));
+
+    if(scratch == NULL){
+        return NULL;
+    }
+
+    scratch->buffer = NULL;
+    scratch->capacity = 0;
+
+    return scratch;
+};
+
+/*
+    listsort_scratch_destroy
+    Function to destroy a `ListSortScratch` and its buffer.
+
+    @param ListSortScratch* scratch
+    @returns void
+*/
+void listsort_scratch_destroy(ListSortScratch* scratch){
+    if(scratch == NULL){
+        return;
+    }
+
+    free(scratch->buffer);
+    free(scratch);
+};
+
+/*
+    listsort_scratch_reserve
+    Function to get a buffer of at least `size` bytes from a `ListSortScratch`, growing it geometrically if needed.
+    The content of the buffer is not kept when it grows.
+
+    @param ListSortScratch* scratch
+    @param size_t size
+    @returns void* buffer, NULL if the allocation failed
+*/
+void* listsort_scratch_reserve(ListSortScratch* scratch, size_t size){
+    if(size <= scratch->capacity){
+        return scratch->buffer;
+    }
+
+    size_t capacity = scratch->capacity ? scratch->capacity : 4096;
+    while(capacity < size){
+        capacity *= 2;
+    }
+
+    //  The content does not need to be kept: avoid the copy of `realloc`
+    void* buffer = malloc(capacity);
+
+    if(buffer == NULL){
+        return NULL;
+    }
+
+    free(scratch->buffer);
+    scratch->buffer = buffer;
+    scratch->capacity = capacity;
+
+    return buffer;
+};
+
+/*
+    item_swap
+    Swap two items of an array of `ListSortItem`.
+    @param ListSortItem* items
+    @param size_t a
+    @param size_t b
+    @returns void
+*/
+static inline void item_swap(ListSortItem* items, size_t a, size_t b){
+    ListSortItem item = items[a];
+    items[a] = items[b];
+    items[b] = item;
+};
+
+/*
+    item_insertionsort
+    Sort a short array of `ListSortItem` with an insertion sort.
+    @param ListSortItem* items
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void item_insertionsort(ListSortItem* items, size_t n, int (*compare)(void*, void*)){
+    for(size_t i = 1; i < n; i++){
+        ListSortItem item = items[i];
+        size_t j = i;
+
+        while(j > 0 && compare(items[j - 1].data, item.data) > 0){
+            items[j] = items[j - 1];
+            j--;
+        }
+
+        items[j] = item;
+    }
+};
+
+/*
+    item_sift_down
+    Move the item at position `i` of a binary max-heap of `ListSortItem` down to its place.
+    @param ListSortItem* items
+    @param size_t n
+    @param size_t i
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void item_sift_down(ListSortItem* items, size_t n, size_t i, int (*compare)(void*, void*)){
+    ListSortItem item = items[i];
+
+    for(;;){
+        size_t child = 2 * i + 1;
+
+        if(child >= n){
+            break;
+        }
+        if(child + 1 < n && compare(items[child + 1].data, items[child].data) > 0){
+            child++;
+        }
+        if(compare(items[child].data, item.data) <= 0){
+            break;
+        }
+
+        items[i] = items[child];
+        i = child;
+    }
+
+    items[i] = item;
+};
+
+/*
+    item_heapsort
+    Sort an array of `ListSortItem` with a heap sort, the fallback of the introsort.
+    @param ListSortItem* items
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void item_heapsort(ListSortItem* items, size_t n, int (*compare)(void*, void*)){
+    for(size_t i = n / 2; i-- > 0;){
+        item_sift_down(items, n, i, compare);
+    }
+
+    while(n > 1){
+        n--;
+
+        ListSortItem max = items[0];
+        items[0] = items[n];
+        items[n] = max;
+        item_sift_down(items, n, 0, compare);
+    }
+};
+
+/*
+    item_introsort
+    Sort an array of `ListSortItem` with an introsort: a quicksort with a median-of-three pivot, which falls back to a heap sort
+    past `depth` levels of partitioning (O(N log N) worst case) and finishes short ranges with an insertion sort.
+    The smaller side of each partition is sorted recursively, the larger one in the loop, so the recursion depth stays under log2(N).
+    @param ListSortItem* items
+    @param size_t n
+    @param size_t depth
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void item_introsort(ListSortItem* items, size_t n, size_t depth, int (*compare)(void*, void*)){
+    while(n > LISTSORT_INSERTION_CUTOFF){
+        if(depth == 0){
+            item_heapsort(items, n, compare);
+            return;
+        }
+        depth--;
+
+        //  Order the first, middle and last items: the median is the pivot, the others bound the scans
+        size_t mid = (n - 1) / 2;
+
+        if(compare(items[mid].data, items[0].data) < 0){
+            item_swap(items, mid, 0);
+        }
+        if(compare(items[n - 1].data, items[mid].data) < 0){
+            item_swap(items, n - 1, mid);
+            if(compare(items[mid].data, items[0].data) < 0){
+                item_swap(items, mid, 0);
+            }
+        }
+
+        //  Hoare partition: [0, j] holds no item greater than the pivot, [j + 1, n) no item smaller
+        void* pivot = items[mid].data;
+        size_t i = 0;
+        size_t j = n - 1;
+
+        for(;;){
+            while(compare(items[i].data, pivot) < 0){
+                i++;
+            }
+            while(compare(items[j].data, pivot) > 0){
+                j--;
+            }
+            if(i >= j){
+                break;
+            }
+
+            item_swap(items, i, j);
+            i++;
+            j--;
+        }
+
+        size_t left = j + 1;
+
+        if(left < n - left){
+            item_introsort(items, left, depth, compare);
+            items += left;
+            n -= left;
+        }else{
+            item_introsort(items + left, n - left, depth, compare);
+            n = left;
+        }
+    }
+
+    item_insertionsort(items, n, compare);
+};
+
+/*
+    item_sort
+    Sort an array of `ListSortItem` with `item_introsort`, allowing 2 * log2(N) levels of partitioning.
+    @param ListSortItem* items
+    @param size_t n
+    @param int (*compare)(void*, void*)
+    @returns void
+*/
+static void item_sort(ListSortItem* items, size_t n, int (*compare)(void*, void*)){
+    size_t depth = 0;
+
+    for(size_t m = n; m > 1; m >>= 1){
+        depth += 2;
+    }
+
+    item_introsort(items, n, depth, compare);
+};
+
+/*
+    sll_arraysort
+    Function to sort a `SinglyLinkedList` (sll) through a contiguous array: the (data, node) pairs are gathered in a buffer,
+    sorted there with an introsort, and the nodes are relinked in one pass. The sort is not stable.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param SinglyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @param ListSortScratch* scratch, buffer reused across sorts; NULL to allocate a temporary one
+    @returns SinglyLinkedList* list, left unchanged if the allocation of the buffer failed
+*/
+SinglyLinkedList* sll_arraysort(SinglyLinkedList* list, int (*compare)(void*, void*), ListSortScratch* scratch){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    size_t n = list->size;
+    ListSortItem* items = scratch ? (ListSortItem*)listsort_scratch_reserve(scratch, n * sizeof(ListSortItem)) : (ListSortItem*)malloc(n * sizeof(ListSortItem));
+
+    if(items == NULL){
+        return list;
+    }
+
+    size_t i = 0;
+    for(SLLNode* current = list->head; current != NULL; current = current->next){
+        items[i].data = current->data;
+        items[i].node = current;
+        i++;
+    }
+
+    item_sort(items, n, compare);
+
+    list->head = (SLLNode*)items[0].node;
+    for(i = 0; i + 1 < n; i++){
+        ((SLLNode*)items[i].node)->next = (SLLNode*)items[i + 1].node;
+    }
+    ((SLLNode*)items[n - 1].node)->next = NULL;
+
+    if(scratch == NULL){
+        free(items);
+    }
+
+    return list;
+};
+
+/*
+    dll_arraysort
+    Function to sort a `DoublyLinkedList` (dll) through a contiguous array: the (data, node) pairs are gathered in a buffer,
+    sorted there with an introsort, and the `next` and `prev` pointers are relinked in one pass. The sort is not stable.
+    The compare function is used to compare two elements in the list. It must be provided by the user.
+
+    @param DoublyLinkedList* list
+    @param int (*compare)(void*, void*)
+    @param ListSortScratch* scratch, buffer reused across sorts; NULL to allocate a temporary one
+    @returns DoublyLinkedList* list, left unchanged if the allocation of the buffer failed
+*/
+DoublyLinkedList* dll_arraysort(DoublyLinkedList* list, int (*compare)(void*, void*), ListSortScratch* scratch){
+    if(list == NULL || list->head == NULL || list->head->next == NULL){
+        return list;
+    }
+
+    size_t n = list->size;
+    ListSortItem* items = scratch ? (ListSortItem*)listsort_scratch_reserve(scratch, n * sizeof(ListSortItem)) : (ListSortItem*)malloc(n * sizeof(ListSortItem));
+
+    if(items == NULL){
+        return list;
+    }
+
+    size_t i = 0;
+    for(DLLNode* current = list->head; current != NULL; current = current->next){
+        items[i].data = current->data;
+        items[i].node = current;
+        i++;
+    }
+
+    item_sort(items, n, compare);
+
+    DLLNode* prev = NULL;
+    for(i = 0; i < n; i++){
+        DLLNode* node = (DLLNode*)items[i].node;
+
+        node->prev = prev;
+        if(prev != NULL){
+            prev->next = node;
+        }
+        prev = node;
+    }
+    prev->next = NULL;
+
+    list->head = (DLLNode*)items[0].node;
+    list->tail = prev;
+
+    if(scratch == NULL){
+        free(items);
+    }
+
+    return list;
+};
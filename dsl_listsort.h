@@ -9,6 +9,8 @@
     - Selection Sort
     - Insertion Sort
     - Merge Sort
+    - Natural Merge Sort (adaptive, Timsort-style)
+    - Introsort through an array (gather, sort, relink)
 
     For all data structures:
     - Singly Linked List
@@ -22,6 +24,19 @@
 */
 
 #include "dsl_lists.h"
+#include "dsl_unrolled.h"
+#include "dsl_threadpool.h"
+
+/*
+    Scratch buffer of the array sorts
+    - `buffer` is the memory reused by successive sorts
+    - `capacity` is its size in bytes; it only grows, and is freed by `listsort_scratch_destroy`
+    A scratch buffer must not be used by two sorts at the same time.
+*/
+typedef struct ListSortScratch {
+    void* buffer;
+    size_t capacity;
+} ListSortScratch;
 
 /*
     sll_bubblesort
@@ -332,12 +347,386 @@ CircularLinkedList* cll_mergesort(CircularLinkedList* list, int (*compare)(void*
 CircularLinkedList* cll_quicksort(CircularLinkedList* list, int (*compare)(void*, void*));
 
 
+//  Parallel sorting algorithms
+
+/*
+    sll_parallel_mergesort
+    Sorts a singly linked list in place using a merge sort driven by a work-stealing thread pool.
+    The nodes are relinked, so the list is sorted without allocating new nodes. The sort is stable.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the singly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+    - pool: the thread pool running the sort (see `dsl_threadpool.h`)
+
+    Returns:
+    - a pointer to the sorted singly linked list
+*/
+SinglyLinkedList* sll_parallel_mergesort(SinglyLinkedList* list, int (*compare)(void*, void*), ThreadPool* pool);
+
+/*
+    dll_parallel_mergesort
+    Sorts a doubly linked list in place using a merge sort driven by a work-stealing thread pool.
+    The nodes are relinked, so the list is sorted without allocating new nodes. The sort is stable.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the doubly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+    - pool: the thread pool running the sort (see `dsl_threadpool.h`)
+
+    Returns:
+    - a pointer to the sorted doubly linked list
+*/
+DoublyLinkedList* dll_parallel_mergesort(DoublyLinkedList* list, int (*compare)(void*, void*), ThreadPool* pool);
+
+
+//  `UnrolledList` sorting algorithms
+
+/*
+    ull_mergesort
+    Sorts an unrolled linked list using the merge sort algorithm. The sort is stable.
+    The compare function is used to compare two elements in the list.
+    The compare function should return:
+    - 0 if the two elements are equal
+    - -1 if the first element is less than the second element
+    - 1 if the first element is greater than the second element
+    The compare function should have the following signature:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the unrolled linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the sorted unrolled linked list
+    - NULL if the buffers of the sort could not be allocated; the list is then left unchanged, unsorted
+*/
+UnrolledList* ull_mergesort(UnrolledList* list, int (*compare)(void*, void*));
+
+
+//  `Queue` sorting algorithms
+
+/*
+    queue_mergesort
+    Sorts a queue using the merge sort algorithm, from the front to the back. The sort is stable.
+    The nodes are relinked in place, without allocating new nodes.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - queue: the queue to sort
+    - compare: the comparison function to use to compare two elements in the queue
+
+    Returns:
+    - a pointer to the sorted queue
+*/
+Queue* queue_mergesort(Queue* queue, int (*compare)(void*, void*));
+
+
+//  Selection and heap sorting algorithms
+
+/*
+    sll_topk
+    Gets the `k` smallest elements of a singly linked list, in sorted order, using a bounded heap of `k` elements in O(N log K).
+    The list is not modified: the elements are inserted in a new list.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the singly linked list to select from
+    - k: the number of elements to select; the whole list is selected if it has fewer elements
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to a new singly linked list with the `k` smallest elements, NULL if the allocation failed
+*/
+SinglyLinkedList* sll_topk(SinglyLinkedList* list, size_t k, int (*compare)(void*, void*));
+
+/*
+    dll_topk
+    Gets the `k` smallest elements of a doubly linked list, in sorted order, using a bounded heap of `k` elements in O(N log K).
+    The list is not modified: the elements are inserted in a new list.
+
+    Parameters:
+    - list: the doubly linked list to select from
+    - k: the number of elements to select; the whole list is selected if it has fewer elements
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to a new doubly linked list with the `k` smallest elements, NULL if the allocation failed
+*/
+DoublyLinkedList* dll_topk(DoublyLinkedList* list, size_t k, int (*compare)(void*, void*));
+
+/*
+    sll_nth_element
+    Places the `n`-th smallest element of a singly linked list at position `n` (from 0), like `std::nth_element`, using a quickselect over the nodes in expected O(N).
+    The nodes are relinked: no element before position `n` is greater than it, and no element after is smaller.
+
+    Parameters:
+    - list: the singly linked list to rearrange
+    - n: the position of the element to select
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the node at position `n`, NULL if the list has `n` elements or fewer
+*/
+SLLNode* sll_nth_element(SinglyLinkedList* list, size_t n, int (*compare)(void*, void*));
+
+/*
+    dll_nth_element
+    Places the `n`-th smallest element of a doubly linked list at position `n` (from 0), like `std::nth_element`, using a quickselect over the nodes in expected O(N).
+    The nodes are relinked: no element before position `n` is greater than it, and no element after is smaller.
+
+    Parameters:
+    - list: the doubly linked list to rearrange
+    - n: the position of the element to select
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the node at position `n`, NULL if the list has `n` elements or fewer
+*/
+DLLNode* dll_nth_element(DoublyLinkedList* list, size_t n, int (*compare)(void*, void*));
+
+/*
+    sll_partial_sort
+    Sorts the `k` smallest elements of a singly linked list into its first `k` nodes, in O(N + K log K).
+    The other nodes follow in no particular order.
+
+    Parameters:
+    - list: the singly linked list to sort
+    - k: the number of elements to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the partially sorted singly linked list
+*/
+SinglyLinkedList* sll_partial_sort(SinglyLinkedList* list, size_t k, int (*compare)(void*, void*));
+
+/*
+    dll_partial_sort
+    Sorts the `k` smallest elements of a doubly linked list into its first `k` nodes, in O(N + K log K).
+    The other nodes follow in no particular order.
+
+    Parameters:
+    - list: the doubly linked list to sort
+    - k: the number of elements to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the partially sorted doubly linked list
+*/
+DoublyLinkedList* dll_partial_sort(DoublyLinkedList* list, size_t k, int (*compare)(void*, void*));
+
+/*
+    sll_heapsort
+    Sorts a singly linked list using the heap sort algorithm, in O(N log N) without recursion. The sort is not stable.
+    The elements are sorted in an array and written back to the nodes, which are not relinked.
+
+    Parameters:
+    - list: the singly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the sorted singly linked list
+    - NULL if the array of the elements could not be allocated; the list is then left unchanged, unsorted
+*/
+SinglyLinkedList* sll_heapsort(SinglyLinkedList* list, int (*compare)(void*, void*));
+
+/*
+    dll_heapsort
+    Sorts a doubly linked list using the heap sort algorithm, in O(N log N) without recursion. The sort is not stable.
+    The elements are sorted in an array and written back to the nodes, which are not relinked.
+
+    Parameters:
+    - list: the doubly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the sorted doubly linked list
+    - NULL if the array of the elements could not be allocated; the list is then left unchanged, unsorted
+*/
+DoublyLinkedList* dll_heapsort(DoublyLinkedList* list, int (*compare)(void*, void*));
+
+
+//  Adaptive sorting algorithms
+
+/*
+    sll_natural_mergesort
+    Sorts a singly linked list using an adaptive natural merge sort, in the manner of Timsort.
+    The list is cut into the ascending and strictly descending runs it already contains; descending runs are reversed in place,
+    runs shorter than 32 to 64 elements are extended by insertion, and the runs are merged with a galloping merge.
+    Already sorted input takes O(N), input made of K sorted batches O(N log K), and any input O(N log N).
+    The sort is stable and relinks the nodes without allocating.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the singly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the sorted singly linked list
+*/
+SinglyLinkedList* sll_natural_mergesort(SinglyLinkedList* list, int (*compare)(void*, void*));
+
+/*
+    dll_natural_mergesort
+    Sorts a doubly linked list using an adaptive natural merge sort, in the manner of Timsort. See `sll_natural_mergesort`.
+    The sort is stable and relinks the nodes without allocating.
+
+    Parameters:
+    - list: the doubly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+
+    Returns:
+    - a pointer to the sorted doubly linked list
+*/
+DoublyLinkedList* dll_natural_mergesort(DoublyLinkedList* list, int (*compare)(void*, void*));
+
+
+//  Merging sorted lists
+
+/*
+    sll_merge_k
+    Merges `k` sorted singly linked lists into one sorted list in O(N log k), with a loser tree.
+    The nodes are spliced into the new list, without allocating nodes, and the input lists are left empty.
+    The merge is stable: equal elements keep the order of their lists, then their order within a list.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - lists: the array of the sorted singly linked lists to merge
+    - k: the number of lists
+    - compare: the comparison function to use to compare two elements in the lists
+
+    Returns:
+    - a pointer to a new singly linked list holding every element, NULL if the allocation of the list failed (the input lists are then unchanged)
+*/
+SinglyLinkedList* sll_merge_k(SinglyLinkedList** lists, size_t k, int (*compare)(void*, void*));
+
+/*
+    dll_merge_k
+    Merges `k` sorted doubly linked lists into one sorted list in O(N log k), with a loser tree. See `sll_merge_k`.
+
+    Parameters:
+    - lists: the array of the sorted doubly linked lists to merge
+    - k: the number of lists
+    - compare: the comparison function to use to compare two elements in the lists
+
+    Returns:
+    - a pointer to a new doubly linked list holding every element, NULL if the allocation of the list failed (the input lists are then unchanged)
+*/
+DoublyLinkedList* dll_merge_k(DoublyLinkedList** lists, size_t k, int (*compare)(void*, void*));
+
+/*
+    sll_parallel_merge_k
+    Merges `k` sorted singly linked lists into one sorted list on a work-stealing thread pool.
+    Groups of lists are merged in parallel with loser trees, then the merged groups are merged pairwise. See `sll_merge_k`.
+
+    Parameters:
+    - lists: the array of the sorted singly linked lists to merge
+    - k: the number of lists
+    - compare: the comparison function to use to compare two elements in the lists
+    - pool: the thread pool running the merge (see `dsl_threadpool.h`)
+
+    Returns:
+    - a pointer to a new singly linked list holding every element, NULL if the allocation of the list failed (the input lists are then unchanged)
+*/
+SinglyLinkedList* sll_parallel_merge_k(SinglyLinkedList** lists, size_t k, int (*compare)(void*, void*), ThreadPool* pool);
+
+/*
+    dll_parallel_merge_k
+    Merges `k` sorted doubly linked lists into one sorted list on a work-stealing thread pool. See `sll_parallel_merge_k`.
+
+    Parameters:
+    - lists: the array of the sorted doubly linked lists to merge
+    - k: the number of lists
+    - compare: the comparison function to use to compare two elements in the lists
+    - pool: the thread pool running the merge (see `dsl_threadpool.h`)
+
+    Returns:
+    - a pointer to a new doubly linked list holding every element, NULL if the allocation of the list failed (the input lists are then unchanged)
+*/
+DoublyLinkedList* dll_parallel_merge_k(DoublyLinkedList** lists, size_t k, int (*compare)(void*, void*), ThreadPool* pool);
+
+
+//  Sorting through an array
+
+/*
+    listsort_scratch_create
+    Creates an empty scratch buffer for `sll_arraysort` and `dll_arraysort`. It grows to the largest list sorted with it.
+
+    Returns:
+    - a pointer to the new scratch buffer, NULL if the allocation failed
+*/
+ListSortScratch* listsort_scratch_create();
+
+/*
+    listsort_scratch_destroy
+    Destroys a scratch buffer and frees its memory.
+
+    Parameters:
+    - scratch: the scratch buffer to destroy
+*/
+void listsort_scratch_destroy(ListSortScratch* scratch);
+
+/*
+    listsort_scratch_reserve
+    Gets a buffer of at least `size` bytes from a scratch buffer, growing it if needed. The content is not kept when the buffer grows.
+    The buffer stays valid until the next call on the same scratch buffer.
+
+    Parameters:
+    - scratch: the scratch buffer
+    - size: the number of bytes needed
+
+    Returns:
+    - a pointer to the buffer, NULL if the allocation failed
+*/
+void* listsort_scratch_reserve(ListSortScratch* scratch, size_t size);
+
+/*
+    sll_arraysort
+    Sorts a singly linked list through a contiguous array, to avoid chasing pointers during the comparisons.
+    The (data, node) pairs of the list are gathered in a buffer, sorted there with an introsort (median-of-three quicksort,
+    heap sort past 2 log2(N) levels, insertion sort for short ranges), and the nodes are relinked in one pass.
+    The sort takes O(N log N) in the worst case and is not stable.
+    The compare function follows the same convention as the other sorting algorithms:
+    int compare(void* a, void* b);
+
+    Parameters:
+    - list: the singly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+    - scratch: the scratch buffer holding the pairs, reused across sorts; NULL to allocate a temporary buffer
+
+    Returns:
+    - a pointer to the sorted singly linked list, left unchanged if the buffer could not be allocated
+*/
+SinglyLinkedList* sll_arraysort(SinglyLinkedList* list, int (*compare)(void*, void*), ListSortScratch* scratch);
+
+/*
+    dll_arraysort
+    Sorts a doubly linked list through a contiguous array; the `next` and `prev` pointers are relinked in one pass. See `sll_arraysort`.
+
+    Parameters:
+    - list: the doubly linked list to sort
+    - compare: the comparison function to use to compare two elements in the list
+    - scratch: the scratch buffer holding the pairs, reused across sorts; NULL to allocate a temporary buffer
+
+    Returns:
+    - a pointer to the sorted doubly linked list, left unchanged if the buffer could not be allocated
+*/
+DoublyLinkedList* dll_arraysort(DoublyLinkedList* list, int (*compare)(void*, void*), ListSortScratch* scratch);
+
+
 // ?
 
 Queue* queue_bubblesort(Queue* queue, int (*compare)(void*, void*));
 Queue* queue_selectionsort(Queue* queue, int (*compare)(void*, void*));
 Queue* queue_insertionsort(Queue* queue, int (*compare)(void*, void*));
-Queue* queue_mergesort(Queue* queue, int (*compare)(void*, void*));
 Queue* queue_quicksort(Queue* queue, int (*compare)(void*, void*));
 
 Stack* stack_bubblesort(Stack* stack, int (*compare)(void*, void*));
@@ -0,0 +1,366 @@
+/*
+    Implementation of the thread-local node caches.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "dsl_nodecache.h"
+
+//  Slot of a cache without thread-local magazines
+#define NODECACHE_NO_SLOT SIZE_MAX
+
+/*
+    Magazines held by a thread for a cache
+    - `cache` is the cache, NULL until the thread uses it
+    - `loaded` is the magazine objects are taken from and put into, `previous` the magazine loaded before it; both NULL until needed
+*/
+typedef struct NodeCacheThread {
+    NodeCache *cache;
+    NodeMagazine *loaded;
+    NodeMagazine *previous;
+} NodeCacheThread;
+
+//  Number of slots given to caches
+static atomic_size_t nodecache_slots = 0;
+
+//  Magazines of the calling thread, indexed by the slots of the caches
+static _Thread_local NodeCacheThread nodecache_threads[NODECACHE_MAX_CACHES];
+
+//  Set once the calling thread has registered its magazines for the flush at its exit
+static _Thread_local bool nodecache_registered = false;
+
+//  Key whose destructor flushes the magazines of an exiting thread
+static pthread_key_t nodecache_key;
+static pthread_once_t nodecache_key_once = PTHREAD_ONCE_INIT;
+
+/*
+    nodecache_magazine_release
+    Give a magazine of a thread back to the depot of its cache: among the magazines of free objects if it holds any, otherwise among the empty ones.
+    When the depot has no room left, the objects and the magazine are freed.
+    @param  NodeCache*      Pointer to the cache
+    @param  NodeMagazine*   Pointer to the magazine, NULL for none
+    @return void
+*/
+static void nodecache_magazine_release(NodeCache* cache, NodeMagazine* magazine){
+    if(!magazine){
+        return;
+    }
+
+    bool kept = false;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if(magazine->count > 0 && cache->nfull < NODECACHE_DEPOT_SIZE){
+        magazine->next = cache->full;
+        cache->full = magazine;
+        cache->nfull++;
+        kept = true;
+    }   else if(magazine->count == 0 && cache->nempty < NODECACHE_DEPOT_SIZE){
+            magazine->next = cache->empty;
+            cache->empty = magazine;
+            cache->nempty++;
+            kept = true;
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    if(!kept){
+        for(size_t i = 0; i < magazine->count; i++){
+            free(magazine->objects[i]);
+        }
+
+        free(magazine);
+    }
+}
+
+/*
+    nodecache_thread_flush
+    Return the magazines of a thread to the depots of their caches
+    @param  NodeCacheThread*    The magazines of the thread, `NODECACHE_MAX_CACHES` of them
+    @return void
+*/
+static void nodecache_thread_flush(NodeCacheThread* threads){
+    for(size_t i = 0; i < NODECACHE_MAX_CACHES; i++){
+        if(!threads[i].cache){
+            continue;
+        }
+
+        nodecache_magazine_release(threads[i].cache, threads[i].loaded);
+        nodecache_magazine_release(threads[i].cache, threads[i].previous);
+        threads[i].loaded = NULL;
+        threads[i].previous = NULL;
+    }
+}
+
+/*
+    nodecache_thread_exit
+    Destructor of `nodecache_key`, run when a thread that used a cache exits
+    @param  void*   The magazines of the thread
+    @return void
+*/
+static void nodecache_thread_exit(void* threads){
+    nodecache_thread_flush((NodeCacheThread*)threads);
+}
+
+/*
+    nodecache_key_create
+    Create `nodecache_key`, once
+    @param  void
+    @return void
+*/
+static void nodecache_key_create(void){
+    pthread_key_create(&nodecache_key, nodecache_thread_exit);
+}
+
+/*
+    nodecache_thread
+    Get the magazines of the calling thread for a cache, giving the cache a slot on its first use
+    @param  NodeCache*          Pointer to the cache
+    @return NodeCacheThread*    Pointer to the magazines, NULL if the cache has no magazines
+*/
+static inline NodeCacheThread* nodecache_thread(NodeCache* cache){
+    size_t slot = atomic_load_explicit(&cache->slot, memory_order_acquire);
+
+    if(slot == 0){
+        size_t expected = 0;
+
+        slot = atomic_fetch_add_explicit(&nodecache_slots, 1, memory_order_relaxed) + 1;
+
+        if(slot > NODECACHE_MAX_CACHES){
+            slot = NODECACHE_NO_SLOT;
+        }
+
+        //  Another thread may have given the cache a slot in the meantime: its slot wins
+        if(!atomic_compare_exchange_strong_explicit(&cache->slot, &expected, slot, memory_order_acq_rel, memory_order_acquire)){
+            slot = expected;
+        }
+    }
+
+    if(slot == NODECACHE_NO_SLOT){
+        return NULL;
+    }
+
+    NodeCacheThread* thread = &nodecache_threads[slot - 1];
+
+    if(!thread->cache){
+        thread->cache = cache;
+
+        if(!nodecache_registered){
+            pthread_once(&nodecache_key_once, nodecache_key_create);
+            pthread_setspecific(nodecache_key, nodecache_threads);
+            nodecache_registered = true;
+        }
+    }
+
+    return thread;
+}
+
+/*
+    nodecache_init
+    Initialize an empty cache
+    @param  NodeCache*  Pointer to the cache
+    @param  size_t      Size of the objects
+    @return void
+*/
+void nodecache_init(NodeCache* cache, size_t object_size){
+    cache->object_size = object_size;
+    atomic_init(&cache->slot, 0);
+    pthread_mutex_init(&cache->lock, NULL);
+    cache->full = NULL;
+    cache->nfull = 0;
+    cache->empty = NULL;
+    cache->nempty = 0;
+}
+
+/*
+    nodecache_alloc
+    Allocate an object: from the magazines of the calling thread, from the depot, or from `malloc`
+    @param  NodeCache*  Pointer to the cache
+    @return void*       Pointer to the object, NULL if the allocation failed
+*/
+void* nodecache_alloc(NodeCache* cache){
+    NodeCacheThread* thread = nodecache_thread(cache);
+
+    if(!thread){
+        return malloc(cache->object_size);
+    }
+
+    if(thread->loaded && thread->loaded->count > 0){
+        return thread->loaded->objects[--thread->loaded->count];
+    }
+
+    if(thread->previous && thread->previous->count > 0){
+        NodeMagazine* loaded = thread->loaded;
+
+        thread->loaded = thread->previous;
+        thread->previous = loaded;
+
+        return thread->loaded->objects[--thread->loaded->count];
+    }
+
+    //  Both magazines are empty: exchange the previous one for a magazine of free objects from the depot
+    NodeMagazine* full = NULL;
+    NodeMagazine* empty = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if(cache->full){
+        full = cache->full;
+        cache->full = full->next;
+        cache->nfull--;
+
+        if(thread->previous && cache->nempty < NODECACHE_DEPOT_SIZE){
+            thread->previous->next = cache->empty;
+            cache->empty = thread->previous;
+            cache->nempty++;
+        }   else{
+                empty = thread->previous;
+        }
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    if(!full){
+        return malloc(cache->object_size);
+    }
+
+    free(empty);
+    thread->previous = thread->loaded;
+    thread->loaded = full;
+
+    return full->objects[--full->count];
+}
+
+/*
+    nodecache_free
+    Release an object into the magazines of the calling thread, whichever thread allocated it
+    @param  NodeCache*  Pointer to the cache
+    @param  void*       Pointer to the object, allocated by the cache or by `malloc` with at least the size of the cache; NULL is ignored
+    @return void
+*/
+void nodecache_free(NodeCache* cache, void* object){
+    if(!object){
+        return;
+    }
+
+    NodeCacheThread* thread = nodecache_thread(cache);
+
+    if(!thread){
+        free(object);
+        return;
+    }
+
+    if(thread->loaded && thread->loaded->count < NODECACHE_MAGAZINE_SIZE){
+        thread->loaded->objects[thread->loaded->count++] = object;
+        return;
+    }
+
+    if(thread->previous && thread->previous->count == 0){
+        NodeMagazine* loaded = thread->loaded;
+
+        thread->loaded = thread->previous;
+        thread->previous = loaded;
+        thread->loaded->objects[thread->loaded->count++] = object;
+        return;
+    }
+
+    //  Both magazines are full, or the thread has none yet: move the previous one to the depot and load an empty one
+    NodeMagazine* full = thread->previous;
+    NodeMagazine* empty = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if(full && cache->nfull < NODECACHE_DEPOT_SIZE){
+        full->next = cache->full;
+        cache->full = full;
+        cache->nfull++;
+        full = NULL;
+    }
+
+    if(!full && cache->empty){
+        empty = cache->empty;
+        cache->empty = empty->next;
+        cache->nempty--;
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    if(full){
+        //  The depot has no room left: its objects go back to `free` and the magazine is reused
+        for(size_t i = 0; i < full->count; i++){
+            free(full->objects[i]);
+        }
+
+        full->count = 0;
+        empty = full;
+    }   else if(!empty){
+            empty = (NodeMagazine*)malloc(sizeof(NodeMagazine));
+
+            if(!empty){
+                thread->previous = NULL;
+                free(object);
+                return;
+            }
+
+            empty->count = 0;
+    }
+
+    thread->previous = thread->loaded;
+    thread->loaded = empty;
+    empty->objects[empty->count++] = object;
+}
+
+/*
+    nodecache_flush
+    Return the magazines the calling thread holds, of every cache, to their depots. This is done when a thread exits.
+    @param  void
+    @return void
+*/
+void nodecache_flush(void){
+    nodecache_thread_flush(nodecache_threads);
+}
+
+/*
+    nodecache_trim
+    Free the objects and magazines of the depot of a cache. The magazines held by threads are not affected.
+    @param  NodeCache*  Pointer to the cache
+    @return void
+*/
+void nodecache_trim(NodeCache* cache){
+    pthread_mutex_lock(&cache->lock);
+
+    NodeMagazine* full = cache->full;
+    NodeMagazine* empty = cache->empty;
+
+    cache->full = NULL;
+    cache->nfull = 0;
+    cache->empty = NULL;
+    cache->nempty = 0;
+
+    pthread_mutex_unlock(&cache->lock);
+
+    while(full){
+        NodeMagazine* next = full->next;
+
+        for(size_t i = 0; i < full->count; i++){
+            free(full->objects[i]);
+        }
+
+        free(full);
+        full = next;
+    }
+
+    while(empty){
+        NodeMagazine* next = empty->next;
+        free(empty);
+        empty = next;
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef DSL_NODECACHE_H
+#define DSL_NODECACHE_H
+/*
+    Interface for the thread-local node caches.
+
+    A `NodeCache` recycles the freed objects of one size, e.g. the nodes of one list type, so that threads building and tearing down lists concurrently
+    stop contending in `malloc` and `free`. It follows the magazine design of the slab allocators:
+    - every thread holds, per cache, two magazines (a loaded one and the previous one) of up to `NODECACHE_MAGAZINE_SIZE` free objects,
+      and allocates from and frees into them without any lock;
+    - when both are empty, or both are full, the thread exchanges a magazine with the cache's depot, under the depot's lock, once every `NODECACHE_MAGAZINE_SIZE` operations;
+    - the depot keeps up to `NODECACHE_DEPOT_SIZE` magazines of free objects and hands them to any thread, so the objects freed by one thread, such as the nodes
+      of a list built by another thread, are reused by the others. Beyond that, objects go back to `free`.
+    The magazines of a thread go back to the depot when the thread exits, or on `nodecache_flush`.
+
+    The objects are allocated with `malloc` one by one: an object of a cache may be released with `free`, and an object allocated with `malloc`, of at least the
+    size of the cache, may be released with `nodecache_free`. The nodes of `dsl_lists.h` are allocated from one cache per node type.
+
+    Caches are never destroyed, since any thread may still hold magazines of theirs; `nodecache_trim` returns the objects of a depot to `free`.
+    Up to `NODECACHE_MAX_CACHES` caches have magazines; further caches fall back to `malloc` and `free`.
+
+    The current `NodeCache` methods are:
+    - `nodecache_init`: Initialize a cache, as `NODECACHE_INITIALIZER` does for a static one
+    - `nodecache_alloc`: Allocate an object from a cache
+    - `nodecache_free`: Release an object into a cache
+    - `nodecache_flush`: Return the magazines of the calling thread to their depots
+    - `nodecache_trim`: Free the objects of the depot of a cache
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+//  Number of objects of a magazine
+#define NODECACHE_MAGAZINE_SIZE 64
+
+//  Number of magazines of free objects kept by the depot of a cache
+#define NODECACHE_DEPOT_SIZE 128
+
+//  Number of caches with thread-local magazines
+#define NODECACHE_MAX_CACHES 16
+
+/*
+    Magazine of free objects
+    - `next` links the magazines of a depot
+    - `count` is the number of objects, the first `count` entries of `objects`
+*/
+typedef struct NodeMagazine {
+    struct NodeMagazine *next;
+    size_t count;
+    void *objects[NODECACHE_MAGAZINE_SIZE];
+} NodeMagazine;
+
+/*
+    Node cache
+    - `object_size` is the size of the objects
+    - `slot` is 1 + the index of the thread-local magazines of the cache, 0 until its first use, `SIZE_MAX` if the cache has no magazines
+    - `lock` protects the depot: `full` and `nfull` are the magazines of free objects, `empty` and `nempty` the empty magazines
+*/
+typedef struct NodeCache {
+    size_t object_size;
+    atomic_size_t slot;
+    pthread_mutex_t lock;
+    NodeMagazine *full;
+    size_t nfull;
+    NodeMagazine *empty;
+    size_t nempty;
+} NodeCache;
+
+//  Static initializer of a cache of objects of a given size
+#define NODECACHE_INITIALIZER(size) {(size), 0, PTHREAD_MUTEX_INITIALIZER, NULL, 0, NULL, 0}
+
+//  NodeCache methods
+
+/*
+    nodecache_init
+    Initialize an empty cache
+    @param  NodeCache*  Pointer to the cache
+    @param  size_t      Size of the objects
+    @return void
+*/
+void nodecache_init(NodeCache* cache, size_t object_size);
+
+/*
+    nodecache_alloc
+    Allocate an object: from the magazines of the calling thread, from the depot, or from `malloc`
+    @param  NodeCache*  Pointer to the cache
+    @return void*       Pointer to the object, NULL if the allocation failed
+*/
+void* nodecache_alloc(NodeCache* cache);
+
+/*
+    nodecache_free
+    Release an object into the magazines of the calling thread, whichever thread allocated it
+    @param  NodeCache*  Pointer to the cache
+    @param  void*       Pointer to the object, allocated by the cache or by `malloc` with at least the size of the cache; NULL is ignored
+    @return void
+*/
+void nodecache_free(NodeCache* cache, void* object);
+
+/*
+    nodecache_flush
+    Return the magazines the calling thread holds, of every cache, to their depots. This is done when a thread exits.
+    @param  void
+    @return void
+*/
+void nodecache_flush(void);
+
+/*
+    nodecache_trim
+    Free the objects and magazines of the depot of a cache. The magazines held by threads are not affected.
+    @param  NodeCache*  Pointer to the cache
+    @return void
+*/
+void nodecache_trim(NodeCache* cache);
+
+#endif // DSL_NODECACHE_H
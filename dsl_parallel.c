@@ -0,0 +1,355 @@
+/*
+    Implementation of the parallel operations over singly linked lists.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "dsl_parallel.h"
+
+//  Size of a cache line: the accumulators of the chunks are padded to it, so that threads do not write to the same line
+#define PARALLEL_CACHE_LINE 64
+
+/*
+    Operation run on every chunk
+*/
+typedef enum ParallelOperation {
+    PARALLEL_FOREACH,
+    PARALLEL_MAP,
+    PARALLEL_REDUCE,
+    PARALLEL_FILTER
+} ParallelOperation;
+
+/*
+    Operation and functions shared by the chunks of a parallel pass
+*/
+typedef struct ParallelJob {
+    ParallelOperation operation;
+    ListVisitFunction visit;
+    ListMapFunction map;
+    ListAccumulateFunction accumulate;
+    ListKeepFunction keep;
+    ListFreeFunction free_data;
+    void *context;
+} ParallelJob;
+
+/*
+    Chunk of a list processed by a task
+    - `job` is the operation
+    - `start` is the first node of the chunk, `n` its number of nodes
+    - `accumulator` is the accumulator of the chunk, for a reduction
+    - `kept_head`, `kept_tail` and `removed` are the chain of the kept nodes and the number of removed nodes, for a filter
+*/
+typedef struct ParallelChunk {
+    const ParallelJob *job;
+    SLLNode *start;
+    size_t n;
+    void *accumulator;
+    SLLNode *kept_head;
+    SLLNode *kept_tail;
+    size_t removed;
+} ParallelChunk;
+
+/*
+    parallel_chunk_run
+    Run the operation of a chunk on its nodes
+    @param  void*   Pointer to the `ParallelChunk`
+    @return void
+*/
+static void parallel_chunk_run(void* arg){
+    ParallelChunk* chunk = (ParallelChunk*)arg;
+    const ParallelJob* job = chunk->job;
+    SLLNode* node = chunk->start;
+
+    switch(job->operation){
+        case PARALLEL_FOREACH:
+            for(size_t i = 0; i < chunk->n; i++, node = node->next){
+                job->visit(node->data, job->context);
+            }
+            break;
+
+        case PARALLEL_MAP:
+            for(size_t i = 0; i < chunk->n; i++, node = node->next){
+                node->data = job->map(node->data, job->context);
+            }
+            break;
+
+        case PARALLEL_REDUCE:
+            for(size_t i = 0; i < chunk->n; i++, node = node->next){
+                job->accumulate(chunk->accumulator, node->data, job->context);
+            }
+            break;
+
+        case PARALLEL_FILTER:
+            for(size_t i = 0; i < chunk->n; i++){
+                //  The last node of the chunk links to the next chunk, which another task may be freeing: `next` is only followed within the chunk
+                SLLNode* next = node->next;
+
+                if(job->keep(node->data, job->context)){
+                    if(chunk->kept_tail){
+                        chunk->kept_tail->next = node;
+                    }   else{
+                            chunk->kept_head = node;
+                    }
+                    chunk->kept_tail = node;
+                }   else{
+                        //  A payload copied into a node block is freed with its block
+                        if(job->free_data && !list_data_in_block(node->data)){
+                            job->free_data(node->data);
+                        }
+                        sllnode_free(node);
+                        chunk->removed++;
+                }
+
+                node = next;
+            }
+            break;
+    }
+}
+
+/*
+    parallel_chunks_create
+    Get the chunks of a list: several per thread of the pool, of at least `PARALLEL_LIST_CUTOFF` nodes each, or a single one
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  const ParallelJob*  Operation of the chunks
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @param  ParallelChunk*      Chunk used when the list is processed as a whole
+    @param  size_t*             Set to the number of chunks
+    @return ParallelChunk*      Array of the chunks: `single` if there is one chunk, an allocated array otherwise
+*/
+static ParallelChunk* parallel_chunks_create(SinglyLinkedList* sll, const ParallelJob* job, ThreadPool* pool, ParallelChunk* single, size_t* nchunks){
+    size_t count = 1;
+
+    if(pool){
+        count = threadpool_size(pool) * PARALLEL_CHUNKS_PER_THREAD;
+
+        if(count > sll->size / PARALLEL_LIST_CUTOFF){
+            count = sll->size / PARALLEL_LIST_CUTOFF;
+        }
+    }
+
+    ParallelChunk* chunks = count > 1 ? (ParallelChunk*)calloc(count, sizeof(ParallelChunk)) : NULL;
+
+    if(!chunks){
+        *single = (ParallelChunk){job, NULL, 0, NULL, NULL, NULL, 0};
+        *nchunks = 1;
+        return single;
+    }
+
+    for(size_t i = 0; i < count; i++){
+        chunks[i].job = job;
+    }
+
+    *nchunks = count;
+
+    return chunks;
+}
+
+/*
+    parallel_execute
+    Carve a list into chunks of nearly equal sizes with one pass over its `next` pointers and run them. Each chunk but the last one is submitted to the pool
+    as soon as the pass has walked past it, so the workers start while the calling thread is still splitting; the calling thread runs the last chunk, then waits for the others.
+    A task may relink or free the nodes of its chunk, which is why the pass never reads a chunk after submitting it.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ParallelChunk*      Array of the chunks, from `parallel_chunks_create`
+    @param  size_t              Number of chunks
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+static void parallel_execute(SinglyLinkedList* sll, ParallelChunk* chunks, size_t nchunks, ThreadPool* pool){
+    if(nchunks == 1){
+        chunks[0].start = sll->head;
+        chunks[0].n = sll->size;
+        parallel_chunk_run(&chunks[0]);
+        return;
+    }
+
+    TaskGroup group;
+    taskgroup_init(&group);
+
+    SLLNode* node = sll->head;
+
+    for(size_t i = 0; i < nchunks; i++){
+        chunks[i].start = node;
+        chunks[i].n = sll->size / nchunks + (i < sll->size % nchunks ? 1 : 0);
+
+        if(i + 1 == nchunks){
+            break;
+        }
+
+        for(size_t j = 0; j < chunks[i].n; j++){
+            node = node->next;
+        }
+
+        if(!threadpool_submit(pool, &group, parallel_chunk_run, &chunks[i])){
+            parallel_chunk_run(&chunks[i]);
+        }
+    }
+
+    parallel_chunk_run(&chunks[nchunks - 1]);
+    threadpool_wait(pool, &group);
+}
+
+/*
+    sll_parallel_foreach
+    Call a function on every element of a singly linked list, in parallel; the order of the calls is unspecified
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListVisitFunction   Function called on every element, from several threads at once
+    @param  void*               Context given to the function
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_foreach(SinglyLinkedList* sll, ListVisitFunction visit, void* context, ThreadPool* pool){
+    ParallelJob job = {PARALLEL_FOREACH, visit, NULL, NULL, NULL, NULL, context};
+    ParallelChunk single;
+    size_t nchunks;
+
+    ParallelChunk* chunks = parallel_chunks_create(sll, &job, pool, &single, &nchunks);
+    parallel_execute(sll, chunks, nchunks, pool);
+
+    if(chunks != &single){
+        free(chunks);
+    }
+}
+
+/*
+    sll_parallel_map
+    Replace the data of every node of a singly linked list by the result of a function of it, in parallel
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListMapFunction     Function called on every element, from several threads at once
+    @param  void*               Context given to the function
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_map(SinglyLinkedList* sll, ListMapFunction map, void* context, ThreadPool* pool){
+    ParallelJob job = {PARALLEL_MAP, NULL, map, NULL, NULL, NULL, context};
+    ParallelChunk single;
+    size_t nchunks;
+
+    ParallelChunk* chunks = parallel_chunks_create(sll, &job, pool, &single, &nchunks);
+    parallel_execute(sll, chunks, nchunks, pool);
+
+    if(chunks != &single){
+        free(chunks);
+    }
+
+    //  The index maps the data to the nodes, and the data changed
+    if(sll->index){
+        sll_index_rebuild(sll);
+    }
+}
+
+/*
+    sll_parallel_reduce
+    Reduce the elements of a singly linked list, in parallel: every chunk starts from a copy of `identity` and accumulates its elements in order,
+    then the accumulators of the chunks are combined in list order into `result`
+    @param  SinglyLinkedList*       Pointer to the list
+    @param  void*                   Result of the reduction, `accumulator_size` bytes
+    @param  const void*             Initial value of an accumulator, `accumulator_size` bytes
+    @param  size_t                  Size of an accumulator
+    @param  ListAccumulateFunction  Function folding an element into an accumulator
+    @param  ListCombineFunction     Function folding the accumulator of the next chunk into an accumulator
+    @param  void*                   Context given to the functions
+    @param  ThreadPool*             Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_reduce(SinglyLinkedList* sll, void* result, const void* identity, size_t accumulator_size,
+                         ListAccumulateFunction accumulate, ListCombineFunction combine, void* context, ThreadPool* pool){
+    ParallelJob job = {PARALLEL_REDUCE, NULL, NULL, accumulate, NULL, NULL, context};
+    ParallelChunk single;
+    size_t nchunks;
+
+    ParallelChunk* chunks = parallel_chunks_create(sll, &job, pool, &single, &nchunks);
+
+    size_t stride = (accumulator_size + PARALLEL_CACHE_LINE - 1) / PARALLEL_CACHE_LINE * PARALLEL_CACHE_LINE;
+    unsigned char* accumulators = nchunks > 1 ? (unsigned char*)malloc(nchunks * stride) : NULL;
+
+    if(!accumulators){
+        //  One chunk, or no room for the accumulators: the calling thread reduces the whole list into `result`
+        if(chunks != &single){
+            free(chunks);
+        }
+
+        memcpy(result, identity, accumulator_size);
+        single = (ParallelChunk){&job, sll->head, sll->size, result, NULL, NULL, 0};
+        parallel_chunk_run(&single);
+        return;
+    }
+
+    for(size_t i = 0; i < nchunks; i++){
+        chunks[i].accumulator = accumulators + i * stride;
+        memcpy(chunks[i].accumulator, identity, accumulator_size);
+    }
+
+    parallel_execute(sll, chunks, nchunks, pool);
+
+    memcpy(result, chunks[0].accumulator, accumulator_size);
+
+    for(size_t i = 1; i < nchunks; i++){
+        combine(result, chunks[i].accumulator, context);
+    }
+
+    free(accumulators);
+    free(chunks);
+}
+
+/*
+    sll_parallel_filter
+    Remove the elements of a singly linked list that a predicate rejects, in parallel, keeping the order of the others. The removed nodes are freed.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListKeepFunction    Predicate called on every element, from several threads at once
+    @param  ListFreeFunction    Function freeing the data of a removed node, NULL to leave the data to the caller; not called on the payloads of a node block
+    @param  void*               Context given to the predicate
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return size_t              Number of removed elements
+*/
+size_t sll_parallel_filter(SinglyLinkedList* sll, ListKeepFunction keep, ListFreeFunction free_data, void* context, ThreadPool* pool){
+    ParallelJob job = {PARALLEL_FILTER, NULL, NULL, NULL, keep, free_data, context};
+    ParallelChunk single;
+    size_t nchunks;
+
+    ParallelChunk* chunks = parallel_chunks_create(sll, &job, pool, &single, &nchunks);
+    parallel_execute(sll, chunks, nchunks, pool);
+
+    //  Splice the kept chains of the chunks in list order
+    SLLNode* head = NULL;
+    SLLNode* tail = NULL;
+    size_t removed = 0;
+
+    for(size_t i = 0; i < nchunks; i++){
+        removed += chunks[i].removed;
+
+        if(!chunks[i].kept_head){
+            continue;
+        }
+
+        if(tail){
+            tail->next = chunks[i].kept_head;
+        }   else{
+                head = chunks[i].kept_head;
+        }
+        tail = chunks[i].kept_tail;
+    }
+
+    if(tail){
+        tail->next = NULL;
+    }
+
+    sll->head = head;
+    sll->size -= removed;
+
+    if(chunks != &single){
+        free(chunks);
+    }
+
+    if(removed && sll->index){
+        sll_index_rebuild(sll);
+    }
+
+    return removed;
+}
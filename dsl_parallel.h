@@ -0,0 +1,127 @@
+#ifndef DSL_PARALLEL_H
+#define DSL_PARALLEL_H
+/*
+    Interface for the parallel operations over singly linked lists.
+
+    A singly linked list cannot be split without walking it. The parallel operations walk the list once, following the `next` pointers without reading the elements,
+    and submit each chunk as a task of a work-stealing `ThreadPool` (see `dsl_threadpool.h`) as soon as the walk has passed it, so the workers process the first chunks
+    while the walk carves the next ones; the calling thread runs the last chunk. The chunks are several per thread (`PARALLEL_CHUNKS_PER_THREAD`) so that idle workers
+    steal the remaining ones when the elements cost unequal work. Lists shorter than `PARALLEL_LIST_CUTOFF` nodes per chunk use fewer chunks, down to a sequential pass.
+
+    - `sll_parallel_foreach` visits every element; `sll_parallel_map` replaces every element by the result of a function
+    - `sll_parallel_reduce` folds the elements of each chunk into an accumulator, then combines the accumulators in list order:
+      the operation must be associative, but need not be commutative
+    - `sll_parallel_filter` removes the elements a predicate rejects: each chunk relinks the nodes it keeps and frees the others, and the kept chains are spliced together
+      in list order, without allocating
+
+    The removed nodes of a list built in bulk are released from their node block without a lock, like any other node, and the elements copied into the block
+    by `sll_from_array` or `sll_from_generator` are never passed to `free_data`: `free` may be given for such a list.
+
+    The functions must not be called on a list that another thread modifies. They do not fail: if the chunks cannot be allocated, the calling thread runs the operation alone.
+    An attached hash index is rebuilt after `sll_parallel_map` and `sll_parallel_filter`.
+
+    The current methods are:
+    - `sll_parallel_foreach`: Visit every element of a singly linked list in parallel
+    - `sll_parallel_map`: Replace every element of a singly linked list in parallel
+    - `sll_parallel_reduce`: Reduce the elements of a singly linked list in parallel
+    - `sll_parallel_filter`: Remove the elements of a singly linked list rejected by a predicate, in parallel
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dsl_lists.h"
+#include "dsl_threadpool.h"
+
+//  Smallest number of nodes of a chunk
+#define PARALLEL_LIST_CUTOFF 4096
+
+//  Number of chunks per thread of the pool
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+/*
+    Function visiting an element
+    - `data` is the data of the node
+    - `context` is the pointer given to the operation
+*/
+typedef void (*ListVisitFunction)(void* data, void* context);
+
+/*
+    Function mapping an element: returns the new data of the node
+*/
+typedef void* (*ListMapFunction)(void* data, void* context);
+
+/*
+    Predicate of a filter: returns true to keep the node
+*/
+typedef bool (*ListKeepFunction)(void* data, void* context);
+
+/*
+    Function folding an element into an accumulator
+    - `accumulator` is the accumulator of the chunk
+    - `data` is the data of the node
+    - `context` is the pointer given to the operation
+*/
+typedef void (*ListAccumulateFunction)(void* accumulator, void* data, void* context);
+
+/*
+    Function folding the accumulator of the next chunk, `other`, into `accumulator`
+*/
+typedef void (*ListCombineFunction)(void* accumulator, const void* other, void* context);
+
+/*
+    sll_parallel_foreach
+    Call a function on every element of a singly linked list, in parallel; the order of the calls is unspecified
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListVisitFunction   Function called on every element, from several threads at once
+    @param  void*               Context given to the function
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_foreach(SinglyLinkedList* sll, ListVisitFunction visit, void* context, ThreadPool* pool);
+
+/*
+    sll_parallel_map
+    Replace the data of every node of a singly linked list by the result of a function of it, in parallel
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListMapFunction     Function called on every element, from several threads at once
+    @param  void*               Context given to the function
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_map(SinglyLinkedList* sll, ListMapFunction map, void* context, ThreadPool* pool);
+
+/*
+    sll_parallel_reduce
+    Reduce the elements of a singly linked list, in parallel: every chunk starts from a copy of `identity` and accumulates its elements in order,
+    then the accumulators of the chunks are combined in list order into `result`
+    @param  SinglyLinkedList*       Pointer to the list
+    @param  void*                   Result of the reduction, `accumulator_size` bytes
+    @param  const void*             Initial value of an accumulator, `accumulator_size` bytes
+    @param  size_t                  Size of an accumulator
+    @param  ListAccumulateFunction  Function folding an element into an accumulator
+    @param  ListCombineFunction     Function folding the accumulator of the next chunk into an accumulator
+    @param  void*                   Context given to the functions
+    @param  ThreadPool*             Thread pool running the chunks, NULL for a sequential pass
+    @return void
+*/
+void sll_parallel_reduce(SinglyLinkedList* sll, void* result, const void* identity, size_t accumulator_size,
+                         ListAccumulateFunction accumulate, ListCombineFunction combine, void* context, ThreadPool* pool);
+
+/*
+    sll_parallel_filter
+    Remove the elements of a singly linked list that a predicate rejects, in parallel, keeping the order of the others. The removed nodes are freed.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListKeepFunction    Predicate called on every element, from several threads at once
+    @param  ListFreeFunction    Function freeing the data of a removed node, NULL to leave the data to the caller; not called on the payloads of a node block
+    @param  void*               Context given to the predicate
+    @param  ThreadPool*         Thread pool running the chunks, NULL for a sequential pass
+    @return size_t              Number of removed elements
+*/
+size_t sll_parallel_filter(SinglyLinkedList* sll, ListKeepFunction keep, ListFreeFunction free_data, void* context, ThreadPool* pool);
+
+#endif // DSL_PARALLEL_H
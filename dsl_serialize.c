@@ -0,0 +1,740 @@
+/*
+    Implementation of the binary list files.
+
+    The writer keeps the checksum of the bytes written so far and seeks back to the header when it is closed.
+    The mapping checks every bound before any element is read, so a truncated or corrupted file is refused rather than read out of bounds.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dsl_serialize.h"
+
+//  Offset basis and prime of the 64-bit FNV-1a hash
+#define LISTFILE_FNV_OFFSET 0xcbf29ce484222325ull
+#define LISTFILE_FNV_PRIME 0x100000001b3ull
+
+_Static_assert(sizeof(ListFileHeader) == 64, "the header of a list file is 64 bytes");
+
+
+/*
+    Checksum
+*/
+
+/*
+    listfile_hash
+    Add bytes to a 64-bit FNV-1a hash
+    @param  uint64_t        Hash of the previous bytes, `LISTFILE_FNV_OFFSET` for none
+    @param  const void*     Bytes to be added
+    @param  size_t          Number of bytes
+    @return uint64_t        Hash of all the bytes
+*/
+static uint64_t listfile_hash(uint64_t hash, const void* bytes, size_t n){
+    const unsigned char* current = (const unsigned char*)bytes;
+
+    for(size_t i = 0; i < n; i++){
+        hash ^= current[i];
+        hash *= LISTFILE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+
+/*
+    Writing
+*/
+
+/*
+    listfile_writer_put
+    Write bytes to a list file and add them to its checksum
+    @param  ListFileWriter*     Pointer to the writer
+    @param  const void*         Bytes to be written
+    @param  size_t              Number of bytes
+    @return bool                true if the operation was successful, false after a write error
+*/
+static bool listfile_writer_put(ListFileWriter* writer, const void* bytes, size_t n){
+    if(n == 0){
+        return true;
+    }
+
+    if(fwrite(bytes, 1, n, writer->file) != n){
+        writer->failed = true;
+        return false;
+    }
+
+    writer->header.checksum = listfile_hash(writer->header.checksum, bytes, n);
+    writer->header.payload_size += n;
+
+    return true;
+}
+
+/*
+    listfile_writer_open
+    Create, or truncate, a list file to be written
+    @param  const char*         Path of the file
+    @param  ListFileKind        Kind of the list saved
+    @param  size_t              Size of every element, 0 for length-prefixed elements
+    @return ListFileWriter*     Pointer to the new writer, NULL if the file could not be created
+*/
+ListFileWriter* listfile_writer_open(const char* path, ListFileKind kind, size_t element_size){
+    if(!path || kind >= LISTFILE_KINDS){
+        return NULL;
+    }
+
+    ListFileWriter* writer = (ListFileWriter*)calloc(1, sizeof(ListFileWriter));
+
+    if(!writer){
+        return NULL;
+    }
+
+    writer->file = fopen(path, "wb");
+
+    if(!writer->file){
+        free(writer);
+        return NULL;
+    }
+
+    memcpy(writer->header.magic, LISTFILE_MAGIC, sizeof(LISTFILE_MAGIC));
+    writer->header.version = LISTFILE_VERSION;
+    writer->header.byte_order = LISTFILE_BYTE_ORDER;
+    writer->header.kind = (uint32_t)kind;
+    writer->header.element_size = element_size;
+    writer->header.checksum = LISTFILE_FNV_OFFSET;
+
+    //  Until the writer is closed, the header is zeroed: an unfinished file has no magic string and is refused
+    ListFileHeader blank;
+    memset(&blank, 0, sizeof(blank));
+
+    if(fwrite(&blank, sizeof(blank), 1, writer->file) != 1){
+        writer->failed = true;
+    }
+
+    return writer;
+}
+
+/*
+    listfile_writer_append
+    Append an element to a list file
+    @param  ListFileWriter*     Pointer to the writer
+    @param  const void*         Pointer to the data of the element
+    @param  size_t              Size of the data; ignored with fixed-size elements
+    @return bool                true if the operation was successful, false after a write error
+*/
+bool listfile_writer_append(ListFileWriter* writer, const void* data, size_t size){
+    if(!writer || writer->failed){
+        return false;
+    }
+
+    if(writer->header.element_size > 0){
+        if(!data || !listfile_writer_put(writer, data, writer->header.element_size)){
+            writer->failed = true;
+            return false;
+        }
+
+        writer->header.count++;
+
+        return true;
+    }
+
+    static const unsigned char zeros[LISTFILE_ALIGNMENT] = {0};
+    uint64_t length = size;
+    size_t padding = (LISTFILE_ALIGNMENT - size % LISTFILE_ALIGNMENT) % LISTFILE_ALIGNMENT;
+
+    if((size && !data) || !listfile_writer_put(writer, &length, sizeof(length)) || !listfile_writer_put(writer, data, size) || !listfile_writer_put(writer, zeros, padding)){
+        writer->failed = true;
+        return false;
+    }
+
+    writer->header.count++;
+
+    return true;
+}
+
+/*
+    listfile_writer_close
+    Write the header of a list file, with its count and checksum, and close it
+    @param  ListFileWriter*     Pointer to the writer, freed
+    @return bool                true if the whole file was written, false otherwise
+*/
+bool listfile_writer_close(ListFileWriter* writer){
+    if(!writer){
+        return false;
+    }
+
+    bool ok = !writer->failed;
+
+    ok = ok && fseek(writer->file, 0, SEEK_SET) == 0;
+    ok = ok && fwrite(&writer->header, sizeof(ListFileHeader), 1, writer->file) == 1;
+    ok = (fclose(writer->file) == 0) && ok;
+
+    free(writer);
+
+    return ok;
+}
+
+/*
+    listfile_write_data
+    Append the data of a node to a list file
+    @param  ListFileWriter*         Pointer to the writer
+    @param  void*                   Pointer to the data
+    @param  ListFileSizeFunction    Size of the data with length-prefixed elements
+    @return bool                    true if the operation was successful, false otherwise
+*/
+static bool listfile_write_data(ListFileWriter* writer, void* data, ListFileSizeFunction size_of){
+    size_t size = writer->header.element_size > 0 ? writer->header.element_size : size_of(data);
+
+    return listfile_writer_append(writer, data, size);
+}
+
+/*
+    listfile_save_open
+    Open the writer of a list saved at once, after checking that the size of its elements is known
+    @param  const char*             Path of the file
+    @param  ListFileKind            Kind of the list
+    @param  size_t                  Size of every element, 0 for length-prefixed elements
+    @param  ListFileSizeFunction    Size of each element with length-prefixed elements
+    @return ListFileWriter*         Pointer to the writer, NULL otherwise
+*/
+static ListFileWriter* listfile_save_open(const char* path, ListFileKind kind, size_t element_size, ListFileSizeFunction size_of){
+    if(element_size == 0 && !size_of){
+        return NULL;
+    }
+
+    return listfile_writer_open(path, kind, element_size);
+}
+
+/*
+    sll_save
+    Save a singly linked list to a file
+    @param  SinglyLinkedList*       Pointer to the list
+    @param  const char*             Path of the file
+    @param  size_t                  Size of every element, 0 for length-prefixed elements
+    @param  ListFileSizeFunction    Size of each element, required with length-prefixed elements
+    @return bool                    true if the operation was successful, false otherwise
+*/
+bool sll_save(SinglyLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of){
+    if(!list){
+        return false;
+    }
+
+    ListFileWriter* writer = listfile_save_open(path, LISTFILE_SLL, element_size, size_of);
+
+    if(!writer){
+        return false;
+    }
+
+    for(SLLNode* current = list->head; current && !writer->failed; current = current->next){
+        listfile_write_data(writer, current->data, size_of);
+    }
+
+    return listfile_writer_close(writer);
+}
+
+/*
+    dll_save
+    Save a doubly linked list to a file. See `sll_save`.
+*/
+bool dll_save(DoublyLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of){
+    if(!list){
+        return false;
+    }
+
+    ListFileWriter* writer = listfile_save_open(path, LISTFILE_DLL, element_size, size_of);
+
+    if(!writer){
+        return false;
+    }
+
+    for(DLLNode* current = list->head; current && !writer->failed; current = current->next){
+        listfile_write_data(writer, current->data, size_of);
+    }
+
+    return listfile_writer_close(writer);
+}
+
+/*
+    cll_save
+    Save a circular linked list to a file, from its head. See `sll_save`.
+*/
+bool cll_save(CircularLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of){
+    if(!list){
+        return false;
+    }
+
+    ListFileWriter* writer = listfile_save_open(path, LISTFILE_CLL, element_size, size_of);
+
+    if(!writer){
+        return false;
+    }
+
+    CLLNode* current = list->head;
+
+    for(size_t i = 0; i < list->size && !writer->failed; i++){
+        listfile_write_data(writer, current->data, size_of);
+        current = current->next;
+    }
+
+    return listfile_writer_close(writer);
+}
+
+/*
+    stack_save
+    Save a stack to a file, from its top. See `sll_save`.
+*/
+bool stack_save(Stack* stack, const char* path, size_t element_size, ListFileSizeFunction size_of){
+    if(!stack){
+        return false;
+    }
+
+    ListFileWriter* writer = listfile_save_open(path, LISTFILE_STACK, element_size, size_of);
+
+    if(!writer){
+        return false;
+    }
+
+    for(DLLNode* current = stack->top; current && !writer->failed; current = current->next){
+        listfile_write_data(writer, current->data, size_of);
+    }
+
+    return listfile_writer_close(writer);
+}
+
+/*
+    queue_save
+    Save a queue to a file, from its front. See `sll_save`.
+*/
+bool queue_save(Queue* queue, const char* path, size_t element_size, ListFileSizeFunction size_of){
+    if(!queue){
+        return false;
+    }
+
+    ListFileWriter* writer = listfile_save_open(path, LISTFILE_QUEUE, element_size, size_of);
+
+    if(!writer){
+        return false;
+    }
+
+    for(DLLNode* current = queue->front; current && !writer->failed; current = current->next){
+        listfile_write_data(writer, current->data, size_of);
+    }
+
+    return listfile_writer_close(writer);
+}
+
+
+/*
+    Loading
+*/
+
+/*
+    listfile_check
+    Check the header of a mapped list file and the bounds of its elements
+    @param  const ListFileHeader*   Header of the file
+    @param  size_t                  Size of the file
+    @param  bool                    Whether to check the checksum of the payload
+    @return bool                    true if the file can be read safely, false otherwise
+*/
+static bool listfile_check(const ListFileHeader* header, size_t map_size, bool verify){
+    if(memcmp(header->magic, LISTFILE_MAGIC, sizeof(LISTFILE_MAGIC)) != 0 || header->version != LISTFILE_VERSION || header->byte_order != LISTFILE_BYTE_ORDER){
+        return false;
+    }
+
+    if(header->kind >= LISTFILE_KINDS || header->payload_size != map_size - sizeof(ListFileHeader)){
+        return false;
+    }
+
+    const unsigned char* payload = (const unsigned char*)(header + 1);
+    uint64_t payload_size = header->payload_size;
+
+    if(header->element_size > 0){
+        if(header->count > payload_size / header->element_size || header->count * header->element_size != payload_size){
+            return false;
+        }
+    }   else{
+            //  Walk the lengths once, so the cursor and the views never leave the payload
+            uint64_t offset = 0;
+
+            for(uint64_t i = 0; i < header->count; i++){
+                if(payload_size - offset < sizeof(uint64_t)){
+                    return false;
+                }
+
+                uint64_t length;
+                memcpy(&length, payload + offset, sizeof(length));
+                offset += sizeof(uint64_t);
+
+                if(length > payload_size - offset){
+                    return false;
+                }
+
+                uint64_t padded = length + (LISTFILE_ALIGNMENT - length % LISTFILE_ALIGNMENT) % LISTFILE_ALIGNMENT;
+
+                if(padded > payload_size - offset){
+                    return false;
+                }
+
+                offset += padded;
+            }
+
+            if(offset != payload_size){
+                return false;
+            }
+    }
+
+    if(verify && listfile_hash(LISTFILE_FNV_OFFSET, payload, (size_t)payload_size) != header->checksum){
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    listfile_map
+    Map a list file read-only and check its header and the bounds of its elements
+    @param  const char*     Path of the file
+    @param  bool            Whether to check the checksum of the payload, which reads the whole file
+    @return ListFile*       Pointer to the mapped file, NULL if it cannot be mapped, is not a complete list file of this version and byte order, or fails a check
+*/
+ListFile* listfile_map(const char* path, bool verify){
+    if(!path){
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+
+    if(fd < 0){
+        return NULL;
+    }
+
+    struct stat status;
+
+    if(fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(ListFileHeader)){
+        close(fd);
+        return NULL;
+    }
+
+    size_t map_size = (size_t)status.st_size;
+    void* map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    //  The mapping keeps its own reference to the file
+    close(fd);
+
+    if(map == MAP_FAILED){
+        return NULL;
+    }
+
+    if(!listfile_check((const ListFileHeader*)map, map_size, verify)){
+        munmap(map, map_size);
+        return NULL;
+    }
+
+    ListFile* file = (ListFile*)calloc(1, sizeof(ListFile));
+
+    if(!file){
+        munmap(map, map_size);
+        return NULL;
+    }
+
+    file->map = map;
+    file->map_size = map_size;
+    file->header = (const ListFileHeader*)map;
+    file->payload = (const unsigned char*)map + sizeof(ListFileHeader);
+
+    return file;
+}
+
+/*
+    listfile_unmap
+    Unmap a list file and free its views
+    @param  ListFile*   Pointer to the mapped file
+    @return void
+*/
+void listfile_unmap(ListFile* file){
+    if(!file){
+        return;
+    }
+
+    for(int kind = 0; kind < LISTFILE_KINDS; kind++){
+        free(file->nodes[kind]);
+    }
+
+    munmap(file->map, file->map_size);
+    free(file);
+}
+
+/*
+    listfile_count
+    Get the number of elements of a list file
+    @param  ListFile*   Pointer to the mapped file
+    @return size_t      Number of elements
+*/
+size_t listfile_count(ListFile* file){
+    return file ? (size_t)file->header->count : 0;
+}
+
+/*
+    listfile_next
+    Get the next element of a list file, in place
+    @param  ListFile*       Pointer to the mapped file
+    @param  size_t*         Cursor, set to 0 before the first element and advanced by each call
+    @param  size_t*         If not NULL, receives the size of the element
+    @return const void*     Pointer to the data of the element in the mapping, NULL after the last element
+*/
+const void* listfile_next(ListFile* file, size_t* cursor, size_t* size){
+    if(!file || !cursor || *cursor >= file->header->payload_size){
+        return NULL;
+    }
+
+    const unsigned char* record = file->payload + *cursor;
+    uint64_t element_size = file->header->element_size;
+
+    if(element_size > 0){
+        *cursor += element_size;
+
+        if(size){
+            *size = element_size;
+        }
+
+        return record;
+    }
+
+    uint64_t length;
+    memcpy(&length, record, sizeof(length));
+
+    //  The bounds were checked by `listfile_map`
+    *cursor += sizeof(uint64_t) + length + (LISTFILE_ALIGNMENT - length % LISTFILE_ALIGNMENT) % LISTFILE_ALIGNMENT;
+
+    if(size){
+        *size = length;
+    }
+
+    return record + sizeof(uint64_t);
+}
+
+/*
+    listfile_record_size
+    Get the size of an element of a list file, e.g. the data of a node of a view
+    @param  ListFile*       Pointer to the mapped file
+    @param  const void*     Pointer to the data of the element in the mapping
+    @return size_t          Size of the element
+*/
+size_t listfile_record_size(ListFile* file, const void* data){
+    if(!file || !data){
+        return 0;
+    }
+
+    if(file->header->element_size > 0){
+        return file->header->element_size;
+    }
+
+    uint64_t length;
+    memcpy(&length, (const unsigned char*)data - sizeof(uint64_t), sizeof(length));
+
+    return (size_t)length;
+}
+
+
+/*
+    Views
+*/
+
+/*
+    listfile_nodes
+    Allocate the node block of a view, with room for every element
+    @param  ListFile*       Pointer to the mapped file
+    @param  ListFileKind    Kind of the view
+    @param  size_t          Size of a node
+    @return void*           Pointer to the block, NULL if the file is empty or the allocation failed
+*/
+static void* listfile_nodes(ListFile* file, ListFileKind kind, size_t node_size){
+    size_t count = listfile_count(file);
+
+    if(count == 0 || count > SIZE_MAX / node_size){
+        return NULL;
+    }
+
+    file->nodes[kind] = malloc(count * node_size);
+
+    return file->nodes[kind];
+}
+
+/*
+    listfile_dll_nodes
+    Link the nodes of a view made of `DLLNode`, in the order of the file
+    @param  ListFile*       Pointer to the mapped file
+    @param  ListFileKind    Kind of the view
+    @return DLLNode*        Pointer to the first node, NULL if the file is empty or the allocation failed
+*/
+static DLLNode* listfile_dll_nodes(ListFile* file, ListFileKind kind){
+    size_t count = listfile_count(file);
+    DLLNode* nodes = (DLLNode*)listfile_nodes(file, kind, sizeof(DLLNode));
+
+    if(!nodes){
+        return NULL;
+    }
+
+    size_t cursor = 0;
+
+    for(size_t i = 0; i < count; i++){
+        nodes[i].data = (void*)listfile_next(file, &cursor, NULL);
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = i + 1 < count ? &nodes[i + 1] : NULL;
+    }
+
+    return nodes;
+}
+
+/*
+    listfile_sll
+    Get a read-only view of a list file as a singly linked list, built on the first call with one allocation for all its nodes
+    @param  ListFile*           Pointer to the mapped file
+    @return SinglyLinkedList*   Pointer to the view, owned by the mapped file; NULL if the allocation failed
+*/
+SinglyLinkedList* listfile_sll(ListFile* file){
+    if(!file){
+        return NULL;
+    }
+
+    size_t count = listfile_count(file);
+
+    if(count > 0 && !file->nodes[LISTFILE_SLL]){
+        SLLNode* nodes = (SLLNode*)listfile_nodes(file, LISTFILE_SLL, sizeof(SLLNode));
+
+        if(!nodes){
+            return NULL;
+        }
+
+        size_t cursor = 0;
+
+        for(size_t i = 0; i < count; i++){
+            nodes[i].data = (void*)listfile_next(file, &cursor, NULL);
+            nodes[i].next = i + 1 < count ? &nodes[i + 1] : NULL;
+        }
+
+        file->sll.head = nodes;
+        file->sll.size = count;
+    }
+
+    return &file->sll;
+}
+
+/*
+    listfile_dll
+    Get a read-only view of a list file as a doubly linked list. See `listfile_sll`.
+*/
+DoublyLinkedList* listfile_dll(ListFile* file){
+    if(!file){
+        return NULL;
+    }
+
+    size_t count = listfile_count(file);
+
+    if(count > 0 && !file->nodes[LISTFILE_DLL]){
+        DLLNode* nodes = listfile_dll_nodes(file, LISTFILE_DLL);
+
+        if(!nodes){
+            return NULL;
+        }
+
+        file->dll.head = nodes;
+        file->dll.tail = &nodes[count - 1];
+        file->dll.size = count;
+    }
+
+    return &file->dll;
+}
+
+/*
+    listfile_cll
+    Get a read-only view of a list file as a circular linked list. See `listfile_sll`.
+*/
+CircularLinkedList* listfile_cll(ListFile* file){
+    if(!file){
+        return NULL;
+    }
+
+    size_t count = listfile_count(file);
+
+    if(count > 0 && !file->nodes[LISTFILE_CLL]){
+        CLLNode* nodes = (CLLNode*)listfile_nodes(file, LISTFILE_CLL, sizeof(CLLNode));
+
+        if(!nodes){
+            return NULL;
+        }
+
+        size_t cursor = 0;
+
+        for(size_t i = 0; i < count; i++){
+            nodes[i].data = (void*)listfile_next(file, &cursor, NULL);
+            nodes[i].next = &nodes[(i + 1) % count];
+        }
+
+        file->cll.head = nodes;
+        file->cll.size = count;
+    }
+
+    return &file->cll;
+}
+
+/*
+    listfile_stack
+    Get a read-only view of a list file as a stack, the first element on top. See `listfile_sll`.
+*/
+Stack* listfile_stack(ListFile* file){
+    if(!file){
+        return NULL;
+    }
+
+    size_t count = listfile_count(file);
+
+    if(count > 0 && !file->nodes[LISTFILE_STACK]){
+        DLLNode* nodes = listfile_dll_nodes(file, LISTFILE_STACK);
+
+        if(!nodes){
+            return NULL;
+        }
+
+        file->stack.top = nodes;
+        file->stack.size = count;
+    }
+
+    return &file->stack;
+}
+
+/*
+    listfile_queue
+    Get a read-only view of a list file as a queue, the first element at the front. See `listfile_sll`.
+*/
+Queue* listfile_queue(ListFile* file){
+    if(!file){
+        return NULL;
+    }
+
+    size_t count = listfile_count(file);
+
+    if(count > 0 && !file->nodes[LISTFILE_QUEUE]){
+        DLLNode* nodes = listfile_dll_nodes(file, LISTFILE_QUEUE);
+
+        if(!nodes){
+            return NULL;
+        }
+
+        file->queue.front = nodes;
+        file->queue.back = &nodes[count - 1];
+        file->queue.size = count;
+    }
+
+    return &file->queue;
+}
@@ -0,0 +1,274 @@
+#ifndef DSL_SERIALIZE_H
+#define DSL_SERIALIZE_H
+/*
+    Interface for the implementation of the binary list files.
+
+    The lists of `dsl_lists.h` are saved in a compact binary file, and loaded back by mapping the file in memory: the elements are read in place, with no copy and no allocation per element.
+
+    A list file is a 64-byte header followed by the payload:
+    - the header holds a magic string, the format version, a byte-order mark, the kind of list saved, the number of elements, the size of the payload and its FNV-1a checksum;
+    - with fixed-size elements (`element_size` > 0), the payload is the `count` elements, `element_size` bytes each, back to back;
+    - with length-prefixed elements (`element_size` == 0), each element is a 64-bit length followed by its bytes, padded to 8 bytes, so every element is 8-byte aligned in the mapping.
+    Files are written in the byte order of the machine, and refused on a machine of the other byte order.
+
+    Files are written element by element with a `ListFileWriter` (`listfile_writer_open`, `listfile_writer_append`, `listfile_writer_close`), or from a whole list (`sll_save`, ...).
+    The header is completed when the writer is closed, so a file left unfinished is refused when mapped.
+
+    `listfile_map` maps a file read-only and checks its header, the bounds of its elements and, optionally, its checksum.
+    The elements are read with `listfile_next`, or through a read-only view of the file as a list (`listfile_sll`, ...): the nodes of a view are allocated in one block, and their data point into the mapping.
+    A view may be traversed, searched and reordered, but nodes must not be inserted or removed, and the data must not be written; the view is freed by `listfile_unmap`, never by `sll_destroy`.
+
+    The current methods are:
+    - `listfile_writer_open`: Create a list file to be written
+    - `listfile_writer_append`: Append an element to a list file
+    - `listfile_writer_close`: Complete and close a list file
+    - `sll_save`, `dll_save`, `cll_save`, `stack_save`, `queue_save`: Save a list to a file
+    - `listfile_map`: Map a list file in memory
+    - `listfile_unmap`: Unmap a list file and free its views
+    - `listfile_count`: Get the number of elements of a list file
+    - `listfile_next`: Get the next element of a list file
+    - `listfile_record_size`: Get the size of an element of a list file
+    - `listfile_sll`, `listfile_dll`, `listfile_cll`, `listfile_stack`, `listfile_queue`: Get a read-only view of a list file as a list
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "dsl_lists.h"
+
+//  Magic string at the start of every list file
+#define LISTFILE_MAGIC "DSLLIST"
+
+//  Version of the format written
+#define LISTFILE_VERSION 1
+
+//  Byte-order mark, read back as another value on a machine of the other byte order
+#define LISTFILE_BYTE_ORDER 0x01020304u
+
+//  Alignment of the length-prefixed elements
+#define LISTFILE_ALIGNMENT 8
+
+/*
+    Kind of the list saved in a file; any file can be viewed as any kind of list
+*/
+typedef enum ListFileKind {
+    LISTFILE_SLL,
+    LISTFILE_DLL,
+    LISTFILE_CLL,
+    LISTFILE_STACK,
+    LISTFILE_QUEUE,
+    LISTFILE_KINDS
+} ListFileKind;
+
+/*
+    Header of a list file, 64 bytes
+    - `magic` is `LISTFILE_MAGIC`
+    - `version` is the version of the format, `LISTFILE_VERSION`
+    - `byte_order` is `LISTFILE_BYTE_ORDER`, in the byte order of the machine that wrote the file
+    - `kind` is the `ListFileKind` of the list saved
+    - `element_size` is the size of every element, 0 for length-prefixed elements
+    - `count` is the number of elements
+    - `payload_size` is the number of bytes after the header
+    - `checksum` is the 64-bit FNV-1a hash of the payload
+*/
+typedef struct ListFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t element_size;
+    uint64_t count;
+    uint64_t payload_size;
+    uint64_t checksum;
+    uint8_t padding[8];
+} ListFileHeader;
+
+/*
+    Size of the data of an element saved with length-prefixed elements, e.g. `strlen(data) + 1` for strings
+*/
+typedef size_t (*ListFileSizeFunction)(void* data);
+
+/*
+    Writer of a list file
+    - `file` is the file written
+    - `header` is the header, completed by `listfile_writer_close`
+    - `failed` is set after a write error, or an element of the wrong size
+*/
+typedef struct ListFileWriter {
+    FILE *file;
+    ListFileHeader header;
+    bool failed;
+} ListFileWriter;
+
+/*
+    List file mapped in memory
+    - `map` is the mapping of the file, `map_size` its size
+    - `header` is the header of the file
+    - `payload` is the first byte of the payload
+    - `nodes` is the node block of the view of each kind, NULL until it is built
+    - `sll`, `dll`, `cll`, `stack` and `queue` are the views
+*/
+typedef struct ListFile {
+    void *map;
+    size_t map_size;
+    const ListFileHeader *header;
+    const unsigned char *payload;
+    void *nodes[LISTFILE_KINDS];
+    SinglyLinkedList sll;
+    DoublyLinkedList dll;
+    CircularLinkedList cll;
+    Stack stack;
+    Queue queue;
+} ListFile;
+
+//  Writing
+
+/*
+    listfile_writer_open
+    Create, or truncate, a list file to be written
+    @param  const char*         Path of the file
+    @param  ListFileKind        Kind of the list saved
+    @param  size_t              Size of every element, 0 for length-prefixed elements
+    @return ListFileWriter*     Pointer to the new writer, NULL if the file could not be created
+*/
+ListFileWriter* listfile_writer_open(const char* path, ListFileKind kind, size_t element_size);
+
+/*
+    listfile_writer_append
+    Append an element to a list file
+    @param  ListFileWriter*     Pointer to the writer
+    @param  const void*         Pointer to the data of the element
+    @param  size_t              Size of the data; ignored with fixed-size elements
+    @return bool                true if the operation was successful, false after a write error
+*/
+bool listfile_writer_append(ListFileWriter* writer, const void* data, size_t size);
+
+/*
+    listfile_writer_close
+    Write the header of a list file, with its count and checksum, and close it
+    @param  ListFileWriter*     Pointer to the writer, freed
+    @return bool                true if the whole file was written, false otherwise
+*/
+bool listfile_writer_close(ListFileWriter* writer);
+
+/*
+    sll_save
+    Save a singly linked list to a file
+    @param  SinglyLinkedList*       Pointer to the list
+    @param  const char*             Path of the file
+    @param  size_t                  Size of every element, 0 for length-prefixed elements
+    @param  ListFileSizeFunction    Size of each element, required with length-prefixed elements
+    @return bool                    true if the operation was successful, false otherwise
+*/
+bool sll_save(SinglyLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of);
+
+/*
+    dll_save
+    Save a doubly linked list to a file. See `sll_save`.
+*/
+bool dll_save(DoublyLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of);
+
+/*
+    cll_save
+    Save a circular linked list to a file, from its head. See `sll_save`.
+*/
+bool cll_save(CircularLinkedList* list, const char* path, size_t element_size, ListFileSizeFunction size_of);
+
+/*
+    stack_save
+    Save a stack to a file, from its top. See `sll_save`.
+*/
+bool stack_save(Stack* stack, const char* path, size_t element_size, ListFileSizeFunction size_of);
+
+/*
+    queue_save
+    Save a queue to a file, from its front. See `sll_save`.
+*/
+bool queue_save(Queue* queue, const char* path, size_t element_size, ListFileSizeFunction size_of);
+
+//  Loading
+
+/*
+    listfile_map
+    Map a list file read-only and check its header and the bounds of its elements
+    @param  const char*     Path of the file
+    @param  bool            Whether to check the checksum of the payload, which reads the whole file
+    @return ListFile*       Pointer to the mapped file, NULL if it cannot be mapped, is not a complete list file of this version and byte order, or fails a check
+*/
+ListFile* listfile_map(const char* path, bool verify);
+
+/*
+    listfile_unmap
+    Unmap a list file and free its views
+    @param  ListFile*   Pointer to the mapped file
+    @return void
+*/
+void listfile_unmap(ListFile* file);
+
+/*
+    listfile_count
+    Get the number of elements of a list file
+    @param  ListFile*   Pointer to the mapped file
+    @return size_t      Number of elements
+*/
+size_t listfile_count(ListFile* file);
+
+/*
+    listfile_next
+    Get the next element of a list file, in place
+    @param  ListFile*       Pointer to the mapped file
+    @param  size_t*         Cursor, set to 0 before the first element and advanced by each call
+    @param  size_t*         If not NULL, receives the size of the element
+    @return const void*     Pointer to the data of the element in the mapping, NULL after the last element
+*/
+const void* listfile_next(ListFile* file, size_t* cursor, size_t* size);
+
+/*
+    listfile_record_size
+    Get the size of an element of a list file, e.g. the data of a node of a view
+    @param  ListFile*       Pointer to the mapped file
+    @param  const void*     Pointer to the data of the element in the mapping
+    @return size_t          Size of the element
+*/
+size_t listfile_record_size(ListFile* file, const void* data);
+
+/*
+    listfile_sll
+    Get a read-only view of a list file as a singly linked list, built on the first call with one allocation for all its nodes
+    @param  ListFile*           Pointer to the mapped file
+    @return SinglyLinkedList*   Pointer to the view, owned by the mapped file; NULL if the allocation failed
+*/
+SinglyLinkedList* listfile_sll(ListFile* file);
+
+/*
+    listfile_dll
+    Get a read-only view of a list file as a doubly linked list. See `listfile_sll`.
+*/
+DoublyLinkedList* listfile_dll(ListFile* file);
+
+/*
+    listfile_cll
+    Get a read-only view of a list file as a circular linked list. See `listfile_sll`.
+*/
+CircularLinkedList* listfile_cll(ListFile* file);
+
+/*
+    listfile_stack
+    Get a read-only view of a list file as a stack, the first element on top. See `listfile_sll`.
+*/
+Stack* listfile_stack(ListFile* file);
+
+/*
+    listfile_queue
+    Get a read-only view of a list file as a queue, the first element at the front. See `listfile_sll`.
+*/
+Queue* listfile_queue(ListFile* file);
+
+#endif // DSL_SERIALIZE_H
@@ -0,0 +1,1042 @@
+/*
+    Implementation of the vectorized sorts of integer keys.
+
+    The SIMD kernels are compiled with the `target` attribute of GCC and Clang, so the file builds without `-mavx2` and the kernel is chosen at runtime.
+    On other compilers and architectures only the radix sort is available.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "dsl_simdsort.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMDSORT_X86 1
+#include <immintrin.h>
+#endif
+
+//  Number of keys sorted in registers before the merge passes; the SIMD kernels sort arrays padded to a multiple of it
+#define SIMDSORT_BLOCK 16
+
+//  Number of keys under which an insertion sort is used
+#define SIMDSORT_SMALL 64
+
+//  Largest list sorted by packing the position of the nodes in the low 32 bits of the keys
+#define SIMDSORT_MAX_PACKED ((size_t)UINT32_MAX)
+
+//  Kernel in use, -1 until it is first detected
+static atomic_int simdsort_isa = -1;
+
+/*
+    Element of the pair radix sort: a 64-bit key and the position of its node
+*/
+typedef struct SimdSortPair {
+    int64_t key;
+    size_t index;
+} SimdSortPair;
+
+/*
+    Merge of two sorted arrays whose lengths are multiples of the number of keys per register
+*/
+typedef void (*SimdSortMergeFunction)(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out);
+
+
+/*
+    Scalar kernels
+*/
+
+/*
+    i64_insertionsort
+    Sort a short array of 64-bit integers with an insertion sort
+    @param  int64_t*    Array to be sorted
+    @param  size_t      Number of integers
+    @return void
+*/
+static void i64_insertionsort(int64_t* keys, size_t n){
+    for(size_t i = 1; i < n; i++){
+        int64_t key = keys[i];
+        size_t j = i;
+
+        while(j > 0 && keys[j - 1] > key){
+            keys[j] = keys[j - 1];
+            j--;
+        }
+
+        keys[j] = key;
+    }
+}
+
+/*
+    radix_byte
+    Get a byte of a key for the radix sort, with the sign bit flipped so that negative keys come first
+    @param  int64_t     Key
+    @param  unsigned    Position of the byte, 0 for the least significant
+    @return size_t      Byte, between 0 and 255
+*/
+static inline size_t radix_byte(int64_t key, unsigned byte){
+    return (size_t)(((uint64_t)key ^ 0x8000000000000000ULL) >> (8 * byte)) & 0xFF;
+}
+
+/*
+    radix_i64
+    Sort an array of 64-bit integers with an LSD radix sort on bytes, from `first_byte` to the most significant.
+    The bytes below `first_byte` must already be in order for equal high bytes, as the positions packed by `sll_sort_int`.
+    A pass whose byte is the same in every key is skipped.
+    @param  int64_t*    Array to be sorted
+    @param  int64_t*    Working buffer of `n` integers
+    @param  size_t      Number of integers
+    @param  unsigned    First byte sorted
+    @return void
+*/
+static void radix_i64(int64_t* keys, int64_t* buffer, size_t n, unsigned first_byte){
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+
+    //  One pass builds the histograms of every byte
+    for(size_t i = 0; i < n; i++){
+        for(unsigned byte = first_byte; byte < 8; byte++){
+            counts[byte][radix_byte(keys[i], byte)]++;
+        }
+    }
+
+    int64_t* source = keys;
+    int64_t* target = buffer;
+
+    for(unsigned byte = first_byte; byte < 8; byte++){
+        size_t* count = counts[byte];
+
+        if(count[radix_byte(source[0], byte)] == n){
+            continue;
+        }
+
+        size_t offset = 0;
+        for(size_t digit = 0; digit < 256; digit++){
+            size_t c = count[digit];
+            count[digit] = offset;
+            offset += c;
+        }
+
+        for(size_t i = 0; i < n; i++){
+            target[count[radix_byte(source[i], byte)]++] = source[i];
+        }
+
+        int64_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if(source != keys){
+        memcpy(keys, source, n * sizeof(int64_t));
+    }
+}
+
+/*
+    radix_pairs
+    Sort an array of (key, position) pairs by key with an LSD radix sort on bytes. The sort is stable.
+    @param  SimdSortPair*   Array to be sorted
+    @param  SimdSortPair*   Working buffer of `n` pairs
+    @param  size_t          Number of pairs
+    @return SimdSortPair*   Sorted array: `pairs` or `buffer`
+*/
+static SimdSortPair* radix_pairs(SimdSortPair* pairs, SimdSortPair* buffer, size_t n){
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+
+    for(size_t i = 0; i < n; i++){
+        for(unsigned byte = 0; byte < 8; byte++){
+            counts[byte][radix_byte(pairs[i].key, byte)]++;
+        }
+    }
+
+    SimdSortPair* source = pairs;
+    SimdSortPair* target = buffer;
+
+    for(unsigned byte = 0; byte < 8; byte++){
+        size_t* count = counts[byte];
+
+        if(count[radix_byte(source[0].key, byte)] == n){
+            continue;
+        }
+
+        size_t offset = 0;
+        for(size_t digit = 0; digit < 256; digit++){
+            size_t c = count[digit];
+            count[digit] = offset;
+            offset += c;
+        }
+
+        for(size_t i = 0; i < n; i++){
+            target[count[radix_byte(source[i].key, byte)]++] = source[i];
+        }
+
+        SimdSortPair* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    return source;
+}
+
+/*
+    simdsort_merge_passes
+    Merge the sorted blocks of `width` integers of an array pairwise until it is sorted, alternating between the array and the buffer
+    @param  int64_t*                Array made of sorted blocks; receives the sorted integers
+    @param  int64_t*                Working buffer of `n` integers
+    @param  size_t                  Number of integers, a multiple of `SIMDSORT_BLOCK`
+    @param  size_t                  Length of the sorted blocks
+    @param  SimdSortMergeFunction   Merge kernel
+    @return void
+*/
+static void simdsort_merge_passes(int64_t* keys, int64_t* buffer, size_t n, size_t width, SimdSortMergeFunction merge){
+    int64_t* source = keys;
+    int64_t* target = buffer;
+
+    for(; width < n; width *= 2){
+        for(size_t start = 0; start < n; start += 2 * width){
+            size_t middle = start + width < n ? start + width : n;
+            size_t end = start + 2 * width < n ? start + 2 * width : n;
+
+            if(middle == end){
+                memcpy(target + start, source + start, (end - start) * sizeof(int64_t));
+            }   else{
+                    merge(source + start, middle - start, source + middle, end - middle, target + start);
+            }
+        }
+
+        int64_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if(source != keys){
+        memcpy(keys, source, n * sizeof(int64_t));
+    }
+}
+
+
+#ifdef SIMDSORT_X86
+
+/*
+    AVX2 kernels: 4 keys per register
+*/
+
+/*
+    avx2_minmax
+    Compare two registers lane by lane
+    @param  __m256i*    First register, receives the minimums
+    @param  __m256i*    Second register, receives the maximums
+    @return void
+*/
+__attribute__((target("avx2")))
+static inline void avx2_minmax(__m256i* a, __m256i* b){
+    __m256i greater = _mm256_cmpgt_epi64(*a, *b);
+    __m256i min = _mm256_blendv_epi8(*a, *b, greater);
+
+    *b = _mm256_blendv_epi8(*b, *a, greater);
+    *a = min;
+}
+
+/*
+    avx2_reverse
+    Reverse the lanes of a register
+    @param  __m256i     Register
+    @return __m256i     Reversed register
+*/
+__attribute__((target("avx2")))
+static inline __m256i avx2_reverse(__m256i v){
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/*
+    avx2_bitonic_finish
+    Sort a register holding a bitonic sequence: compare the lanes at distance 2, then at distance 1
+    @param  __m256i     Bitonic register
+    @return __m256i     Sorted register
+*/
+__attribute__((target("avx2")))
+static inline __m256i avx2_bitonic_finish(__m256i v){
+    __m256i swapped = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+    __m256i greater = _mm256_cmpgt_epi64(v, swapped);
+    __m256i min = _mm256_blendv_epi8(v, swapped, greater);
+    __m256i max = _mm256_blendv_epi8(swapped, v, greater);
+    v = _mm256_blend_epi32(min, max, 0xF0);
+
+    swapped = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1));
+    greater = _mm256_cmpgt_epi64(v, swapped);
+    min = _mm256_blendv_epi8(v, swapped, greater);
+    max = _mm256_blendv_epi8(swapped, v, greater);
+
+    return _mm256_blend_epi32(min, max, 0xCC);
+}
+
+/*
+    avx2_merge4
+    Merge two sorted registers: the 4 smallest keys end in the first one, the 4 largest in the second one, both sorted
+    @param  __m256i*    First sorted register
+    @param  __m256i*    Second sorted register
+    @return void
+*/
+__attribute__((target("avx2")))
+static inline void avx2_merge4(__m256i* a, __m256i* b){
+    *b = avx2_reverse(*b);
+    avx2_minmax(a, b);
+    *a = avx2_bitonic_finish(*a);
+    *b = avx2_bitonic_finish(*b);
+}
+
+/*
+    avx2_sort16
+    Sort a block of 16 keys in registers: a sorting network on the columns of a 4x4 matrix, a transposition, then bitonic merges
+    @param  int64_t*    Block to be sorted
+    @return void
+*/
+__attribute__((target("avx2")))
+static void avx2_sort16(int64_t* block){
+    __m256i r0 = _mm256_loadu_si256((const __m256i*)(block));
+    __m256i r1 = _mm256_loadu_si256((const __m256i*)(block + 4));
+    __m256i r2 = _mm256_loadu_si256((const __m256i*)(block + 8));
+    __m256i r3 = _mm256_loadu_si256((const __m256i*)(block + 12));
+
+    //  Optimal network of 4 elements on every column
+    avx2_minmax(&r0, &r1);
+    avx2_minmax(&r2, &r3);
+    avx2_minmax(&r0, &r2);
+    avx2_minmax(&r1, &r3);
+    avx2_minmax(&r1, &r2);
+
+    //  Transpose: every register now holds a sorted column
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+    r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+    //  Two sorted runs of 8
+    avx2_merge4(&r0, &r1);
+    avx2_merge4(&r2, &r3);
+
+    //  Bitonic merge of the runs of 8: compare with the reversed second run, then sort each bitonic half
+    __m256i s0 = avx2_reverse(r3);
+    __m256i s1 = avx2_reverse(r2);
+    avx2_minmax(&r0, &s0);
+    avx2_minmax(&r1, &s1);
+    avx2_minmax(&r0, &r1);
+    avx2_minmax(&s0, &s1);
+
+    _mm256_storeu_si256((__m256i*)(block), avx2_bitonic_finish(r0));
+    _mm256_storeu_si256((__m256i*)(block + 4), avx2_bitonic_finish(r1));
+    _mm256_storeu_si256((__m256i*)(block + 8), avx2_bitonic_finish(s0));
+    _mm256_storeu_si256((__m256i*)(block + 12), avx2_bitonic_finish(s1));
+}
+
+/*
+    avx2_merge
+    Merge two sorted arrays, 4 keys at a time: the register of the smallest pending keys is merged with the next 4 keys of the array whose next key is smaller
+    @param  const int64_t*  First sorted array
+    @param  size_t          Length of the first array, a multiple of 4
+    @param  const int64_t*  Second sorted array
+    @param  size_t          Length of the second array, a multiple of 4
+    @param  int64_t*        Output array
+    @return void
+*/
+__attribute__((target("avx2")))
+static void avx2_merge(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out){
+    __m256i low = _mm256_loadu_si256((const __m256i*)a);
+    __m256i high = _mm256_loadu_si256((const __m256i*)b);
+    size_t ia = 4, ib = 4;
+
+    avx2_merge4(&low, &high);
+    _mm256_storeu_si256((__m256i*)out, low);
+    out += 4;
+
+    while(ia < na || ib < nb){
+        if(ib >= nb || (ia < na && a[ia] <= b[ib])){
+            low = _mm256_loadu_si256((const __m256i*)(a + ia));
+            ia += 4;
+        }   else{
+                low = _mm256_loadu_si256((const __m256i*)(b + ib));
+                ib += 4;
+        }
+
+        avx2_merge4(&low, &high);
+        _mm256_storeu_si256((__m256i*)out, low);
+        out += 4;
+    }
+
+    _mm256_storeu_si256((__m256i*)out, high);
+}
+
+/*
+    avx2_sort
+    Sort an array of keys with the AVX2 kernels
+    @param  int64_t*    Array to be sorted
+    @param  int64_t*    Working buffer of `n` integers
+    @param  size_t      Number of integers, a multiple of `SIMDSORT_BLOCK`
+    @return void
+*/
+__attribute__((target("avx2")))
+static void avx2_sort(int64_t* keys, int64_t* buffer, size_t n){
+    for(size_t i = 0; i < n; i += SIMDSORT_BLOCK){
+        avx2_sort16(keys + i);
+    }
+
+    simdsort_merge_passes(keys, buffer, n, SIMDSORT_BLOCK, avx2_merge);
+}
+
+
+/*
+    SSE4.2 kernels: 2 keys per register
+*/
+
+/*
+    sse_minmax
+    Compare two registers lane by lane
+    @param  __m128i*    First register, receives the minimums
+    @param  __m128i*    Second register, receives the maximums
+    @return void
+*/
+__attribute__((target("sse4.2")))
+static inline void sse_minmax(__m128i* a, __m128i* b){
+    __m128i greater = _mm_cmpgt_epi64(*a, *b);
+    __m128i min = _mm_blendv_epi8(*a, *b, greater);
+
+    *b = _mm_blendv_epi8(*b, *a, greater);
+    *a = min;
+}
+
+/*
+    sse_swap_lanes
+    Swap the two lanes of a register
+    @param  __m128i     Register
+    @return __m128i     Register with its lanes swapped
+*/
+__attribute__((target("sse4.2")))
+static inline __m128i sse_swap_lanes(__m128i v){
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+/*
+    sse_bitonic_finish
+    Sort a register of 2 keys
+    @param  __m128i     Register
+    @return __m128i     Sorted register
+*/
+__attribute__((target("sse4.2")))
+static inline __m128i sse_bitonic_finish(__m128i v){
+    __m128i swapped = sse_swap_lanes(v);
+    __m128i greater = _mm_cmpgt_epi64(v, swapped);
+    __m128i min = _mm_blendv_epi8(v, swapped, greater);
+    __m128i max = _mm_blendv_epi8(swapped, v, greater);
+
+    return _mm_blend_epi16(min, max, 0xF0);
+}
+
+/*
+    sse_merge2
+    Merge two sorted registers: the 2 smallest keys end in the first one, the 2 largest in the second one, both sorted
+    @param  __m128i*    First sorted register
+    @param  __m128i*    Second sorted register
+    @return void
+*/
+__attribute__((target("sse4.2")))
+static inline void sse_merge2(__m128i* a, __m128i* b){
+    *b = sse_swap_lanes(*b);
+    sse_minmax(a, b);
+    *a = sse_bitonic_finish(*a);
+    *b = sse_bitonic_finish(*b);
+}
+
+/*
+    sse_sort4
+    Sort a block of 4 keys in registers: sort the columns of a 2x2 matrix, transpose it, and merge the two sorted rows
+    @param  int64_t*    Block to be sorted
+    @return void
+*/
+__attribute__((target("sse4.2")))
+static void sse_sort4(int64_t* block){
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(block));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(block + 2));
+
+    sse_minmax(&r0, &r1);
+    __m128i t0 = _mm_unpacklo_epi64(r0, r1);
+    __m128i t1 = _mm_unpackhi_epi64(r0, r1);
+    sse_merge2(&t0, &t1);
+
+    _mm_storeu_si128((__m128i*)(block), t0);
+    _mm_storeu_si128((__m128i*)(block + 2), t1);
+}
+
+/*
+    sse_merge
+    Merge two sorted arrays, 2 keys at a time. See `avx2_merge`.
+    @param  const int64_t*  First sorted array
+    @param  size_t          Length of the first array, a multiple of 2
+    @param  const int64_t*  Second sorted array
+    @param  size_t          Length of the second array, a multiple of 2
+    @param  int64_t*        Output array
+    @return void
+*/
+__attribute__((target("sse4.2")))
+static void sse_merge(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out){
+    __m128i low = _mm_loadu_si128((const __m128i*)a);
+    __m128i high = _mm_loadu_si128((const __m128i*)b);
+    size_t ia = 2, ib = 2;
+
+    sse_merge2(&low, &high);
+    _mm_storeu_si128((__m128i*)out, low);
+    out += 2;
+
+    while(ia < na || ib < nb){
+        if(ib >= nb || (ia < na && a[ia] <= b[ib])){
+            low = _mm_loadu_si128((const __m128i*)(a + ia));
+            ia += 2;
+        }   else{
+                low = _mm_loadu_si128((const __m128i*)(b + ib));
+                ib += 2;
+        }
+
+        sse_merge2(&low, &high);
+        _mm_storeu_si128((__m128i*)out, low);
+        out += 2;
+    }
+
+    _mm_storeu_si128((__m128i*)out, high);
+}
+
+/*
+    sse_sort
+    Sort an array of keys with the SSE4.2 kernels
+    @param  int64_t*    Array to be sorted
+    @param  int64_t*    Working buffer of `n` integers
+    @param  size_t      Number of integers, a multiple of `SIMDSORT_BLOCK`
+    @return void
+*/
+__attribute__((target("sse4.2")))
+static void sse_sort(int64_t* keys, int64_t* buffer, size_t n){
+    for(size_t i = 0; i < n; i += 4){
+        sse_sort4(keys + i);
+    }
+
+    simdsort_merge_passes(keys, buffer, n, 4, sse_merge);
+}
+
+#endif // SIMDSORT_X86
+
+
+/*
+    Dispatch
+*/
+
+/*
+    simdsort_detect
+    Get the fastest kernel supported by the processor and the compiler
+    @return SimdSortIsa     Best kernel available
+*/
+SimdSortIsa simdsort_detect(){
+#ifdef SIMDSORT_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx2")){
+        return SIMDSORT_AVX2;
+    }
+    if(__builtin_cpu_supports("sse4.2")){
+        return SIMDSORT_SSE42;
+    }
+#endif
+
+    return SIMDSORT_SCALAR;
+}
+
+/*
+    simdsort_get_isa
+    Get the kernel used by the sorts, the best one available unless restricted by `simdsort_set_isa`
+    @return SimdSortIsa     Kernel in use
+*/
+SimdSortIsa simdsort_get_isa(){
+    int isa = atomic_load_explicit(&simdsort_isa, memory_order_relaxed);
+
+    if(isa < 0){
+        isa = (int)simdsort_detect();
+        atomic_store_explicit(&simdsort_isa, isa, memory_order_relaxed);
+    }
+
+    return (SimdSortIsa)isa;
+}
+
+/*
+    simdsort_set_isa
+    Restrict the sorts to a kernel. A kernel the processor does not support is replaced by the best one it supports.
+    @param  SimdSortIsa     Kernel to use
+    @return SimdSortIsa     Kernel actually used
+*/
+SimdSortIsa simdsort_set_isa(SimdSortIsa isa){
+    SimdSortIsa best = simdsort_detect();
+
+    if(isa > best){
+        isa = best;
+    }
+
+    atomic_store_explicit(&simdsort_isa, (int)isa, memory_order_relaxed);
+
+    return isa;
+}
+
+/*
+    simdsort_isa_name
+    Get the name of a kernel
+    @param  SimdSortIsa     Kernel
+    @return const char*     Name of the kernel
+*/
+const char* simdsort_isa_name(SimdSortIsa isa){
+    switch(isa){
+        case SIMDSORT_AVX2:
+            return "AVX2";
+        case SIMDSORT_SSE42:
+            return "SSE4.2";
+        default:
+            return "scalar (radix)";
+    }
+}
+
+/*
+    simdsort_padded_length
+    Round a number of keys up to a multiple of `SIMDSORT_BLOCK`
+    @param  size_t  Number of keys
+    @return size_t  Padded number of keys
+*/
+static size_t simdsort_padded_length(size_t n){
+    return (n + SIMDSORT_BLOCK - 1) / SIMDSORT_BLOCK * SIMDSORT_BLOCK;
+}
+
+/*
+    simdsort_run
+    Sort an array of keys with a kernel. For the SIMD kernels, the array must have room for the padded length and is padded here with `INT64_MAX`.
+    @param  int64_t*    Array to be sorted, with room for `simdsort_padded_length(n)` integers
+    @param  int64_t*    Working buffer of `simdsort_padded_length(n)` integers
+    @param  size_t      Number of integers
+    @param  SimdSortIsa Kernel
+    @param  unsigned    First byte sorted by the radix sort
+    @return void
+*/
+static void simdsort_run(int64_t* keys, int64_t* buffer, size_t n, SimdSortIsa isa, unsigned first_byte){
+    if(n < SIMDSORT_SMALL){
+        i64_insertionsort(keys, n);
+        return;
+    }
+
+#ifdef SIMDSORT_X86
+    if(isa != SIMDSORT_SCALAR){
+        size_t padded = simdsort_padded_length(n);
+
+        //  The padding sorts after every key, so the first `n` keys are the sorted array
+        for(size_t i = n; i < padded; i++){
+            keys[i] = INT64_MAX;
+        }
+
+        if(isa == SIMDSORT_AVX2){
+            avx2_sort(keys, buffer, padded);
+        }   else{
+                sse_sort(keys, buffer, padded);
+        }
+
+        return;
+    }
+#else
+    (void)isa;
+#endif
+
+    radix_i64(keys, buffer, n, first_byte);
+}
+
+/*
+    simdsort_i64
+    Sort an array of 64-bit integers in ascending order with the kernel in use
+    @param  int64_t*    Array to be sorted
+    @param  size_t      Number of integers
+    @return bool        true if the operation was successful, false if the allocation of the working buffer failed
+*/
+bool simdsort_i64(int64_t* keys, size_t n){
+    if(n < SIMDSORT_SMALL){
+        i64_insertionsort(keys, n);
+        return true;
+    }
+
+    size_t padded = simdsort_padded_length(n);
+    int64_t* work = (int64_t*)malloc(2 * padded * sizeof(int64_t));
+
+    if(!work){
+        return false;
+    }
+
+    memcpy(work, keys, n * sizeof(int64_t));
+    simdsort_run(work, work + padded, n, simdsort_get_isa(), 0);
+    memcpy(keys, work, n * sizeof(int64_t));
+
+    free(work);
+
+    return true;
+}
+
+/*
+    radixsort_i64
+    Sort an array of 64-bit integers in ascending order with an LSD radix sort on bytes
+    @param  int64_t*    Array to be sorted
+    @param  size_t      Number of integers
+    @return bool        true if the operation was successful, false if the allocation of the working buffer failed
+*/
+bool radixsort_i64(int64_t* keys, size_t n){
+    if(n < 2){
+        return true;
+    }
+
+    int64_t* buffer = (int64_t*)malloc(n * sizeof(int64_t));
+
+    if(!buffer){
+        return false;
+    }
+
+    radix_i64(keys, buffer, n, 0);
+    free(buffer);
+
+    return true;
+}
+
+
+/*
+    List sorts
+*/
+
+/*
+    simdsort_reserve
+    Get a working memory of `size` bytes from a scratch buffer, or allocate it
+    @param  ListSortScratch*    Scratch buffer, NULL to allocate
+    @param  size_t              Number of bytes
+    @return void*               Working memory, NULL if the allocation failed
+*/
+static void* simdsort_reserve(ListSortScratch* scratch, size_t size){
+    return scratch ? listsort_scratch_reserve(scratch, size) : malloc(size);
+}
+
+/*
+    simdsort_release
+    Release a working memory obtained with `simdsort_reserve`
+    @param  ListSortScratch*    Scratch buffer, NULL if the memory was allocated
+    @param  void*               Working memory
+    @return void
+*/
+static void simdsort_release(ListSortScratch* scratch, void* memory){
+    if(!scratch){
+        free(memory);
+    }
+}
+
+/*
+    simdsort_packed_nodes
+    Sort the nodes of a list of `n` `int` by packed keys. The nodes are given in list order; on return, `order` holds them in sorted order.
+    @param  void**              Nodes, in list order
+    @param  int64_t*            Packed keys (key * 2^32 + position), with room for the padded length
+    @param  int64_t*            Working buffer of the padded length
+    @param  size_t              Number of nodes
+    @param  void**              Receives the nodes in sorted order
+    @return void
+*/
+static void simdsort_packed_nodes(void** nodes, int64_t* packed, int64_t* buffer, size_t n, void** order){
+    //  The positions already sit in ascending order in the low half: the radix sort only needs the 4 bytes of the keys
+    simdsort_run(packed, buffer, n, simdsort_get_isa(), 4);
+
+    for(size_t i = 0; i < n; i++){
+        order[i] = nodes[(uint64_t)packed[i] & 0xFFFFFFFFULL];
+    }
+}
+
+/*
+    sll_relink
+    Relink the nodes of a singly linked list in the order of an array
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  void**              Nodes in their new order
+    @param  size_t              Number of nodes
+    @return void
+*/
+static void sll_relink(SinglyLinkedList* list, void** order, size_t n){
+    for(size_t i = 0; i + 1 < n; i++){
+        ((SLLNode*)order[i])->next = (SLLNode*)order[i + 1];
+    }
+
+    ((SLLNode*)order[n - 1])->next = NULL;
+    list->head = (SLLNode*)order[0];
+}
+
+/*
+    dll_relink
+    Relink the nodes of a doubly linked list in the order of an array
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  void**              Nodes in their new order
+    @param  size_t              Number of nodes
+    @return void
+*/
+static void dll_relink(DoublyLinkedList* list, void** order, size_t n){
+    DLLNode* prev = NULL;
+
+    for(size_t i = 0; i < n; i++){
+        DLLNode* node = (DLLNode*)order[i];
+
+        node->prev = prev;
+        if(prev){
+            prev->next = node;
+        }
+        prev = node;
+    }
+
+    prev->next = NULL;
+    list->head = (DLLNode*)order[0];
+    list->tail = prev;
+}
+
+/*
+    simdsort_int_size
+    Get the working memory of the sort of `n` `int`: packed keys and buffer of the padded length, nodes in list order and in sorted order
+    @param  size_t  Number of elements
+    @return size_t  Number of bytes
+*/
+static size_t simdsort_int_size(size_t n){
+    return 2 * simdsort_padded_length(n) * sizeof(int64_t) + 2 * n * sizeof(void*);
+}
+
+/*
+    simdsort_int64_size
+    Get the working memory of the sort of `n` `int64_t`: pairs and buffer, nodes in list order
+    @param  size_t  Number of elements
+    @return size_t  Number of bytes
+*/
+static size_t simdsort_int64_size(size_t n){
+    return 2 * n * sizeof(SimdSortPair) + n * sizeof(void*);
+}
+
+/*
+    simdsort_int64_nodes
+    Sort `n` nodes by their (key, position) pairs with the radix sort; on return, `nodes` holds them in sorted order
+    @param  void**          Nodes, in list order
+    @param  SimdSortPair*   Pairs, in list order
+    @param  SimdSortPair*   Working buffer of `n` pairs
+    @param  size_t          Number of nodes
+    @return void
+*/
+static void simdsort_int64_nodes(void** nodes, SimdSortPair* pairs, SimdSortPair* buffer, size_t n){
+    SimdSortPair* sorted = radix_pairs(pairs, buffer, n);
+
+    //  The positions of `sorted` index the nodes in list order: reuse the other pair array to hold them
+    void** order = (void**)(sorted == pairs ? buffer : pairs);
+    for(size_t i = 0; i < n; i++){
+        order[i] = nodes[sorted[i].index];
+    }
+
+    memcpy(nodes, order, n * sizeof(void*));
+}
+
+/*
+    sll_sort_int
+    Sort a singly linked list whose data point to `int`, with the kernel in use. The sort is stable.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return SinglyLinkedList*   Pointer to the list
+*/
+SinglyLinkedList* sll_sort_int(SinglyLinkedList* list, ListSortScratch* scratch){
+    if(!list || !list->head || !list->head->next){
+        return list;
+    }
+
+    size_t n = list->size;
+
+    //  Keys wider than 32 bits, or positions beyond 32 bits, do not fit in the packed keys
+    if(sizeof(int) != sizeof(int32_t) || n >= SIMDSORT_MAX_PACKED){
+        void* memory = simdsort_reserve(scratch, simdsort_int64_size(n));
+
+        if(!memory){
+            return list;
+        }
+
+        SimdSortPair* pairs = (SimdSortPair*)memory;
+        void** nodes = (void**)(pairs + 2 * n);
+        size_t i = 0;
+
+        for(SLLNode* current = list->head; current; current = current->next){
+            pairs[i].key = *(int*)current->data;
+            pairs[i].index = i;
+            nodes[i++] = current;
+        }
+
+        simdsort_int64_nodes(nodes, pairs, pairs + n, n);
+        sll_relink(list, nodes, n);
+        simdsort_release(scratch, memory);
+
+        return list;
+    }
+
+    void* memory = simdsort_reserve(scratch, simdsort_int_size(n));
+
+    if(!memory){
+        return list;
+    }
+
+    size_t padded = simdsort_padded_length(n);
+    int64_t* packed = (int64_t*)memory;
+    void** nodes = (void**)(packed + 2 * padded);
+    void** order = nodes + n;
+    size_t i = 0;
+
+    for(SLLNode* current = list->head; current; current = current->next){
+        packed[i] = (int64_t)*(int*)current->data * 4294967296LL + (int64_t)i;
+        nodes[i++] = current;
+    }
+
+    simdsort_packed_nodes(nodes, packed, packed + padded, n, order);
+    sll_relink(list, order, n);
+    simdsort_release(scratch, memory);
+
+    return list;
+}
+
+/*
+    dll_sort_int
+    Sort a doubly linked list whose data point to `int`, with the kernel in use. The sort is stable.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return DoublyLinkedList*   Pointer to the list
+*/
+DoublyLinkedList* dll_sort_int(DoublyLinkedList* list, ListSortScratch* scratch){
+    if(!list || !list->head || !list->head->next){
+        return list;
+    }
+
+    size_t n = list->size;
+
+    if(sizeof(int) != sizeof(int32_t) || n >= SIMDSORT_MAX_PACKED){
+        void* memory = simdsort_reserve(scratch, simdsort_int64_size(n));
+
+        if(!memory){
+            return list;
+        }
+
+        SimdSortPair* pairs = (SimdSortPair*)memory;
+        void** nodes = (void**)(pairs + 2 * n);
+        size_t i = 0;
+
+        for(DLLNode* current = list->head; current; current = current->next){
+            pairs[i].key = *(int*)current->data;
+            pairs[i].index = i;
+            nodes[i++] = current;
+        }
+
+        simdsort_int64_nodes(nodes, pairs, pairs + n, n);
+        dll_relink(list, nodes, n);
+        simdsort_release(scratch, memory);
+
+        return list;
+    }
+
+    void* memory = simdsort_reserve(scratch, simdsort_int_size(n));
+
+    if(!memory){
+        return list;
+    }
+
+    size_t padded = simdsort_padded_length(n);
+    int64_t* packed = (int64_t*)memory;
+    void** nodes = (void**)(packed + 2 * padded);
+    void** order = nodes + n;
+    size_t i = 0;
+
+    for(DLLNode* current = list->head; current; current = current->next){
+        packed[i] = (int64_t)*(int*)current->data * 4294967296LL + (int64_t)i;
+        nodes[i++] = current;
+    }
+
+    simdsort_packed_nodes(nodes, packed, packed + padded, n, order);
+    dll_relink(list, order, n);
+    simdsort_release(scratch, memory);
+
+    return list;
+}
+
+/*
+    sll_sort_int64
+    Sort a singly linked list whose data point to `int64_t`, with the radix sort. The sort is stable.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return SinglyLinkedList*   Pointer to the list
+*/
+SinglyLinkedList* sll_sort_int64(SinglyLinkedList* list, ListSortScratch* scratch){
+    if(!list || !list->head || !list->head->next){
+        return list;
+    }
+
+    size_t n = list->size;
+    void* memory = simdsort_reserve(scratch, simdsort_int64_size(n));
+
+    if(!memory){
+        return list;
+    }
+
+    SimdSortPair* pairs = (SimdSortPair*)memory;
+    void** nodes = (void**)(pairs + 2 * n);
+    size_t i = 0;
+
+    for(SLLNode* current = list->head; current; current = current->next){
+        pairs[i].key = *(int64_t*)current->data;
+        pairs[i].index = i;
+        nodes[i++] = current;
+    }
+
+    simdsort_int64_nodes(nodes, pairs, pairs + n, n);
+    sll_relink(list, nodes, n);
+    simdsort_release(scratch, memory);
+
+    return list;
+}
+
+/*
+    dll_sort_int64
+    Sort a doubly linked list whose data point to `int64_t`, with the radix sort. The sort is stable.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return DoublyLinkedList*   Pointer to the list
+*/
+DoublyLinkedList* dll_sort_int64(DoublyLinkedList* list, ListSortScratch* scratch){
+    if(!list || !list->head || !list->head->next){
+        return list;
+    }
+
+    size_t n = list->size;
+    void* memory = simdsort_reserve(scratch, simdsort_int64_size(n));
+
+    if(!memory){
+        return list;
+    }
+
+    SimdSortPair* pairs = (SimdSortPair*)memory;
+    void** nodes = (void**)(pairs + 2 * n);
+    size_t i = 0;
+
+    for(DLLNode* current = list->head; current; current = current->next){
+        pairs[i].key = *(int64_t*)current->data;
+        pairs[i].index = i;
+        nodes[i++] = current;
+    }
+
+    simdsort_int64_nodes(nodes, pairs, pairs + n, n);
+    dll_relink(list, nodes, n);
+    simdsort_release(scratch, memory);
+
+    return list;
+}
@@ -0,0 +1,131 @@
+#ifndef DSL_SIMDSORT_H
+#define DSL_SIMDSORT_H
+/*
+    Interface for the implementation of the vectorized sorts of integer keys.
+
+    Lists whose elements are integers are sorted without a comparison function: the keys are gathered into a contiguous array, sorted there, and the nodes are relinked in one pass.
+    For 32-bit keys, each key is packed with the position of its node into a 64-bit integer (key in the high half, position in the low half),
+    so sorting the packed integers sorts the nodes, stably, with no separate payload to move.
+
+    The arrays of 64-bit integers are sorted by one of three kernels, chosen at runtime from the features of the processor:
+    - `SIMDSORT_AVX2`: blocks of 16 keys are sorted in registers by a sorting network and bitonic merges, then merged pairwise with a 4-lane bitonic merge kernel;
+    - `SIMDSORT_SSE42`: the same with 2-lane vectors;
+    - `SIMDSORT_SCALAR`: an LSD radix sort on bytes, the fallback on other processors and compilers.
+    64-bit keys do not leave room for the position of the node, so `sll_sort_int64` and `dll_sort_int64` always use the radix sort, on (key, position) pairs.
+
+    The current methods are:
+    - `simdsort_detect`: Get the best kernel supported by the processor
+    - `simdsort_get_isa`, `simdsort_set_isa`: Get or restrict the kernel in use
+    - `simdsort_isa_name`: Get the name of a kernel
+    - `simdsort_i64`: Sort an array of 64-bit integers
+    - `radixsort_i64`: Sort an array of 64-bit integers with the radix sort
+    - `sll_sort_int`, `dll_sort_int`: Sort a list of `int`
+    - `sll_sort_int64`, `dll_sort_int64`: Sort a list of `int64_t`
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dsl_lists.h"
+#include "dsl_listsort.h"
+
+/*
+    Sorting kernel, from the most portable to the fastest
+*/
+typedef enum SimdSortIsa {
+    SIMDSORT_SCALAR,
+    SIMDSORT_SSE42,
+    SIMDSORT_AVX2
+} SimdSortIsa;
+
+/*
+    simdsort_detect
+    Get the fastest kernel supported by the processor and the compiler
+    @return SimdSortIsa     Best kernel available
+*/
+SimdSortIsa simdsort_detect();
+
+/*
+    simdsort_get_isa
+    Get the kernel used by the sorts, the best one available unless restricted by `simdsort_set_isa`
+    @return SimdSortIsa     Kernel in use
+*/
+SimdSortIsa simdsort_get_isa();
+
+/*
+    simdsort_set_isa
+    Restrict the sorts to a kernel, e.g. to compare the kernels. A kernel the processor does not support is replaced by the best one it supports.
+    The setting is shared by all threads.
+    @param  SimdSortIsa     Kernel to use
+    @return SimdSortIsa     Kernel actually used
+*/
+SimdSortIsa simdsort_set_isa(SimdSortIsa isa);
+
+/*
+    simdsort_isa_name
+    Get the name of a kernel
+    @param  SimdSortIsa     Kernel
+    @return const char*     Name of the kernel
+*/
+const char* simdsort_isa_name(SimdSortIsa isa);
+
+/*
+    simdsort_i64
+    Sort an array of 64-bit integers in ascending order with the kernel in use
+    @param  int64_t*    Array to be sorted
+    @param  size_t      Number of integers
+    @return bool        true if the operation was successful, false if the allocation of the working buffer failed (the array is unchanged)
+*/
+bool simdsort_i64(int64_t* keys, size_t n);
+
+/*
+    radixsort_i64
+    Sort an array of 64-bit integers in ascending order with an LSD radix sort on bytes; the bytes that are equal in every key are skipped
+    @param  int64_t*    Array to be sorted
+    @param  size_t      Number of integers
+    @return bool        true if the operation was successful, false if the allocation of the working buffer failed (the array is unchanged)
+*/
+bool radixsort_i64(int64_t* keys, size_t n);
+
+/*
+    sll_sort_int
+    Sort a singly linked list whose data point to `int`, with the kernel in use. The sort is stable.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts (see `dsl_listsort.h`), NULL to allocate a temporary one
+    @return SinglyLinkedList*   Pointer to the list, left unchanged if the allocation of the buffer failed
+*/
+SinglyLinkedList* sll_sort_int(SinglyLinkedList* list, ListSortScratch* scratch);
+
+/*
+    dll_sort_int
+    Sort a doubly linked list whose data point to `int`, with the kernel in use. The sort is stable.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return DoublyLinkedList*   Pointer to the list, left unchanged if the allocation of the buffer failed
+*/
+DoublyLinkedList* dll_sort_int(DoublyLinkedList* list, ListSortScratch* scratch);
+
+/*
+    sll_sort_int64
+    Sort a singly linked list whose data point to `int64_t`, with the radix sort. The sort is stable.
+    @param  SinglyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return SinglyLinkedList*   Pointer to the list, left unchanged if the allocation of the buffer failed
+*/
+SinglyLinkedList* sll_sort_int64(SinglyLinkedList* list, ListSortScratch* scratch);
+
+/*
+    dll_sort_int64
+    Sort a doubly linked list whose data point to `int64_t`, with the radix sort. The sort is stable.
+    @param  DoublyLinkedList*   Pointer to the list
+    @param  ListSortScratch*    Scratch buffer reused across sorts, NULL to allocate a temporary one
+    @return DoublyLinkedList*   Pointer to the list, left unchanged if the allocation of the buffer failed
+*/
+DoublyLinkedList* dll_sort_int64(DoublyLinkedList* list, ListSortScratch* scratch);
+
+#endif // DSL_SIMDSORT_H
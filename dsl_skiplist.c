@@ -0,0 +1,350 @@
+/*
+    Implementation of the skip list.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "dsl_skiplist.h"
+
+/*
+    skipnode_size
+    Size of a node with the given number of levels, rounded up to keep the nodes aligned in the pool chunks
+    @param  size_t  Number of levels
+    @return size_t  Size of the node in bytes
+*/
+static size_t skipnode_size(size_t level){
+    size_t size = sizeof(SkipNode) + level * sizeof(SkipNode*);
+    return (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+}
+
+/*
+    skiplist_pool_alloc
+    Allocate a node from the pool: from the free list of its level if possible, otherwise from the current chunk
+    @param  SkipListPool*   Pointer to the pool
+    @param  size_t          Number of levels of the node
+    @return SkipNode*       Pointer to the node, NULL if the allocation failed
+*/
+static SkipNode* skiplist_pool_alloc(SkipListPool* pool, size_t level){
+    SkipNode* node = pool->free_nodes[level];
+
+    if(node){
+        pool->free_nodes[level] = node->next[0];
+        return node;
+    }
+
+    size_t size = skipnode_size(level);
+
+    if(pool->remaining < size){
+        SkipListChunk* chunk = (SkipListChunk*)malloc(sizeof(SkipListChunk) + SKIPLIST_CHUNK_SIZE);
+
+        if(!chunk){
+            return NULL;
+        }
+
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+        pool->cursor = (char*)chunk->memory;
+        pool->remaining = SKIPLIST_CHUNK_SIZE;
+    }
+
+    node = (SkipNode*)pool->cursor;
+    pool->cursor += size;
+    pool->remaining -= size;
+
+    return node;
+}
+
+/*
+    skiplist_pool_free
+    Return a node to the free list of its level
+    @param  SkipListPool*   Pointer to the pool
+    @param  SkipNode*       Pointer to the node
+    @return void
+*/
+static void skiplist_pool_free(SkipListPool* pool, SkipNode* node){
+    node->next[0] = pool->free_nodes[node->level];
+    pool->free_nodes[node->level] = node;
+}
+
+/*
+    skiplist_random_level
+    Draw the number of levels of a new node: each additional level is kept with probability 1/4
+    @param  SkipList*   Pointer to the skip list
+    @return size_t      Number of levels, between 1 and `SKIPLIST_MAX_LEVEL`
+*/
+static size_t skiplist_random_level(SkipList* skl){
+    //  xorshift64*
+    skl->seed ^= skl->seed >> 12;
+    skl->seed ^= skl->seed << 25;
+    skl->seed ^= skl->seed >> 27;
+    unsigned long long bits = skl->seed * 0x2545F4914F6CDD1DULL;
+
+    size_t level = 1;
+    while(level < SKIPLIST_MAX_LEVEL && (bits & 3) == 0){
+        level++;
+        bits >>= 2;
+    }
+
+    return level;
+}
+
+/*
+    skiplist_find
+    Find, at every level, the last node whose element compares less than `data`
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be compared
+    @param  SkipNode**  Array of `SKIPLIST_MAX_LEVEL` predecessors, filled for the levels in use (may be NULL)
+    @return SkipNode*   Pointer to the first node not less than `data`, NULL if there is none
+*/
+static SkipNode* skiplist_find(SkipList* skl, void* data, SkipNode** update){
+    SkipNode* current = skl->head;
+
+    for(size_t i = skl->level; i-- > 0;){
+        while(current->next[i] && skl->compare(current->next[i]->data, data) < 0){
+            current = current->next[i];
+        }
+
+        if(update){
+            update[i] = current;
+        }
+    }
+
+    return current->next[0];
+}
+
+/*
+    skiplist_create
+    Create a new skip list
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return SkipList*                       Pointer to the new skip list, NULL if the allocation failed
+*/
+SkipList* skiplist_create(int (*compare)(void*, void*)){
+    SkipList* skl = (SkipList*)malloc(sizeof(SkipList));
+
+    if(!skl){
+        return NULL;
+    }
+
+    memset(&skl->pool, 0, sizeof(SkipListPool));
+    skl->head = skiplist_pool_alloc(&skl->pool, SKIPLIST_MAX_LEVEL);
+
+    if(!skl->head){
+        free(skl);
+        return NULL;
+    }
+
+    skl->head->data = NULL;
+    skl->head->level = SKIPLIST_MAX_LEVEL;
+    for(size_t i = 0; i < SKIPLIST_MAX_LEVEL; i++){
+        skl->head->next[i] = NULL;
+    }
+
+    skl->level = 1;
+    skl->size = 0;
+    skl->compare = compare;
+    skl->seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)(size_t)skl;
+
+    return skl;
+}
+
+/*
+    skiplist_destroy
+    Destroy a skip list, releasing the node pool chunk by chunk
+    @param  SkipList*   Pointer to the skip list
+    @return void
+*/
+void skiplist_destroy(SkipList* skl){
+    SkipListChunk* chunk = skl->pool.chunks;
+    SkipListChunk* next = NULL;
+
+    while(chunk){
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(skl);
+}
+
+/*
+    skiplist_insert
+    Insert a new element, after the elements that compare equal to it
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be stored
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool skiplist_insert(SkipList* skl, void* data){
+    SkipNode* update[SKIPLIST_MAX_LEVEL];
+    SkipNode* current = skl->head;
+
+    //  Walk past the equal elements as well, so that insertion is stable
+    for(size_t i = skl->level; i-- > 0;){
+        while(current->next[i] && skl->compare(current->next[i]->data, data) <= 0){
+            current = current->next[i];
+        }
+        update[i] = current;
+    }
+
+    size_t level = skiplist_random_level(skl);
+    SkipNode* node = skiplist_pool_alloc(&skl->pool, level);
+
+    if(!node){
+        return false;
+    }
+
+    for(size_t i = skl->level; i < level; i++){
+        update[i] = skl->head;
+    }
+    if(level > skl->level){
+        skl->level = level;
+    }
+
+    node->data = data;
+    node->level = level;
+
+    for(size_t i = 0; i < level; i++){
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+
+    skl->size++;
+
+    return true;
+}
+
+/*
+    skiplist_remove
+    Remove the first element that compares equal to the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be removed
+    @return bool        true if an element was removed, false otherwise
+*/
+bool skiplist_remove(SkipList* skl, void* data){
+    SkipNode* update[SKIPLIST_MAX_LEVEL];
+    SkipNode* node = skiplist_find(skl, data, update);
+
+    if(!node || skl->compare(node->data, data) != 0){
+        return false;
+    }
+
+    for(size_t i = 0; i < node->level; i++){
+        update[i]->next[i] = node->next[i];
+    }
+
+    while(skl->level > 1 && skl->head->next[skl->level - 1] == NULL){
+        skl->level--;
+    }
+
+    skiplist_pool_free(&skl->pool, node);
+    skl->size--;
+
+    return true;
+}
+
+/*
+    skiplist_search
+    Search for the first element that compares equal to the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be searched
+    @return SkipNode*   Pointer to the node if found, NULL otherwise
+*/
+SkipNode* skiplist_search(SkipList* skl, void* data){
+    SkipNode* node = skiplist_find(skl, data, NULL);
+
+    if(node && skl->compare(node->data, data) == 0){
+        return node;
+    }
+
+    return NULL;
+}
+
+/*
+    skiplist_lower_bound
+    Get the first element that does not compare less than the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be compared
+    @return SkipNode*   Pointer to the node, NULL if every element is less than `data`
+*/
+SkipNode* skiplist_lower_bound(SkipList* skl, void* data){
+    return skiplist_find(skl, data, NULL);
+}
+
+/*
+    skiplist_first
+    Get the first (smallest) element of a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return SkipNode*   Pointer to the first node, NULL if the list is empty
+*/
+SkipNode* skiplist_first(SkipList* skl){
+    return skl->head->next[0];
+}
+
+/*
+    skipnode_next
+    Get the next element in order
+    @param  SkipNode*   Pointer to the current node
+    @return SkipNode*   Pointer to the next node, NULL at the end of the list
+*/
+SkipNode* skipnode_next(SkipNode* node){
+    return node->next[0];
+}
+
+/*
+    skiplist_range
+    Visit, in order, the elements in the range [`low`, `high`)
+    @param  SkipList*                       Pointer to the skip list
+    @param  void*                           Pointer to the lower bound (inclusive), or NULL
+    @param  void*                           Pointer to the upper bound (exclusive), or NULL
+    @param  bool (*visit)(void*, void*)     Function called with the data of each element and `context`
+    @param  void*                           Context given to `visit`
+    @return size_t                          Number of elements visited
+*/
+size_t skiplist_range(SkipList* skl, void* low, void* high, bool (*visit)(void* data, void* context), void* context){
+    SkipNode* current = low ? skiplist_lower_bound(skl, low) : skiplist_first(skl);
+    size_t visited = 0;
+
+    while(current && (!high || skl->compare(current->data, high) < 0)){
+        visited++;
+
+        if(!visit(current->data, context)){
+            break;
+        }
+
+        current = current->next[0];
+    }
+
+    return visited;
+}
+
+/*
+    skiplist_print
+    Print the contents of a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return void
+*/
+void skiplist_print(SkipList* skl){
+    SkipNode* current = skl->head->next[0];
+
+    while(current){
+        printf("%d\n", *(int*)current->data);
+        current = current->next[0];
+    }
+}
+
+/*
+    skiplist_len
+    Get the number of elements in a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return size_t      Number of elements in the skip list
+*/
+size_t skiplist_len(SkipList* skl){
+    return skl->size;
+}
@@ -0,0 +1,198 @@
+#ifndef DSL_SKIPLIST_H
+#define DSL_SKIPLIST_H
+/*
+    Interface for the implementation of the skip list.
+
+    A `SkipList` keeps its elements ordered by a user comparator, with the same convention as the sorting functions of `dsl_listsort.h`:
+    int compare(void* a, void* b);
+    Each node has a random number of levels (a level is kept with probability 1/4); the upper levels skip over many nodes, so search, insertion and removal take O(log N) expected time, and the bottom level is an ordered singly linked list.
+
+    The forward pointers of a node are stored inline, at the end of the node, so a node is a single allocation of `sizeof(SkipNode) + level * sizeof(SkipNode*)` bytes.
+    Nodes are allocated from a pool owned by the list: large chunks are carved sequentially, freed nodes are kept on per-level free lists, and `skiplist_destroy` releases the chunks without walking the nodes.
+
+    Equal elements are allowed; a new element is inserted after the elements that compare equal to it.
+
+    The current `SkipList` methods are:
+    - `skiplist_create`: Create a new skip list
+    - `skiplist_destroy`: Destroy a skip list
+    - `skiplist_insert`: Insert a new element
+    - `skiplist_remove`: Remove the first element equal to the given one
+    - `skiplist_search`: Search for the first element equal to the given one
+    - `skiplist_lower_bound`: Get the first element not less than the given one
+    - `skiplist_first`: Get the first (smallest) element
+    - `skipnode_next`: Get the next element in order
+    - `skiplist_range`: Visit, in order, the elements of a range
+    - `skiplist_print`: Print the contents of a skip list
+    - `skiplist_len`: Get the number of elements in a skip list
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//  Maximum number of levels of a node
+#define SKIPLIST_MAX_LEVEL 32
+
+//  Size of the chunks allocated by the node pool, in bytes
+#define SKIPLIST_CHUNK_SIZE (64 * 1024)
+
+/*
+    Node of a skip list
+    - `data` is a pointer to the data stored in the node
+    - `level` is the number of forward pointers of the node
+    - `next` are the forward pointers, `next[0]` being the next node in order
+*/
+typedef struct SkipListNode {
+    void *data;
+    size_t level;
+    struct SkipListNode *next[];
+} SkipNode;
+
+/*
+    Chunk of the node pool
+    - `next` is a pointer to the previously allocated chunk
+    - `memory` is the memory carved into nodes
+*/
+typedef struct SkipListChunk {
+    struct SkipListChunk *next;
+    max_align_t memory[];
+} SkipListChunk;
+
+/*
+    Node pool of a skip list
+    - `chunks` is the list of allocated chunks, the most recent first
+    - `cursor` is the first free byte of the most recent chunk
+    - `remaining` is the number of free bytes after `cursor`
+    - `free_nodes` are the lists of freed nodes, by level (linked through `next[0]`)
+*/
+typedef struct SkipListPool {
+    SkipListChunk *chunks;
+    char *cursor;
+    size_t remaining;
+    SkipNode *free_nodes[SKIPLIST_MAX_LEVEL + 1];
+} SkipListPool;
+
+/*
+    Skip list
+    - `head` is a sentinel node with `SKIPLIST_MAX_LEVEL` levels
+    - `level` is the number of levels in use
+    - `size` is the number of elements in the list
+    - `compare` is the comparison function ordering the elements
+    - `seed` is the state of the random generator drawing the node levels
+    - `pool` is the pool the nodes are allocated from
+*/
+typedef struct SkipList {
+    SkipNode *head;
+    size_t level;
+    size_t size;
+    int (*compare)(void*, void*);
+    unsigned long long seed;
+    SkipListPool pool;
+} SkipList;
+
+//  Skip List methods
+
+/*
+    skiplist_create
+    Create a new skip list
+    @param  int (*compare)(void*, void*)    Comparison function ordering the elements
+    @return SkipList*                       Pointer to the new skip list, NULL if the allocation failed
+*/
+SkipList* skiplist_create(int (*compare)(void*, void*));
+
+/*
+    skiplist_destroy
+    Destroy a skip list, releasing the node pool chunk by chunk
+    @param  SkipList*   Pointer to the skip list
+    @return void
+*/
+void skiplist_destroy(SkipList* skl);
+
+/*
+    skiplist_insert
+    Insert a new element, after the elements that compare equal to it
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be stored
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool skiplist_insert(SkipList* skl, void* data);
+
+/*
+    skiplist_remove
+    Remove the first element that compares equal to the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be removed
+    @return bool        true if an element was removed, false otherwise
+*/
+bool skiplist_remove(SkipList* skl, void* data);
+
+/*
+    skiplist_search
+    Search for the first element that compares equal to the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be searched
+    @return SkipNode*   Pointer to the node if found, NULL otherwise
+*/
+SkipNode* skiplist_search(SkipList* skl, void* data);
+
+/*
+    skiplist_lower_bound
+    Get the first element that does not compare less than the given one
+    @param  SkipList*   Pointer to the skip list
+    @param  void*       Pointer to the data to be compared
+    @return SkipNode*   Pointer to the node, NULL if every element is less than `data`
+*/
+SkipNode* skiplist_lower_bound(SkipList* skl, void* data);
+
+/*
+    skiplist_first
+    Get the first (smallest) element of a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return SkipNode*   Pointer to the first node, NULL if the list is empty
+*/
+SkipNode* skiplist_first(SkipList* skl);
+
+/*
+    skipnode_next
+    Get the next element in order
+    @param  SkipNode*   Pointer to the current node
+    @return SkipNode*   Pointer to the next node, NULL at the end of the list
+*/
+SkipNode* skipnode_next(SkipNode* node);
+
+/*
+    skiplist_range
+    Visit, in order, the elements in the range [`low`, `high`). A NULL bound leaves that side of the range open.
+    The visit stops early when `visit` returns false.
+    @param  SkipList*                       Pointer to the skip list
+    @param  void*                           Pointer to the lower bound (inclusive), or NULL
+    @param  void*                           Pointer to the upper bound (exclusive), or NULL
+    @param  bool (*visit)(void*, void*)     Function called with the data of each element and `context`
+    @param  void*                           Context given to `visit`
+    @return size_t                          Number of elements visited
+*/
+size_t skiplist_range(SkipList* skl, void* low, void* high, bool (*visit)(void* data, void* context), void* context);
+
+/*
+    skiplist_print
+    Print the contents of a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return void
+*/
+void skiplist_print(SkipList* skl);
+
+/*
+    skiplist_len
+    Get the number of elements in a skip list
+    @param  SkipList*   Pointer to the skip list
+    @return size_t      Number of elements in the skip list
+*/
+size_t skiplist_len(SkipList* skl);
+
+#endif // DSL_SKIPLIST_H
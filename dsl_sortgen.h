@@ -0,0 +1,324 @@
+#ifndef DSL_SORTGEN_H
+#define DSL_SORTGEN_H
+/*
+    Interface for type-specialized list sorting, generated by macros.
+
+    Every sort in `dsl_listsort.c` calls `compare` through a function pointer, which the compiler cannot inline.
+    `DSL_DEFINE_SORT` instantiates the sorting algorithms for a concrete element type and comparison: the comparison is an expression expanded inside the generated functions, so it is fully inlined.
+
+    Usage:
+        DSL_DEFINE_SORT(int_sort, int, a < b)
+    generates, for lists whose `data` pointers point to `int` values:
+    - `int_sort_sll_bubblesort`, `int_sort_sll_selectionsort`, `int_sort_sll_insertionsort`: same algorithms as their `dsl_listsort.h` counterparts (the `data` pointers are swapped);
+    - `int_sort_sll_mergesort`: stable merge sort that relinks the nodes in place, without allocating;
+    - `int_sort_sll_quicksort`: quick sort on the first element as pivot, like `sll_quicksort`, but partitioning by relinking the nodes in place, without allocating;
+      it recurses into the shorter partition only, so its depth stays logarithmic even when the input makes it quadratic;
+    - `int_sort_dll_*`: the same functions for a `DoublyLinkedList`.
+
+    The comparison `less_expr` is written in terms of two values `a` and `b` of type `type` and must be true when `a` is strictly less than `b`. The generated functions take no `compare` argument and return the sorted list, like the functions of `dsl_listsort.h`.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+
+#include "dsl_lists.h"
+
+/*
+    DSL_DEFINE_SORT
+    Generate the sorting functions of `SinglyLinkedList` and `DoublyLinkedList` for elements of type `type`
+    - `name` is the prefix of the generated functions
+    - `type` is the type pointed to by the `data` pointers
+    - `less_expr` is the "strictly less than" expression, in terms of `a` and `b`
+*/
+#define DSL_DEFINE_SORT(name, type, less_expr)                                                  \
+                                                                                                \
+static inline bool name##_less(void* x, void* y){                                               \
+    type a = *(type*)x;                                                                         \
+    type b = *(type*)y;                                                                         \
+    return (less_expr);                                                                         \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* name##_sll_bubblesort(SinglyLinkedList* list){                  \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    int swapped;                                                                                \
+    SLLNode* temp;                                                                              \
+    SLLNode* end = NULL;                                                                        \
+    do{                                                                                         \
+        swapped = 0;                                                                            \
+        temp = list->head;                                                                      \
+        while(temp->next != end){                                                               \
+            if(name##_less(temp->next->data, temp->data)){                                      \
+                void* t = temp->data;                                                           \
+                temp->data = temp->next->data;                                                  \
+                temp->next->data = t;                                                           \
+                swapped = 1;                                                                    \
+            }                                                                                   \
+            temp = temp->next;                                                                  \
+        }                                                                                       \
+        end = temp;                                                                             \
+    }while(swapped);                                                                            \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* name##_sll_selectionsort(SinglyLinkedList* list){               \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(SLLNode* temp = list->head; temp->next != NULL; temp = temp->next){                     \
+        SLLNode* min = temp;                                                                    \
+        for(SLLNode* r = temp->next; r != NULL; r = r->next){                                   \
+            if(name##_less(r->data, min->data)){                                                \
+                min = r;                                                                        \
+            }                                                                                   \
+        }                                                                                       \
+        void* t = min->data;                                                                    \
+        min->data = temp->data;                                                                 \
+        temp->data = t;                                                                         \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* name##_sll_insertionsort(SinglyLinkedList* list){               \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(SLLNode* temp = list->head; temp != NULL; temp = temp->next){                           \
+        for(SLLNode* r = temp->next; r != NULL; r = r->next){                                   \
+            if(name##_less(r->data, temp->data)){                                               \
+                void* t = temp->data;                                                           \
+                temp->data = r->data;                                                           \
+                r->data = t;                                                                    \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SLLNode* name##_sllnode_mergesort(SLLNode* chain, size_t n){                      \
+    if(n < 2){                                                                                  \
+        return chain;                                                                           \
+    }                                                                                           \
+    SLLNode* cut = chain;                                                                       \
+    for(size_t i = 1; i < n / 2; i++){                                                          \
+        cut = cut->next;                                                                        \
+    }                                                                                           \
+    SLLNode* b = cut->next;                                                                     \
+    cut->next = NULL;                                                                           \
+    SLLNode* a = name##_sllnode_mergesort(chain, n / 2);                                        \
+    b = name##_sllnode_mergesort(b, n - n / 2);                                                 \
+    SLLNode head;                                                                               \
+    SLLNode* tail = &head;                                                                      \
+    while(a != NULL && b != NULL){                                                              \
+        if(!name##_less(b->data, a->data)){                                                     \
+            tail->next = a;                                                                     \
+            a = a->next;                                                                        \
+        }else{                                                                                  \
+            tail->next = b;                                                                     \
+            b = b->next;                                                                        \
+        }                                                                                       \
+        tail = tail->next;                                                                      \
+    }                                                                                           \
+    tail->next = (a != NULL) ? a : b;                                                           \
+    return head.next;                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* name##_sll_mergesort(SinglyLinkedList* list){                   \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    list->head = name##_sllnode_mergesort(list->head, list->size);                              \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SLLNode* name##_sllnode_quicksort(SLLNode* chain, SLLNode* rest){                 \
+    SLLNode* head = NULL;                                                                       \
+    SLLNode** out = &head;                                                                      \
+    while(chain != NULL){                                                                       \
+        SLLNode* pivot = chain;                                                                 \
+        SLLNode* less = NULL;                                                                   \
+        SLLNode* greater = NULL;                                                                \
+        size_t nless = 0;                                                                       \
+        size_t ngreater = 0;                                                                    \
+        for(SLLNode* node = pivot->next; node != NULL;){                                        \
+            SLLNode* next = node->next;                                                         \
+            if(name##_less(node->data, pivot->data)){                                           \
+                node->next = less;                                                              \
+                less = node;                                                                    \
+                nless++;                                                                        \
+            }else{                                                                              \
+                node->next = greater;                                                           \
+                greater = node;                                                                 \
+                ngreater++;                                                                     \
+            }                                                                                   \
+            node = next;                                                                        \
+        }                                                                                       \
+        if(nless <= ngreater){                                                                  \
+            *out = name##_sllnode_quicksort(less, pivot);                                       \
+            out = &pivot->next;                                                                 \
+            chain = greater;                                                                    \
+        }else{                                                                                  \
+            pivot->next = name##_sllnode_quicksort(greater, rest);                              \
+            rest = pivot;                                                                       \
+            chain = less;                                                                       \
+        }                                                                                       \
+    }                                                                                           \
+    *out = rest;                                                                                \
+    return head;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* name##_sll_quicksort(SinglyLinkedList* list){                   \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    list->head = name##_sllnode_quicksort(list->head, NULL);                                    \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* name##_dll_bubblesort(DoublyLinkedList* list){                  \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(DLLNode* current = list->head; current != NULL; current = current->next){              \
+        for(DLLNode* next = current->next; next != NULL; next = next->next){                    \
+            if(name##_less(next->data, current->data)){                                         \
+                void* temp = current->data;                                                     \
+                current->data = next->data;                                                     \
+                next->data = temp;                                                              \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* name##_dll_selectionsort(DoublyLinkedList* list){               \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(DLLNode* current = list->head; current->next != NULL; current = current->next){         \
+        DLLNode* min = current;                                                                 \
+        for(DLLNode* r = current->next; r != NULL; r = r->next){                                \
+            if(name##_less(r->data, min->data)){                                                \
+                min = r;                                                                        \
+            }                                                                                   \
+        }                                                                                       \
+        void* temp = min->data;                                                                 \
+        min->data = current->data;                                                              \
+        current->data = temp;                                                                   \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* name##_dll_insertionsort(DoublyLinkedList* list){               \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(DLLNode* current = list->head; current != NULL; current = current->next){              \
+        for(DLLNode* r = current->next; r != NULL; r = r->next){                                \
+            if(name##_less(r->data, current->data)){                                            \
+                void* temp = current->data;                                                     \
+                current->data = r->data;                                                        \
+                r->data = temp;                                                                 \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DLLNode* name##_dllnode_mergesort(DLLNode* chain, size_t n){                      \
+    if(n < 2){                                                                                  \
+        return chain;                                                                           \
+    }                                                                                           \
+    DLLNode* cut = chain;                                                                       \
+    for(size_t i = 1; i < n / 2; i++){                                                          \
+        cut = cut->next;                                                                        \
+    }                                                                                           \
+    DLLNode* b = cut->next;                                                                     \
+    cut->next = NULL;                                                                           \
+    DLLNode* a = name##_dllnode_mergesort(chain, n / 2);                                        \
+    b = name##_dllnode_mergesort(b, n - n / 2);                                                 \
+    DLLNode head;                                                                               \
+    DLLNode* tail = &head;                                                                      \
+    while(a != NULL && b != NULL){                                                              \
+        if(!name##_less(b->data, a->data)){                                                     \
+            tail->next = a;                                                                     \
+            a = a->next;                                                                        \
+        }else{                                                                                  \
+            tail->next = b;                                                                     \
+            b = b->next;                                                                        \
+        }                                                                                       \
+        tail = tail->next;                                                                      \
+    }                                                                                           \
+    tail->next = (a != NULL) ? a : b;                                                           \
+    return head.next;                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* name##_dll_mergesort(DoublyLinkedList* list){                   \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    list->head = name##_dllnode_mergesort(list->head, list->size);                              \
+    DLLNode* prev = NULL;                                                                       \
+    for(DLLNode* current = list->head; current != NULL; current = current->next){              \
+        current->prev = prev;                                                                   \
+        prev = current;                                                                         \
+    }                                                                                           \
+    list->tail = prev;                                                                          \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DLLNode* name##_dllnode_quicksort(DLLNode* chain, DLLNode* rest){                 \
+    DLLNode* head = NULL;                                                                       \
+    DLLNode** out = &head;                                                                      \
+    while(chain != NULL){                                                                       \
+        DLLNode* pivot = chain;                                                                 \
+        DLLNode* less = NULL;                                                                   \
+        DLLNode* greater = NULL;                                                                \
+        size_t nless = 0;                                                                       \
+        size_t ngreater = 0;                                                                    \
+        for(DLLNode* node = pivot->next; node != NULL;){                                        \
+            DLLNode* next = node->next;                                                         \
+            if(name##_less(node->data, pivot->data)){                                           \
+                node->next = less;                                                              \
+                less = node;                                                                    \
+                nless++;                                                                        \
+            }else{                                                                              \
+                node->next = greater;                                                           \
+                greater = node;                                                                 \
+                ngreater++;                                                                     \
+            }                                                                                   \
+            node = next;                                                                        \
+        }                                                                                       \
+        if(nless <= ngreater){                                                                  \
+            *out = name##_dllnode_quicksort(less, pivot);                                       \
+            out = &pivot->next;                                                                 \
+            chain = greater;                                                                    \
+        }else{                                                                                  \
+            pivot->next = name##_dllnode_quicksort(greater, rest);                              \
+            rest = pivot;                                                                       \
+            chain = less;                                                                       \
+        }                                                                                       \
+    }                                                                                           \
+    *out = rest;                                                                                \
+    return head;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* name##_dll_quicksort(DoublyLinkedList* list){                   \
+    if(list == NULL || list->head == NULL || list->head->next == NULL){                         \
+        return list;                                                                            \
+    }                                                                                           \
+    list->head = name##_dllnode_quicksort(list->head, NULL);                                    \
+    DLLNode* prev = NULL;                                                                       \
+    for(DLLNode* current = list->head; current != NULL; current = current->next){              \
+        current->prev = prev;                                                                   \
+        prev = current;                                                                         \
+    }                                                                                           \
+    list->tail = prev;                                                                          \
+    return list;                                                                                \
+}
+
+#endif // DSL_SORTGEN_H
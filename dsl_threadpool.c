@@ -0,0 +1,419 @@
+/*
+    Implementation of the work-stealing thread pool.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "dsl_threadpool.h"
+
+//  Number of failed attempts to find a task before an idle worker goes to sleep
+#define THREADPOOL_SPIN_ROUNDS 64
+
+/*
+    Task submitted to the pool
+    - `function` is the function to execute
+    - `arg` is the argument given to the function
+    - `group` is the group the task belongs to
+*/
+typedef struct ThreadPoolTask {
+    TaskFunction function;
+    void *arg;
+    TaskGroup *group;
+} ThreadPoolTask;
+
+//  Worker running on the current thread, NULL outside of any pool
+static _Thread_local ThreadPoolWorker* current_worker = NULL;
+
+/*
+    threadpool_current_worker
+    Get the worker of `pool` running on the calling thread
+    @param  ThreadPool*         Pointer to the pool
+    @return ThreadPoolWorker*   Pointer to the worker, NULL if the calling thread is not a worker of `pool`
+*/
+static ThreadPoolWorker* threadpool_current_worker(ThreadPool* pool){
+    if(current_worker && current_worker->pool == pool){
+        return current_worker;
+    }
+
+    return NULL;
+}
+
+/*
+    threadpool_take
+    Find a task to run: the worker's own deque first, then the injection queue, then the other workers' deques
+    @param  ThreadPool*         Pointer to the pool
+    @param  ThreadPoolWorker*   Pointer to the calling worker, NULL for a thread outside the pool
+    @return ThreadPoolTask*     Pointer to the task, NULL if none was found
+*/
+static ThreadPoolTask* threadpool_take(ThreadPool* pool, ThreadPoolWorker* self){
+    ThreadPoolTask* task = NULL;
+
+    if(self){
+        task = (ThreadPoolTask*)wsdeque_pop(self->deque);
+    }
+
+    if(!task && atomic_load_explicit(&pool->injected, memory_order_relaxed) > 0){
+        pthread_mutex_lock(&pool->injection_lock);
+        task = (ThreadPoolTask*)queue_dequeue(pool->injection);
+
+        if(task){
+            atomic_fetch_sub_explicit(&pool->injected, 1, memory_order_relaxed);
+        }
+
+        pthread_mutex_unlock(&pool->injection_lock);
+    }
+
+    if(!task){
+        unsigned int seed = self ? self->seed : (unsigned int)(size_t)&task;
+        size_t start = (size_t)rand_r(&seed) % pool->nthreads;
+
+        for(size_t i = 0; i < pool->nthreads && !task; i++){
+            ThreadPoolWorker* victim = &pool->workers[(start + i) % pool->nthreads];
+
+            if(victim != self){
+                task = (ThreadPoolTask*)wsdeque_steal(victim->deque);
+            }
+        }
+
+        if(self){
+            self->seed = seed;
+
+            if(task){
+                atomic_fetch_add_explicit(&self->stolen, 1, memory_order_relaxed);
+            }
+        }
+    }
+
+    if(task){
+        atomic_fetch_sub(&pool->queued, 1);
+    }
+
+    return task;
+}
+
+/*
+    threadpool_run
+    Execute a task, signal its group and free it
+    @param  ThreadPoolTask*     Pointer to the task
+    @param  ThreadPoolWorker*   Pointer to the calling worker, NULL for a thread outside the pool
+    @return void
+*/
+static void threadpool_run(ThreadPoolTask* task, ThreadPoolWorker* self){
+    TaskGroup* group = task->group;
+
+    task->function(task->arg);
+    free(task);
+
+    if(self){
+        atomic_fetch_add_explicit(&self->executed, 1, memory_order_relaxed);
+    }
+
+    atomic_fetch_sub_explicit(&group->pending, 1, memory_order_release);
+}
+
+/*
+    threadpool_worker_main
+    Main loop of a worker thread
+    @param  void*   Pointer to the worker
+    @return void*   NULL
+*/
+static void* threadpool_worker_main(void* arg){
+    ThreadPoolWorker* self = (ThreadPoolWorker*)arg;
+    ThreadPool* pool = self->pool;
+    int idle = 0;
+
+    current_worker = self;
+
+    while(!atomic_load(&pool->stop)){
+        ThreadPoolTask* task = threadpool_take(pool, self);
+
+        if(task){
+            threadpool_run(task, self);
+            idle = 0;
+            continue;
+        }
+
+        if(++idle < THREADPOOL_SPIN_ROUNDS){
+            sched_yield();
+            continue;
+        }
+
+        //  Park until a task is submitted. `sleepers` is raised before `queued` is checked, and
+        //  `threadpool_submit` raises `queued` before it checks `sleepers`, so no wakeup is lost.
+        pthread_mutex_lock(&pool->sleep_lock);
+        atomic_fetch_add(&pool->sleepers, 1);
+        while(atomic_load(&pool->queued) == 0 && !atomic_load(&pool->stop)){
+            pthread_cond_wait(&pool->wakeup, &pool->sleep_lock);
+        }
+        atomic_fetch_sub(&pool->sleepers, 1);
+        pthread_mutex_unlock(&pool->sleep_lock);
+        idle = 0;
+    }
+
+    current_worker = NULL;
+
+    return NULL;
+}
+
+/*
+    threadpool_release
+    Stop and join the first `started` workers, then free every resource of the pool, including the tasks that were never started
+    @param  ThreadPool*     Pointer to the pool
+    @param  size_t          Number of worker threads that were started
+    @return void
+*/
+static void threadpool_release(ThreadPool* pool, size_t started){
+    atomic_store(&pool->stop, true);
+
+    pthread_mutex_lock(&pool->sleep_lock);
+    pthread_cond_broadcast(&pool->wakeup);
+    pthread_mutex_unlock(&pool->sleep_lock);
+
+    for(size_t i = 0; i < started; i++){
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    ThreadPoolTask* task = NULL;
+
+    for(size_t i = 0; i < pool->nthreads; i++){
+        if(!pool->workers[i].deque){
+            continue;
+        }
+
+        while((task = (ThreadPoolTask*)wsdeque_pop(pool->workers[i].deque))){
+            free(task);
+        }
+        wsdeque_destroy(pool->workers[i].deque);
+    }
+
+    while((task = (ThreadPoolTask*)queue_dequeue(pool->injection))){
+        free(task);
+    }
+    queue_destroy(pool->injection);
+
+    pthread_mutex_destroy(&pool->injection_lock);
+    pthread_mutex_destroy(&pool->sleep_lock);
+    pthread_cond_destroy(&pool->wakeup);
+
+    free(pool->workers);
+    free(pool);
+}
+
+/*
+    taskgroup_init
+    Initialize an empty task group
+    @param  TaskGroup*  Pointer to the group
+    @return void
+*/
+void taskgroup_init(TaskGroup* group){
+    atomic_init(&group->pending, 0);
+}
+
+/*
+    threadpool_create
+    Create a new thread pool
+    @param  size_t          Number of worker threads, 0 to use the number of online processors
+    @return ThreadPool*     Pointer to the new pool, NULL if the creation failed
+*/
+ThreadPool* threadpool_create(size_t nthreads){
+    if(nthreads == 0){
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (size_t)online : 1;
+    }
+
+    ThreadPool* pool = (ThreadPool*)malloc(sizeof(ThreadPool));
+
+    if(!pool){
+        return NULL;
+    }
+
+    pool->nthreads = nthreads;
+    pool->workers = (ThreadPoolWorker*)calloc(nthreads, sizeof(ThreadPoolWorker));
+    pool->injection = queue_create();
+
+    if(!pool->workers || !pool->injection){
+        free(pool->workers);
+        if(pool->injection){
+            queue_destroy(pool->injection);
+        }
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->injection_lock, NULL);
+    pthread_mutex_init(&pool->sleep_lock, NULL);
+    pthread_cond_init(&pool->wakeup, NULL);
+    atomic_init(&pool->injected, 0);
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->stop, false);
+
+    for(size_t i = 0; i < nthreads; i++){
+        ThreadPoolWorker* worker = &pool->workers[i];
+
+        worker->pool = pool;
+        worker->index = i;
+        worker->seed = (unsigned int)(i * 2654435761u + 1);
+        worker->deque = wsdeque_create(256);
+        atomic_init(&worker->executed, 0);
+        atomic_init(&worker->stolen, 0);
+    }
+
+    //  Every deque must exist before any worker starts stealing
+    for(size_t i = 0; i < nthreads; i++){
+        if(!pool->workers[i].deque){
+            threadpool_release(pool, 0);
+            return NULL;
+        }
+    }
+
+    for(size_t i = 0; i < nthreads; i++){
+        if(pthread_create(&pool->workers[i].thread, NULL, threadpool_worker_main, &pool->workers[i]) != 0){
+            threadpool_release(pool, i);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+/*
+    threadpool_destroy
+    Stop and join the workers and destroy the pool
+    @param  ThreadPool*     Pointer to the pool
+    @return void
+*/
+void threadpool_destroy(ThreadPool* pool){
+    threadpool_release(pool, pool->nthreads);
+}
+
+/*
+    threadpool_submit
+    Submit a task to the pool
+    @param  ThreadPool*     Pointer to the pool
+    @param  TaskGroup*      Pointer to the group the task belongs to
+    @param  TaskFunction    Function to execute
+    @param  void*           Argument given to the function
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool threadpool_submit(ThreadPool* pool, TaskGroup* group, TaskFunction function, void* arg){
+    ThreadPoolTask* task = (ThreadPoolTask*)malloc(sizeof(ThreadPoolTask));
+
+    if(!task){
+        return false;
+    }
+
+    task->function = function;
+    task->arg = arg;
+    task->group = group;
+
+    //  The group must account for the task before anyone can run it
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+
+    ThreadPoolWorker* self = threadpool_current_worker(pool);
+    bool pushed;
+
+    if(self){
+        pushed = wsdeque_push(self->deque, task);
+    }   else{
+            pthread_mutex_lock(&pool->injection_lock);
+            pushed = queue_enqueue(pool->injection, task);
+
+            if(pushed){
+                atomic_fetch_add_explicit(&pool->injected, 1, memory_order_relaxed);
+            }
+
+            pthread_mutex_unlock(&pool->injection_lock);
+    }
+
+    if(!pushed){
+        atomic_fetch_sub_explicit(&group->pending, 1, memory_order_relaxed);
+        free(task);
+        return false;
+    }
+
+    atomic_fetch_add(&pool->queued, 1);
+
+    if(atomic_load(&pool->sleepers) > 0){
+        pthread_mutex_lock(&pool->sleep_lock);
+        pthread_cond_signal(&pool->wakeup);
+        pthread_mutex_unlock(&pool->sleep_lock);
+    }
+
+    return true;
+}
+
+/*
+    threadpool_wait
+    Wait until every task of a group has finished. A worker executes pending tasks in the meantime
+    @param  ThreadPool*     Pointer to the pool
+    @param  TaskGroup*      Pointer to the group
+    @return void
+*/
+void threadpool_wait(ThreadPool* pool, TaskGroup* group){
+    ThreadPoolWorker* self = threadpool_current_worker(pool);
+
+    while(atomic_load_explicit(&group->pending, memory_order_acquire) > 0){
+        //  Only workers help: a thread outside the pool leaves the tasks to the workers
+        ThreadPoolTask* task = self ? threadpool_take(pool, self) : NULL;
+
+        if(task){
+            threadpool_run(task, self);
+        }   else{
+                sched_yield();
+        }
+    }
+}
+
+/*
+    threadpool_size
+    Get the number of worker threads of a pool
+    @param  ThreadPool*     Pointer to the pool
+    @return size_t          Number of worker threads
+*/
+size_t threadpool_size(ThreadPool* pool){
+    return pool->nthreads;
+}
+
+/*
+    threadpool_executed
+    Get the number of tasks executed by a worker since the last reset
+    @param  ThreadPool*     Pointer to the pool
+    @param  size_t          Index of the worker
+    @return size_t          Number of tasks executed
+*/
+size_t threadpool_executed(ThreadPool* pool, size_t worker){
+    return atomic_load_explicit(&pool->workers[worker].executed, memory_order_relaxed);
+}
+
+/*
+    threadpool_stolen
+    Get the number of tasks a worker stole from other workers since the last reset
+    @param  ThreadPool*     Pointer to the pool
+    @param  size_t          Index of the worker
+    @return size_t          Number of tasks stolen
+*/
+size_t threadpool_stolen(ThreadPool* pool, size_t worker){
+    return atomic_load_explicit(&pool->workers[worker].stolen, memory_order_relaxed);
+}
+
+/*
+    threadpool_reset_stats
+    Reset the per-worker counters of a pool
+    @param  ThreadPool*     Pointer to the pool
+    @return void
+*/
+void threadpool_reset_stats(ThreadPool* pool){
+    for(size_t i = 0; i < pool->nthreads; i++){
+        atomic_store_explicit(&pool->workers[i].executed, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool->workers[i].stolen, 0, memory_order_relaxed);
+    }
+}
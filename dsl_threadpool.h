@@ -0,0 +1,171 @@
+#ifndef DSL_THREADPOOL_H
+#define DSL_THREADPOOL_H
+/*
+    Interface for a work-stealing thread pool built on the `WSDeque` from `dsl_wsdeque.h`.
+
+    Each worker thread owns a `WSDeque`. Tasks submitted from a worker are pushed at the bottom of its own deque and popped back in LIFO order, which keeps recursive (fork-join) workloads cache friendly. Idle workers steal from the top of a random victim's deque, so unbalanced task trees spread over all the workers.
+    Tasks submitted from outside the pool go through a shared injection `Queue` (see `dsl_lists.h`).
+
+    Tasks are grouped in a `TaskGroup`: `threadpool_wait` blocks until every task of a group has finished. A worker that waits runs pending tasks of the pool in the meantime instead of blocking, which makes it safe to wait from inside a task, e.g. in a parallel divide and conquer sort.
+
+    The current `ThreadPool` methods are:
+    - `threadpool_create`: Create a new thread pool
+    - `threadpool_destroy`: Destroy a thread pool
+    - `threadpool_submit`: Submit a task to the pool
+    - `threadpool_wait`: Wait for every task of a group to finish
+    - `threadpool_size`: Get the number of worker threads
+    - `threadpool_executed`: Get the number of tasks executed by a worker
+    - `threadpool_stolen`: Get the number of tasks stolen by a worker
+    - `threadpool_reset_stats`: Reset the per-worker counters
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "dsl_lists.h"
+#include "dsl_wsdeque.h"
+
+/*
+    Task function executed by the pool
+    - `arg` is the pointer given to `threadpool_submit`
+*/
+typedef void (*TaskFunction)(void* arg);
+
+/*
+    Group of tasks that can be waited on
+    - `pending` is the number of submitted tasks that have not finished yet
+*/
+typedef struct TaskGroup {
+    atomic_size_t pending;
+} TaskGroup;
+
+/*
+    Worker of a thread pool
+    - `pool` is a pointer to the pool that owns the worker
+    - `deque` is the work-stealing deque owned by the worker
+    - `thread` is the thread running the worker
+    - `index` is the index of the worker in the pool
+    - `seed` is the state of the random generator used to pick victims
+    - `executed` is the number of tasks executed by the worker
+    - `stolen` is the number of tasks stolen by the worker from other workers
+*/
+typedef struct ThreadPoolWorker {
+    struct ThreadPool *pool;
+    WSDeque *deque;
+    pthread_t thread;
+    size_t index;
+    unsigned int seed;
+    atomic_size_t executed;
+    atomic_size_t stolen;
+} ThreadPoolWorker;
+
+/*
+    Thread pool
+    - `nthreads` is the number of worker threads
+    - `workers` is the array of workers
+    - `injection` is the queue of tasks submitted from outside the pool
+    - `injection_lock` protects `injection`
+    - `injected` is the number of tasks of `injection`, updated under `injection_lock` and read without it to skip an empty queue
+    - `queued` is the number of tasks submitted but not yet taken by a thread
+    - `sleepers` is the number of workers waiting on `wakeup`
+    - `stop` is set when the pool is being destroyed
+    - `sleep_lock` and `wakeup` are used to park idle workers
+*/
+typedef struct ThreadPool {
+    size_t nthreads;
+    ThreadPoolWorker *workers;
+    Queue *injection;
+    pthread_mutex_t injection_lock;
+    atomic_size_t injected;
+    atomic_size_t queued;
+    atomic_size_t sleepers;
+    atomic_bool stop;
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wakeup;
+} ThreadPool;
+
+/*
+    taskgroup_init
+    Initialize an empty task group
+    @param  TaskGroup*  Pointer to the group
+    @return void
+*/
+void taskgroup_init(TaskGroup* group);
+
+/*
+    threadpool_create
+    Create a new thread pool
+    @param  size_t          Number of worker threads, 0 to use the number of online processors
+    @return ThreadPool*     Pointer to the new pool, NULL if the creation failed
+*/
+ThreadPool* threadpool_create(size_t nthreads);
+
+/*
+    threadpool_destroy
+    Stop and join the workers and destroy the pool. Tasks that were never started are discarded, so every group should be waited on before.
+    @param  ThreadPool*     Pointer to the pool
+    @return void
+*/
+void threadpool_destroy(ThreadPool* pool);
+
+/*
+    threadpool_submit
+    Submit a task to the pool. From a worker thread, the task is pushed on the worker's own deque.
+    @param  ThreadPool*     Pointer to the pool
+    @param  TaskGroup*      Pointer to the group the task belongs to
+    @param  TaskFunction    Function to execute
+    @param  void*           Argument given to the function
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool threadpool_submit(ThreadPool* pool, TaskGroup* group, TaskFunction function, void* arg);
+
+/*
+    threadpool_wait
+    Wait until every task of a group has finished. When called from a worker (i.e. from inside a task), the worker executes pending tasks while it waits.
+    @param  ThreadPool*     Pointer to the pool
+    @param  TaskGroup*      Pointer to the group
+    @return void
+*/
+void threadpool_wait(ThreadPool* pool, TaskGroup* group);
+
+/*
+    threadpool_size
+    Get the number of worker threads of a pool
+    @param  ThreadPool*     Pointer to the pool
+    @return size_t          Number of worker threads
+*/
+size_t threadpool_size(ThreadPool* pool);
+
+/*
+    threadpool_executed
+    Get the number of tasks executed by a worker since the last reset
+    @param  ThreadPool*     Pointer to the pool
+    @param  size_t          Index of the worker
+    @return size_t          Number of tasks executed
+*/
+size_t threadpool_executed(ThreadPool* pool, size_t worker);
+
+/*
+    threadpool_stolen
+    Get the number of tasks a worker stole from other workers since the last reset
+    @param  ThreadPool*     Pointer to the pool
+    @param  size_t          Index of the worker
+    @return size_t          Number of tasks stolen
+*/
+size_t threadpool_stolen(ThreadPool* pool, size_t worker);
+
+/*
+    threadpool_reset_stats
+    Reset the per-worker counters of a pool
+    @param  ThreadPool*     Pointer to the pool
+    @return void
+*/
+void threadpool_reset_stats(ThreadPool* pool);
+
+#endif // DSL_THREADPOOL_H
@@ -0,0 +1,440 @@
+#ifndef DSL_TYPED_LISTS_H
+#define DSL_TYPED_LISTS_H
+/*
+    Interface for list variants that store their values inline in the nodes.
+
+    The lists in `dsl_lists.h` store a `void*` pointer in every node, so each element costs two allocations (the node and the value) and every comparison goes through a function pointer and two dereferences.
+    The macros below generate, for a given element type, a singly or doubly linked list whose nodes embed the value itself:
+    - one allocation per element;
+    - the comparison is an expression expanded inside the generated functions, so the compiler can inline it.
+
+    The generic `void*` lists of `dsl_lists.h` are not affected. `<prefix>_to_sll` and `<prefix>_to_dll` build a generic list whose `data` pointers point to the values stored in the typed nodes, so every function of `dsl_lists.h` and `dsl_listsort.h` remains available on typed data.
+
+    Usage:
+        DSL_DEFINE_TYPED_SLL(int_sll, int, DSL_COMPARE_SCALAR(a, b))
+    generates the types `int_sll_node` and `int_sll_list` and the functions:
+    - `int_sll_create`: Create a new list
+    - `int_sll_destroy`: Destroy a list
+    - `int_sll_insert`: Insert a new value at the beginning of the list
+    - `int_sll_append`: Append a new value at the end of the list
+    - `int_sll_remove`: Remove the first node whose value compares equal to the given one
+    - `int_sll_search`: Search for the first node whose value compares equal to the given one
+    - `int_sll_len`: Get the number of nodes in the list
+    - `int_sll_sort`: Sort the list with a stable merge sort, relinking the nodes
+    - `int_sll_to_sll`: Build a generic `SinglyLinkedList` pointing to the values of the list, NULL if an allocation failed
+    `DSL_DEFINE_TYPED_DLL` generates the same functions (with `_to_dll`) for a doubly linked list.
+
+    The comparison expression is written in terms of two values `a` and `b` of the element type and must evaluate to a negative integer, 0 or a positive integer, like the `compare` functions of `dsl_listsort.h`.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "dsl_lists.h"
+
+/*
+    DSL_COMPARE_SCALAR
+    Three-way comparison of two scalar values, without the overflow of `a - b`
+*/
+#define DSL_COMPARE_SCALAR(a, b) (((a) > (b)) - ((a) < (b)))
+
+/*
+    DSL_DEFINE_TYPED_SLL
+    Generate a singly linked list storing values of type `type` inline
+    - `prefix` is the prefix of the generated types and functions
+    - `type` is the type of the values
+    - `compare_expr` is the comparison expression, in terms of `a` and `b`
+*/
+#define DSL_DEFINE_TYPED_SLL(prefix, type, compare_expr)                                        \
+                                                                                                \
+typedef struct prefix##_node {                                                                  \
+    struct prefix##_node *next;                                                                 \
+    type value;                                                                                 \
+} prefix##_node;                                                                                \
+                                                                                                \
+typedef struct prefix##_list {                                                                  \
+    prefix##_node *head;                                                                        \
+    prefix##_node *tail;                                                                        \
+    size_t size;                                                                                \
+} prefix##_list;                                                                                \
+                                                                                                \
+static inline int prefix##_compare(type a, type b){                                             \
+    return (compare_expr);                                                                      \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_list* prefix##_create(void){                                             \
+    prefix##_list* list = (prefix##_list*)malloc(sizeof(prefix##_list));                        \
+    if(!list){                                                                                  \
+        return NULL;                                                                            \
+    }                                                                                           \
+    list->head = NULL;                                                                          \
+    list->tail = NULL;                                                                          \
+    list->size = 0;                                                                             \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline void prefix##_destroy(prefix##_list* list){                                       \
+    prefix##_node* current = list->head;                                                        \
+    prefix##_node* next = NULL;                                                                 \
+    while(current){                                                                             \
+        next = current->next;                                                                   \
+        free(current);                                                                          \
+        current = next;                                                                         \
+    }                                                                                           \
+    free(list);                                                                                 \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_insert(prefix##_list* list, type value){                            \
+    prefix##_node* node = (prefix##_node*)malloc(sizeof(prefix##_node));                        \
+    if(!node){                                                                                  \
+        return false;                                                                           \
+    }                                                                                           \
+    node->value = value;                                                                        \
+    node->next = list->head;                                                                    \
+    list->head = node;                                                                          \
+    if(!list->tail){                                                                            \
+        list->tail = node;                                                                      \
+    }                                                                                           \
+    list->size++;                                                                               \
+    return true;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_append(prefix##_list* list, type value){                            \
+    prefix##_node* node = (prefix##_node*)malloc(sizeof(prefix##_node));                        \
+    if(!node){                                                                                  \
+        return false;                                                                           \
+    }                                                                                           \
+    node->value = value;                                                                        \
+    node->next = NULL;                                                                          \
+    if(list->tail){                                                                             \
+        list->tail->next = node;                                                                \
+    }   else{                                                                                   \
+            list->head = node;                                                                  \
+    }                                                                                           \
+    list->tail = node;                                                                          \
+    list->size++;                                                                               \
+    return true;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_remove(prefix##_list* list, type value){                            \
+    prefix##_node* current = list->head;                                                        \
+    prefix##_node* previous = NULL;                                                             \
+    while(current){                                                                             \
+        if(prefix##_compare(current->value, value) == 0){                                       \
+            if(previous){                                                                       \
+                previous->next = current->next;                                                 \
+            }   else{                                                                           \
+                    list->head = current->next;                                                 \
+            }                                                                                   \
+            if(list->tail == current){                                                          \
+                list->tail = previous;                                                          \
+            }                                                                                   \
+            free(current);                                                                      \
+            list->size--;                                                                       \
+            return true;                                                                        \
+        }                                                                                       \
+        previous = current;                                                                     \
+        current = current->next;                                                                \
+    }                                                                                           \
+    return false;                                                                               \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_node* prefix##_search(prefix##_list* list, type value){                  \
+    prefix##_node* current = list->head;                                                        \
+    while(current){                                                                             \
+        if(prefix##_compare(current->value, value) == 0){                                       \
+            return current;                                                                     \
+        }                                                                                       \
+        current = current->next;                                                                \
+    }                                                                                           \
+    return NULL;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline size_t prefix##_len(prefix##_list* list){                                         \
+    return list->size;                                                                          \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_node* prefix##_merge(prefix##_node* a, prefix##_node* b,                 \
+                                            prefix##_node** tail){                              \
+    prefix##_node head;                                                                         \
+    prefix##_node* last = &head;                                                                \
+    while(a && b){                                                                              \
+        if(prefix##_compare(a->value, b->value) <= 0){                                          \
+            last->next = a;                                                                     \
+            a = a->next;                                                                        \
+        }   else{                                                                               \
+                last->next = b;                                                                 \
+                b = b->next;                                                                    \
+        }                                                                                       \
+        last = last->next;                                                                      \
+    }                                                                                           \
+    last->next = a ? a : b;                                                                     \
+    while(last->next){                                                                          \
+        last = last->next;                                                                      \
+    }                                                                                           \
+    *tail = last;                                                                               \
+    return head.next;                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_list* prefix##_sort(prefix##_list* list){                                \
+    /*  Bottom-up merge sort: runs of `width` nodes are merged pairwise, doubling `width` */    \
+    if(list->size < 2){                                                                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(size_t width = 1; width < list->size; width *= 2){                                      \
+        prefix##_node head;                                                                     \
+        prefix##_node* last = &head;                                                            \
+        prefix##_node* rest = list->head;                                                       \
+        while(rest){                                                                            \
+            prefix##_node* left = rest;                                                         \
+            prefix##_node* right = NULL;                                                        \
+            prefix##_node* cut = left;                                                          \
+            for(size_t i = 1; i < width && cut->next; i++){                                     \
+                cut = cut->next;                                                                \
+            }                                                                                   \
+            right = cut->next;                                                                  \
+            cut->next = NULL;                                                                   \
+            cut = right;                                                                        \
+            for(size_t i = 1; i < width && cut && cut->next; i++){                              \
+                cut = cut->next;                                                                \
+            }                                                                                   \
+            rest = NULL;                                                                        \
+            if(cut){                                                                            \
+                rest = cut->next;                                                               \
+                cut->next = NULL;                                                               \
+            }                                                                                   \
+            prefix##_node* merged_tail = NULL;                                                  \
+            last->next = prefix##_merge(left, right, &merged_tail);                             \
+            last = merged_tail;                                                                 \
+        }                                                                                       \
+        list->head = head.next;                                                                 \
+        list->tail = last;                                                                      \
+    }                                                                                           \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline SinglyLinkedList* prefix##_to_sll(prefix##_list* list){                           \
+    /*  The nodes are linked through a tail pointer: `sll_append` would walk the list */        \
+    SinglyLinkedList* sll = sll_create();                                                       \
+    if(!sll){                                                                                   \
+        return NULL;                                                                            \
+    }                                                                                           \
+    SLLNode** last = &sll->head;                                                                \
+    for(prefix##_node* current = list->head; current; current = current->next){                \
+        SLLNode* node = sllnode_create(&current->value);                                        \
+        if(!node){                                                                              \
+            sll_destroy(sll);                                                                   \
+            return NULL;                                                                        \
+        }                                                                                       \
+        *last = node;                                                                           \
+        last = &node->next;                                                                     \
+        sll->size++;                                                                            \
+    }                                                                                           \
+    return sll;                                                                                 \
+}
+
+
+/*
+    DSL_DEFINE_TYPED_DLL
+    Generate a doubly linked list storing values of type `type` inline
+    - `prefix` is the prefix of the generated types and functions
+    - `type` is the type of the values
+    - `compare_expr` is the comparison expression, in terms of `a` and `b`
+*/
+#define DSL_DEFINE_TYPED_DLL(prefix, type, compare_expr)                                        \
+                                                                                                \
+typedef struct prefix##_node {                                                                  \
+    struct prefix##_node *next;                                                                 \
+    struct prefix##_node *prev;                                                                 \
+    type value;                                                                                 \
+} prefix##_node;                                                                                \
+                                                                                                \
+typedef struct prefix##_list {                                                                  \
+    prefix##_node *head;                                                                        \
+    prefix##_node *tail;                                                                        \
+    size_t size;                                                                                \
+} prefix##_list;                                                                                \
+                                                                                                \
+static inline int prefix##_compare(type a, type b){                                             \
+    return (compare_expr);                                                                      \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_list* prefix##_create(void){                                             \
+    prefix##_list* list = (prefix##_list*)malloc(sizeof(prefix##_list));                        \
+    if(!list){                                                                                  \
+        return NULL;                                                                            \
+    }                                                                                           \
+    list->head = NULL;                                                                          \
+    list->tail = NULL;                                                                          \
+    list->size = 0;                                                                             \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline void prefix##_destroy(prefix##_list* list){                                       \
+    prefix##_node* current = list->head;                                                        \
+    prefix##_node* next = NULL;                                                                 \
+    while(current){                                                                             \
+        next = current->next;                                                                   \
+        free(current);                                                                          \
+        current = next;                                                                         \
+    }                                                                                           \
+    free(list);                                                                                 \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_insert(prefix##_list* list, type value){                            \
+    prefix##_node* node = (prefix##_node*)malloc(sizeof(prefix##_node));                        \
+    if(!node){                                                                                  \
+        return false;                                                                           \
+    }                                                                                           \
+    node->value = value;                                                                        \
+    node->prev = NULL;                                                                          \
+    node->next = list->head;                                                                    \
+    if(list->head){                                                                             \
+        list->head->prev = node;                                                                \
+    }   else{                                                                                   \
+            list->tail = node;                                                                  \
+    }                                                                                           \
+    list->head = node;                                                                          \
+    list->size++;                                                                               \
+    return true;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_append(prefix##_list* list, type value){                            \
+    prefix##_node* node = (prefix##_node*)malloc(sizeof(prefix##_node));                        \
+    if(!node){                                                                                  \
+        return false;                                                                           \
+    }                                                                                           \
+    node->value = value;                                                                        \
+    node->next = NULL;                                                                          \
+    node->prev = list->tail;                                                                    \
+    if(list->tail){                                                                             \
+        list->tail->next = node;                                                                \
+    }   else{                                                                                   \
+            list->head = node;                                                                  \
+    }                                                                                           \
+    list->tail = node;                                                                          \
+    list->size++;                                                                               \
+    return true;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline bool prefix##_remove(prefix##_list* list, type value){                            \
+    prefix##_node* current = list->head;                                                        \
+    while(current){                                                                             \
+        if(prefix##_compare(current->value, value) == 0){                                       \
+            if(current->prev){                                                                  \
+                current->prev->next = current->next;                                            \
+            }   else{                                                                           \
+                    list->head = current->next;                                                 \
+            }                                                                                   \
+            if(current->next){                                                                  \
+                current->next->prev = current->prev;                                            \
+            }   else{                                                                           \
+                    list->tail = current->prev;                                                 \
+            }                                                                                   \
+            free(current);                                                                      \
+            list->size--;                                                                       \
+            return true;                                                                        \
+        }                                                                                       \
+        current = current->next;                                                                \
+    }                                                                                           \
+    return false;                                                                               \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_node* prefix##_search(prefix##_list* list, type value){                  \
+    prefix##_node* current = list->head;                                                        \
+    while(current){                                                                             \
+        if(prefix##_compare(current->value, value) == 0){                                       \
+            return current;                                                                     \
+        }                                                                                       \
+        current = current->next;                                                                \
+    }                                                                                           \
+    return NULL;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline size_t prefix##_len(prefix##_list* list){                                         \
+    return list->size;                                                                          \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_node* prefix##_merge(prefix##_node* a, prefix##_node* b,                 \
+                                            prefix##_node** tail){                              \
+    prefix##_node head;                                                                         \
+    prefix##_node* last = &head;                                                                \
+    while(a && b){                                                                              \
+        if(prefix##_compare(a->value, b->value) <= 0){                                          \
+            last->next = a;                                                                     \
+            a = a->next;                                                                        \
+        }   else{                                                                               \
+                last->next = b;                                                                 \
+                b = b->next;                                                                    \
+        }                                                                                       \
+        last = last->next;                                                                      \
+    }                                                                                           \
+    last->next = a ? a : b;                                                                     \
+    while(last->next){                                                                          \
+        last = last->next;                                                                      \
+    }                                                                                           \
+    *tail = last;                                                                               \
+    return head.next;                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline prefix##_list* prefix##_sort(prefix##_list* list){                                \
+    /*  Bottom-up merge sort on `next`, then one pass to rebuild `prev` */                      \
+    if(list->size < 2){                                                                         \
+        return list;                                                                            \
+    }                                                                                           \
+    for(size_t width = 1; width < list->size; width *= 2){                                      \
+        prefix##_node head;                                                                     \
+        prefix##_node* last = &head;                                                            \
+        prefix##_node* rest = list->head;                                                       \
+        while(rest){                                                                            \
+            prefix##_node* left = rest;                                                         \
+            prefix##_node* right = NULL;                                                        \
+            prefix##_node* cut = left;                                                          \
+            for(size_t i = 1; i < width && cut->next; i++){                                     \
+                cut = cut->next;                                                                \
+            }                                                                                   \
+            right = cut->next;                                                                  \
+            cut->next = NULL;                                                                   \
+            cut = right;                                                                        \
+            for(size_t i = 1; i < width && cut && cut->next; i++){                              \
+                cut = cut->next;                                                                \
+            }                                                                                   \
+            rest = NULL;                                                                        \
+            if(cut){                                                                            \
+                rest = cut->next;                                                               \
+                cut->next = NULL;                                                               \
+            }                                                                                   \
+            prefix##_node* merged_tail = NULL;                                                  \
+            last->next = prefix##_merge(left, right, &merged_tail);                             \
+            last = merged_tail;                                                                 \
+        }                                                                                       \
+        list->head = head.next;                                                                 \
+    }                                                                                           \
+    prefix##_node* prev = NULL;                                                                 \
+    for(prefix##_node* current = list->head; current; current = current->next){                \
+        current->prev = prev;                                                                   \
+        prev = current;                                                                         \
+    }                                                                                           \
+    list->tail = prev;                                                                          \
+    return list;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline DoublyLinkedList* prefix##_to_dll(prefix##_list* list){                           \
+    DoublyLinkedList* dll = dll_create();                                                       \
+    if(!dll){                                                                                   \
+        return NULL;                                                                            \
+    }                                                                                           \
+    for(prefix##_node* current = list->head; current; current = current->next){                \
+        if(!dll_append(dll, &current->value)){                                                  \
+            dll_destroy(dll);                                                                   \
+            return NULL;                                                                        \
+        }                                                                                       \
+    }                                                                                           \
+    return dll;                                                                                 \
+}
+
+#endif // DSL_TYPED_LISTS_H
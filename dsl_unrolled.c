@@ -0,0 +1,289 @@
+/*
+    Implementation of the unrolled linked list.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "dsl_unrolled.h"
+
+/*
+    ullnode_create
+    Create a new, empty, unrolled linked list node
+    @param  void
+    @return ULLNode*    Pointer to the new node
+*/
+ULLNode* ullnode_create(void){
+    ULLNode* node = (ULLNode*)malloc(sizeof(ULLNode));
+
+    if(!node){
+        return NULL;
+    }
+
+    node->next = NULL;
+    node->count = 0;
+
+    return node;
+}
+
+/*
+    ullnode_free
+    Free a node from an unrolled linked list
+    @param  ULLNode*    Pointer to the node to be freed
+    @return void
+*/
+void ullnode_free(ULLNode* node){
+    free(node);
+}
+
+/*
+    ull_create
+    Create a new, empty, unrolled linked list
+    @param  void
+    @return UnrolledList*   Pointer to the new list
+*/
+UnrolledList* ull_create(void){
+    UnrolledList* ull = (UnrolledList*)malloc(sizeof(UnrolledList));
+
+    if(!ull){
+        return NULL;
+    }
+
+    ull->head = NULL;
+    ull->tail = NULL;
+    ull->size = 0;
+
+    return ull;
+}
+
+/*
+    ull_destroy
+    Destroy an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return void
+*/
+void ull_destroy(UnrolledList* ull){
+    ull_destroy_with(ull, NULL);
+}
+
+/*
+    ull_destroy_with
+    Destroy an unrolled linked list and the data of its elements, in one pass
+    @param  UnrolledList*       Pointer to the list
+    @param  void (*)(void*)     Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void ull_destroy_with(UnrolledList* ull, void (*free_data)(void*)){
+    ULLNode* current = ull->head;
+    ULLNode* next = NULL;
+
+    while(current){
+        next = current->next;
+
+        if(free_data){
+            for(size_t i = 0; i < current->count; i++){
+                free_data(current->data[i]);
+            }
+        }
+
+        ullnode_free(current);
+        current = next;
+    }
+
+    free(ull);
+}
+
+/*
+    ull_insert
+    Insert a new element at the beginning of an unrolled linked list.
+    The element goes in the first node when it has room, otherwise a new first node is created.
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be stored
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_insert(UnrolledList* ull, void* data){
+    ULLNode* node = ull->head;
+
+    if(!node || node->count == ULL_NODE_CAPACITY){
+        node = ullnode_create();
+
+        if(!node){
+            return false;
+        }
+
+        node->next = ull->head;
+        ull->head = node;
+
+        if(!ull->tail){
+            ull->tail = node;
+        }
+    }
+
+    memmove(&node->data[1], &node->data[0], node->count * sizeof(void*));
+    node->data[0] = data;
+    node->count++;
+    ull->size++;
+
+    return true;
+}
+
+/*
+    ull_append
+    Append a new element at the end of an unrolled linked list.
+    The element goes in the last node when it has room, otherwise a new last node is created.
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be stored
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_append(UnrolledList* ull, void* data){
+    ULLNode* node = ull->tail;
+
+    if(!node || node->count == ULL_NODE_CAPACITY){
+        node = ullnode_create();
+
+        if(!node){
+            return false;
+        }
+
+        if(ull->tail){
+            ull->tail->next = node;
+        }   else{
+                ull->head = node;
+        }
+
+        ull->tail = node;
+    }
+
+    node->data[node->count++] = data;
+    ull->size++;
+
+    return true;
+}
+
+/*
+    ull_remove
+    Remove an element from an unrolled linked list.
+    A node that falls below half capacity takes elements from its successor: the two nodes are merged when they fit in one, otherwise the node borrows
+    the first elements of its successor until it is half full. Empty nodes are freed.
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be removed
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_remove(UnrolledList* ull, void* data){
+    ULLNode* current = ull->head;
+    ULLNode* previous = NULL;
+
+    while(current){
+        for(size_t i = 0; i < current->count; i++){
+            if(current->data[i] != data){
+                continue;
+            }
+
+            memmove(&current->data[i], &current->data[i + 1], (current->count - i - 1) * sizeof(void*));
+            current->count--;
+            ull->size--;
+
+            if(current->count == 0){
+                if(previous){
+                    previous->next = current->next;
+                }   else{
+                        ull->head = current->next;
+                }
+
+                if(ull->tail == current){
+                    ull->tail = previous;
+                }
+
+                ullnode_free(current);
+            }   else if(current->count < ULL_NODE_CAPACITY / 2 && current->next && current->count + current->next->count <= ULL_NODE_CAPACITY){
+                    ULLNode* next = current->next;
+
+                    memcpy(&current->data[current->count], next->data, next->count * sizeof(void*));
+                    current->count += next->count;
+                    current->next = next->next;
+
+                    if(ull->tail == next){
+                        ull->tail = current;
+                    }
+
+                    ullnode_free(next);
+            }   else if(current->count < ULL_NODE_CAPACITY / 2 && current->next){
+                    //  The successor holds more than the missing elements: borrow them, which leaves it more than half full
+                    ULLNode* next = current->next;
+                    size_t borrowed = ULL_NODE_CAPACITY / 2 - current->count;
+
+                    memcpy(&current->data[current->count], next->data, borrowed * sizeof(void*));
+                    memmove(next->data, &next->data[borrowed], (next->count - borrowed) * sizeof(void*));
+                    current->count += borrowed;
+                    next->count -= borrowed;
+            }
+
+            return true;
+        }
+
+        previous = current;
+        current = current->next;
+    }
+
+    return false;
+}
+
+/*
+    ull_search
+    Search for an element in an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be searched
+    @param  size_t*         If not NULL, receives the index of the element inside the returned node
+    @return ULLNode*        Pointer to the node holding the element if found, NULL otherwise
+*/
+ULLNode* ull_search(UnrolledList* ull, void* data, size_t* index){
+    ULLNode* current = ull->head;
+
+    while(current){
+        for(size_t i = 0; i < current->count; i++){
+            if(current->data[i] == data){
+                if(index){
+                    *index = i;
+                }
+                return current;
+            }
+        }
+
+        current = current->next;
+    }
+
+    return NULL;
+}
+
+/*
+    ull_print
+    Print the contents of an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return void
+*/
+void ull_print(UnrolledList* ull){
+    ULLNode* current = ull->head;
+
+    while(current){
+        for(size_t i = 0; i < current->count; i++){
+            printf("%d\n", *(int*)current->data[i]);
+        }
+        current = current->next;
+    }
+}
+
+/*
+    ull_len
+    Get the number of elements in an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return size_t          Number of elements in the list
+*/
+size_t ull_len(UnrolledList* ull){
+    return ull->size;
+}
@@ -0,0 +1,168 @@
+#ifndef DSL_UNROLLED_H
+#define DSL_UNROLLED_H
+/*
+    Interface for the implementation of the unrolled linked list.
+
+    An `UnrolledList` is a singly linked list where each node stores a small array of elements instead of a single one.
+    The node is sized to two 64-byte cache lines: a traversal touches one node (and one cache miss) every `ULL_NODE_CAPACITY` elements, instead of one node per element for a `SinglyLinkedList`.
+
+    The elements are `void*` pointers, with the same semantics as in `SinglyLinkedList`:
+    - `ull_insert` adds an element at the beginning of the list, `ull_append` at the end;
+    - `ull_remove` and `ull_search` look for the first element whose pointer equals the given one.
+
+    A removal that leaves a node below half capacity refills it from its successor: the two nodes are merged when they fit in one, otherwise the node borrows
+    elements from its successor until it is half full; only the last node can stay below half capacity. Insertions create a node, with a single element,
+    only when the first or last node is full, so a node is not kept half full until a removal reaches it.
+
+    The following functions are provided for working with unrolled linked lists:
+    - `ull_create`: Create a new unrolled linked list
+    - `ull_destroy`: Destroy an unrolled linked list
+    - `ull_destroy_with`: Destroy an unrolled linked list and the data of its elements
+    - `ull_insert`: Insert a new element at the beginning of an unrolled linked list
+    - `ull_append`: Append a new element at the end of an unrolled linked list
+    - `ull_remove`: Remove an element from an unrolled linked list
+    - `ull_search`: Search for an element in an unrolled linked list
+    - `ull_print`: Print the contents of an unrolled linked list
+    - `ull_len`: Get the number of elements in an unrolled linked list
+
+    Sorting functions for the `UnrolledList` are defined in `dsl_listsort.h`.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Number of elements stored in a node.
+    With 64-bit pointers, a node takes 8 (`next`) + 8 (`count`) + 14 * 8 = 128 bytes, i.e. two cache lines.
+*/
+#ifndef ULL_NODE_CAPACITY
+#define ULL_NODE_CAPACITY 14
+#endif
+
+/*
+    Node of an unrolled linked list
+    - `next` is a pointer to the next node in the list
+    - `count` is the number of elements stored in the node
+    - `data` are the pointers to the data of the elements, in list order
+*/
+typedef struct UnrolledListNode {
+    struct UnrolledListNode *next;
+    size_t count;
+    void *data[ULL_NODE_CAPACITY];
+} ULLNode;
+
+/*
+    Unrolled linked list
+    - `head` is a pointer to the first node in the list
+    - `tail` is a pointer to the last node in the list
+    - `size` is the number of elements in the list
+*/
+typedef struct UnrolledList {
+    ULLNode *head;
+    ULLNode *tail;
+    size_t size;
+} UnrolledList;
+
+//  Unrolled Linked List methods
+
+/*
+    ullnode_create
+    Create a new, empty, unrolled linked list node
+    @param  void
+    @return ULLNode*    Pointer to the new node
+*/
+ULLNode* ullnode_create(void);
+
+/*
+    ullnode_free
+    Free a node from an unrolled linked list
+    @param  ULLNode*    Pointer to the node to be freed
+    @return void
+*/
+void ullnode_free(ULLNode* node);
+
+/*
+    ull_create
+    Create a new unrolled linked list
+    @param  void
+    @return UnrolledList*   Pointer to the new list
+*/
+UnrolledList* ull_create(void);
+
+/*
+    ull_destroy
+    Destroy an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return void
+*/
+void ull_destroy(UnrolledList* ull);
+
+/*
+    ull_destroy_with
+    Destroy an unrolled linked list and free the data of its elements in the same pass
+    @param  UnrolledList*       Pointer to the list
+    @param  void (*)(void*)     Function freeing the data of an element, NULL to leave the data to the caller
+    @return void
+*/
+void ull_destroy_with(UnrolledList* ull, void (*free_data)(void*));
+
+/*
+    ull_insert
+    Insert a new element at the beginning of an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be stored
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_insert(UnrolledList* ull, void* data);
+
+/*
+    ull_append
+    Append a new element at the end of an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be stored
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_append(UnrolledList* ull, void* data);
+
+/*
+    ull_remove
+    Remove an element from an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be removed
+    @return bool            true if the operation was successful, false otherwise
+*/
+bool ull_remove(UnrolledList* ull, void* data);
+
+/*
+    ull_search
+    Search for an element in an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @param  void*           Pointer to the data to be searched
+    @param  size_t*         If not NULL, receives the index of the element inside the returned node
+    @return ULLNode*        Pointer to the node holding the element if found, NULL otherwise
+*/
+ULLNode* ull_search(UnrolledList* ull, void* data, size_t* index);
+
+/*
+    ull_print
+    Print the contents of an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return void
+*/
+void ull_print(UnrolledList* ull);
+
+/*
+    ull_len
+    Get the number of elements in an unrolled linked list
+    @param  UnrolledList*   Pointer to the list
+    @return size_t          Number of elements in the list
+*/
+size_t ull_len(UnrolledList* ull);
+
+#endif // DSL_UNROLLED_H
@@ -0,0 +1,223 @@
+/*
+    Implementation of the work-stealing deque (Chase-Lev), following the C11 formulation by Le, Pop, Cohen and Zappa Nardelli.
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include "dsl_wsdeque.h"
+
+/*
+    wsdeque_buffer_create
+    Allocate a circular buffer with the given capacity
+    @param  size_t          Capacity of the buffer (a power of two)
+    @return WSDequeBuffer*  Pointer to the new buffer, NULL if the allocation failed
+*/
+static WSDequeBuffer* wsdeque_buffer_create(size_t capacity){
+    WSDequeBuffer* buffer = (WSDequeBuffer*)malloc(sizeof(WSDequeBuffer) + capacity * sizeof(_Atomic(void*)));
+
+    if(!buffer){
+        return NULL;
+    }
+
+    buffer->capacity = capacity;
+    buffer->retired = NULL;
+
+    return buffer;
+}
+
+/*
+    wsdeque_buffer_get / wsdeque_buffer_put
+    Relaxed access to the slot of index `i` of a circular buffer
+*/
+static inline void* wsdeque_buffer_get(WSDequeBuffer* buffer, long i){
+    return atomic_load_explicit(&buffer->items[(size_t)i & (buffer->capacity - 1)], memory_order_relaxed);
+}
+
+static inline void wsdeque_buffer_put(WSDequeBuffer* buffer, long i, void* data){
+    atomic_store_explicit(&buffer->items[(size_t)i & (buffer->capacity - 1)], data, memory_order_relaxed);
+}
+
+/*
+    wsdeque_grow
+    Replace the buffer of a deque by one twice as large, copying the elements in [top, bottom)
+    @param  WSDeque*        Pointer to the deque
+    @param  WSDequeBuffer*  Pointer to the current buffer
+    @param  long            Current top index
+    @param  long            Current bottom index
+    @return WSDequeBuffer*  Pointer to the new buffer, NULL if the allocation failed
+*/
+static WSDequeBuffer* wsdeque_grow(WSDeque* deque, WSDequeBuffer* buffer, long top, long bottom){
+    WSDequeBuffer* grown = wsdeque_buffer_create(buffer->capacity * 2);
+
+    if(!grown){
+        return NULL;
+    }
+
+    for(long i = top; i < bottom; i++){
+        wsdeque_buffer_put(grown, i, wsdeque_buffer_get(buffer, i));
+    }
+
+    //  Thieves may still be reading the old buffer: keep it until the deque is destroyed
+    grown->retired = buffer;
+    atomic_store_explicit(&deque->buffer, grown, memory_order_release);
+
+    return grown;
+}
+
+/*
+    wsdeque_create
+    Create a new work-stealing deque
+    @param  size_t      Initial capacity of the deque (rounded up to a power of two)
+    @return WSDeque*    Pointer to the new deque, NULL if the allocation failed
+*/
+WSDeque* wsdeque_create(size_t capacity){
+    WSDeque* deque = (WSDeque*)malloc(sizeof(WSDeque));
+
+    if(!deque){
+        return NULL;
+    }
+
+    size_t rounded = 16;
+    while(rounded < capacity){
+        rounded *= 2;
+    }
+
+    WSDequeBuffer* buffer = wsdeque_buffer_create(rounded);
+
+    if(!buffer){
+        free(deque);
+        return NULL;
+    }
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+
+    return deque;
+}
+
+/*
+    wsdeque_destroy
+    Destroy a work-stealing deque, including every retired buffer
+    @param  WSDeque*    Pointer to the deque
+    @return void
+*/
+void wsdeque_destroy(WSDeque* deque){
+    WSDequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    WSDequeBuffer* retired = NULL;
+
+    while(buffer){
+        retired = buffer->retired;
+        free(buffer);
+        buffer = retired;
+    }
+
+    free(deque);
+}
+
+/*
+    wsdeque_push
+    Push an element at the bottom of the deque (owner only)
+    @param  WSDeque*    Pointer to the deque
+    @param  void*       Pointer to the data to be pushed
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool wsdeque_push(WSDeque* deque, void* data){
+    if(!data){
+        return false;
+    }
+
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    WSDequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    if(bottom - top > (long)buffer->capacity - 1){
+        buffer = wsdeque_grow(deque, buffer, top, bottom);
+
+        if(!buffer){
+            return false;
+        }
+    }
+
+    wsdeque_buffer_put(buffer, bottom, data);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return true;
+}
+
+/*
+    wsdeque_pop
+    Pop an element from the bottom of the deque (owner only)
+    @param  WSDeque*    Pointer to the deque
+    @return void*       Pointer to the data of the bottom element, NULL if the deque is empty
+*/
+void* wsdeque_pop(WSDeque* deque){
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    WSDequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    void* data = NULL;
+
+    if(top <= bottom){
+        data = wsdeque_buffer_get(buffer, bottom);
+
+        if(top == bottom){
+            //  Last element: race against the thieves for it
+            if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)){
+                data = NULL;
+            }
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }   else{
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return data;
+}
+
+/*
+    wsdeque_steal
+    Steal an element from the top of the deque
+    @param  WSDeque*    Pointer to the deque
+    @return void*       Pointer to the data of the top element, NULL if the deque is empty or the race was lost
+*/
+void* wsdeque_steal(WSDeque* deque){
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if(top >= bottom){
+        return NULL;
+    }
+
+    WSDequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    void* data = wsdeque_buffer_get(buffer, top);
+
+    if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)){
+        return NULL;
+    }
+
+    return data;
+}
+
+/*
+    wsdeque_size
+    Get the number of elements in the deque
+    @param  WSDeque*    Pointer to the deque
+    @return size_t      Number of elements in the deque
+*/
+size_t wsdeque_size(WSDeque* deque){
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
@@ -0,0 +1,104 @@
+#ifndef DSL_WSDEQUE_H
+#define DSL_WSDEQUE_H
+/*
+    Interface for the implementation of a work-stealing deque (Chase-Lev).
+
+    A `WSDeque` is a double-ended queue with a single owner thread and any number of thief threads.
+    - The owner pushes and pops elements at the bottom of the deque, without contention in the common case.
+    - Thieves steal elements from the top of the deque, racing with each other (and with the owner on the last element) through a compare-and-swap on `top`.
+
+    The deque stores `void*` pointers, like the other structures in `dsl_lists.h`. `NULL` cannot be stored, since it is used to signal an empty deque (or a lost race, for `wsdeque_steal`).
+
+    The circular buffer grows when full. Retired buffers may still be read by in-flight thieves, so they are kept until the deque is destroyed.
+
+    The current `WSDeque` methods are:
+    - `wsdeque_create`: Create a new work-stealing deque
+    - `wsdeque_destroy`: Destroy a work-stealing deque
+    - `wsdeque_push`: Push an element at the bottom (owner only)
+    - `wsdeque_pop`: Pop an element from the bottom (owner only)
+    - `wsdeque_steal`: Steal an element from the top (any thread)
+    - `wsdeque_size`: Get an estimate of the number of elements in the deque
+
+
+    nrdc
+    v1.0 2026-10-18
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/*
+    Circular buffer of a work-stealing deque
+    - `capacity` is the number of slots in the buffer (always a power of two)
+    - `retired` is a pointer to the previous (smaller) buffer, kept alive for in-flight thieves
+    - `items` are the slots of the buffer
+*/
+typedef struct WSDequeBuffer {
+    size_t capacity;
+    struct WSDequeBuffer *retired;
+    _Atomic(void*) items[];
+} WSDequeBuffer;
+
+/*
+    Work-stealing deque
+    - `top` is the index of the next element to be stolen
+    - `bottom` is the index of the next free slot at the owner's end
+    - `buffer` is a pointer to the current circular buffer
+*/
+typedef struct WSDeque {
+    atomic_long top;
+    atomic_long bottom;
+    _Atomic(WSDequeBuffer*) buffer;
+} WSDeque;
+
+/*
+    wsdeque_create
+    Create a new work-stealing deque
+    @param  size_t      Initial capacity of the deque (rounded up to a power of two)
+    @return WSDeque*    Pointer to the new deque, NULL if the allocation failed
+*/
+WSDeque* wsdeque_create(size_t capacity);
+
+/*
+    wsdeque_destroy
+    Destroy a work-stealing deque. No other thread may access the deque during or after this call.
+    @param  WSDeque*    Pointer to the deque
+    @return void
+*/
+void wsdeque_destroy(WSDeque* deque);
+
+/*
+    wsdeque_push
+    Push an element at the bottom of the deque. Must only be called by the owner thread.
+    @param  WSDeque*    Pointer to the deque
+    @param  void*       Pointer to the data to be pushed (must not be NULL)
+    @return bool        true if the operation was successful, false otherwise
+*/
+bool wsdeque_push(WSDeque* deque, void* data);
+
+/*
+    wsdeque_pop
+    Pop an element from the bottom of the deque. Must only be called by the owner thread.
+    @param  WSDeque*    Pointer to the deque
+    @return void*       Pointer to the data of the bottom element, NULL if the deque is empty
+*/
+void* wsdeque_pop(WSDeque* deque);
+
+/*
+    wsdeque_steal
+    Steal an element from the top of the deque. May be called by any thread.
+    @param  WSDeque*    Pointer to the deque
+    @return void*       Pointer to the data of the top element, NULL if the deque is empty or the race was lost
+*/
+void* wsdeque_steal(WSDeque* deque);
+
+/*
+    wsdeque_size
+    Get the number of elements in the deque. The value is only a snapshot when other threads are active.
+    @param  WSDeque*    Pointer to the deque
+    @return size_t      Number of elements in the deque
+*/
+size_t wsdeque_size(WSDeque* deque);
+
+#endif // DSL_WSDEQUE_H
@@ -15,6 +15,31 @@
 
     Benchmarking
     - The time taken to sort a list of 1000 elements is measured for each sorting algorithm.
+    - The work-stealing thread pool is measured on an unbalanced recursive workload and on a parallel merge sort.
+    - The traversal of an unrolled linked list is compared with the traversal of a singly linked list.
+    - A list storing `int` values inline is compared with a singly linked list of `int*`.
+    - The sorts generated by `DSL_DEFINE_SORT` are compared with the callback sorts.
+    - The search in a skip list is compared with `sll_search` on sorted lists of 10^3 to 10^7 elements.
+    - The removal from a doubly linked list is compared with and without a hash index.
+    - The LRU and CLOCK caches are measured on Zipf traces, with and without sharding.
+    - The d-ary heap is compared with a queue sorted again after every priority change.
+    - The top-k selection, partial sort and nth element of a list are compared with a full sort for several K/N ratios.
+    - The natural merge sort is compared with the top-down merge sort on lists made of sorted batches.
+    - The k-way merge of sorted lists is compared with sorting their concatenation.
+    - Sorting a list through an array is compared with the in-list sorts for lists of 10^2 to 10^6 elements.
+    - The radix, SSE4.2 and AVX2 integer sorts are compared with the in-list merge sort for lists of 10^4 to 10^7 elements.
+    - The external sort is compared with the in-memory merge sort under shrinking memory budgets.
+    - Loading a list from a mapped list file is compared with rebuilding it element by element.
+    - The bulk list constructors are compared with building a list element by element.
+    - Merging and splitting lists by splicing their nodes is compared with the append loops.
+    - Destroying a list with its elements in one pass is compared with freeing them in a loop first, for lists of 10^6 and 10^7 elements.
+    - The search throughput on a heap-scattered list is measured with and without prefetching ahead of the traversal.
+    - The memory per element and the operations of the compact lists are compared with the singly and doubly linked lists.
+    - The traversal of sorted lists is measured before and after their compaction.
+    - The block deque is compared with the node-based stack and queue through the same `stack_*` and `queue_*` calls.
+    - The throughput and latency of a blocking queue are compared with a consumer polling a queue under a mutex.
+    - The node caches are compared with `malloc` and `free` on a multi-threaded churn of node allocations.
+    - The parallel reduce, foreach and filter over a singly linked list are compared with a sequential pass on 1 to 4 threads.
 */
 
 #include <stdio.h>
@@ -25,6 +50,7 @@
 #include "dsl_lists.h"
 #include "dsl_listsort.h"
 #include "dsl_benchmarking_suite.h"
+#include "dsl_threadpool.h"
 
 #define LIST_SIZE 1000
 
@@ -63,7 +89,131 @@ int main(){
     RUN("dll_quicksort", "dll", 1000, 100);
     RUN("dll_mergesort", "dll", 1000, 100);
 
+    //  Test the work-stealing `ThreadPool`
+    PRINT_TITLE("Testing the work-stealing thread pool");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_threadpool(32, 1000000));
+
+    //  Test the `UnrolledList` data structure
+    PRINT_TITLE("Testing the Unrolled Linked List data structure");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_unrolled_traversal(1000000, 20));
+
+    //  Test the inline value storage generated by `dsl_typed_lists.h`
+    PRINT_TITLE("Testing the inline value storage lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_typed_sll(1000000, 20));
+
+    //  Test the type-specialized sorts generated by `dsl_sortgen.h`
+    PRINT_TITLE("Testing the type-specialized sorting algorithms");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_sortgen(100, 1000));
+
+    //  Test the `SkipList` data structure
+    PRINT_TITLE("Testing the Skip List data structure");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_skiplist(3, 7, 100000));
+
+    //  Test the `HashIndex` of the lists
+    PRINT_TITLE("Testing the hash index of the lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_hashindex(100000, 1000));
+
+    //  Test the LRU and CLOCK caches
+    PRINT_TITLE("Testing the LRU and CLOCK caches");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_cache(1000000, 10000, 2000000));
+
+    //  Test the `Heap` priority queue
+    PRINT_TITLE("Testing the d-ary heap priority queue");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_heap(10000, 1000));
+
+    //  Test the top-k selection over lists
+    PRINT_TITLE("Testing the top-k selection and partial sort");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_topk(1000000));
+
+    //  Test the natural merge sort on partially sorted lists
+    PRINT_TITLE("Testing the natural merge sort");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_natural_mergesort(1000000));
+
+    //  Test the k-way merge of sorted lists
+    PRINT_TITLE("Testing the k-way merge of sorted lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_merge_k(1000000));
+
+    //  Test the sort through an array
+    PRINT_TITLE("Testing the sort through an array");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_arraysort(100, 1000000));
+
+    //  Test the integer sort kernels
+    PRINT_TITLE("Testing the SIMD integer sorts");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_simdsort(10000, 10000000));
+
+    //  Test the external sort
+    PRINT_TITLE("Testing the external sort");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_extsort(1000000));
+
+    //  Test the list files
+    PRINT_TITLE("Testing the list files");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_serialize(1000000));
+
+    //  Test the bulk construction of lists
+    PRINT_TITLE("Testing the bulk construction of lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_bulk_construction(10000000));
+
+    //  Test the splicing of lists
+    PRINT_TITLE("Testing the splicing of lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_splice(1000000, 64));
+
+    //  Test the teardown of lists
+    PRINT_TITLE("Testing the teardown of lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_teardown(1000000));
+    fprintf(stdout, "%s", run_benchmark_teardown(10000000));
+
+    //  Test the prefetching traversal
+    PRINT_TITLE("Testing the prefetching traversal");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_prefetch(4000000, 3));
+
+    //  Test the compact lists
+    PRINT_TITLE("Testing the compact lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_compactlist(1000000));
+
+    //  Test the compaction of lists
+    PRINT_TITLE("Testing the compaction of lists");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_compaction(1000000, 10));
+
+    //  Test the block deque
+    PRINT_TITLE("Testing the block deque");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_deque(1000000));
+
+    //  Test the blocking queue
+    PRINT_TITLE("Testing the blocking queue");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_blockingqueue(1000000, 2000));
 
+    //  Test the node caches
+    PRINT_TITLE("Testing the node caches");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_nodecache(20000000, 4));
+
+    //  Test the parallel list operations
+    PRINT_TITLE("Testing the parallel list operations");
+    PRINT_LINE();
+    fprintf(stdout, "%s", run_benchmark_parallel(4000000, 4));
 
 
     //  Finish program